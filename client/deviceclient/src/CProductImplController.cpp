@@ -68,6 +68,9 @@ std::string g_strStartupReason = "";
 //! Client restart count
 int g_nRestartCount = 0;
 
+//! compression dictionary file to train, if the Client is started to train it
+std::string g_strDictionaryPath = "";
+
 #if defined(IC_UNIT_TEST)
 static const std::string IGNITION_EV_ID = "IgnStatus";
 static const std::string IGNITION_EV_VER = "1.0";
@@ -87,7 +90,10 @@ void print_usage()
     std::cerr << "-re <restart reason> <restart count> " <<
             "- to set the client restart reason and restart count" << std::endl;
     std::cerr << "-d <debug level {1..7}> - to set debug level" << std::endl;
-    std::cerr << "-i - to print client details and then exit\n" << std::endl;
+    std::cerr << "-i - to print client details and then exit" << std::endl;
+    std::cerr << "-td <dictionary file> - to train a candidate upload " <<
+            "compression dictionary from the stored events and then exit\n" <<
+            std::endl;
 }
 
 /**
@@ -203,6 +209,37 @@ bool handle_restart_count_option(int &rnIter, const int &rnArgC, char *pchArgV[]
     return bResult;
 }
 
+/**
+ * Method to handle the compression dictionary training command-line argument.
+ * @param[in] rnIter current iterator position of the command-line arguments
+ * @param[in] rnArgC count of command-line arguments
+ * @param[in] pchArgV array of command-line arguments
+ * @return true if dictionary file path is successfully read, false otherwise
+ */
+bool handle_train_dictionary_option(int &rnIter, const int &rnArgC,
+                                    char *pchArgV[])
+{
+    bool bResult = false;
+
+    //increment to read the dictionary file path
+    rnIter++;
+
+    if (rnIter < rnArgC)
+    {
+        // Make sure this isn't another switch
+        if (pchArgV[rnIter][0] != '-')
+        {
+            g_strDictionaryPath = pchArgV[rnIter];
+            bResult = true;
+        }
+    }
+    else
+    {
+        std::cerr << "Dictionary file is not found!" << std::endl;
+    }
+    return bResult;
+}
+
 /**
  * Method to parse the command-line arguments
  * @param[in] nArgC count of command-line arguments
@@ -235,6 +272,11 @@ bool parse_args(int nArgC, char *pchArgV[])
         {
             bParseResult = g_bOutputInfo = true;
         }
+        else if (0 == strcmp(pchArgV[nIter], "-td"))
+        {
+            bParseResult = handle_train_dictionary_option(nIter, nArgC,
+                                                          pchArgV);
+        }
         else
         {
             HCPLOG_T << "Error on argument: " << pchArgV[nIter];
@@ -390,6 +432,22 @@ void CProductImplController::StartController(int &rnArgC, char *pchArgV[])
     m_pMsgDispatcher = new ic_device::CClientMessageDispatcherImpl();
     ic_core::CIgniteClient::SetClientMessageDispatcher(m_pMsgDispatcher);
 
+    if (!g_strDictionaryPath.empty())
+    {
+        // events are decrypted for training, keys are ready after InitAnalytics
+        if (0 != ic_core::CIgniteClient::TrainCompressionDictionary(
+                                                          g_strDictionaryPath))
+        {
+            std::cerr << "Dictionary training failed!" << std::endl;
+        }
+
+        // leave through the normal shutdown, releasing the client resources
+        ic_core::CIgniteClient::PrepareForShutdown(0, true,
+                                           ic_core::IC_EXIT_TYPE::eNORMAL_EXIT);
+        Start();
+        return;
+    }
+
     HCPLOG_I << " - Detecting and setting Bench Mode to differentiate real cars and test HUs.";
     std::string benchModeFilePath = ic_core::CIgniteConfig::GetInstance()->
                                                GetAsString("BenchModeFilePath");
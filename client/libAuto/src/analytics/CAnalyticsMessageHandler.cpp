@@ -20,6 +20,7 @@
 #include "CClientConn.h"
 #include "CIgniteLog.h"
 #include "db/CLocalConfig.h"
+#include "dam/CSharedEvent.h"
 #include "CRemoteService.h"
 
 using namespace std;
@@ -104,9 +105,15 @@ void CAnalyticsMessageHandler::NotifyMessage(MsgPayload msgPayload)
 {
     if (msgPayload.eType == ic_core::IMessageHandler::eMSG_TYPE_EVENT)
     {
-        ic_core::CEventWrapper event;
-        event.JsonToEvent(msgPayload.strPayloadJson);
-        std::string strEventID = event.GetEventId();
+        /* parse only if the event is not already available, so that the
+         * base handler can reuse the same parsed event for dispatching
+         */
+        if (!msgPayload.pEvent)
+        {
+            msgPayload.pEvent = 
+                 ic_core::CSharedEvent::Create(msgPayload.strPayloadJson);
+        }
+        const std::string &strEventID = msgPayload.pEvent->GetEventId();
 
         //proceed only if it is required event
         if (!m_jsonEventDomainMap.isMember(strEventID))
@@ -118,14 +125,14 @@ void CAnalyticsMessageHandler::NotifyMessage(MsgPayload msgPayload)
         {
             //store in localConfig
             ic_core::CLocalConfig::GetInstance()->Set("lastLocation",
-                                                    msgPayload.strPayloadJson);
+                                         msgPayload.pEvent->GetSerialized());
         }
         // store Odometer event
         if (strEventID.compare("Odometer") == 0)
         {
             //store in localConfig
             ic_core::CLocalConfig::GetInstance()->Set("lastOdometer",
-                                                    msgPayload.strPayloadJson);
+                                         msgPayload.pEvent->GetSerialized());
         }
     }
 
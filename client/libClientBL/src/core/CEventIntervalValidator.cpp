@@ -36,11 +36,9 @@ static const std::string KEY_EVENT_INTERVAL_VALIDATOR =
 static const std::string KEY_EVENT_INTERVAL_LIST = "DAM.Database.IntervalList";
 
 CEventIntervalValidator::CEventIntervalValidator()
+    : m_bValidateInterval(false), m_ullConfigVersion(0)
 {
     m_mapEventInterval.clear();
-    m_bValidateInterval = ic_core::CIgniteConfig::GetInstance()->GetBool
-                                            (KEY_EVENT_INTERVAL_VALIDATOR,
-                                            false);
     PopulateEventIntervalFromConfig();
 }
 
@@ -52,27 +50,42 @@ CEventIntervalValidator* CEventIntervalValidator::GetInstance()
 
 void CEventIntervalValidator::PopulateEventIntervalFromConfig()
 {
-    ic_core::CIgniteConfig* pIgniteConfig = ic_core::CIgniteConfig::
-                                                                GetInstance();
-    ic_utils::Json::Value jsonIntervalList = pIgniteConfig->GetJsonValue(
-                                                    KEY_EVENT_INTERVAL_LIST);
+    std::shared_ptr<const ic_core::CConfigSnapshot> pSnapshot = 
+                            ic_core::CIgniteConfig::GetInstance()->GetSnapshot();
+
+    ic_utils::CScopeLock scopeLock(m_IntervalMutex);
+    if (pSnapshot->GetVersion() == m_ullConfigVersion)
+    {
+        // Already populated from this snapshot by another thread
+        return;
+    }
+
+    const ic_utils::Json::Value &rjsonIntervalList = 
+                              pSnapshot->GetJsonValue(KEY_EVENT_INTERVAL_LIST);
 
     /* Iterate over each list and populate map with it's interval
      * Value -1 indicates, it does not need any interval check and
      * can be uploaded as it came.
      */
-    ic_utils::Json::ValueIterator jsonIterStart = jsonIntervalList.begin();
-    ic_utils::Json::ValueIterator jsonIterEnd   = jsonIntervalList.end();
-
-    ic_utils::CScopeLock scopeLock(m_IntervalMutex);
+    std::map<std::string, std::pair<int, long long int> > mapEventInterval;
+    ic_utils::Json::ValueConstIterator jsonIterStart = rjsonIntervalList.begin();
+    ic_utils::Json::ValueConstIterator jsonIterEnd   = rjsonIntervalList.end();
     for(; jsonIterStart != jsonIterEnd; jsonIterStart++)
     {
         std::string strEventId = jsonIterStart.key().asString();
         int nIntvl = (*jsonIterStart).asInt64();
         HCPLOG_I << strEventId << " with interval = " << nIntvl <<
                                                 "  Configured  to upload";
-        m_mapEventInterval[strEventId] = std::make_pair(nIntvl, 0);
+        std::map<std::string, std::pair<int, long long int> >::iterator 
+                                iterOld = m_mapEventInterval.find(strEventId);
+        long long llPrevTimestamp = (iterOld != m_mapEventInterval.end()) ?
+                                                     iterOld->second.second : 0;
+        mapEventInterval[strEventId] = std::make_pair(nIntvl, llPrevTimestamp);
     }
+    m_mapEventInterval.swap(mapEventInterval);
+    m_bValidateInterval = pSnapshot->GetBool(KEY_EVENT_INTERVAL_VALIDATOR,
+                                             false);
+    m_ullConfigVersion = pSnapshot->GetVersion();
 }
 
 /* The method returns true
@@ -90,6 +103,12 @@ bool CEventIntervalValidator::IsValidInterval(std::string strEventId,
                                             long long llTimestamp)
 {
     HCPLOG_D << strEventId;
+    if (m_ullConfigVersion != 
+        ic_core::CIgniteConfig::GetInstance()->GetSnapshotVersion())
+    {
+        PopulateEventIntervalFromConfig();
+    }
+
     if(!m_bValidateInterval)
     {
         //Not set to check interval for events
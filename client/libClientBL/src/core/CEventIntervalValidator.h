@@ -29,6 +29,7 @@
 #define CEVENT_INTERVAL_VALIDATOR_H
 
 #include <map>
+#include <atomic>
 #include "CIgniteMutex.h"
 
 namespace ic_bl
@@ -75,7 +76,9 @@ private:
     CEventIntervalValidator();
 
     /**
-     * Method to populate event Interval based on configuration
+     * Method to populate event Interval based on the current config snapshot,
+     * if it changed since the intervals were populated. Timestamps of events
+     * still configured are kept.
      * @param void
      * @return void 
      * 
@@ -99,7 +102,10 @@ private:
     std::map<std::string, std::pair<int, long long int> >m_mapEventInterval;
 
     //! Member variable to check whether interval validation to be done or not
-    bool m_bValidateInterval;
+    std::atomic<bool> m_bValidateInterval;
+
+    //! Member variable to store version of config snapshot intervals read from
+    std::atomic<unsigned long long> m_ullConfigVersion;
 
     //! Member variable to provide mutex lock
     ic_utils::CIgniteMutex m_IntervalMutex;
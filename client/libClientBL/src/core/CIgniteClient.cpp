@@ -729,6 +729,12 @@ void CIgniteClient::CleanupAttachments()
     }
 }
 
+int CIgniteClient::TrainCompressionDictionary(const std::string &rstrPath)
+{
+    HCPLOG_C << "Training compression dictionary " << rstrPath;
+    return ic_bl::CUploadUtils::TrainCompressionDictionary(rstrPath) ? 0 : -1;
+}
+
 int CIgniteClient::StartNotifications()
 {
 
@@ -30,27 +30,51 @@ namespace ic_bl
 using std::string;
 
 CActivityDelay::CActivityDelay(CTransportHandlerBase* pNextHandler) :
-                               CTransportHandlerBase(pNextHandler)
+                               CTransportHandlerBase(pNextHandler),
+                               m_ullConfigVersion(0)
 {
     //read the config values
-    ic_utils::Json:: Value jsonUploadEventConfigValue =
-        ic_core::CIgniteConfig::GetInstance()->GetJsonValue
-                                                    ("DAM.UploadEventConfig");
-    if(jsonUploadEventConfigValue.size() == 0)
+    GetEventConfigData();
+}
+
+std::shared_ptr<const std::map<std::string, int>> 
+CActivityDelay::GetEventConfigData()
+{
+    if (m_ullConfigVersion == 
+        ic_core::CIgniteConfig::GetInstance()->GetSnapshotVersion())
+    {
+        return std::atomic_load(&m_pEventConfigData);
+    }
+
+    std::shared_ptr<const ic_core::CConfigSnapshot> pSnapshot = 
+                            ic_core::CIgniteConfig::GetInstance()->GetSnapshot();
+    const ic_utils::Json::Value &rjsonUploadEventConfigValue =
+                             pSnapshot->GetJsonValue("DAM.UploadEventConfig");
+    std::shared_ptr<std::map<std::string, int>> pEventConfigData(
+                                             new std::map<std::string, int>());
+    if(rjsonUploadEventConfigValue.size() == 0)
     {
         HCPLOG_I << "UploadEventConfig tag does not exist";
-        m_mapEventConfigData.clear();
-        return ;
     }
 
-    for(unsigned i = 0; i < jsonUploadEventConfigValue.size(); i++)
+    for(unsigned i = 0; i < rjsonUploadEventConfigValue.size(); i++)
     {
-        ic_utils::Json:: Value jsonConfigVal = jsonUploadEventConfigValue[i];
-        string strEventId = jsonConfigVal["eventID"].asString();
-        int nTimeout = jsonConfigVal["timeoutSec"].asInt();
-        m_mapEventConfigData.insert(std::pair <string, int>
-                                                        (strEventId, nTimeout));
+        const ic_utils::Json::Value &rjsonConfigVal = 
+                                                 rjsonUploadEventConfigValue[i];
+        string strEventId = rjsonConfigVal["eventID"].asString();
+        int nTimeout = rjsonConfigVal["timeoutSec"].asInt();
+        pEventConfigData->insert(std::pair <string, int>(strEventId, nTimeout));
     }
+
+    /*
+     * The map is never modified once published, so the event and upload
+     * threads can both use it without locking
+     */
+    std::shared_ptr<const std::map<std::string, int>> pPublished = 
+                                                              pEventConfigData;
+    std::atomic_store(&m_pEventConfigData, pPublished);
+    m_ullConfigVersion = pSnapshot->GetVersion();
+    return pPublished;
 }
 
 CActivityDelay::~CActivityDelay()
@@ -63,8 +87,10 @@ void CActivityDelay::HandleEvent(ic_core::CEventWrapper* pEvent)
     HCPLOG_METHOD();
     long long  llCurrentTime = ic_utils::CIgniteDateTime::GetMonotonicTimeMs();
     std::string strEventID = pEvent->GetEventId();
+    std::shared_ptr<const std::map<std::string, int>> pEventConfigData = 
+                                                          GetEventConfigData();
 
-    if(m_mapEventConfigData.find(strEventID) != m_mapEventConfigData.end())
+    if(pEventConfigData->find(strEventID) != pEventConfigData->end())
     {
         std::pair<std::map<std::string, long long>::iterator, bool> ret;
         ret = m_mapDefervent.insert(std::pair <std::string,
@@ -98,25 +124,30 @@ int CActivityDelay::ComputeDeferUpload()
     long long llCurrentTime = ic_utils::CIgniteDateTime::GetMonotonicTimeMs();
 
     int nDefertime = 0;
+    std::shared_ptr<const std::map<std::string, int>> pEventConfigData = 
+                                                          GetEventConfigData();
     if(!m_mapDefervent.empty())
     {
         for (std::map<std::string, long long>::iterator defer_iter = 
              m_mapDefervent.begin(); defer_iter != m_mapDefervent.end();
              ++defer_iter)
         {
+            std::map<std::string, int>::const_iterator config_iter = 
+                                      pEventConfigData->find(defer_iter->first);
+            int nTimeout = (config_iter != pEventConfigData->end()) ? 
+                                                         config_iter->second : 0;
             if((TIME_DIFFERNCE_IN_SECONDS(llCurrentTime,
-              defer_iter->second )) >=  m_mapEventConfigData[defer_iter->first])
+              defer_iter->second )) >=  nTimeout)
             {
                 continue;
             }
             else
             {
                 //calculating the max defer time among the stored UI events
-                if((m_mapEventConfigData[defer_iter->first] - 
-                            TIME_DIFFERNCE_IN_SECONDS(llCurrentTime,
+                if((nTimeout - TIME_DIFFERNCE_IN_SECONDS(llCurrentTime,
                             defer_iter->second)) > nDefertime)
                 {
-                    nDefertime = m_mapEventConfigData[defer_iter->first] - 
+                    nDefertime = nTimeout - 
                                  TIME_DIFFERNCE_IN_SECONDS(llCurrentTime,
                                  defer_iter->second);
                 }
@@ -33,6 +33,8 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <map>
+#include <memory>
+#include <atomic>
 #include "dam/CTransportHandlerBase.h"
 
 namespace ic_bl 
@@ -72,12 +74,22 @@ public:
     virtual void HandleEvent(ic_core::CEventWrapper* pEvent);
 
 protected:
+    /**
+     * Method to get the configured event timeouts, read again from the config
+     * snapshot if it changed since they were read
+     * @param void
+     * @return Map of eventId as key and timeout in seconds as value
+     */
+    std::shared_ptr<const std::map<std::string, int>> GetEventConfigData();
 
     //! Member variable stores eventId as key and its current time as value
     std::map<std::string, long long> m_mapDefervent;
     
     //! Member variable stores eventId as key and timeout in seconds as value
-    std::map<std::string, int> m_mapEventConfigData;
+    std::shared_ptr<const std::map<std::string, int>> m_pEventConfigData;
+
+    //! Member variable stores version of config snapshot timeouts read from
+    std::atomic<unsigned long long> m_ullConfigVersion;
 };
 
 } /* namespace ic_bl*/
@@ -32,6 +32,7 @@
 #include "CDBTransportWrapper.h"
 #include "upload/CMQTTUploader.h"
 #include "dam/CDBTransportWrapper.h"
+#include "CEventCodec.h"
 
 //! Macro for CCacheTransport string
 #ifdef PREFIX
@@ -61,6 +62,9 @@ static const int DEF_EVENT_RECEIVER_PRIORITY = 5; // Background priority
 //! Constant queue size increased to 2Mb for high frequency event data
 static const int MAX_QUEUE_SIZE = 2000000;
 
+//! Constant maximum number of events in the queue
+static const unsigned int MAX_QUEUE_EVENTS = 16384;
+
 //! Constant key for 'DAM.IgnitewhiteListedEvents' string
 static const std::string KEY_IGNITE_WHITE_LIST_EVENTS = 
                                                   "DAM.IgnitewhiteListedEvents";
@@ -142,7 +146,10 @@ unsigned long long g_ulCurrPulled = 0;
 unsigned long long g_ulDiscardedEvent= 0;
 #endif
 
-CCacheTransport::CCacheTransport():m_bIsEventWhitelistingEnabled(false)
+CCacheTransport::CCacheTransport():
+    m_eventQueue(MAX_QUEUE_EVENTS, MAX_QUEUE_SIZE,
+                 ic_utils::eOVERFLOW_DROP_NEWEST),
+    m_bIsEventWhitelistingEnabled(false)
 {
     m_bHasStarted = false;
 
@@ -263,18 +270,19 @@ bool CCacheTransport::Send(const std::string& rstrSerialized)
     if (m_bIsShutdownInitiated)
     {
         //print complete event log when shutdown initiated
-        HCPLOG_W << "Ignoring due to shutdown:"<< rstrSerialized;
+        HCPLOG_W << "Ignoring due to shutdown:"
+                 << ic_event::CEventCodec::ToJsonString(rstrSerialized);
         return false;
     }
     if ( (m_pStreamLog != NULL) && m_pStreamLog->is_open() )
     {
-        *m_pStreamLog << rstrSerialized << std::endl;
+        *m_pStreamLog << ic_event::CEventCodec::ToJsonString(rstrSerialized)
+                      << std::endl;
     }
 
     bool ret = true;
-    if (m_eventQueue.Size() < MAX_QUEUE_SIZE)
+    if (m_eventQueue.Put(rstrSerialized, rstrSerialized.size()))
     {
-        m_eventQueue.Put(rstrSerialized, rstrSerialized.size());
         if (0 == g_ulInCnt) 
         {
             g_ulInCntIter++;
@@ -298,7 +306,8 @@ bool CCacheTransport::Send(const std::string& rstrSerialized)
 
     if (!ret)
     {
-        HCPLOG_E << "Q overflow-discarding " << rstrSerialized;
+        HCPLOG_E << "Q overflow-discarding " 
+                 << ic_event::CEventCodec::ToJsonString(rstrSerialized);
         g_ulTotOECnt++;
         if ((1 == g_ulTotOECnt) || (0 == g_ulTotOECnt%10)) 
         {
@@ -331,9 +340,11 @@ void CCacheTransport::FlushCache()
     std::string strEvent;
     while(m_eventQueue.Take(&strEvent))
     {
-        ic_core::CEventWrapper* pEvent = new ic_core::CEventWrapper();
-        pEvent->JsonToEvent(strEvent);
-        m_pEventTSValidationHandler->HandleEvent(pEvent);
+        ic_core::CEventWrapper* pEvent = CreateEvent(strEvent);
+        if (NULL != pEvent)
+        {
+            m_pEventTSValidationHandler->HandleEvent(pEvent);
+        }
     }
     if(m_pMsgController) 
     {
@@ -374,8 +385,11 @@ void CCacheTransport::Run()
             }
             g_ulOutCnt++;
             // handle the event
-            ic_core::CEventWrapper* pEvent = new ic_core::CEventWrapper();
-            pEvent->JsonToEvent(strEvent);
+            ic_core::CEventWrapper* pEvent = CreateEvent(strEvent);
+            if (NULL == pEvent)
+            {
+                continue;
+            }
 
             //reset log counter for inflow events when IgnStatus is off
             if (IsLogCounterResetNeeded(pEvent))
@@ -413,6 +427,26 @@ void CCacheTransport::Run()
     Detach();
 }
 
+ic_core::CEventWrapper *CCacheTransport::CreateEvent(const std::string &rstrEvent)
+{
+    ic_core::CEventWrapper* pEvent = new ic_core::CEventWrapper();
+    if (ic_event::CEventCodec::IsEncoded(rstrEvent))
+    {
+        if (!pEvent->BinaryToEvent(rstrEvent))
+        {
+            HCPLOG_E << "Dropping binary event failing to decode, size="
+                     << rstrEvent.size();
+            delete pEvent;
+            pEvent = NULL;
+        }
+    }
+    else
+    {
+        pEvent->JsonToEvent(rstrEvent);
+    }
+    return pEvent;
+}
+
 bool CCacheTransport::IsLogCounterResetNeeded(ic_core::CEventWrapper *pEvent)
 {
     if((pEvent->GetEventId() == KEY_IGNITIONSTATUS) 
@@ -482,10 +516,11 @@ void CCacheTransport::ProcessEvent(ic_core::CEventWrapper *pEvent,
         {
             //logging first and all 100th events - for later tracking purposes
             HCPLOG_I << "non-ignite event cnt: " << g_ulNieCntIter << ":" 
-                     << g_ulNieCnt << "-" << rstrEventStr;
+                     << g_ulNieCnt << "-"
+                     << ic_event::CEventCodec::ToLogString(rstrEventStr);
         }
         HCPLOG_D <<"N-IgnEvnt cnt:" << g_ulNieCntIter << ":" << g_ulNieCnt 
-                 << "-" << rstrEventStr;
+                 << "-" << ic_event::CEventCodec::ToLogString(rstrEventStr);
         //print event id and timestamp for non ignite event
         HCPLOG_I << eventId << " TS: " << timestamp;
         #endif
@@ -534,10 +569,20 @@ void CCacheTransport::NotifyShutdown()
 }
 
 bool CCacheTransport::LogCriticalEvent(const std::string& eID,
-                                       const std::string& ePayload)
+                                       const std::string& rstrEvent)
 {
     bool bCriticalLogging = true;
 
+    // Binary payloads are logged by event id and size, not decoded again
+    std::string strBinaryPayload;
+    if (ic_event::CEventCodec::IsEncoded(rstrEvent))
+    {
+        strBinaryPayload = eID + " " +
+                           ic_event::CEventCodec::ToLogString(rstrEvent);
+    }
+    const std::string &ePayload = strBinaryPayload.empty() ? rstrEvent :
+                                  strBinaryPayload;
+
     //if alert, log w/o restriction
     if(m_setAlertsList.find(eID) != m_setAlertsList.end())
     {
@@ -935,7 +980,7 @@ int CCacheTransport::PopulateEventsFromDomainMap(const ic_utils::Json::Value&
         }
         else 
         {
-            HCPLOG_E "Invalid Config";
+            HCPLOG_E << "Invalid Config";
         }
     }
     return rSetDomainEventsList.size();
@@ -36,7 +36,7 @@
 #include <map>
 #include <algorithm>
 #include "CIgniteMutex.h"
-#include "CConcurrentQueue.h"
+#include "CBoundedQueue.h"
 #include "CIgniteConfig.h"
 #include "CIgniteThread.h"
 #include "IOnOffNotificationReceiver.h"
@@ -135,7 +135,8 @@ private:
      * Method is used to log the payload of inflow events as CRITICAL as per
      * the count configured in config file
      * @param[in] rstrEID event-id use to check count in config
-     * @param[in] rstrEPayload event payload in string use to log
+     * @param[in] rstrEPayload event payload in string use to log, binary
+     * payloads are logged by their size
      * @return true if event is logged as CRITICAL otherwise false
      * (logged in DEBUG level for debug purposes)
      */
@@ -226,6 +227,15 @@ private:
      */
     void ProcessEvent(ic_core::CEventWrapper *pEvent, 
                       const std::string &rstrEventStr);
+
+    /**
+     * Method to create event from the queued payload; binary encoded payloads
+     * are decoded directly into the event
+     * @param[in] rstrEvent queued event payload
+     * @return created event, to be deleted by the handlers; NULL if a binary
+     *         payload fails to decode and the event is dropped
+     */
+    ic_core::CEventWrapper *CreateEvent(const std::string &rstrEvent);
     
     /**
      * Method to print log counter value
@@ -303,7 +313,7 @@ private:
     bool m_bHasStarted;
 
     //! Member variable to store received events in queue
-    ic_utils::CConcurrentQueue<std::string> m_eventQueue;
+    ic_utils::CBoundedQueue<std::string> m_eventQueue;
 
     //! Member variable holding mutex
     ic_utils::CIgniteMutex m_handleQueueMutex;
@@ -23,11 +23,10 @@
 #include "CIgniteLog.h"
 #include "CIgniteDateTime.h"
 #include "CIgniteEvent.h"
+#include "CCrc32.h"
 #include "CIgniteStringUtils.h"
 #include "CIgniteConfig.h"
 #include "crypto/CIgniteDataSecurity.h"
-#include "core/CKeyGenerator.h"
-#include "core/CAesSeed.h"
 #include "CIgniteFileUtils.h"
 #include "upload/CUploadController.h"
 #include "auth/CTokenManager.h"
@@ -80,6 +79,26 @@ static const std::string KEY_MAX_INSERT_IN_ONE_TRANSACTION = "DAM.Database.maxIn
 //! Constant key for '50' int value
 static const uint16_t DEF_MAX_INSERT_IN_ONE_TRANSACTION = 50;
 
+//! Constant key for 'DAM.Database.cryptoWorkers' string
+static const std::string KEY_CRYPTO_WORKERS = "DAM.Database.cryptoWorkers";
+
+//! Constant key for '1' int value, events are encrypted on the DB thread only
+static const unsigned int DEF_CRYPTO_WORKERS = 1;
+
+//! Constant key for 'DAM.Database.eventQueueCapacity' string
+static const std::string KEY_EVENT_QUEUE_CAPACITY = "DAM.Database.eventQueueCapacity";
+
+//! Constant default maximum number of events in the queue; the queue is
+//! otherwise bounded by its size in bytes like before
+static const unsigned int DEF_EVENT_QUEUE_CAPACITY = 16384;
+
+//! Constant key for 'DAM.Database.eventQueuePutTimeoutMs' string
+static const std::string KEY_EVENT_QUEUE_PUT_TIMEOUT = "DAM.Database.eventQueuePutTimeoutMs";
+
+//! Constant default wait in milliseconds for space in a full queue; 0 never
+//! blocks the producer, an event not fitting is dropped
+static const unsigned int DEF_EVENT_QUEUE_PUT_TIMEOUT = 0;
+
 //! Constant key for 'attachmentFailureReason' string
 static const std::string KEY_ATTACHMENT_FAILURE_REASON = "attachmentFailureReason";
 
@@ -116,9 +135,53 @@ unsigned long int g_ulnPECntIter=0;
 
 static std::string encrypt_event_data(const std::string& rstrEventData)
 {
-    ic_core::CIgniteDataSecurity securityObject(ic_core::CKeyGenerator::GetActivationKey(),
-                       ic_core::CAesSeed::GetInstance()->GetIvRandom());
-    return securityObject.Encrypt(rstrEventData);
+    return ic_core::CIgniteDataSecurity::EncryptEvent(rstrEventData);
+}
+
+/**
+ * Global method to encrypt the event payload of a row in place; the payload is
+ * put in plain text while the row is prepared. The CRC32 of the plain payload
+ * is stored along, letting the uploader validate the decrypted payload
+ * without parsing it.
+ * @param[in/out] rData row to insert
+ * @return void
+ */
+static void encrypt_row_events(ic_core::CContentValues &rData)
+{
+    const std::string strEvent =
+                      rData.GetAsString(ic_core::CDataBaseConst::COL_EVENTS);
+    rData.Put(ic_core::CDataBaseConst::COL_CHECKSUM,
+              (long long)ic_event::CCrc32::Calculate(strEvent));
+    rData.PutBlob(ic_core::CDataBaseConst::COL_EVENTS,
+                  encrypt_event_data(strEvent));
+}
+
+/**
+ * Global method to encrypt the event payloads of rows in place as one group,
+ * see encrypt_row_events
+ * @param[in/out] rvecRows rows to insert
+ * @param[in] unWorkers maximum number of threads encrypting the group
+ * @return void
+ */
+static void encrypt_rows_events(std::vector<ic_core::CContentValues> &rvecRows,
+                                unsigned int unWorkers)
+{
+    std::vector<std::string> vecEvents;
+    vecEvents.reserve(rvecRows.size());
+    for (auto &rRow : rvecRows)
+    {
+        vecEvents.push_back(rRow.GetAsString(ic_core::CDataBaseConst::COL_EVENTS));
+        rRow.Put(ic_core::CDataBaseConst::COL_CHECKSUM,
+                 (long long)ic_event::CCrc32::Calculate(vecEvents.back()));
+    }
+
+    ic_core::CIgniteDataSecurity::EncryptEvents(vecEvents, unWorkers);
+
+    for (size_t nIdx = 0; nIdx < rvecRows.size(); nIdx++)
+    {
+        rvecRows[nIdx].PutBlob(ic_core::CDataBaseConst::COL_EVENTS,
+                               vecEvents[nIdx]);
+    }
 }
 
 /**
@@ -129,42 +192,72 @@ static std::string encrypt_event_data(const std::string& rstrEventData)
  */
 static std::string decrypt_event_data(const std::string& rstrEvent)
 {
-    ic_core::CIgniteDataSecurity securityObject(ic_core::CKeyGenerator::GetActivationKey(),
-                       ic_core::CAesSeed::GetInstance()->GetIvRandom());
-    return securityObject.Decrypt(rstrEvent);
+    return ic_core::CIgniteDataSecurity::DecryptEvent(rstrEvent);
+}
+
+/**
+ * Global method to read the maximum number of events in the event queue
+ * @param void
+ * @return configured capacity, the default one if not configured
+ */
+static unsigned int get_event_queue_capacity()
+{
+    int nCapacity = ic_core::CIgniteConfig::GetInstance()->GetInt(KEY_EVENT_QUEUE_CAPACITY,
+                                                                 DEF_EVENT_QUEUE_CAPACITY);
+    return (nCapacity > 0) ? (unsigned int)nCapacity : DEF_EVENT_QUEUE_CAPACITY;
+}
+
+/**
+ * Global method to read the wait for space in a full event queue; a producer
+ * is only blocked if a wait is configured
+ * @param void
+ * @return configured wait in milliseconds, 0 if not configured
+ */
+static unsigned int get_event_queue_put_timeout()
+{
+    int nTimeoutMs = ic_core::CIgniteConfig::GetInstance()->GetInt(KEY_EVENT_QUEUE_PUT_TIMEOUT,
+                                                                  DEF_EVENT_QUEUE_PUT_TIMEOUT);
+    return (nTimeoutMs > 0) ? (unsigned int)nTimeoutMs : 0;
 }
 
 }
 
 void CDBTransport::InsertEvent(const std::string& rstrSerialized)
+{
+    InsertEvent(*ic_core::CSharedEvent::Create(rstrSerialized));
+}
+
+void CDBTransport::InsertEvent(const ic_core::CSharedEvent& rEvent,
+                               std::vector<ic_core::CContentValues> *pvecEventRows)
 {
     HCPLOG_METHOD();
-    ic_core::CEventWrapper event;
-    event.JsonToEvent(rstrSerialized);
-    ic_utils::Json::Value jsonEvData = event.GetData();
-    std::string strEventId = event.GetEventId();
+    const ic_utils::Json::Value &jsonEvData = rEvent.GetData();
+    const std::string &strEventId = rEvent.GetEventId();
+    const std::string &rstrSerialized = rEvent.GetSerialized();
     ic_core::CUploadMode *pMode = ic_core::CUploadMode::GetInstance();
     if( strEventId == "IgniteClientLaunched")
     {
         SendIgniteStartMessage();
     }
 
-    long long llTimeStamp = event.GetTimestamp();
-    long long llTimeZone = event.GetTimezone() * 60 * 1000; // time zone in ms
+    long long llTimeStamp = rEvent.GetTimestamp();
+    long long llTimeZone = rEvent.GetTimezone() * 60 * 1000; // time zone in ms
     long lInsertStatus = -1;
     ic_core::CContentValues data;
     data.Put(ic_core::CDataBaseConst::COL_EVENT_ID, strEventId);
     data.Put(ic_core::CDataBaseConst::COL_TIMESTAMP, llTimeStamp);
     data.Put(ic_core::CDataBaseConst::COL_TIMEZONE, llTimeZone);
     data.Put(ic_core::CDataBaseConst::COL_SIZE, (long long)rstrSerialized.size());
-    data.Put(ic_core::CDataBaseConst::COL_HAS_ATTACH, event.GetAttachments().empty() ? 0 : 1);
-    data.Put(ic_core::CDataBaseConst::COL_EVENTS, encrypt_event_data(rstrSerialized));
+    data.Put(ic_core::CDataBaseConst::COL_HAS_ATTACH, rEvent.GetAttachments().empty() ? 0 : 1);
+    //encrypted just before insertion, in one group for bulk inserted rows
+    data.Put(ic_core::CDataBaseConst::COL_EVENTS, rstrSerialized);
 
     bool bSupportedEvent(false);
 
     if(pMode->IsStreamModeSupported()){
         if (CMessageController::IsAlert(strEventId))
         {
+            encrypt_row_events(data);
             lInsertStatus = ic_core::CDataBaseFacade::GetInstance()->Insert(ic_core::CDataBaseConst::TABLE_ALERT_STORE, &data);
             if(-1 == lInsertStatus)
             {
@@ -177,7 +270,7 @@ void CDBTransport::InsertEvent(const std::string& rstrSerialized)
 
     if (pMode->IsEventSupportedForStream(strEventId)) 
     {
-        ProcessEventForStreamMode(event, pMode->IsBatchModeSupported(), data);
+        ProcessEventForStreamMode(rEvent, pMode->IsBatchModeSupported(), data);
         bSupportedEvent = true;
 
     }//if(pMode->IsEventSupportedForStream(strEventId))
@@ -190,11 +283,15 @@ void CDBTransport::InsertEvent(const std::string& rstrSerialized)
 
     if (jsonEvData.isMember("topic")) 
     {
-        GetTopicedEventData(pMode, event, data);
+        GetTopicedEventData(pMode, rEvent, data);
         bSupportedEvent = true;
     }
 
-    if(bSupportedEvent) {
+    if(bSupportedEvent && (NULL != pvecEventRows)) {
+        pvecEventRows->push_back(data);
+    }
+    else if(bSupportedEvent) {
+        encrypt_row_events(data);
         lInsertStatus = ic_core::CDataBaseFacade::GetInstance()->Insert(ic_core::CDataBaseConst::TABLE_EVENT_STORE, &data);
         if (-1 == lInsertStatus) {
             HCPLOG_E << "Insert failed " << strEventId << " , " << llTimeStamp;
@@ -212,11 +309,11 @@ void CDBTransport::SendIgniteStartMessage()
     }
 }
 
-void CDBTransport::ProcessEventForStreamMode(ic_core::CEventWrapper &rEvent,
+void CDBTransport::ProcessEventForStreamMode(const ic_core::CSharedEvent &rEvent,
                                             const bool &rbBatchModeSupported,
                                             ic_core::CContentValues &rData)
 {
-    std::string strEventId = rEvent.GetEventId();
+    const std::string &strEventId = rEvent.GetEventId();
 
     /* If event has attachment, it should be uploaded via Batch Upload, 
      * provided batch mode is supported
@@ -240,18 +337,18 @@ void CDBTransport::ProcessEventForStreamMode(ic_core::CEventWrapper &rEvent,
         if (!rEvent.GetAttachments().empty()) 
         {
             /* Event has attachment but batch mode is not supported, 
-             * updating event
+             * updating a copy of the event as the shared one is immutable
              */
-            rEvent.AddField(KEY_ATTACHMENT_FAILURE_REASON, 
-                            BATCH_MODE_UNSUPPORTED);
+            ic_core::CEventWrapper event = rEvent.GetEventCopy();
+            event.AddField(KEY_ATTACHMENT_FAILURE_REASON, 
+                           BATCH_MODE_UNSUPPORTED);
 
             std::string strSerializedEvnt;
-            rEvent.EventToJson(strSerializedEvnt);
+            event.EventToJson(strSerializedEvnt);
 
             rData.Put(ic_core::CDataBaseConst::COL_SIZE, 
                      (long long)strSerializedEvnt.size());
-            rData.Put(ic_core::CDataBaseConst::COL_EVENTS, 
-                      encrypt_event_data(strSerializedEvnt));
+            rData.Put(ic_core::CDataBaseConst::COL_EVENTS, strSerializedEvnt);
 
             //Deleting attachment from IC's attachment space
             std::string strAttachmentPath = ic_core::CIgniteConfig::GetInstance()
@@ -270,10 +367,10 @@ void CDBTransport::ProcessEventForStreamMode(ic_core::CEventWrapper &rEvent,
 }
 
 void CDBTransport::GetTopicedEventData(const ic_core::CUploadMode *pMode, 
-                                      ic_core::CEventWrapper &rEvent,
+                                      const ic_core::CSharedEvent &rEvent,
                                       ic_core::CContentValues &rData)
 {
-    ic_utils::Json::Value jsonEvntData = rEvent.GetData();
+    const ic_utils::Json::Value &jsonEvntData = rEvent.GetData();
     rData.Put(ic_core::CDataBaseConst::COL_TOPIC, jsonEvntData["topic"].asString());
 
     /* topiced events will go through stream mode by default
@@ -294,7 +391,10 @@ void CDBTransport::GetTopicedEventData(const ic_core::CUploadMode *pMode,
     }
 }
 
-CDBTransport::CDBTransport(CTransportHandlerBase* handler) : CTransportHandlerBase(handler)
+CDBTransport::CDBTransport(CTransportHandlerBase* handler) : CTransportHandlerBase(handler),
+    m_queEvent(get_event_queue_capacity(), 0,
+               (get_event_queue_put_timeout() > 0) ? ic_utils::eOVERFLOW_BLOCK : ic_utils::eOVERFLOW_DROP_NEWEST,
+               get_event_queue_put_timeout())
 {
     m_nDbEventStoreRecordAvgSize = ic_core::CIgniteConfig::GetInstance()->GetInt(KEY_DB_EVENTSTORE_SIZE, DEF_EVENTSTORE_SIZE);
     if (DEF_EVENTSTORE_SIZE > m_nDbEventStoreRecordAvgSize || MAX_EVENTSTORE_SIZE < m_nDbEventStoreRecordAvgSize)
@@ -302,6 +402,7 @@ CDBTransport::CDBTransport(CTransportHandlerBase* handler) : CTransportHandlerBa
         m_nDbEventStoreRecordAvgSize = DEF_EVENTSTORE_SIZE;
     } 
     m_nMaxEventInsertInOneTxn = ic_core::CIgniteConfig::GetInstance()->GetInt(KEY_MAX_INSERT_IN_ONE_TRANSACTION, DEF_MAX_INSERT_IN_ONE_TRANSACTION);
+    m_unCryptoWorkers = ic_core::CIgniteConfig::GetInstance()->GetInt(KEY_CRYPTO_WORKERS, DEF_CRYPTO_WORKERS);
     std::string strDbLogPath = ic_core::CIgniteConfig::GetInstance()->GetString("DAM.Log.dbStream");
     if (!strDbLogPath.empty())
     {
@@ -385,6 +486,9 @@ void CDBTransport::Run()
         pthread_mutex_unlock(&sEventCacheMutex);
         if (unQueSize == 0)
         {
+            // Idle, release a bounded part of the space freed by purges
+            ic_core::CDataBaseFacade::GetInstance()->ReclaimFreePages();
+
             HCPLOG_D << "Q empty. Sleeping 1s";
             sleep(1); // back off if there is not enough events in the cache and release the lock
         }
@@ -421,21 +525,27 @@ void CDBTransport::Run()
 
 void CDBTransport::ProcessQueueData(const unsigned int &runQueSize)
 {
-    std::string strEvntData;
+    ic_core::CSharedEventPtr pEvent;
     uint16_t unMaxLimit = GetMaxEventToInsertInOneTxn(runQueSize);
     uint16_t unInsertCntr = 1;
+
+    //event store rows are collected and inserted in bulk at the end
+    std::vector<ic_core::CContentValues> vecEventRows;
+    vecEventRows.reserve(unMaxLimit);
     while(unInsertCntr <= unMaxLimit)
     {
         //insertion of events is based on maxLimit value returned from getMaxEventToInsertInOneTxn
         //max events to be inserted in one txn are based on the value configured as maxInsertEventInOneTxn
-        if (!m_queEvent.Take(&strEvntData)) 
+        if (!m_queEvent.Take(&pEvent)) 
         {
             break;
         }
 
-        if(0 < strEvntData.size())
+        size_t nEvntDataSize = 0;
+        if(pEvent)
         {
-            ProcessMessage(strEvntData);
+            nEvntDataSize = pEvent->GetSerialized().size();
+            ProcessMessage(pEvent, &vecEventRows);
         }
         //increment insert count
         ++unInsertCntr;
@@ -458,7 +568,7 @@ void CDBTransport::ProcessQueueData(const unsigned int &runQueSize)
          * size of m_ulEventSizeInQueue
          */
         m_ulEventSizeInQueue = runQueSize;
-        m_ulEventSizeInQueue = m_ulEventSizeInQueue - strEvntData.size();
+        m_ulEventSizeInQueue = m_ulEventSizeInQueue - nEvntDataSize;
 
         /* if current threshold size is not max and eventqueue size went down 
          * below 90% of limit (max-window), set the threshold level as maximum
@@ -469,17 +579,36 @@ void CDBTransport::ProcessQueueData(const unsigned int &runQueSize)
             m_ulEventInsertThresholdSize = m_ulEventQueueMaxSize;
         }
     }//end of while(unInsertCntr <= unMaxLimit)
+
+    if (!vecEventRows.empty())
+    {
+        encrypt_rows_events(vecEventRows, m_unCryptoWorkers);
+
+        int nInserted = ic_core::CDataBaseFacade::GetInstance()->BulkInsert(
+                          ic_core::CDataBaseConst::TABLE_EVENT_STORE, vecEventRows);
+        if (nInserted != (int)vecEventRows.size())
+        {
+            HCPLOG_E << "Insert failed for " << (vecEventRows.size() - nInserted)
+                     << " of " << vecEventRows.size() << " events";
+        }
+    }
 }
 
 void CDBTransport::ProcessMessage(const string& rstrSerialized)
+{
+    ProcessMessage(ic_core::CSharedEvent::Create(rstrSerialized));
+}
+
+void CDBTransport::ProcessMessage(const ic_core::CSharedEventPtr& rpEvent,
+                                  std::vector<ic_core::CContentValues> *pvecEventRows)
 {
     HCPLOG_METHOD();
 
     if ( (m_pStreamLog != NULL) && m_pStreamLog->is_open() )
     {
-        *m_pStreamLog << rstrSerialized << endl;
+        *m_pStreamLog << rpEvent->GetSerialized() << endl;
     }
-    InsertEvent(rstrSerialized);
+    InsertEvent(*rpEvent, pvecEventRows);
 }
 
 void CDBTransport::PurgeDB(const size_t dbSize)
@@ -525,11 +654,14 @@ void CDBTransport::PurgeDB(const size_t dbSize)
 
 void CDBTransport::HandleEvent(ic_core::CEventWrapper* pEvent)
 {
-    std::string strEventId = pEvent->GetEventId();
-    double dblEventTs = pEvent->GetTimestamp();
-    std::string strSerializedEvnt;
-    pEvent->EventToJson(strSerializedEvnt);
-    delete pEvent;
+    HandleSharedEvent(ic_core::CSharedEvent::Create(pEvent));
+}
+
+void CDBTransport::HandleSharedEvent(const ic_core::CSharedEventPtr& rpEvent)
+{
+    const std::string &strEventId = rpEvent->GetEventId();
+    double dblEventTs = rpEvent->GetTimestamp();
+    const std::string &strSerializedEvnt = rpEvent->GetSerialized();
 
     // Before going ahead for anything, first check if the interval Validation required
     if(!CEventIntervalValidator::GetInstance()->IsValidInterval(strEventId, dblEventTs))
@@ -570,15 +702,23 @@ void CDBTransport::HandleEvent(ic_core::CEventWrapper* pEvent)
             std::string strIgnoredEvnt;
             ignoredEvnts.EventToJson(strIgnoredEvnt);
 
-            m_queEvent.Put(strIgnoredEvnt, strIgnoredEvnt.size());
+            m_queEvent.Put(ic_core::CSharedEvent::Create(strIgnoredEvnt),
+                           strIgnoredEvnt.size());
             HCPLOG_W << ">>IgnoredEvent details pushed into the queue " << strIgnoredEvnt;
 
             //let us reset the counters
             InitIgnoredEvents();
         }
 
-        m_queEvent.Put(strSerializedEvnt, strSerializedEvnt.size());
-        HCPLOG_T << strEventId << ">>event is successfully pushed into the queue!";
+        if (m_queEvent.Put(rpEvent, strSerializedEvnt.size()))
+        {
+            HCPLOG_T << strEventId << ">>event is successfully pushed into the queue!";
+        }
+        else
+        {
+            HCPLOG_E << ">>Dropping the event:" << strEventId << "~ EventQueue is full~ dropped:"
+                     << m_queEvent.GetStats().ullDroppedCount;
+        }
 
         PrintEvntQueueLogs();
     }
@@ -619,10 +759,8 @@ void CDBTransport::PrintEvntQueueLogs()
 
 void CDBTransport::HandleNonIgniteEvent(ic_core::CEventWrapper* pEvent)
 {
-    std::string strSerializedEvnt;
-    pEvent->EventToJson(strSerializedEvnt);
-    delete pEvent;
-    m_queEvent.Put(strSerializedEvnt, strSerializedEvnt.size());
+    ic_core::CSharedEventPtr pSharedEvent = ic_core::CSharedEvent::Create(pEvent);
+    m_queEvent.Put(pSharedEvent, pSharedEvent->GetSerialized().size());
 }
 
 void CDBTransport::FlushCache()
@@ -630,14 +768,14 @@ void CDBTransport::FlushCache()
     // Execute multiple insertions as single transaction for optimized performance
     ic_core::CDataBaseFacade* pDb = ic_core::CDataBaseFacade::GetInstance();
     bool bTransactionStarted = pDb->StartTransaction();
-    std::string ret;
-    while(m_queEvent.Take(&ret))
+    ic_core::CSharedEventPtr pEvent;
+    while(m_queEvent.Take(&pEvent))
     {
-        if(ret.size() > 0)
+        if(pEvent)
         {
-            ProcessMessage(ret);
+            ProcessMessage(pEvent);
+            HCPLOG_W << "flushing cache: " << pEvent->GetSerialized();
         }
-        HCPLOG_W << "flushing cache: " << ret;
     }
     if (bTransactionStarted)
     {
@@ -31,9 +31,11 @@
 #include <iostream>
 #include <fstream>
 #include <set>
+#include <vector>
 #include "dam/CTransportHandlerBase.h"
+#include "db/CContentValues.h"
 #include "CIgniteThread.h"
-#include "CConcurrentQueue.h"
+#include "CBoundedQueue.h"
 #include "db/CGranularityReductionHandler.h"
 #include "IOnOffNotificationReceiver.h"
 
@@ -78,6 +80,13 @@ public:
      */
     virtual void HandleEvent(ic_core::CEventWrapper* pEvent);
 
+    /**
+     * Method to handle shared event to store in database
+     * @param[in] rpEvent Shared event data
+     * @return void
+     */
+    virtual void HandleSharedEvent(const ic_core::CSharedEventPtr& rpEvent);
+
     /**
      * Method to insert event into database
      * @param[in] rstrSerialized Serialized event string to be inserted in db
@@ -85,6 +94,16 @@ public:
      */
     static void InsertEvent(const std::string& rstrSerialized);
 
+    /**
+     * Method to insert already parsed event into database
+     * @param[in] rEvent Shared event to be inserted in db
+     * @param[out] pvecEventRows if not NULL, the event store row is appended
+     *  to it for a later bulk insert instead of being inserted
+     * @return void
+     */
+    static void InsertEvent(const ic_core::CSharedEvent& rEvent,
+                            std::vector<ic_core::CContentValues> *pvecEventRows = NULL);
+
     /**
      * Overriding Method of IOnOffNotificationReceiver class
      * @see IOnOffNotificationReceiver::NotifyShutdown()
@@ -133,6 +152,16 @@ private:
      */
     void ProcessMessage(const std::string& rstrEvntPayload);
 
+    /**
+     * Method to process the given shared event by persisting it in the database.
+     * @param[in] rpEvent Shared event data
+     * @param[out] pvecEventRows if not NULL, the event store row is appended
+     *  to it for a later bulk insert instead of being inserted
+     * @return void
+     */
+    void ProcessMessage(const ic_core::CSharedEventPtr& rpEvent,
+                        std::vector<ic_core::CContentValues> *pvecEventRows = NULL);
+
     /**
      * Method to initialize ignored events count
      * @param void
@@ -182,7 +211,7 @@ private:
      * @param[out] rData data content object
      * @return void
      */
-    static void ProcessEventForStreamMode(ic_core::CEventWrapper &rEvent,
+    static void ProcessEventForStreamMode(const ic_core::CSharedEvent &rEvent,
                                           const bool &rbBatchModeSupported,
                                           ic_core::CContentValues &rData);
 
@@ -194,7 +223,7 @@ private:
      * @return void
      */
     static void GetTopicedEventData(const ic_core::CUploadMode *pMode,
-                                    ic_core::CEventWrapper &rEvent,
+                                    const ic_core::CSharedEvent &rEvent,
                                     ic_core::CContentValues &rData);
 
     /**
@@ -208,7 +237,7 @@ private:
     std::ofstream* m_pStreamLog;
 
     //! Member variable to hold queue of event
-    ic_utils::CConcurrentQueue<std::string> m_queEvent;
+    ic_utils::CBoundedQueue<ic_core::CSharedEventPtr> m_queEvent;
 
     //! Member variable to hold ignored event count
     int m_nIgnoredEventCnt;
@@ -251,6 +280,9 @@ private:
 
      //! Member variable to store configurable maximum limit for event to be inserted in one transaction*
     uint16_t m_nMaxEventInsertInOneTxn;
+
+    //! Member variable to store configurable maximum number of threads encrypting events of one transaction
+    unsigned int m_unCryptoWorkers;
 };
 } /* namespace ic_bl*/
 #endif /* CDB_TRANSPORT_H */
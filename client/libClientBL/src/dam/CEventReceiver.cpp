@@ -20,18 +20,58 @@
 #include "dam/CEventReceiver.h"
 #include "dam/CCacheTransport.h"
 #include "CIgniteMessage.h"
+#include "CEventCodec.h"
 #include "CMessageQueue.h"
 #include "CIgniteConfig.h"
 #include "CIgniteFileUtils.h"
 #include "CIgniteLog.h"
 
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "CEventReceiver"
+
 namespace ic_bl
 {
+namespace
+{
+/**
+ * Method to read the event payload of the given message as per its format
+ * @param[in] rMsg Received message
+ * @param[out] rstrPayload Event payload; JSON text or binary encoded event
+ * @return true if the payload format is supported else false
+ */
+bool GetEventPayload(const ic_event::CIgniteMessage& rMsg,
+                     std::string& rstrPayload)
+{
+    if (ic_event::ePAYLOAD_FORMAT_JSON == rMsg.GetPayloadFormat())
+    {
+        rstrPayload = rMsg.GetMessageAsString();
+        return true;
+    }
+
+    unsigned int unLen = 0;
+    const unsigned char* puchMsg = rMsg.GetMessage(unLen);
+    if ((ic_event::ePAYLOAD_FORMAT_BINARY_V1 == rMsg.GetPayloadFormat()) &&
+        (puchMsg != NULL))
+    {
+        rstrPayload.assign((const char*)puchMsg, unLen);
+        return ic_event::CEventCodec::IsEncoded(rstrPayload);
+    }
+
+    HCPLOG_E << "Unsupported event payload format: " 
+             << rMsg.GetPayloadFormat();
+    return false;
+}
+} /* namespace */
+
 CEventReceiver::CEventReceiver(ic_core::CMessageQueue* pPublisher, bool bReceiverSuspended)
+    : m_attachmentPath("DAM.Upload.CurlSender.fileAttachmentPath")
 {
     HCPLOG_METHOD();
     m_pPublisher = pPublisher;
     m_bReceiverSuspended = bReceiverSuspended;
+    ic_core::CIgniteConfig::GetInstance()->BindHandle(&m_attachmentPath);
     
     if (pPublisher)
     {
@@ -62,31 +102,40 @@ void CEventReceiver::ResumeReceiver()
 bool CEventReceiver::Handle(const ic_event::CIgniteMessage& rMsg)
 {
     bool bEvntProcessed = false;
-    static std::string strAttachmentPath = 
-                               ic_core::CIgniteConfig::GetInstance()->GetString(
-                               "DAM.Upload.CurlSender.fileAttachmentPath");
+    std::string strPayload;
+    if (!GetEventPayload(rMsg, strPayload))
+    {
+        return bEvntProcessed;
+    }
 
     HCPLOG_T << "CEventReceiver::send() received message: " 
-             << rMsg.GetMessageAsString();
+             << ic_event::CEventCodec::ToLogString(strPayload);
     if (!m_bReceiverSuspended)
     {
-        CCacheTransport::GetInstance()->Send(rMsg.GetMessageAsString());
+        CCacheTransport::GetInstance()->Send(strPayload);
         bEvntProcessed = true;
     }
     else
     {
         ic_core::CEventWrapper* pEvent = new ic_core::CEventWrapper();
-        pEvent->JsonToEvent(rMsg.GetMessageAsString());
+        if (ic_event::CEventCodec::IsEncoded(strPayload))
+        {
+            pEvent->BinaryToEvent(strPayload);
+        }
+        else
+        {
+            pEvent->JsonToEvent(strPayload);
+        }
 
         HCPLOG_T << "CEventReceiver not active: ignoring message: " 
-                 << rMsg.GetMessageAsString();
+                 << ic_event::CEventCodec::ToLogString(strPayload);
 
         //while ignoring, if the event has any attachments, delete them
         std::vector<std::string> vectorAttachments = pEvent->GetAttachments();
         for(unsigned int i = 0; i < vectorAttachments.size(); i++)
         {
             //remove the attachment files from the local drive.
-            std::string strFileToDelete = strAttachmentPath + "/" +
+            std::string strFileToDelete = m_attachmentPath.Get() + "/" +
                                           vectorAttachments[i];
             ic_utils::CIgniteFileUtils::Remove(strFileToDelete);
         }
@@ -30,6 +30,7 @@
 
 #include "CIgniteThread.h"
 #include "CMessageQueue.h"
+#include "CIgniteConfig.h"
 
 namespace ic_bl
 {
@@ -84,6 +85,9 @@ private:
     
     //! Member variable to hold receiver's suspended status
     bool m_bReceiverSuspended;
+
+    //! Member variable to hold config handle of attachment path
+    ic_core::CConfigHandle<std::string> m_attachmentPath;
 };
 }/* namespace ic_bl */
 #endif /* CEVENT_RECEIVER_H */
@@ -43,10 +43,16 @@ std::set<std::string> g_setAlerts;
 
 //! Constant key for 1MB int
 static const int MAX_QUEUE_SIZE = 1000000; // 1MB
+
+//! Constant maximum number of events in the queue
+static const unsigned int MAX_QUEUE_EVENTS = 8192;
 }
 
 CMessageController::CMessageController(CTransportHandlerBase* pNextHandler)
-    : CTransportHandlerBase(pNextHandler), m_bIsShutdownInitiated(false)
+    : CTransportHandlerBase(pNextHandler),
+      m_queMqttEvents(MAX_QUEUE_EVENTS, MAX_QUEUE_SIZE,
+                      ic_utils::eOVERFLOW_DROP_NEWEST),
+      m_bIsShutdownInitiated(false)
 {
     Init();
     Start();
@@ -118,11 +124,13 @@ void CMessageController::HandleEvent(ic_core::CEventWrapper* pEvent)
         CUploadController::GetInstance()->TriggerAlertsUpload(START_ALERT_UPLOAD);
     }
 
-    if (m_queMqttEvents.Size() < MAX_QUEUE_SIZE)
+    /* freeze the event here, so that the message handlers and the next
+     * handlers share the same serialized and parsed event
+     */
+    ic_core::CSharedEventPtr pSharedEvent = ic_core::CSharedEvent::Create(pEvent);
+
+    if (m_queMqttEvents.Put(pSharedEvent, pSharedEvent->GetSerialized().size()))
     {
-        std::string strSerialized;
-        pEvent->EventToJson(strSerialized);
-        m_queMqttEvents.Put(strSerialized, strSerialized.size());
         Notify(); //Process mqtt events
     }
     else
@@ -130,7 +138,7 @@ void CMessageController::HandleEvent(ic_core::CEventWrapper* pEvent)
         HCPLOG_E << "MQTT alerts queue full, no alerts will be raised for event :" << strEventId;
     }
 
-    m_pNextHandler->HandleEvent(pEvent);
+    m_pNextHandler->HandleSharedEvent(pSharedEvent);
 }
 
 void CMessageController::HandleNotification(const std::string& rstrdomain, const ic_utils::Json::Value& rjsonNotif)
@@ -155,16 +163,17 @@ void CMessageController::HandleNotification(const std::string& rstrdomain, const
     }
 }
 
-void CMessageController::ProcessEvent(const std::string& rstrEventId, const std::string& rstrSerEvent)
+void CMessageController::ProcessEvent(const ic_core::CSharedEventPtr& rpEvent)
 {
     //check if any handler is interested for this event
     for (std::vector<CMessageController::MessageHandler>::iterator iter = m_vecHndlrList.begin() ; iter != m_vecHndlrList.end(); ++iter)
     {
-        if (iter->pHandlerRef->IsHandlerSubscribedForEvent(rstrEventId))
+        if (iter->pHandlerRef->IsHandlerSubscribedForEvent(rpEvent->GetEventId()))
         {
             ic_core::IMessageHandler::MsgPayload payload;
             payload.eType = ic_core::IMessageHandler::eMSG_TYPE_EVENT;
-            payload.strPayloadJson = rstrSerEvent;
+            payload.strPayloadJson = rpEvent->GetSerialized();
+            payload.pEvent = rpEvent;
 
             iter->pHandlerRef->NotifyMessage(payload);
         }
@@ -176,13 +185,11 @@ void CMessageController::FlushCache()
     //Execute multiple insertions as single transaction for optimized performance
     ic_core::CDataBaseFacade* pDb = ic_core::CDataBaseFacade::GetInstance();
     bool bTransactionStarted = pDb->StartTransaction();
-    std::string strRet;
-    while(m_queMqttEvents.Take(&strRet) && strRet.size() > 0)
+    ic_core::CSharedEventPtr pEvent;
+    while(m_queMqttEvents.Take(&pEvent) && pEvent)
     {
-        ic_core::CEventWrapper event;
-        event.JsonToEvent(strRet);
-        ProcessEvent(event.GetEventId(), strRet);
-        HCPLOG_W << "flushing cache: " << strRet;
+        ProcessEvent(pEvent);
+        HCPLOG_W << "flushing cache: " << pEvent->GetSerialized();
     }
     if (bTransactionStarted)
     {
@@ -213,12 +220,10 @@ void CMessageController::Run()
                 break;
             }
         }
-        std::string strEventJson;
-        if (m_queMqttEvents.Take(&strEventJson) && strEventJson.size() > 0)
+        ic_core::CSharedEventPtr pEvent;
+        if (m_queMqttEvents.Take(&pEvent) && pEvent)
         {
-            ic_core::CEventWrapper event;
-            event.JsonToEvent(strEventJson);
-            ProcessEvent(event.GetEventId(), strEventJson);
+            ProcessEvent(pEvent);
         }
     }
 
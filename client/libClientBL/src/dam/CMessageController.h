@@ -34,7 +34,7 @@
 #include "CIgniteThread.h"
 #include "jsoncpp/json.h"
 #include "CTransportHandlerBase.h"
-#include "CConcurrentQueue.h"
+#include "CBoundedQueue.h"
 #include "analytics/CEventProcessor.h"
 
 #include "IMessageHandler.h"
@@ -138,11 +138,10 @@ private:
 
     /**
     * Method to process event by its respective handler
-    * @param[in] rstrEventID Event Id
-    * @param[in] rstrSerEvent Event payload json string
+    * @param[in] rpEvent Shared event data
     * @return void
     */
-    void ProcessEvent(const std::string& rstrEventID, const std::string& rstrSerEvent);
+    void ProcessEvent(const ic_core::CSharedEventPtr& rpEvent);
 
     /**
     * Method for mutex wait
@@ -177,8 +176,8 @@ private:
     //! Member variable for mqtt event wait condition
     ic_utils::CThreadCondition m_mqttEvWaitCondition;
     
-    //! Member variable to hold queue of string of mqtt event
-    ic_utils::CConcurrentQueue<std::string> m_queMqttEvents;
+    //! Member variable to hold queue of shared mqtt events
+    ic_utils::CBoundedQueue<ic_core::CSharedEventPtr> m_queMqttEvents;
 
     //! Member variable to track device shutdown status
     bool m_bIsShutdownInitiated;
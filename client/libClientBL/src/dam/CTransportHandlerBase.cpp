@@ -44,4 +44,17 @@ void CTransportHandlerBase::HandleEvent(ic_core::CEventWrapper* pEvent)
         HCPLOG_E << "m_pNextHandler is null";
     }
 }
+
+void CTransportHandlerBase::HandleSharedEvent(
+                                       const ic_core::CSharedEventPtr &rpEvent)
+{
+    if(NULL != m_pNextHandler)
+    {
+        m_pNextHandler->HandleSharedEvent(rpEvent);
+    }
+    else
+    {
+        HCPLOG_E << "m_pNextHandler is null";
+    }
+}
 } /* namespace ic_bl*/
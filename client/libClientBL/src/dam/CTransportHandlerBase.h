@@ -29,6 +29,7 @@
 
 #include <string>
 #include "dam/CEventWrapper.h"
+#include "dam/CSharedEvent.h"
 namespace ic_bl 
 {
 
@@ -53,6 +54,14 @@ public:
      */
     virtual void HandleEvent(ic_core::CEventWrapper* pEvent);
 
+    /**
+     * Method to handle an event which is already frozen into a shared
+     * snapshot by a previous handler, hence it is not to be modified anymore
+     * @param[in] rpEvent Shared event data
+     * @return void
+     */
+    virtual void HandleSharedEvent(const ic_core::CSharedEventPtr &rpEvent);
+
     /**
      * Destructor
      */
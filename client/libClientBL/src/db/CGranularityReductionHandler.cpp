@@ -169,15 +169,15 @@ std::set<std::string>
 
     HCPLOG_T << "sql=" << strSelection;
 
-    ic_core::CCursor *pCurObj = ic_core::CDataBaseFacade::GetInstance()->Query(
+    ic_core::CStreamCursor *pCurObj =
+                   ic_core::CDataBaseFacade::GetInstance()->QueryStream(
                                      ic_core::CDataBaseConst::TABLE_EVENT_STORE,
                                      vecProjection, strSelection);
 
     if (pCurObj)
     {
         HCPLOG_T << "retrieving items...";
-        for (bool bWorking = pCurObj->MoveToFirst(); bWorking;
-             bWorking = pCurObj->MoveToNext())
+        while (pCurObj->MoveToNext())
         {
             std::string strEId = pCurObj->GetString(pCurObj->GetColumnIndex(
                           "DISTINCT " + ic_core::CDataBaseConst::COL_EVENT_ID));
@@ -232,15 +232,15 @@ std::set<CGranularityReductionHandler::EventList>
     std::vector<std::string> vecOrderBy;
     vecOrderBy.push_back(ic_core::CDataBaseConst::COL_ID + " ASC");
 
-    ic_core::CCursor *pCurObj = ic_core::CDataBaseFacade::GetInstance()->Query(
+    ic_core::CStreamCursor *pCurObj =
+                   ic_core::CDataBaseFacade::GetInstance()->QueryStream(
                      ic_core::CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
                      strSelection, vecOrderBy, nLimit);
 
     if (pCurObj)
     {
         HCPLOG_T << "retrieving items...";
-        for (bool bWorking = pCurObj->MoveToFirst(); bWorking;
-             bWorking = pCurObj->MoveToNext())
+        while (pCurObj->MoveToNext())
         {
             EventList stEvnt;
             stEvnt.llEventId = pCurObj->GetLong(pCurObj->GetColumnIndex(
@@ -294,15 +294,15 @@ std::set<std::string>
 
     HCPLOG_T << "sql=" << strSelection;
 
-    ic_core::CCursor *pCurObj = ic_core::CDataBaseFacade::GetInstance()->Query(
+    ic_core::CStreamCursor *pCurObj =
+                   ic_core::CDataBaseFacade::GetInstance()->QueryStream(
                                      ic_core::CDataBaseConst::TABLE_EVENT_STORE,
                                      vecProjection, strSelection);
 
     if (pCurObj)
     {
         HCPLOG_T << "retrieving items...";
-        for (bool bWorking = pCurObj->MoveToFirst(); bWorking;
-             bWorking = pCurObj->MoveToNext())
+        while (pCurObj->MoveToNext())
         {
             std::string strEId = pCurObj->GetString(pCurObj->GetColumnIndex(
                           "DISTINCT " + ic_core::CDataBaseConst::COL_EVENT_ID));
@@ -360,15 +360,15 @@ std::set<CGranularityReductionHandler::EventList>
     std::vector<std::string> vecOrderBy;
     vecOrderBy.push_back(ic_core::CDataBaseConst::COL_ID + " ASC");
 
-    ic_core::CCursor *pCurObj = ic_core::CDataBaseFacade::GetInstance()->Query(
+    ic_core::CStreamCursor *pCurObj =
+                   ic_core::CDataBaseFacade::GetInstance()->QueryStream(
                      ic_core::CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
                      strSelection, vecOrderBy, nLimit);
 
     if (pCurObj)
     {
         HCPLOG_T << "retrieving items...";
-        for (bool bWorking = pCurObj->MoveToFirst(); bWorking;
-             bWorking = pCurObj->MoveToNext())
+        while (pCurObj->MoveToNext())
         {
             EventList stEvnt;
             stEvnt.llEventId = pCurObj->GetLong(pCurObj->GetColumnIndex(
@@ -425,15 +425,15 @@ std::set<CGranularityReductionHandler::EventList>
     std::vector<std::string> vecOrderBy;
     vecOrderBy.push_back(ic_core::CDataBaseConst::COL_ID + " ASC");
 
-    ic_core::CCursor *pCurObj = ic_core::CDataBaseFacade::GetInstance()->Query(
+    ic_core::CStreamCursor *pCurObj =
+                   ic_core::CDataBaseFacade::GetInstance()->QueryStream(
                      ic_core::CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
                      strSelection, vecOrderBy, nLimit);
 
     if (pCurObj)
     {
         HCPLOG_T << "retrieving items...";
-        for (bool bWorking = pCurObj->MoveToFirst(); bWorking;
-             bWorking = pCurObj->MoveToNext())
+        while (pCurObj->MoveToNext())
         {
             EventList stEvnt;
             stEvnt.llEventId = pCurObj->GetLong(pCurObj->GetColumnIndex(
@@ -1463,26 +1463,29 @@ void CGranularityReductionHandler::DefaultPolicyHandler()
     ic_core::CDataBaseFacade* pDB = ic_core::CDataBaseFacade::GetInstance();
     size_t unDBSize = pDB->GetSize();
 
+    // Only the time range of the oldest rows is needed, let sqlite compute it
+    std::string strOldestRows = "(SELECT " +
+              ic_core::CDataBaseConst::COL_TIMESTAMP + " FROM " +
+              ic_core::CDataBaseConst::TABLE_EVENT_STORE + " WHERE " +
+              ic_core::CDataBaseConst::COL_TIMESTAMP + " IS NOT NULL ORDER BY " +
+              ic_core::CDataBaseConst::COL_TIMESTAMP + " ASC LIMIT " +
+              ic_utils::CIgniteStringUtils::NumberToString(nRowCount) + ")";
     std::vector<std::string> vecProjection;
-    vecProjection.push_back(ic_core::CDataBaseConst::COL_TIMESTAMP);
-    std::vector<std::string> vecOrderBy;
-    vecOrderBy.push_back(ic_core::CDataBaseConst::COL_TIMESTAMP + " ASC");
-    ic_core::CCursor *pCurObj = pDB->Query(
-                      ic_core::CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
-                      ic_core::CDataBaseConst::COL_TIMESTAMP + " IS NOT NULL",
-                      vecOrderBy, nRowCount);
+    vecProjection.push_back("MIN(" + ic_core::CDataBaseConst::COL_TIMESTAMP +
+                            ")");
+    vecProjection.push_back("MAX(" + ic_core::CDataBaseConst::COL_TIMESTAMP +
+                            ")");
+    ic_core::CStreamCursor *pCurObj = pDB->QueryStream(strOldestRows,
+                                                       vecProjection);
 
     long long llStartTime = 0;
     long long llEndTime = 0;
     if (pCurObj)
     {
-        if (pCurObj->MoveToFirst())
+        if (pCurObj->MoveToNext())
         {
-            llStartTime = pCurObj->GetLong(pCurObj->GetColumnIndex(
-                                       ic_core::CDataBaseConst::COL_TIMESTAMP));
-            pCurObj->MoveToLast();
-            llEndTime = pCurObj->GetLong(pCurObj->GetColumnIndex(
-                                       ic_core::CDataBaseConst::COL_TIMESTAMP));
+            llStartTime = pCurObj->GetLong(0);
+            llEndTime = pCurObj->GetLong(1);
         }
         delete pCurObj;
     }
@@ -1496,18 +1499,16 @@ void CGranularityReductionHandler::DefaultPolicyHandler()
     // Query and delete attachments belonging to the events to be purged
     vecProjection.clear();
     vecProjection.push_back(ic_core::CDataBaseConst::COL_EVENTS);
-    pCurObj = pDB->Query(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+    pCurObj = pDB->QueryStream(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
                          vecProjection, strSelection + " AND (" +
                          ic_core::CDataBaseConst::COL_HAS_ATTACH + "=1)");
 
     std::set<std::string> setFileList;
     if (pCurObj)
     {
-        for (bool bWorking = pCurObj->MoveToFirst(); bWorking;
-             bWorking = pCurObj->MoveToNext())
+        while (pCurObj->MoveToNext())
         {
-            std::string eventData = pCurObj->GetString(pCurObj->GetColumnIndex(
-                                          ic_core::CDataBaseConst::COL_EVENTS));
+            std::string eventData = pCurObj->GetString(0);
             eventData = CUploadUtils::DecryptEventData(eventData);
             if (eventData.empty())
             {
@@ -1562,11 +1563,16 @@ void CGranularityReductionHandler::UpdateGRLevel(long long llStartTime,
 
     ic_core::CDataBaseFacade *pDB = ic_core::CDataBaseFacade::GetInstance();
 
-    std::string strSelection = "(" + ic_core::CDataBaseConst::COL_TIMESTAMP + 
-              " > " + ic_utils::CIgniteStringUtils::NumberToString(llStartTime);
-    strSelection += " AND " + ic_core::CDataBaseConst::COL_TIMESTAMP + " <= " +
-                        ic_utils::CIgniteStringUtils::NumberToString(llEndTime);
+    // the time range is bound, the statement is reused for every range
+    std::string strSelection = "(" + ic_core::CDataBaseConst::COL_TIMESTAMP +
+                               " > ?";
+    strSelection += " AND " + ic_core::CDataBaseConst::COL_TIMESTAMP + " <= ?";
     strSelection += ")";
+    std::vector<std::string> vecSelectionArgs;
+    vecSelectionArgs.push_back(
+                    ic_utils::CIgniteStringUtils::NumberToString(llStartTime));
+    vecSelectionArgs.push_back(
+                    ic_utils::CIgniteStringUtils::NumberToString(llEndTime));
 
     strSelection += " AND " + ic_core::CDataBaseConst::COL_EVENT_ID;
     strSelection += " NOT IN (" + stPolicy.strExemptedEvents;
@@ -1582,7 +1588,8 @@ void CGranularityReductionHandler::UpdateGRLevel(long long llStartTime,
     ic_core::CContentValues data;
     data.Put(ic_core::CDataBaseConst::COL_GRANULARITY,stPolicy.nGranLevel);
 
-    pDB->Update(ic_core::CDataBaseConst::TABLE_EVENT_STORE, &data, strSelection);
+    pDB->Update(ic_core::CDataBaseConst::TABLE_EVENT_STORE, &data, strSelection,
+                vecSelectionArgs);
 
     if (bTransactionStarted)
     {
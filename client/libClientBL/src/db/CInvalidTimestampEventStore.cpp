@@ -21,8 +21,6 @@
 #include "CIgniteConfig.h"
 #include "CIgniteLog.h"
 #include "CIgniteStringUtils.h"
-#include "core/CKeyGenerator.h"
-#include "core/CAesSeed.h"
 #include "crypto/CIgniteDataSecurity.h"
 #include "db/CDataBaseFacade.h"
 #include "dam/CEventWrapper.h"
@@ -42,10 +40,7 @@ namespace ic_bl
  */
 static std::string encrypt_event_data(const std::string &rstrEventData)
 {
-    ic_core::CIgniteDataSecurity securityObject(
-                               ic_core::CKeyGenerator::GetActivationKey(),
-                               ic_core::CAesSeed::GetInstance()->GetIvRandom());
-    return securityObject.Encrypt(rstrEventData);
+    return ic_core::CIgniteDataSecurity::EncryptEvent(rstrEventData);
 }
 
 /**
@@ -55,10 +50,7 @@ static std::string encrypt_event_data(const std::string &rstrEventData)
  */
 static std::string decrypt_event(const std::string &rstrEvent)
 {
-    ic_core::CIgniteDataSecurity securityObject(
-                               ic_core::CKeyGenerator::GetActivationKey(),
-                               ic_core::CAesSeed::GetInstance()->GetIvRandom());
-    return securityObject.Decrypt(rstrEvent);
+    return ic_core::CIgniteDataSecurity::DecryptEvent(rstrEvent);
 }
 
 CInvalidTimestampEventStore::CInvalidTimestampEventStore()
@@ -201,8 +193,8 @@ long CInvalidTimestampEventStore::InsertIntoDb(const std::string &rstrSerialized
     ic_core::CContentValues data;
     data.Put(ic_core::CDataBaseConst::COL_TIMESTAMP, llTimestamp);
 
-    data.Put(ic_core::CDataBaseConst::COL_EVENTS,
-             encrypt_event_data(rstrSerialized));
+    data.PutBlob(ic_core::CDataBaseConst::COL_EVENTS,
+                 encrypt_event_data(rstrSerialized));
     return ic_core::CDataBaseFacade::GetInstance()->Insert(
                      ic_core::CDataBaseConst::TABLE_INVALID_EVENT_STORE, &data);
 }
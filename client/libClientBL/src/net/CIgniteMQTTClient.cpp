@@ -34,6 +34,7 @@
 #include "CIgniteClient.h"
 #include "CHttpResponse.h"
 #include "upload/CMidHandler.h"
+#include "upload/CMQTTUploader.h"
 
 #ifdef PREFIX
 #undef PREFIX
@@ -322,7 +323,8 @@ int CIgniteMQTTClient::PublishAlerts(int *pnMid, const void *pvoidAlertPayload,
 }
 
 int CIgniteMQTTClient::PublishEvents(int *pnMid, const void *pvoidEventPayload,
-                                const int nSize, const std::string &rstrVendor)
+                                const int nSize, const std::string &rstrVendor,
+                                const std::string &rstrTopicSuffix)
 {
     ic_utils::CScopeLock scopeLock(m_PubTopicMutex);
     HCPLOG_METHOD();
@@ -337,6 +339,7 @@ int CIgniteMQTTClient::PublishEvents(int *pnMid, const void *pvoidEventPayload,
         strTopic = 
             m_strTopicprefix + m_strDeviceID + "/2c/" + rstrVendor + "events";
     }
+    strTopic.append(rstrTopicSuffix);
     HCPLOG_I << "topic:" << strTopic;
 
     return PublishMessage(pnMid, pvoidEventPayload, nSize, strTopic, nQos);
@@ -509,6 +512,7 @@ void CIgniteMQTTClient::SendFirmwareVersionEvent(const std::string
 void CIgniteMQTTClient::on_disconnect(int nRc)
 {
     CMQTTClient::on_disconnect(nRc);
+    CMQTTUploader::GetInstance()->NotifyConnectionLost();
 
     m_nNoOfTopicsToSubscribe = 0;
     m_nNoOfTopicSubAckRcvd = 0;
@@ -579,6 +583,7 @@ void CIgniteMQTTClient::on_publish(int nMid)
         HCPLOG_D << "mid[" << nMid << "]";
     }
     CMidHandler::GetInstance()->ProcessPublishedMid(nMid);
+    CMQTTUploader::GetInstance()->NotifyPublishAck(nMid);
 }
 
 void CIgniteMQTTClient::on_log(int nLevel, const char* cstrStr)
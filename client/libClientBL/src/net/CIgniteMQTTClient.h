@@ -127,10 +127,13 @@ public:
      * @param[in] nSize Size of buffer
      * @param[in] rstrVendor  If it is not empty then buffer will be uploaded
      * on its corresponding topic
+     * @param[in] rstrTopicSuffix Suffix appended to the topic, e.g. to
+     * advertise the compression dictionary version
      * @return 0 on success.
      */
     int PublishEvents(int *pnMid, const void *pvoidEventPayload,
-                      const int nSize, const std::string &rstrVendor = "");
+                      const int nSize, const std::string &rstrVendor = "",
+                      const std::string &rstrTopicSuffix = "");
 
     /**
      * Method to Upload / publish events on a particular topic
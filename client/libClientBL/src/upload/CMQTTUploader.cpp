@@ -20,6 +20,7 @@
 #include <sys/time.h>
 #include "unistd.h"
 #include <vector>
+#include <algorithm>
 #include <iterator>
 #include <limits.h>
 #include "CMQTTUploader.h"
@@ -34,6 +35,8 @@
 #include "core/CAesSeed.h"
 #include "config/CUploadMode.h"
 #include "CUploadUtils.h"
+#include "auth/CTokenManager.h"
+#include "CIgniteHTTPConnector.h"
 
 #ifdef PREFIX
 #undef PREFIX
@@ -85,6 +88,78 @@ static const int MIN_UPLOAD_EVENT_COUNT = 20;
 // Maximum events count for uploading in a bundle
 static const int MAX_UPLOAD_EVENT_COUNT = 175;
 
+// Topic suffix advertising the id of the compression dictionary
+static const std::string DICTIONARY_TOPIC_SUFFIX = "/dict/";
+
+// Initial wait in seconds before retrying a failed dictionary download
+static const time_t DICTIONARY_RETRY_MIN = 60;
+
+// Maximum wait in seconds between the dictionary download retries
+static const time_t DICTIONARY_RETRY_MAX = 3600;
+
+// Config key for the number of events batches prefetched during upload
+static const std::string KEY_PREFETCH_DEPTH =
+                                    "MQTT.pub_topics.events.prefetchDepth";
+
+// Default prefetch depth, events batches are prepared one after the other
+static const int DEF_PREFETCH_DEPTH = 0;
+
+// Maximum prefetch depth
+static const int MAX_PREFETCH_DEPTH = 8;
+
+// Config key for the memory bound of the prefetched events batches
+static const std::string KEY_PREFETCH_MAX_BYTES =
+                                    "MQTT.pub_topics.events.prefetchMaxBytes";
+
+// Default memory bound in bytes of the prefetched events batches
+static const int DEF_PREFETCH_MAX_BYTES = 1024 * 1024;
+
+/* MID reserving prefetched events until they are published; reservations
+ * left behind are cleared along with the pending MIDs on (re)connect
+ */
+static const int RESERVED_MID = -1;
+
+// Config key for the initial size of the events publish window
+static const std::string KEY_PUBLISH_WINDOW_SIZE = "MQTT.publishWindow.size";
+
+// Default publish window size, the window is disabled
+static const int DEF_PUBLISH_WINDOW_SIZE = 0;
+
+// Config key for the maximum size of the events publish window
+static const std::string KEY_PUBLISH_WINDOW_MAX_SIZE =
+                                                "MQTT.publishWindow.maxSize";
+
+// Config key for the PUBACK timeout of the events publish window
+static const std::string KEY_PUBLISH_WINDOW_ACK_TIMEOUT =
+                                            "MQTT.publishWindow.ackTimeoutMs";
+
+// Default PUBACK timeout in milliseconds
+static const int DEF_PUBLISH_WINDOW_ACK_TIMEOUT = 10000;
+
+// Config key for the inflight messages limit of the MQTT client
+static const std::string KEY_MAX_INFLIGHT_MESSAGES = "MQTT.maxInflightMessages";
+
+// Default inflight messages limit of the MQTT client
+static const int DEF_MAX_INFLIGHT_MESSAGES = 20;
+
+// Wait time in milliseconds between checks of a full publish window
+static const unsigned int PUBLISH_WINDOW_WAIT_TIME = 500;
+
+// Config key for the events upload lanes
+static const std::string KEY_UPLOAD_LANES = "MQTT.uploadLanes";
+
+// Default share of the link granted to an upload lane
+static const int DEF_LANE_SHARE = 1;
+
+// Default number of payloads of an upload lane awaiting a PUBACK
+static const int DEF_LANE_INFLIGHT = 10;
+
+// PUBACK timeout in milliseconds of the upload lanes
+static const unsigned int LANE_ACK_TIMEOUT = 10000;
+
+// Maximum number of acks kept for MIDs not yet mapped to their lane
+static const size_t MAX_EARLY_LANE_ACKS = 256;
+
 /**
  * Method to update the MID column in rows specified in the database ,
  * with mid value passed
@@ -102,20 +177,20 @@ bool update_mid(const std::string& rstrTable,
         HCPLOG_D << "Nothing to update";
     }
 
-    std::string strSelection = ic_core::CDataBaseConst::COL_ID + " in (";
-    for (int nI = 0; nI < rvecRowIDs.size(); nI++)
-    {
-        strSelection.append(
-            ic_utils::CIgniteStringUtils::NumberToString(rvecRowIDs[nI]));
-        strSelection.append(",");
-    }
-    strSelection.replace(strSelection.size() - 1, 1, ")");
-
     ic_core::CContentValues data;
     data.Put(ic_core::CDataBaseConst::COL_MID, nMid);
 
-    bool bResult = ic_core::CDataBaseFacade::GetInstance()->Update(rstrTable, 
-                                                            &data, strSelection);
+    // the row ids are bound to the ID set, the update statement stays prepared
+    ic_core::CDataBaseFacade *pDb = ic_core::CDataBaseFacade::GetInstance();
+    bool bResult = pDb->StartTransaction();
+    if (bResult)
+    {
+        // the ID set is only consistent while the transaction lock is held
+        bResult = pDb->BindIdSet(rvecRowIDs) &&
+                  pDb->UpdateByIdSet(rstrTable, &data,
+                                     ic_core::CDataBaseConst::COL_ID);
+        pDb->EndTransaction(bResult);
+    }
     if (!bResult)
     {
         HCPLOG_E << "Failed to update table " << rstrTable << "~" << nMid;
@@ -125,6 +200,62 @@ bool update_mid(const std::string& rstrTable,
     return bRetVal;
 }
 
+/**
+ * Method to read the link share and inflight budget of an upload lane
+ * @param[in] rjsonLane Lane configuration
+ * @param[out] runShare Share of the link granted to the lane
+ * @param[out] runInflight Maximum number of payloads awaiting a PUBACK
+ * @return void
+ */
+void read_lane_budget(const ic_utils::Json::Value &rjsonLane,
+                      unsigned int &runShare, unsigned int &runInflight)
+{
+    runShare = DEF_LANE_SHARE;
+    runInflight = DEF_LANE_INFLIGHT;
+    if (!rjsonLane.isObject())
+    {
+        return;
+    }
+    if (rjsonLane.isMember("share") && rjsonLane["share"].isInt() &&
+        (rjsonLane["share"].asInt() > 0))
+    {
+        runShare = rjsonLane["share"].asInt();
+    }
+    if (rjsonLane.isMember("inflight") && rjsonLane["inflight"].isInt() &&
+        (rjsonLane["inflight"].asInt() > 0))
+    {
+        runInflight = rjsonLane["inflight"].asInt();
+    }
+}
+
+/**
+ * Method to read the inflight limit of the MQTT client, beyond which messages
+ * are only queued locally by the client
+ * @param void
+ * @return Maximum number of messages awaiting a PUBACK
+ */
+int get_max_inflight()
+{
+    int nMaxInflight = ic_core::CIgniteConfig::GetInstance()->GetInt(
+                        KEY_MAX_INFLIGHT_MESSAGES, DEF_MAX_INFLIGHT_MESSAGES);
+    return (nMaxInflight > 0) ? nMaxInflight : DEF_MAX_INFLIGHT_MESSAGES;
+}
+
+/**
+ * Method to quote a string as an SQL literal
+ * @param[in] rstrValue String to quote
+ * @return Quoted string
+ */
+std::string quote_sql(const std::string &rstrValue)
+{
+    std::string strQuoted = "'";
+    for (size_t nI = 0; nI < rstrValue.size(); nI++)
+    {
+        strQuoted += (rstrValue[nI] == '\'') ? "''" : rstrValue.substr(nI, 1);
+    }
+    return strQuoted + "'";
+}
+
 /**
  * Method to check if the compression of MQTT payload is enabled
  * with mid value passed
@@ -146,6 +277,36 @@ bool is_compression_enabled()
     return bRetVal;
 }
 
+/**
+ * Method to read the compression dictionary configuration
+ * @param[out] rstrPath Path of the dictionary file
+ * @param[out] rstrUrl Url distributing the dictionary
+ * @param[out] rstrId Id of the configured dictionary, empty to accept any
+ * @return Configuration joined in a string to detect its changes
+ */
+std::string get_dictionary_config(std::string &rstrPath, std::string &rstrUrl,
+                                  std::string &rstrId)
+{
+    ic_core::CIgniteConfig *pConfig = ic_core::CIgniteConfig::GetInstance();
+    rstrPath = pConfig->GetString(KEY_COMPRESSION_DICTIONARY);
+    rstrUrl = pConfig->GetString(KEY_COMPRESSION_DICTIONARY_URL);
+    rstrId = pConfig->GetString(KEY_COMPRESSION_DICTIONARY_ID);
+    return rstrPath + "\n" + rstrUrl + "\n" + rstrId;
+}
+
+/**
+ * Method to check if a dictionary is the configured one
+ * @param[in] rDictionary Dictionary to check
+ * @param[in] rstrId Id of the configured dictionary, empty to accept any
+ * @return True if the dictionary is the configured one, false otherwise
+ */
+bool is_configured_dictionary(const ic_utils::CGzipDictionary &rDictionary,
+                              const std::string &rstrId)
+{
+    return rstrId.empty() || (rstrId ==
+        ic_utils::CIgniteStringUtils::NumberToString(rDictionary.GetId()));
+}
+
 } // local namespace
 
 CMQTTUploader::CMQTTUploader()
@@ -159,6 +320,7 @@ CMQTTUploader::CMQTTUploader()
     m_EventTimer = NULL;
     m_AlertTimer = NULL;
     m_bUploadSuspended = false;
+    m_pLaneScheduler = NULL;
 
     ic_utils::Json::Value jsonEventArray = 
         ic_core::CIgniteConfig::GetInstance()->GetJsonValue(
@@ -178,6 +340,20 @@ CMQTTUploader::CMQTTUploader()
 
     InitEventsUploadCnt();
 
+    m_bDictionaryConfigUpdated = false;
+    m_tDictionaryRetry = 0;
+    m_tDictionaryBackoff = DICTIONARY_RETRY_MIN;
+    LoadCompressionDictionary();
+
+    m_unPrefetchedBytes = 0;
+    m_bPrefetchDone = true;
+    m_bStopPrefetch = false;
+    InitUploadPrefetch();
+
+    InitPublishWindow();
+
+    InitUploadLanes();
+
     InitConfigBasedLogging();
 
     ic_core::CIgniteConfig::GetInstance()->SubscribeForConfigUpdateNotification(
@@ -214,6 +390,311 @@ void CMQTTUploader::InitEventsUploadCnt()
     HCPLOG_C << "Max upload-event cnt:  " << m_unMaxEventUploadCnt;
 }
 
+bool CMQTTUploader::LoadCompressionDictionary()
+{
+    std::string strPath;
+    std::string strUrl;
+    std::string strId;
+    m_strDictionaryConfig = get_dictionary_config(strPath, strUrl, strId);
+    m_bDictionaryPending = false;
+    if (!m_bCompression || strPath.empty())
+    {
+        UseCompressionDictionary("");
+        return true;
+    }
+
+    /* dictionaries are trained and distributed centrally, the file keeps the
+     * local copy; when it does not hold the configured dictionary it is
+     * downloaded again by the uploader thread, see
+     * RefreshCompressionDictionary()
+     */
+    ic_utils::CGzipDictionary dictionary;
+    bool bValid = dictionary.Load(strPath);
+    if (bValid && !is_configured_dictionary(dictionary, strId))
+    {
+        HCPLOG_E << "Compression dictionary id " << dictionary.GetId()
+                 << " is not the configured " << strId;
+        bValid = false;
+    }
+    if (!bValid && !strUrl.empty())
+    {
+        HCPLOG_I << "Compression dictionary to be downloaded: " << strPath;
+        m_bDictionaryPending = true;
+    }
+
+    /* payloads compressed with a dictionary are zlib streams, published on
+     * the topic variant naming the dictionary id; without a valid dictionary
+     * the plain gzip payloads are kept
+     */
+    if (!bValid || !UseCompressionDictionary(dictionary.GetData()))
+    {
+        HCPLOG_E << "Compression dictionary not used: " << strPath;
+        UseCompressionDictionary("");
+        bValid = false;
+    }
+    return bValid;
+}
+
+bool CMQTTUploader::UseCompressionDictionary(const std::string &rstrData)
+{
+    if (rstrData.empty() || !m_gzipStream.SetDictionary(rstrData) ||
+        !m_prefetchGzipStream.SetDictionary(rstrData))
+    {
+        m_gzipStream.SetDictionary("");
+        m_prefetchGzipStream.SetDictionary("");
+        m_strDictionary.clear();
+        m_strDictionaryTopicSuffix.clear();
+        return false;
+    }
+
+    m_strDictionary = rstrData;
+    m_strDictionaryTopicSuffix = DICTIONARY_TOPIC_SUFFIX +
+        ic_utils::CIgniteStringUtils::NumberToString(
+                                          m_gzipStream.GetDictionaryId());
+    HCPLOG_C << "Compression dictionary id " << m_gzipStream.GetDictionaryId();
+    return true;
+}
+
+void CMQTTUploader::RefreshCompressionDictionary()
+{
+    std::string strPath;
+    std::string strUrl;
+    std::string strId;
+    if (m_bDictionaryConfigUpdated.exchange(false) &&
+        (get_dictionary_config(strPath, strUrl, strId) !=
+         m_strDictionaryConfig))
+    {
+        HCPLOG_I << "Compression dictionary configuration changed";
+        LoadCompressionDictionary();
+        m_tDictionaryRetry = 0;
+        m_tDictionaryBackoff = DICTIONARY_RETRY_MIN;
+    }
+
+    if (!m_bDictionaryPending || (time(NULL) < m_tDictionaryRetry))
+    {
+        return;
+    }
+
+    get_dictionary_config(strPath, strUrl, strId);
+    ic_utils::CGzipDictionary dictionary;
+    bool bValid = FetchCompressionDictionary(strUrl, strPath, dictionary);
+    if (bValid && !is_configured_dictionary(dictionary, strId))
+    {
+        HCPLOG_E << "Compression dictionary id " << dictionary.GetId()
+                 << " is not the configured " << strId;
+        bValid = false;
+    }
+
+    if (bValid && UseCompressionDictionary(dictionary.GetData()))
+    {
+        m_bDictionaryPending = false;
+        m_tDictionaryBackoff = DICTIONARY_RETRY_MIN;
+        return;
+    }
+
+    // payloads are kept without dictionary until a later download succeeds
+    m_tDictionaryRetry = time(NULL) + m_tDictionaryBackoff;
+    HCPLOG_W << "Compression dictionary download retried in "
+             << m_tDictionaryBackoff << "secs";
+    m_tDictionaryBackoff = std::min(m_tDictionaryBackoff * 2,
+                                    DICTIONARY_RETRY_MAX);
+}
+
+bool CMQTTUploader::FetchCompressionDictionary(const std::string &rstrUrl,
+                                        const std::string &rstrPath,
+                                        ic_utils::CGzipDictionary &rDictionary)
+{
+    HCPLOG_METHOD() << "url=" << rstrUrl;
+    ic_network::HttpErrorCode eErrorCode = ic_network::HttpErrorCode::eERR_OK;
+    std::string strToken = CTokenManager::GetInstance()->GetToken(eErrorCode);
+    if (ic_network::HttpErrorCode::eERR_OK != eErrorCode)
+    {
+        HCPLOG_E << "No token to download the compression dictionary";
+        return false;
+    }
+
+    ic_network::CIgniteHTTPConnector::CDictionaryResponse resp;
+    ic_network::CIgniteHTTPConnector::GetInstance()->GetCompressionDictionary(
+                                                      strToken, resp, rstrUrl);
+    if ((ic_network::HttpErrorCode::eERR_OK != resp.m_eHttpSessionErrCode) ||
+        !rDictionary.Parse(resp.m_strDictionary))
+    {
+        HCPLOG_E << "Compression dictionary download failed, http code "
+                 << resp.m_lHttpRespCode;
+        return false;
+    }
+
+    // a failed save only costs a download on the next start
+    rDictionary.Save(rstrPath);
+    return true;
+}
+
+void CMQTTUploader::InitUploadPrefetch()
+{
+    ic_core::CIgniteConfig *pConfig = ic_core::CIgniteConfig::GetInstance();
+    int nDepth = pConfig->GetInt(KEY_PREFETCH_DEPTH, DEF_PREFETCH_DEPTH);
+    int nMaxBytes = pConfig->GetInt(KEY_PREFETCH_MAX_BYTES,
+                                    DEF_PREFETCH_MAX_BYTES);
+
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    if (nDepth <= 0)
+    {
+        m_unPrefetchDepth = 0;
+    }
+    else if (nDepth >= MAX_PREFETCH_DEPTH)
+    {
+        m_unPrefetchDepth = MAX_PREFETCH_DEPTH;
+    }
+    else
+    {
+        m_unPrefetchDepth = (unsigned int)nDepth;
+    }
+    m_unPrefetchMaxBytes = (nMaxBytes > 0) ? (unsigned int)nMaxBytes :
+                                             DEF_PREFETCH_MAX_BYTES;
+
+    HCPLOG_C << "Upload prefetch depth: " << m_unPrefetchDepth
+             << ", max bytes: " << m_unPrefetchMaxBytes;
+}
+
+void CMQTTUploader::InitPublishWindow()
+{
+    ic_core::CIgniteConfig *pConfig = ic_core::CIgniteConfig::GetInstance();
+    int nSize = pConfig->GetInt(KEY_PUBLISH_WINDOW_SIZE,
+                                DEF_PUBLISH_WINDOW_SIZE);
+
+    // the window is kept within the inflight limit of the MQTT client
+    int nMaxInflight = get_max_inflight();
+    int nMaxSize = pConfig->GetInt(KEY_PUBLISH_WINDOW_MAX_SIZE, nMaxInflight);
+    if ((nMaxSize <= 0) || (nMaxSize > nMaxInflight))
+    {
+        nMaxSize = nMaxInflight;
+    }
+    int nAckTimeout = pConfig->GetInt(KEY_PUBLISH_WINDOW_ACK_TIMEOUT,
+                                      DEF_PUBLISH_WINDOW_ACK_TIMEOUT);
+    if (nAckTimeout <= 0)
+    {
+        nAckTimeout = DEF_PUBLISH_WINDOW_ACK_TIMEOUT;
+    }
+
+    m_publishWindow.Configure((nSize > 0) ? (unsigned int)nSize : 0,
+                              (unsigned int)nMaxSize, (unsigned int)nAckTimeout);
+    HCPLOG_C << "Publish window size: " << m_publishWindow.GetSize()
+             << ", max size: " << nMaxSize << ", ack timeout: " << nAckTimeout;
+}
+
+bool CMQTTUploader::AcquirePublishSlot()
+{
+    while (!m_publishWindow.Acquire(PUBLISH_WINDOW_WAIT_TIME))
+    {
+        if (m_bShutdownRequested || !m_pMqClient->IsConnected())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CMQTTUploader::InitUploadLanes()
+{
+    ic_utils::Json::Value jsonLanes =
+        ic_core::CIgniteConfig::GetInstance()->GetJsonValue(KEY_UPLOAD_LANES);
+
+    std::vector<UploadLane> vecLanes;
+    if (jsonLanes.isObject() && jsonLanes.isMember("enabled") &&
+        jsonLanes["enabled"].asBool())
+    {
+        // one lane per configured topic
+        std::string strConfiguredTopics;
+        ic_utils::Json::Value jsonTopics = jsonLanes["topics"];
+        for (int nI = 0; jsonTopics.isArray() && (nI < jsonTopics.size()); nI++)
+        {
+            if (!jsonTopics[nI].isObject() ||
+                !jsonTopics[nI]["topic"].isString() ||
+                jsonTopics[nI]["topic"].asString().empty())
+            {
+                HCPLOG_E << "Invalid upload lane " << nI;
+                continue;
+            }
+
+            UploadLane lane;
+            lane.m_strName = jsonTopics[nI]["topic"].asString();
+            lane.m_bTopiced = true;
+            lane.m_strTopicSelection = ic_core::CDataBaseConst::COL_TOPIC +
+                                       " == " + quote_sql(lane.m_strName);
+            read_lane_budget(jsonTopics[nI], lane.m_unShare, lane.m_unInflight);
+            vecLanes.push_back(lane);
+
+            strConfiguredTopics += (strConfiguredTopics.empty() ? "" : ",") +
+                                   quote_sql(lane.m_strName);
+        }
+
+        // one lane for the other topics
+        UploadLane otherLane;
+        otherLane.m_strName = "otherTopics";
+        otherLane.m_bTopiced = true;
+        if (!strConfiguredTopics.empty())
+        {
+            otherLane.m_strTopicSelection = ic_core::CDataBaseConst::COL_TOPIC +
+                                        " NOT IN (" + strConfiguredTopics + ")";
+        }
+        read_lane_budget(jsonLanes["otherTopics"], otherLane.m_unShare,
+                         otherLane.m_unInflight);
+        vecLanes.push_back(otherLane);
+
+        // one lane for the batched events stream
+        UploadLane eventsLane;
+        eventsLane.m_strName = "events";
+        eventsLane.m_bTopiced = false;
+        read_lane_budget(jsonLanes["events"], eventsLane.m_unShare,
+                         eventsLane.m_unInflight);
+        vecLanes.push_back(eventsLane);
+
+        // like the publish window, lanes stay within the MQTT inflight limit
+        unsigned int unMaxInflight = get_max_inflight();
+        for (size_t nI = 0; nI < vecLanes.size(); nI++)
+        {
+            if (vecLanes[nI].m_unInflight > unMaxInflight)
+            {
+                HCPLOG_W << "Lane " << vecLanes[nI].m_strName << " inflight "
+                         << vecLanes[nI].m_unInflight << " capped to "
+                         << unMaxInflight;
+                vecLanes[nI].m_unInflight = unMaxInflight;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_LaneMutex);
+    m_vecUploadLanes.swap(vecLanes);
+    HCPLOG_C << "Upload lanes: " << m_vecUploadLanes.size();
+}
+
+void CMQTTUploader::NotifyPublishAck(int nMid)
+{
+    m_publishWindow.OnAcked(nMid);
+
+    std::lock_guard<std::mutex> lock(m_LaneMutex);
+    std::map<int, CPublishWindow*>::iterator iterLane = m_mapLaneMids.find(nMid);
+    if (iterLane != m_mapLaneMids.end())
+    {
+        iterLane->second->OnAcked(nMid);
+        m_mapLaneMids.erase(iterLane);
+    }
+    else if (NULL != m_pLaneScheduler)
+    {
+        // the PUBACK may be received before the publish call returns
+        if (m_setEarlyLaneAcks.size() >= MAX_EARLY_LANE_ACKS)
+        {
+            m_setEarlyLaneAcks.clear();
+        }
+        m_setEarlyLaneAcks.insert(nMid);
+    }
+}
+
+void CMQTTUploader::NotifyConnectionLost()
+{
+    m_publishWindow.Reset();
+}
+
 CMQTTUploader::~CMQTTUploader()
 {
     HCPLOG_METHOD();
@@ -507,14 +988,32 @@ void CMQTTUploader::TriggerEventUploads()
         //do nothing
     }
 
-    if (!UploadTopicedEvents())
+    RefreshCompressionDictionary();
+
+    bool bLanes = false;
     {
-        HCPLOG_I << "Topic based Events Uploaded Successfully;";
+        std::lock_guard<std::mutex> lock(m_LaneMutex);
+        bLanes = !m_vecUploadLanes.empty();
     }
 
-    if (!UploadEvents())
+    if (bLanes)
     {
-        HCPLOG_I << "Events Uploaded Successfully;";
+        if (!UploadEventLanes())
+        {
+            HCPLOG_I << "Events Uploaded Successfully over lanes;";
+        }
+    }
+    else
+    {
+        if (!UploadTopicedEvents())
+        {
+            HCPLOG_I << "Topic based Events Uploaded Successfully;";
+        }
+
+        if (!UploadEvents())
+        {
+            HCPLOG_I << "Events Uploaded Successfully;";
+        }
     }
 
     #if defined(TEST_HIGH_FREQ)
@@ -631,21 +1130,26 @@ bool CMQTTUploader::PrepareDataAndPublish(int &rnMid,
                                           int &rnErr,
                                           const std::string &rstrTopic)
 {
+    if (!AcquirePublishSlot())
+    {
+        rnErr = -1;
+        return true;
+    }
+
     if (m_bCompression)
     {
-        ic_utils::CZippedMsg *pData = ic_utils::CIgniteGZip::GzipMsg(
-                                         (unsigned char*) rstrEventData.c_str(),
-                                         rstrEventData.size());
-        if (NULL == pData)
+        if (!m_gzipStream.Reset() || !m_gzipStream.Append(rstrEventData) ||
+            !m_gzipStream.Finish())
         {
             HCPLOG_E << "Compression Error,retry in next iteration";
+            m_publishWindow.Cancel();
             return false;
         }
 
-        rnErr = m_pMqClient->PublishEventsOnTopic(&rnMid, pData->m_puchBuf, 
-                                              (int)pData->m_unSize, rstrTopic);
-        delete pData;
-        pData = NULL;
+        rnErr = m_pMqClient->PublishEventsOnTopic(&rnMid,
+                                  m_gzipStream.GetData(),
+                                  (int)m_gzipStream.GetSize(),
+                                  rstrTopic + m_strDictionaryTopicSuffix);
     }
     else
     {
@@ -653,25 +1157,39 @@ bool CMQTTUploader::PrepareDataAndPublish(int &rnMid,
         rnErr = m_pMqClient->PublishEventsOnTopic(&rnMid, rstrEventData.c_str(),
                                             rstrEventData.length(), rstrTopic);
     }
+
+    if (!rnErr && (rnMid > 0))
+    {
+        m_publishWindow.OnPublished(rnMid);
+    }
+    else
+    {
+        m_publishWindow.Cancel();
+    }
     return true;
 }
 
 bool CMQTTUploader::PublishEvents(int &rnErr, int &rnMid,
                                  std::string &rstrEvents)
 {
+    if (!AcquirePublishSlot())
+    {
+        rnErr = -1;
+        return true;
+    }
+
     if (m_bCompression)
     {
-        ic_utils::CZippedMsg* pData = ic_utils::CIgniteGZip::
-                                   GzipMsg((unsigned char*) rstrEvents.c_str(),
-                                   rstrEvents.size());
-        if (NULL == pData)
+        // events are compressed into m_gzipStream while read from the DB
+        if (!m_gzipStream.IsFinished())
         {
             HCPLOG_E << "Compression Error!";
+            m_publishWindow.Cancel();
             return false;
         }
-        rnErr = m_pMqClient->PublishEvents(&rnMid,pData->m_puchBuf,
-                                            (int)pData->m_unSize);
-        delete pData;
+        rnErr = m_pMqClient->PublishEvents(&rnMid, m_gzipStream.GetData(),
+                                            (int)m_gzipStream.GetSize(), "",
+                                            m_strDictionaryTopicSuffix);
     }
     else
     {
@@ -680,6 +1198,14 @@ bool CMQTTUploader::PublishEvents(int &rnErr, int &rnMid,
                                          rstrEvents.length());
     }
 
+    if (!rnErr && (rnMid > 0))
+    {
+        m_publishWindow.OnPublished(rnMid);
+    }
+    else
+    {
+        m_publishWindow.Cancel();
+    }
     return true;
 }
 
@@ -731,6 +1257,16 @@ bool CMQTTUploader::VerifyPostPublish(const int &rnMid, int &rnErr,
 int CMQTTUploader::UploadEvents(void)
 {
     HCPLOG_METHOD();
+    bool bPipelined = false;
+    {
+        std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+        bPipelined = (m_unPrefetchDepth > 0);
+    }
+    if (bPipelined)
+    {
+        return UploadEventsPipelined();
+    }
+
     int nErr = -1;
     if (m_pMqClient->IsConnected())
     {
@@ -740,10 +1276,20 @@ int CMQTTUploader::UploadEvents(void)
         do
         {
             std::string strLogStr="";
-            CUploadUtils::GetStreamingEventsFromDB(strLogStr, 
+            if (m_bCompression)
+            {
+                CUploadUtils::GetCompressedStreamingEventsFromDB(strLogStr,
+                                    ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                                    m_unMaxEventUploadCnt, &vecRowIDs,
+                                    m_gzipStream);
+            }
+            else
+            {
+                CUploadUtils::GetStreamingEventsFromDB(strLogStr, 
                                     ic_core::CDataBaseConst::TABLE_EVENT_STORE, 
                                     m_unMaxEventUploadCnt, &vecRowIDs, 
                                     strEvents);
+            }
 
             if (vecRowIDs.size() > 0)
             {
@@ -772,6 +1318,401 @@ int CMQTTUploader::UploadEvents(void)
     return nErr;
 }
 
+int CMQTTUploader::UploadEventsPipelined(void)
+{
+    HCPLOG_METHOD();
+    int nErr = -1;
+    if (!m_pMqClient->IsConnected())
+    {
+        return nErr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+        m_dqPrefetchedBatches.clear();
+        m_unPrefetchedBytes = 0;
+        m_bPrefetchDone = false;
+        m_bStopPrefetch = false;
+    }
+    std::thread prefetchThread(&CMQTTUploader::PrefetchEvents, this);
+
+    while (!m_bShutdownRequested)
+    {
+        PrefetchedBatch batch;
+        {
+            std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+            m_PrefetchCondition.wait(lock, [this] {
+                return !m_dqPrefetchedBatches.empty() || m_bPrefetchDone;
+            });
+            if (m_dqPrefetchedBatches.empty())
+            {
+                // events store drained
+                break;
+            }
+            batch = std::move(m_dqPrefetchedBatches.front());
+            m_dqPrefetchedBatches.pop_front();
+            m_unPrefetchedBytes -= batch.m_strPayload.size();
+        }
+        m_PrefetchCondition.notify_all();
+
+        LogUploadEvntPayload(batch.m_strLog, batch.m_vecRowIDs.size());
+
+        int nMid = 0;
+        HCPLOG_I << "events selected for Upload:" << batch.m_vecRowIDs.size();
+        if (AcquirePublishSlot())
+        {
+            nErr = m_pMqClient->PublishEvents(&nMid, batch.m_strPayload.data(),
+                            (int)batch.m_strPayload.size(), "",
+                            m_bCompression ? m_strDictionaryTopicSuffix : "");
+            if (!nErr && (nMid > 0))
+            {
+                m_publishWindow.OnPublished(nMid);
+            }
+            else
+            {
+                m_publishWindow.Cancel();
+            }
+        }
+        else
+        {
+            nErr = -1;
+        }
+
+        if (!VerifyPostPublish(nMid, nErr, batch.m_vecRowIDs))
+        {
+            // released along with the batches still queued
+            std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+            m_unPrefetchedBytes += batch.m_strPayload.size();
+            m_dqPrefetchedBatches.push_front(std::move(batch));
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+        m_bStopPrefetch = true;
+    }
+    m_PrefetchCondition.notify_all();
+    prefetchThread.join();
+
+    ReleasePrefetchedBatches();
+
+    return nErr;
+}
+
+void CMQTTUploader::ReleasePrefetchedBatches(void)
+{
+    // batches not published are read again by the next upload
+    std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+    for (const PrefetchedBatch &rBatch : m_dqPrefetchedBatches)
+    {
+        update_mid(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                   rBatch.m_vecRowIDs, 0);
+    }
+    m_dqPrefetchedBatches.clear();
+    m_unPrefetchedBytes = 0;
+}
+
+void CMQTTUploader::PrefetchEvents(void)
+{
+    SetCurrentThreadName("CMQTTPrefetch");
+    bool bMore = true;
+    while (bMore)
+    {
+        {
+            /* wait for room in the queue; a batch is always allowed when the
+             * queue is empty so that a large batch cannot stall the upload
+             */
+            std::unique_lock<std::mutex> lock(m_PrefetchMutex);
+            m_PrefetchCondition.wait(lock, [this] {
+                return m_bStopPrefetch || m_bShutdownRequested ||
+                       m_dqPrefetchedBatches.empty() ||
+                       ((m_dqPrefetchedBatches.size() < m_unPrefetchDepth) &&
+                        (m_unPrefetchedBytes < m_unPrefetchMaxBytes));
+            });
+            if (m_bStopPrefetch || m_bShutdownRequested)
+            {
+                break;
+            }
+        }
+
+        PrefetchedBatch batch;
+        bool bReady = FetchEventBatch(batch);
+        bMore = bReady && (batch.m_vecRowIDs.size() == m_unMaxEventUploadCnt);
+
+        if (bReady)
+        {
+            std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+            m_unPrefetchedBytes += batch.m_strPayload.size();
+            m_dqPrefetchedBatches.push_back(std::move(batch));
+        }
+        m_PrefetchCondition.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_PrefetchMutex);
+        m_bPrefetchDone = true;
+    }
+    m_PrefetchCondition.notify_all();
+}
+
+bool CMQTTUploader::FetchEventBatch(PrefetchedBatch &rBatch)
+{
+    if (m_bCompression)
+    {
+        bool bFinished = CUploadUtils::GetCompressedStreamingEventsFromDB(
+                                rBatch.m_strLog,
+                                ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                                m_unMaxEventUploadCnt, &rBatch.m_vecRowIDs,
+                                m_prefetchGzipStream);
+        if (rBatch.m_vecRowIDs.empty())
+        {
+            return false;
+        }
+        if (!bFinished)
+        {
+            HCPLOG_E << "Compression Error!";
+            return false;
+        }
+        rBatch.m_strPayload.assign(
+                        (const char*)m_prefetchGzipStream.GetData(),
+                        m_prefetchGzipStream.GetSize());
+    }
+    else
+    {
+        CUploadUtils::GetStreamingEventsFromDB(rBatch.m_strLog,
+                                ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                                m_unMaxEventUploadCnt, &rBatch.m_vecRowIDs,
+                                rBatch.m_strPayload);
+        if (rBatch.m_vecRowIDs.empty())
+        {
+            return false;
+        }
+    }
+
+    // reserve the rows so that the next batch query skips them
+    if (!update_mid(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                    rBatch.m_vecRowIDs, RESERVED_MID))
+    {
+        HCPLOG_W << "Error in reserving prefetched events";
+        return false;
+    }
+    return true;
+}
+
+int CMQTTUploader::UploadEventLanes(void)
+{
+    HCPLOG_METHOD();
+    if (!m_pMqClient->IsConnected())
+    {
+        return -1;
+    }
+
+    CUploadLaneScheduler scheduler;
+    std::vector<std::unique_ptr<LaneContext>> vecLanes;
+    {
+        std::lock_guard<std::mutex> lock(m_LaneMutex);
+        for (size_t nI = 0; nI < m_vecUploadLanes.size(); nI++)
+        {
+            std::unique_ptr<LaneContext> pLane(new LaneContext());
+            pLane->m_config = m_vecUploadLanes[nI];
+            pLane->m_unIndex = scheduler.AddLane(pLane->m_config.m_unShare);
+            pLane->m_window.Configure(pLane->m_config.m_unInflight,
+                                      pLane->m_config.m_unInflight,
+                                      LANE_ACK_TIMEOUT);
+            pLane->m_gzipStream.SetDictionary(m_strDictionary);
+            vecLanes.push_back(std::move(pLane));
+        }
+        m_setEarlyLaneAcks.clear();
+        m_pLaneScheduler = &scheduler;
+    }
+
+    std::vector<std::thread> vecThreads;
+    for (size_t nI = 0; nI < vecLanes.size(); nI++)
+    {
+        vecThreads.push_back(std::thread(&CMQTTUploader::RunUploadLane, this,
+                                         vecLanes[nI].get(), &scheduler));
+    }
+    for (size_t nI = 0; nI < vecThreads.size(); nI++)
+    {
+        vecThreads[nI].join();
+    }
+
+    // MIDs still awaiting a PUBACK are cleared by CMidHandler as before
+    {
+        std::lock_guard<std::mutex> lock(m_LaneMutex);
+        m_mapLaneMids.clear();
+        m_setEarlyLaneAcks.clear();
+        m_pLaneScheduler = NULL;
+    }
+
+    for (size_t nI = 0; nI < vecLanes.size(); nI++)
+    {
+        HCPLOG_I << "Lane " << vecLanes[nI]->m_config.m_strName << " uploaded "
+                 << scheduler.GetBytes(vecLanes[nI]->m_unIndex) << " bytes, "
+                 << vecLanes[nI]->m_window.GetRetransmitCount()
+                 << " retransmits";
+    }
+    return m_pMqClient->IsConnected() ? 0 : -1;
+}
+
+void CMQTTUploader::RunUploadLane(LaneContext *pLane,
+                                  CUploadLaneScheduler *pScheduler)
+{
+    SetCurrentThreadName("CMQTTLane");
+    const std::string &rstrTable = ic_core::CDataBaseConst::TABLE_EVENT_STORE;
+    bool bMore = true;
+    while (bMore && !m_bShutdownRequested && m_pMqClient->IsConnected())
+    {
+        std::vector<long long> vecRowIDs;
+        if (pLane->m_config.m_bTopiced)
+        {
+            std::map<long long, std::pair<std::string, std::string>> mapEvents;
+            CUploadUtils::GetTopicedStreamingEventsFromDB(rstrTable,
+                                m_unMaxEventUploadCnt, &vecRowIDs, mapEvents,
+                                0, 0, pLane->m_config.m_strTopicSelection);
+            bMore = (mapEvents.size() == m_unMaxEventUploadCnt);
+
+            std::map<long long, std::pair<std::string, std::string>>::iterator
+                                            iterEvent = mapEvents.begin();
+            for (; iterEvent != mapEvents.end(); iterEvent++)
+            {
+                const std::string &rstrEventData = iterEvent->second.second;
+                const void *pvPayload = rstrEventData.data();
+                unsigned int unSize = rstrEventData.size();
+                if (m_bCompression)
+                {
+                    if (!pLane->m_gzipStream.Reset() ||
+                        !pLane->m_gzipStream.Append(rstrEventData) ||
+                        !pLane->m_gzipStream.Finish())
+                    {
+                        HCPLOG_E << "Compression Error,retry in next iteration";
+                        continue;
+                    }
+                    pvPayload = pLane->m_gzipStream.GetData();
+                    unSize = pLane->m_gzipStream.GetSize();
+                }
+
+                int nMid = 0;
+                int nErr = PublishOnLane(*pLane, *pScheduler, pvPayload, unSize,
+                                         iterEvent->second.first, nMid);
+                std::vector<long long> vecRowID(1, iterEvent->first);
+                if (!VerifyPostPublish(nMid, nErr, vecRowID))
+                {
+                    bMore = false;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            std::string strLogStr;
+            std::string strEvents;
+            const void *pvPayload = NULL;
+            unsigned int unSize = 0;
+            if (m_bCompression)
+            {
+                bool bFinished = CUploadUtils::GetCompressedStreamingEventsFromDB(
+                                strLogStr, rstrTable, m_unMaxEventUploadCnt,
+                                &vecRowIDs, pLane->m_gzipStream);
+                if (!vecRowIDs.empty() && !bFinished)
+                {
+                    HCPLOG_E << "Compression Error!";
+                    break;
+                }
+                pvPayload = pLane->m_gzipStream.GetData();
+                unSize = pLane->m_gzipStream.GetSize();
+            }
+            else
+            {
+                CUploadUtils::GetStreamingEventsFromDB(strLogStr, rstrTable,
+                                m_unMaxEventUploadCnt, &vecRowIDs, strEvents);
+                pvPayload = strEvents.data();
+                unSize = strEvents.size();
+            }
+            if (vecRowIDs.empty())
+            {
+                break;
+            }
+            bMore = (vecRowIDs.size() == m_unMaxEventUploadCnt);
+
+            HCPLOG_I << "events selected for Upload:" << vecRowIDs.size();
+            int nMid = 0;
+            int nErr = PublishOnLane(*pLane, *pScheduler, pvPayload, unSize, "",
+                                     nMid);
+            if (!VerifyPostPublish(nMid, nErr, vecRowIDs))
+            {
+                break;
+            }
+        }
+    }
+}
+
+int CMQTTUploader::PublishOnLane(LaneContext &rLane,
+                                 CUploadLaneScheduler &rScheduler,
+                                 const void *pvPayload, unsigned int unSize,
+                                 const std::string &rstrTopic, int &rnMid)
+{
+    // wait for the inflight budget of the lane, then for its share of the link
+    while (!rLane.m_window.Acquire(PUBLISH_WINDOW_WAIT_TIME))
+    {
+        if (m_bShutdownRequested || !m_pMqClient->IsConnected())
+        {
+            return -1;
+        }
+    }
+    if (!rScheduler.Acquire(rLane.m_unIndex, unSize))
+    {
+        rLane.m_window.Cancel();
+        return -1;
+    }
+
+    int nErr = -1;
+    bool bSlotAcquired = AcquirePublishSlot();
+    if (bSlotAcquired)
+    {
+        const std::string &rstrSuffix = m_bCompression ?
+                                        m_strDictionaryTopicSuffix : "";
+        if (rstrTopic.empty())
+        {
+            nErr = m_pMqClient->PublishEvents(&rnMid, pvPayload, unSize, "",
+                                              rstrSuffix);
+        }
+        else
+        {
+            nErr = m_pMqClient->PublishEventsOnTopic(&rnMid, pvPayload, unSize,
+                                                     rstrTopic + rstrSuffix);
+        }
+    }
+
+    // the publish is recorded before the next lane gets its turn
+    if (!nErr && (rnMid > 0))
+    {
+        m_publishWindow.OnPublished(rnMid);
+
+        std::lock_guard<std::mutex> lock(m_LaneMutex);
+        if (m_setEarlyLaneAcks.erase(rnMid) == 0)
+        {
+            m_mapLaneMids[rnMid] = &rLane.m_window;
+            rLane.m_window.OnPublished(rnMid);
+        }
+        else
+        {
+            rLane.m_window.Cancel();
+        }
+    }
+    else
+    {
+        if (bSlotAcquired)
+        {
+            m_publishWindow.Cancel();
+        }
+        rLane.m_window.Cancel();
+    }
+    rScheduler.Release();
+    return nErr;
+}
+
 int CMQTTUploader::StartMQTTUpload()
 {
     int nRetValue = -1;
@@ -973,6 +1914,15 @@ void CMQTTUploader::NotifyShutdown()
 {
     HCPLOG_D << "Shutdown Request Recieved for CMQTTUploader";
     m_bShutdownRequested = true;
+
+    // release the lanes waiting for their turn on the link
+    {
+        std::lock_guard<std::mutex> lock(m_LaneMutex);
+        if (m_pLaneScheduler)
+        {
+            m_pLaneScheduler->Close();
+        }
+    }
     /* Postpone upload a bit to let all the pending events make it to the DB 
      * before shutdown
      */
@@ -1051,6 +2001,15 @@ void CMQTTUploader::NotifyConfigUpdate()
     }
 
     InitEventsUploadCnt();
+
+    // reloaded by the uploader thread, see RefreshCompressionDictionary()
+    m_bDictionaryConfigUpdated = true;
+
+    InitUploadPrefetch();
+
+    InitPublishWindow();
+
+    InitUploadLanes();
 }
 
 bool CMQTTUploader::ResetEventUploaderLogCounter()
@@ -30,14 +30,21 @@
 
 #include "CIgniteThread.h"
 #include "CConcurrentQueue.h"
+#include "CIgniteGZip.h"
 #include <string.h>
 #include <CIgniteMutex.h>
 #include <set>
 #include <map>
+#include <deque>
+#include <memory>
+#include <thread>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include "IOnOffNotificationReceiver.h"
 #include "CMidHandler.h"
+#include "CPublishWindow.h"
+#include "CUploadLaneScheduler.h"
 #include "CIgniteConfig.h"
 #include "net/CIgniteMQTTClient.h"
 
@@ -134,6 +141,22 @@ public:
      */
     bool ResetEventUploaderLogCounter();
 
+    /**
+     * Method to notify the PUBACK of a published message, making room in the
+     * events publish window
+     * @param[in] nMid Message Id received in the PUBACK
+     * @return void
+     */
+    void NotifyPublishAck(int nMid);
+
+    /**
+     * Method to notify the loss of the MQTT connection, resetting the events
+     * publish window
+     * @param void
+     * @return void
+     */
+    void NotifyConnectionLost();
+
     /**
      * Method to get the component related status
      * @param void
@@ -205,6 +228,61 @@ private:
         virtual void Run();
     };
 
+    /**
+     * Structure holding an events batch prepared by the prefetch stage of
+     * the pipelined upload, ready to be published
+     */
+    struct PrefetchedBatch
+    {
+        //! Row IDs of the events in the batch, reserved in the event store
+        std::vector<long long> m_vecRowIDs;
+
+        //! Payload to publish, compressed if compression is enabled
+        std::string m_strPayload;
+
+        //! Events details of the batch for upload logging
+        std::string m_strLog;
+    };
+
+    /**
+     * Structure holding the configuration of an events upload lane
+     */
+    struct UploadLane
+    {
+        //! Name of the lane for logging
+        std::string m_strName;
+
+        //! Flag indicating the lane uploads topiced events
+        bool m_bTopiced;
+
+        //! Selection of the topics uploaded by a topiced lane
+        std::string m_strTopicSelection;
+
+        //! Share of the link granted to the lane
+        unsigned int m_unShare;
+
+        //! Maximum number of payloads of the lane awaiting a PUBACK
+        unsigned int m_unInflight;
+    };
+
+    /**
+     * Structure holding the state of an upload lane while it runs
+     */
+    struct LaneContext
+    {
+        //! Configuration of the lane
+        UploadLane m_config;
+
+        //! Index of the lane in the lane scheduler
+        unsigned int m_unIndex;
+
+        //! Window bounding the payloads of the lane awaiting a PUBACK
+        CPublishWindow m_window;
+
+        //! Member variable to compress the payloads of the lane
+        ic_utils::CGzipStream m_gzipStream;
+    };
+
     /**
      * Default constructor
      */
@@ -243,6 +321,74 @@ private:
      */
     int UploadEvents(void);
 
+    /**
+     * Method to upload the events over MQTT, with the next batches queried,
+     * decrypted and compressed by a prefetch thread while the current batch
+     * is published
+     * @param void
+     * @return 0 on success , non-zero otherwise
+     */
+    int UploadEventsPipelined(void);
+
+    /**
+     * Prefetch thread of the pipelined upload, preparing batches into
+     * m_dqPrefetchedBatches until the events store is drained or the
+     * prefetch is stopped
+     * @param void
+     * @return void
+     */
+    void PrefetchEvents(void);
+
+    /**
+     * Method to clear the reservation of the prefetched batches not
+     * published, so that the next upload reads their events again
+     * @param void
+     * @return void
+     */
+    void ReleasePrefetchedBatches(void);
+
+    /**
+     * Method to read the next events batch of the pipelined upload from the
+     * database and to reserve its rows so that they are not read again
+     * @param[out] rBatch Batch prepared for publishing
+     * @return true if the batch is ready to publish, false otherwise
+     */
+    bool FetchEventBatch(PrefetchedBatch &rBatch);
+
+    /**
+     * Method to upload the events over parallel lanes, one per configured
+     * topic or stream class, sharing the link as configured by
+     * MQTT.uploadLanes
+     * @param void
+     * @return 0 on success , non-zero otherwise
+     */
+    int UploadEventLanes(void);
+
+    /**
+     * Thread of an upload lane, uploading the events of the lane until none
+     * is left or the upload fails
+     * @param[in] pLane Lane to upload
+     * @param[in] pScheduler Scheduler sharing the link between the lanes
+     * @return void
+     */
+    void RunUploadLane(LaneContext *pLane, CUploadLaneScheduler *pScheduler);
+
+    /**
+     * Method to publish a payload of an upload lane, within the inflight
+     * budget and the link share of the lane
+     * @param[in] rLane Lane publishing the payload
+     * @param[in] rScheduler Scheduler sharing the link between the lanes
+     * @param[in] pvPayload Payload to publish
+     * @param[in] unSize Size of the payload
+     * @param[in] rstrTopic Topic of a topiced payload, empty for the events
+     *            topic
+     * @param[out] rnMid Mid of the published payload
+     * @return 0 on success , non-zero otherwise
+     */
+    int PublishOnLane(LaneContext &rLane, CUploadLaneScheduler &rScheduler,
+                      const void *pvPayload, unsigned int unSize,
+                      const std::string &rstrTopic, int &rnMid);
+
     /**
      * Method to upload the alerts over MQTT
      * @param void
@@ -331,6 +477,74 @@ private:
      */
     void InitEventsUploadCnt();
 
+    /**
+     * Method to load the preset compression dictionary configured by
+     * MQTT.compressionDictionary from the dictionary file into m_gzipStream;
+     * a download from MQTT.compressionDictionaryUrl is left pending if the
+     * file does not hold the dictionary of MQTT.compressionDictionaryId
+     * @param void
+     * @return true if the configured dictionary is in use, false otherwise
+     */
+    bool LoadCompressionDictionary();
+
+    /**
+     * Method to set the preset compression dictionary of the payloads
+     * @param[in] rstrData Dictionary data, empty to compress without
+     * @return true if the dictionary is in use, false otherwise
+     */
+    bool UseCompressionDictionary(const std::string &rstrData);
+
+    /**
+     * Method run by the uploader thread before uploading events to reload
+     * the compression dictionary on configuration change and to download a
+     * pending one, retried with a growing delay while it fails
+     * @param void
+     * @return void
+     */
+    void RefreshCompressionDictionary();
+
+    /**
+     * Method to download the preset compression dictionary and to keep it in
+     * the dictionary file
+     * @param[in] rstrUrl Url distributing the dictionary
+     * @param[in] rstrPath Path of the dictionary file
+     * @param[out] rDictionary Downloaded dictionary
+     * @return true if a valid dictionary is downloaded, false otherwise
+     */
+    bool FetchCompressionDictionary(const std::string &rstrUrl,
+                                    const std::string &rstrPath,
+                                    ic_utils::CGzipDictionary &rDictionary);
+
+    /**
+     * Method to initialize the prefetch depth and memory bound of the
+     * pipelined events upload based on configuration
+     * @param void
+     * @return void
+     */
+    void InitUploadPrefetch();
+
+    /**
+     * Method to configure the events publish window based on configuration
+     * @param void
+     * @return void
+     */
+    void InitPublishWindow();
+
+    /**
+     * Method to wait for room in the events publish window
+     * @param void
+     * @return true if an event payload can be published, false if the
+     *         upload is to be stopped
+     */
+    bool AcquirePublishSlot();
+
+    /**
+     * Method to initialize the events upload lanes based on configuration
+     * @param void
+     * @return void
+     */
+    void InitUploadLanes();
+
     /**
      * Method to set upload event log count value
      * @param[in] rnCnt upload event log count value
@@ -385,7 +599,9 @@ private:
      * @param[out] rnMid mid value returned after publishing events.
      * @param[out] rnErr sets value to 0 if publish method is success else
      *                    sets the error code returned after publishing events.
-     * @param[in] rstrEvents events payload received to publish to cloud. .
+     * @param[in] rstrEvents events payload received to publish to cloud; with
+     *                    compression enabled, the payload already compressed
+     *                    into m_gzipStream is published instead.
      * @return true if publishing events over events topic is success
      *         else return false
      */
@@ -418,6 +634,78 @@ private:
     //! Member variable to indicate if the compression of MQTT payload is enabled
     const bool m_bCompression;
 
+    //! Member variable to compress MQTT payloads, reused across publishes
+    ic_utils::CGzipStream m_gzipStream;
+
+    /* Member variable advertising the id of the compression dictionary in use
+     * by the topic suffix "/dict/<id>"; empty without dictionary
+     */
+    std::string m_strDictionaryTopicSuffix;
+
+    //! Publish window bounding the event payloads awaiting a PUBACK
+    CPublishWindow m_publishWindow;
+
+    //! Preset compression dictionary, empty if none is used
+    std::string m_strDictionary;
+
+    //! Dictionary configuration m_strDictionary was loaded from
+    std::string m_strDictionaryConfig;
+
+    //! Flag indicating the configured dictionary has to be downloaded
+    bool m_bDictionaryPending;
+
+    //! Flag indicating the configuration changed since the dictionary load
+    std::atomic<bool> m_bDictionaryConfigUpdated;
+
+    //! Time of the next dictionary download attempt
+    time_t m_tDictionaryRetry;
+
+    //! Delay in seconds before the next dictionary download retry
+    time_t m_tDictionaryBackoff;
+
+    //! Configured events upload lanes, empty if lanes are not used
+    std::vector<UploadLane> m_vecUploadLanes;
+
+    //! Map of the MIDs awaiting a PUBACK to the window of their lane
+    std::map<int, CPublishWindow*> m_mapLaneMids;
+
+    //! MIDs acknowledged before being mapped to their lane, kept only while
+    //! the upload lanes are running
+    std::set<int> m_setEarlyLaneAcks;
+
+    //! Mutex guarding the upload lanes configuration and MIDs
+    std::mutex m_LaneMutex;
+
+    //! Scheduler of the running lanes upload, NULL if none is running
+    CUploadLaneScheduler *m_pLaneScheduler;
+
+    //! Member variable to compress batches prepared by the prefetch thread
+    ic_utils::CGzipStream m_prefetchGzipStream;
+
+    //! Number of events batches prepared ahead of the one being published
+    unsigned int m_unPrefetchDepth;
+
+    //! Maximum size in bytes of the payloads of the prefetched batches
+    unsigned int m_unPrefetchMaxBytes;
+
+    //! Batches prepared by the prefetch thread, in upload order
+    std::deque<PrefetchedBatch> m_dqPrefetchedBatches;
+
+    //! Size in bytes of the payloads held in m_dqPrefetchedBatches
+    size_t m_unPrefetchedBytes;
+
+    //! Flag set by the prefetch thread once it prepares no more batches
+    bool m_bPrefetchDone;
+
+    //! Flag requesting the prefetch thread to stop
+    bool m_bStopPrefetch;
+
+    //! Mutex guarding the prefetch queue and flags
+    std::mutex m_PrefetchMutex;
+
+    //! Condition signalled on changes of the prefetch queue and flags
+    std::condition_variable m_PrefetchCondition;
+
     //! Member variable for event wait condition
     ic_utils::CThreadCondition m_EventWaitCondition;
 
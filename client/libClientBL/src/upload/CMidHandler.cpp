@@ -17,6 +17,7 @@
  ******************************************************************************/
 
 #include "CMidHandler.h"
+#include "CIgniteConfig.h"
 
 #ifdef PREFIX
 #undef PREFIX
@@ -26,17 +27,39 @@
 namespace ic_bl
 {
 
+namespace
+{
+// Config key for the time over which acknowledged MIDs are collected
+static const std::string KEY_ACK_BATCH_WINDOW = "MQTT.ackBatchWindowMs";
+
+// Default time in milliseconds over which acknowledged MIDs are collected
+static const int DEF_ACK_BATCH_WINDOW = 50;
+}
+
 /**
- * Method to delete events from table which are marked against given mid
+ * Method to delete events from table which are marked against given mids,
+ * all mids being cleared in a single transaction
  * @param[in] strTable Table name from which the events needs to be deleted
- * @param[in] nMid Message Id
+ * @param[in] rvecMids Message Ids
  * @return True if deletion is successful and false otherwise
  */
-bool delete_events_from_db(const std::string strTable, int nMid)
+bool delete_events_from_db(const std::string strTable,
+                           const std::vector<long long> &rvecMids)
 {
-    std::string strSelection = ic_core::CDataBaseConst::COL_MID + " == " +
-                                ic_utils::CIgniteStringUtils::NumberToString(nMid);
     ic_core::CDataBaseFacade *pDb = ic_core::CDataBaseFacade::GetInstance();
+
+    /*
+     * The ID set is shared by all users of the connection and only the
+     * transaction lock keeps it from being refilled before it is matched
+     */
+    if (!pDb->StartTransaction())
+    {
+        HCPLOG_E << "Failed to start transaction on " << strTable;
+        return false;
+    }
+
+    // the mids are bound to a temporary ID set, matched by prepared statements
+    bool bResult = pDb->BindIdSet(rvecMids);
     if (strTable == ic_core::CDataBaseConst::TABLE_EVENT_STORE &&
         ic_core::CUploadMode::GetInstance()->IsBatchModeSupported())
     {
@@ -44,25 +67,25 @@ bool delete_events_from_db(const std::string strTable, int nMid)
         //       From 1st deletion quiry, topiced events will get deleted.
 
         // delete events which already uploaded or not supported by batch mode
-        bool bTransactionStarted = pDb->StartTransaction();
-        std::string strDeleteSelection(strSelection);
-        strDeleteSelection += " AND " + ic_core::CDataBaseConst::COL_BATCH_SUPPORT +
-                                " == 0";
-        bool bResult = pDb->Remove(strTable, strDeleteSelection);
+        bResult = bResult && pDb->RemoveByIdSet(strTable,
+                                ic_core::CDataBaseConst::COL_MID,
+                                ic_core::CDataBaseConst::COL_BATCH_SUPPORT +
+                                " == 0");
 
         // mark remaining events as uploaded
         ic_core::CContentValues data;
         data.Put(ic_core::CDataBaseConst::COL_STREAM_SUPPORT, 0);
-        bResult = bResult && pDb->Update(strTable, &data, strSelection);
-
-        if (bTransactionStarted)
-        {
-            pDb->EndTransaction(true);
-        }
-        return bResult;
+        bResult = bResult && pDb->UpdateByIdSet(strTable, &data,
+                                            ic_core::CDataBaseConst::COL_MID);
     }
     else
-        return pDb->Remove(strTable, strSelection);
+    {
+        bResult = bResult && pDb->RemoveByIdSet(strTable,
+                                            ic_core::CDataBaseConst::COL_MID);
+    }
+
+    pDb->EndTransaction(bResult);
+    return bResult;
 }
 
 
@@ -110,13 +133,16 @@ bool CMidHandler::InitMid()
     HCPLOG_D <<"Reset Mid value for all events/alerts to default";
     ic_core::CContentValues data;
     data.Put(ic_core::CDataBaseConst::COL_MID, 0);
+    std::vector<std::string> vecSelectionArgs(1, "0");
     ic_core::CDataBaseFacade *pDb = ic_core::CDataBaseFacade::GetInstance();
     bool bRetAlertMid = pDb->Update(ic_core::CDataBaseConst::TABLE_ALERT_STORE,
                                     &data,
-                                    ic_core::CDataBaseConst::COL_MID + "!=0");
+                                    ic_core::CDataBaseConst::COL_MID + "!=?",
+                                    vecSelectionArgs);
     bool bRetEventMid = pDb->Update(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
                                     &data,
-                                    ic_core::CDataBaseConst::COL_MID + "!=0");
+                                    ic_core::CDataBaseConst::COL_MID + "!=?",
+                                    vecSelectionArgs);
     HCPLOG_C << "initMid done. bRetAlertMid: " << bRetAlertMid 
              << ", bRetEventMid: " << bRetEventMid;
 
@@ -194,16 +220,35 @@ void CMidHandler::Run()
     //Register to get the Shutdown Notification
     ic_core::CIgniteClient::GetOnOffMonitor()->RegisterForShutdownNotification(
                                         this,ic_core::IOnOff::eR_MID_HANDLER);
+    int nAckBatchWindow = ic_core::CIgniteConfig::GetInstance()->GetInt(
+                                KEY_ACK_BATCH_WINDOW, DEF_ACK_BATCH_WINDOW);
     while(true)
     {
-        MidTable* pMt;
-        while (m_queMidTobeDeleted.Take(&pMt))
+        std::map<std::string, std::vector<long long>> mapTableMids;
+        if (CollectMids(mapTableMids) && (nAckBatchWindow > 0) &&
+            !m_bShutdownInitiated)
+        {
+            /* let the acks received meanwhile join this batch, a reconnect
+             * typically completes hundreds of mids at once
+             */
+            std::this_thread::sleep_for(
+                                std::chrono::milliseconds(nAckBatchWindow));
+            CollectMids(mapTableMids);
+        }
+
+        std::map<std::string, std::vector<long long>>::iterator iterTable =
+                                                        mapTableMids.begin();
+        for (; iterTable != mapTableMids.end(); iterTable++)
         {
             //as discussed logLevel changed to debug
-            HCPLOG_D << "Deleting events for mid:" << pMt->m_nMid
-                     << " from table:" << pMt->m_strTable;
-            delete_events_from_db(pMt->m_strTable, pMt->m_nMid);
-            delete pMt;
+            HCPLOG_D << "Deleting events for " << iterTable->second.size()
+                     << " mids from table:" << iterTable->first;
+            if (!delete_events_from_db(iterTable->first, iterTable->second))
+            {
+                HCPLOG_E << "Failed to delete events for "
+                         << iterTable->second.size() << " mids from table:"
+                         << iterTable->first;
+            }
         }
 
         if(m_bShutdownInitiated)
@@ -223,6 +268,20 @@ void CMidHandler::Run()
     Detach();
 }
 
+bool CMidHandler::CollectMids(
+            std::map<std::string, std::vector<long long>> &rmapTableMids)
+{
+    bool bCollected = false;
+    MidTable* pMt;
+    while (m_queMidTobeDeleted.Take(&pMt))
+    {
+        rmapTableMids[pMt->m_strTable].push_back(pMt->m_nMid);
+        delete pMt;
+        bCollected = true;
+    }
+    return bCollected;
+}
+
 void CMidHandler::NotifyShutdown()
 {
     HCPLOG_D << "Shutdown Request Recieved for CMidHandler";
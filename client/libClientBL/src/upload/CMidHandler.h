@@ -37,6 +37,9 @@
 #include <CIgniteMutex.h>
 #include <set>
 #include <map>
+#include <vector>
+#include <thread>
+#include <chrono>
 #include "IOnOffNotificationReceiver.h"
 #include "db/CDataBaseFacade.h"
 
@@ -127,6 +130,15 @@ private:
      */
     bool ClearMid(int nMid,std::string strTable);
 
+    /**
+     * Method to take the MIDs queued for clearing, grouped by table
+     * @param[in/out] rmapTableMids Map of table name to the MIDs to be
+     *                cleared from it, the MIDs taken are appended
+     * @return True if any MID is taken, false otherwise
+     */
+    bool CollectMids(
+            std::map<std::string, std::vector<long long>> &rmapTableMids);
+
     //! Member variable to indicate if shutdown is intitated
     bool m_bShutdownInitiated = false;
 
@@ -0,0 +1,323 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <algorithm>
+#include "CPublishWindow.h"
+#include "CIgniteLog.h"
+
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "CPublishWindow"
+
+namespace ic_bl
+{
+
+namespace
+{
+// Weight of a new sample in the smoothed ack latency
+static const double LATENCY_GAIN = 0.125;
+
+/* Factor over the lowest ack latency above which acks are considered
+ * delayed by queueing in the link or the broker
+ */
+static const double LATENCY_QUEUEING_FACTOR = 2.0;
+
+// Ack latency in milliseconds below which the latency is not considered
+static const double LATENCY_NOISE_MS = 10.0;
+
+// Maximum number of acks kept for MIDs not yet started
+static const size_t MAX_EARLY_ACKS = 256;
+}
+
+CPublishWindow::CPublishWindow() : m_unInitialSize(0), m_unMaxSize(0),
+                                   m_unAckTimeoutMs(0), m_dSize(0),
+                                   m_dSmoothedLatencyMs(0), m_dMinLatencyMs(0),
+                                   m_ullRetransmits(0), m_unPublishing(0)
+{
+}
+
+CPublishWindow::~CPublishWindow()
+{
+}
+
+void CPublishWindow::Configure(unsigned int unInitialSize,
+                               unsigned int unMaxSize,
+                               unsigned int unAckTimeoutMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        unsigned int unPrevInitialSize = m_unInitialSize;
+        m_unMaxSize = std::max(1u, unMaxSize);
+        m_unInitialSize = std::min(unInitialSize, m_unMaxSize);
+        m_unAckTimeoutMs = unAckTimeoutMs;
+
+        // keep the adapted size and the running timers on reconfiguration
+        if ((0 == m_unInitialSize) || (unPrevInitialSize != m_unInitialSize))
+        {
+            m_dSize = m_unInitialSize;
+        }
+        m_dSize = std::min((double)m_unMaxSize, m_dSize);
+        if (0 == m_unInitialSize)
+        {
+            m_mapInflight.clear();
+            m_setStale.clear();
+            m_unPublishing = 0;
+            m_setEarlyAcks.clear();
+        }
+    }
+    m_Condition.notify_all();
+}
+
+bool CPublishWindow::Acquire(unsigned int unWaitMs)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    Clock::time_point deadline = Clock::now() +
+                                 std::chrono::milliseconds(unWaitMs);
+    while ((0 != m_unInitialSize) &&
+           (GetUsedLocked() >= (unsigned int)m_dSize))
+    {
+        Clock::time_point now = Clock::now();
+        if (ExpireLocked(now) > 0)
+        {
+            continue;
+        }
+        if (now >= deadline)
+        {
+            return false;
+        }
+
+        // wake up on an ack, the deadline or the expiry of the oldest timer
+        Clock::time_point wakeup = deadline;
+        for (const auto &rInflight : m_mapInflight)
+        {
+            wakeup = std::min(wakeup, rInflight.second +
+                              std::chrono::milliseconds(m_unAckTimeoutMs));
+        }
+        m_Condition.wait_until(lock, wakeup);
+    }
+
+    if (0 != m_unInitialSize)
+    {
+        m_unPublishing++;
+    }
+    return true;
+}
+
+void CPublishWindow::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (0 == m_unPublishing)
+        {
+            return;
+        }
+
+        // acks kept for publishes in progress belong to none once all are done
+        if (0 == --m_unPublishing)
+        {
+            m_setEarlyAcks.clear();
+        }
+    }
+    m_Condition.notify_all();
+}
+
+void CPublishWindow::OnPublished(int nMid)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (0 == m_unInitialSize)
+    {
+        return;
+    }
+
+    // the PUBACK may be received before the publish call returns
+    if (m_setEarlyAcks.erase(nMid) == 0)
+    {
+        m_mapInflight[nMid] = Clock::now();
+    }
+
+    if ((m_unPublishing > 0) && (0 == --m_unPublishing))
+    {
+        m_setEarlyAcks.clear();
+    }
+}
+
+bool CPublishWindow::OnAcked(int nMid)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (0 == m_unInitialSize)
+        {
+            return false;
+        }
+
+        std::map<int, Clock::time_point>::iterator iterInflight =
+                                                    m_mapInflight.find(nMid);
+        if (iterInflight != m_mapInflight.end())
+        {
+            std::chrono::duration<double, std::milli> latency =
+                                        Clock::now() - iterInflight->second;
+            m_mapInflight.erase(iterInflight);
+            AdaptToLatency(latency.count());
+        }
+        else if (m_setStale.erase(nMid) == 0)
+        {
+            /* an ack of a MID not published through the window, e.g. an
+             * alert, is only kept while a window publish may be its origin
+             */
+            if (m_unPublishing > 0)
+            {
+                if (m_setEarlyAcks.size() >= MAX_EARLY_ACKS)
+                {
+                    m_setEarlyAcks.clear();
+                }
+                m_setEarlyAcks.insert(nMid);
+            }
+            return false;
+        }
+    }
+    m_Condition.notify_all();
+    return true;
+}
+
+unsigned int CPublishWindow::ExpireTimedOut()
+{
+    unsigned int unExpired = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        unExpired = ExpireLocked(Clock::now());
+    }
+    if (unExpired > 0)
+    {
+        m_Condition.notify_all();
+    }
+    return unExpired;
+}
+
+unsigned int CPublishWindow::ExpireLocked(const Clock::time_point &now)
+{
+    unsigned int unExpired = 0;
+    std::map<int, Clock::time_point>::iterator iterInflight =
+                                                        m_mapInflight.begin();
+    while (iterInflight != m_mapInflight.end())
+    {
+        if (now - iterInflight->second >=
+            std::chrono::milliseconds(m_unAckTimeoutMs))
+        {
+            HCPLOG_W << "No PUBACK for mid " << iterInflight->first
+                     << " within " << m_unAckTimeoutMs << "ms";
+            m_setStale.insert(iterInflight->first);
+            iterInflight = m_mapInflight.erase(iterInflight);
+            unExpired++;
+        }
+        else
+        {
+            iterInflight++;
+        }
+    }
+
+    /* the expired messages are retransmitted by the MQTT client, or read
+     * again from the database once the connection is reset; until then they
+     * keep their place in the window, only the window size is reduced
+     */
+    if (unExpired > 0)
+    {
+        m_ullRetransmits += unExpired;
+        m_dSize = std::max(1.0, m_dSize / 2);
+        HCPLOG_W << "Publish window reduced to " << (unsigned int)m_dSize
+                 << ", retransmits: " << m_ullRetransmits;
+    }
+    return unExpired;
+}
+
+size_t CPublishWindow::GetUsedLocked() const
+{
+    return m_mapInflight.size() + m_setStale.size() + m_unPublishing;
+}
+
+void CPublishWindow::AdaptToLatency(double dLatencyMs)
+{
+    if ((0 == m_dMinLatencyMs) || (dLatencyMs < m_dMinLatencyMs))
+    {
+        m_dMinLatencyMs = dLatencyMs;
+    }
+    m_dSmoothedLatencyMs = (0 == m_dSmoothedLatencyMs) ? dLatencyMs :
+        m_dSmoothedLatencyMs + LATENCY_GAIN * (dLatencyMs - m_dSmoothedLatencyMs);
+
+    if ((m_dSmoothedLatencyMs <= LATENCY_NOISE_MS) ||
+        (m_dSmoothedLatencyMs <= LATENCY_QUEUEING_FACTOR * m_dMinLatencyMs))
+    {
+        m_dSize = std::min((double)m_unMaxSize, m_dSize + 1 / m_dSize);
+    }
+    else
+    {
+        m_dSize = std::max(1.0, m_dSize - 1 / m_dSize);
+    }
+}
+
+void CPublishWindow::Reset()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_mapInflight.empty())
+        {
+            m_ullRetransmits += m_mapInflight.size();
+            HCPLOG_C << "Publish window reset with " << m_mapInflight.size()
+                     << " mids pending, retransmits: " << m_ullRetransmits;
+        }
+        m_dSize = m_unInitialSize;
+        m_dSmoothedLatencyMs = 0;
+        m_dMinLatencyMs = 0;
+        m_mapInflight.clear();
+        m_setStale.clear();
+        m_setEarlyAcks.clear();
+    }
+    m_Condition.notify_all();
+}
+
+bool CPublishWindow::IsEnabled()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return (0 != m_unInitialSize);
+}
+
+unsigned int CPublishWindow::GetSize()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return (unsigned int)m_dSize;
+}
+
+unsigned int CPublishWindow::GetInflightCount()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_mapInflight.size() + m_setStale.size();
+}
+
+unsigned long long CPublishWindow::GetRetransmitCount()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_ullRetransmits;
+}
+
+unsigned int CPublishWindow::GetAckLatencyMs()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return (unsigned int)m_dSmoothedLatencyMs;
+}
+
+} // namespace ic_bl
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+********************************************************************************
+* \file CPublishWindow.h
+*
+* \brief This class provides a publish window keyed on the MID of published
+* messages, bounding the messages awaiting a PUBACK from the broker
+********************************************************************************
+*/
+
+#ifndef CPUBLISH_WINDOW_H
+#define CPUBLISH_WINDOW_H
+
+#include <map>
+#include <set>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+namespace ic_bl
+{
+
+/**
+ * Class bounding the number of published messages awaiting a PUBACK. Every
+ * published MID runs a timer until its acknowledgement; the window grows by
+ * one message per window of acks while the ack latency stays close to the
+ * lowest one observed, shrinks as the latency builds up and halves when an
+ * ack times out. A MID whose ack timed out is still held by the MQTT client,
+ * so it keeps its place in the window until its ack or a connection reset.
+ */
+class CPublishWindow
+{
+public:
+    /**
+     * Default constructor, the window is disabled until configured
+     */
+    CPublishWindow();
+
+    /**
+     * Destructor
+     */
+    ~CPublishWindow();
+
+    /**
+     * Method to configure the window
+     * @param[in] unInitialSize Initial window size, 0 disables the window
+     * @param[in] unMaxSize Maximum window size
+     * @param[in] unAckTimeoutMs Time in milliseconds after which a MID not
+     *            acknowledged is accounted as a retransmission
+     * @return void
+     */
+    void Configure(unsigned int unInitialSize, unsigned int unMaxSize,
+                   unsigned int unAckTimeoutMs);
+
+    /**
+     * Method to wait until the window has room for one more message. The room
+     * is held until OnPublished() or Cancel() is called.
+     * @param[in] unWaitMs Maximum time in milliseconds to wait
+     * @return true if a message can be published, false on timeout
+     */
+    bool Acquire(unsigned int unWaitMs);
+
+    /**
+     * Method to give back the room taken by Acquire() when no message has
+     * been published
+     * @param void
+     * @return void
+     */
+    void Cancel();
+
+    /**
+     * Method to start the ack timer of a message published after Acquire()
+     * @param[in] nMid Message Id of the published message
+     * @return void
+     */
+    void OnPublished(int nMid);
+
+    /**
+     * Method to stop the ack timer of an acknowledged message. An unknown MID
+     * is kept for OnPublished() only while a publish is in progress.
+     * @param[in] nMid Message Id received in the PUBACK
+     * @return true if the MID was awaiting its ack, false otherwise
+     */
+    bool OnAcked(int nMid);
+
+    /**
+     * Method to expire the ack timers running longer than the ack timeout;
+     * the expired MIDs stay in flight
+     * @param void
+     * @return Number of MIDs expired
+     */
+    unsigned int ExpireTimedOut();
+
+    /**
+     * Method to reset the window when the connection is lost; messages
+     * awaiting their ack are accounted as retransmissions and expired MIDs
+     * are released
+     * @param void
+     * @return void
+     */
+    void Reset();
+
+    /**
+     * Method to check if the window is enabled
+     * @param void
+     * @return true if enabled, false otherwise
+     */
+    bool IsEnabled();
+
+    /**
+     * Method to get the current window size
+     * @param void
+     * @return Window size in messages
+     */
+    unsigned int GetSize();
+
+    /**
+     * Method to get the number of messages awaiting their ack
+     * @param void
+     * @return Number of messages in flight
+     */
+    unsigned int GetInflightCount();
+
+    /**
+     * Method to get the number of messages accounted as retransmissions
+     * @param void
+     * @return Number of retransmissions
+     */
+    unsigned long long GetRetransmitCount();
+
+    /**
+     * Method to get the smoothed ack latency
+     * @param void
+     * @return Ack latency in milliseconds, 0 if no ack has been received
+     */
+    unsigned int GetAckLatencyMs();
+
+private:
+    //! Alias of the clock timing the acks
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * Method to expire the ack timers, with m_Mutex held
+     * @param[in] now Current time
+     * @return Number of MIDs expired
+     */
+    unsigned int ExpireLocked(const Clock::time_point &now);
+
+    /**
+     * Method to get the number of messages taking room in the window, with
+     * m_Mutex held
+     * @param void
+     * @return Number of messages awaiting their ack or being published
+     */
+    size_t GetUsedLocked() const;
+
+    /**
+     * Method to adapt the window size to the latency of an ack
+     * @param[in] dLatencyMs Ack latency in milliseconds
+     * @return void
+     */
+    void AdaptToLatency(double dLatencyMs);
+
+    //! Initial window size, 0 if the window is disabled
+    unsigned int m_unInitialSize;
+
+    //! Maximum window size
+    unsigned int m_unMaxSize;
+
+    //! Ack timeout in milliseconds
+    unsigned int m_unAckTimeoutMs;
+
+    //! Window size, fractional to grow by one message per window of acks
+    double m_dSize;
+
+    //! Smoothed ack latency in milliseconds
+    double m_dSmoothedLatencyMs;
+
+    //! Lowest ack latency observed in milliseconds
+    double m_dMinLatencyMs;
+
+    //! Number of messages accounted as retransmissions
+    unsigned long long m_ullRetransmits;
+
+    //! Start time of the ack timer of each MID awaiting its ack
+    std::map<int, Clock::time_point> m_mapInflight;
+
+    //! MIDs whose ack timed out, still held by the MQTT client
+    std::set<int> m_setStale;
+
+    //! Number of messages acquired and not yet published or cancelled
+    unsigned int m_unPublishing;
+
+    //! MIDs acknowledged before their timer was started
+    std::set<int> m_setEarlyAcks;
+
+    //! Mutex guarding the window state
+    std::mutex m_Mutex;
+
+    //! Condition signalled when room is made in the window
+    std::condition_variable m_Condition;
+};
+
+} // namespace ic_bl
+
+#endif // CPUBLISH_WINDOW_H
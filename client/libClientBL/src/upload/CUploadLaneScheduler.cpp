@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <algorithm>
+#include "CUploadLaneScheduler.h"
+
+namespace ic_bl
+{
+
+CUploadLaneScheduler::CUploadLaneScheduler() : m_dVirtualClock(0),
+                                               m_bBusy(false), m_bClosed(false)
+{
+}
+
+CUploadLaneScheduler::~CUploadLaneScheduler()
+{
+}
+
+unsigned int CUploadLaneScheduler::AddLane(unsigned int unShare)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Lane lane;
+    lane.m_unShare = std::max(1u, unShare);
+    lane.m_dVirtualTime = m_dVirtualClock;
+    lane.m_bWaiting = false;
+    lane.m_ullBytes = 0;
+    m_vecLanes.push_back(lane);
+    return m_vecLanes.size() - 1;
+}
+
+bool CUploadLaneScheduler::Acquire(unsigned int unLane, size_t unBytes)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (unLane >= m_vecLanes.size())
+    {
+        return false;
+    }
+
+    Lane &rLane = m_vecLanes[unLane];
+    rLane.m_dVirtualTime = std::max(rLane.m_dVirtualTime, m_dVirtualClock);
+    rLane.m_bWaiting = true;
+    m_Condition.wait(lock, [this, unLane] {
+        return m_bClosed || (!m_bBusy && IsNext(unLane));
+    });
+    rLane.m_bWaiting = false;
+
+    if (m_bClosed)
+    {
+        // let the next waiting lane see the scheduler closed too
+        m_Condition.notify_all();
+        return false;
+    }
+
+    m_bBusy = true;
+    m_dVirtualClock = rLane.m_dVirtualTime;
+    rLane.m_dVirtualTime += (double)unBytes / rLane.m_unShare;
+    rLane.m_ullBytes += unBytes;
+    return true;
+}
+
+void CUploadLaneScheduler::Release()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_bBusy = false;
+    }
+    m_Condition.notify_all();
+}
+
+void CUploadLaneScheduler::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_bClosed = true;
+    }
+    m_Condition.notify_all();
+}
+
+unsigned int CUploadLaneScheduler::GetWaitingCount()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    unsigned int unWaiting = 0;
+    for (size_t i = 0; i < m_vecLanes.size(); i++)
+    {
+        unWaiting += m_vecLanes[i].m_bWaiting ? 1 : 0;
+    }
+    return unWaiting;
+}
+
+unsigned long long CUploadLaneScheduler::GetBytes(unsigned int unLane)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return (unLane < m_vecLanes.size()) ? m_vecLanes[unLane].m_ullBytes : 0;
+}
+
+bool CUploadLaneScheduler::IsNext(unsigned int unLane)
+{
+    const Lane &rLane = m_vecLanes[unLane];
+    for (unsigned int i = 0; i < m_vecLanes.size(); i++)
+    {
+        const Lane &rOther = m_vecLanes[i];
+        if ((i != unLane) && rOther.m_bWaiting &&
+            ((rOther.m_dVirtualTime < rLane.m_dVirtualTime) ||
+             ((rOther.m_dVirtualTime == rLane.m_dVirtualTime) && (i < unLane))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ic_bl
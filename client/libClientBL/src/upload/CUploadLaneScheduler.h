@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+********************************************************************************
+* \file CUploadLaneScheduler.h
+*
+* \brief This class provides the sharing of the MQTT link between the upload
+* lanes, in proportion to their configured share
+********************************************************************************
+*/
+
+#ifndef CUPLOAD_LANE_SCHEDULER_H
+#define CUPLOAD_LANE_SCHEDULER_H
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+namespace ic_bl
+{
+
+/**
+ * Class granting the upload lanes their turn to publish. Each lane runs a
+ * virtual clock advanced by the bytes it publishes divided by its share;
+ * among the lanes waiting for their turn, the one with the earliest clock is
+ * granted first, so backlogged lanes get the link in proportion to their
+ * share. A lane joining the competition starts from the clock of the last
+ * granted lane, so that idle lanes do not build up credit.
+ */
+class CUploadLaneScheduler
+{
+public:
+    /**
+     * Default constructor
+     */
+    CUploadLaneScheduler();
+
+    /**
+     * Destructor
+     */
+    ~CUploadLaneScheduler();
+
+    /**
+     * Method to add a lane
+     * @param[in] unShare Share of the link granted to the lane, at least 1
+     * @return Index of the lane
+     */
+    unsigned int AddLane(unsigned int unShare);
+
+    /**
+     * Method to wait for the turn of a lane to publish; the turn is held
+     * until Release is called
+     * @param[in] unLane Index of the lane
+     * @param[in] unBytes Size of the payload to publish
+     * @return true if the turn is granted, false if the scheduler is closed
+     */
+    bool Acquire(unsigned int unLane, size_t unBytes);
+
+    /**
+     * Method to end the turn granted by Acquire
+     * @param void
+     * @return void
+     */
+    void Release();
+
+    /**
+     * Method to close the scheduler, failing the pending and further turns
+     * @param void
+     * @return void
+     */
+    void Close();
+
+    /**
+     * Method to get the number of lanes waiting for their turn
+     * @param void
+     * @return Number of waiting lanes
+     */
+    unsigned int GetWaitingCount();
+
+    /**
+     * Method to get the bytes published by a lane
+     * @param[in] unLane Index of the lane
+     * @return Bytes granted to the lane
+     */
+    unsigned long long GetBytes(unsigned int unLane);
+
+private:
+    /**
+     * Structure holding the scheduling state of a lane
+     */
+    struct Lane
+    {
+        //! Share of the link granted to the lane
+        unsigned int m_unShare;
+
+        //! Virtual clock of the lane
+        double m_dVirtualTime;
+
+        //! Flag set while the lane waits for its turn
+        bool m_bWaiting;
+
+        //! Bytes granted to the lane
+        unsigned long long m_ullBytes;
+    };
+
+    /**
+     * Method to check if a lane is the next to be granted, with m_Mutex held
+     * @param[in] unLane Index of the lane
+     * @return true if no waiting lane is ahead of it, false otherwise
+     */
+    bool IsNext(unsigned int unLane);
+
+    //! Scheduling state of the lanes
+    std::vector<Lane> m_vecLanes;
+
+    //! Virtual clock of the last granted lane
+    double m_dVirtualClock;
+
+    //! Flag set while a turn is held
+    bool m_bBusy;
+
+    //! Flag set once the scheduler is closed
+    bool m_bClosed;
+
+    //! Mutex guarding the scheduling state
+    std::mutex m_Mutex;
+
+    //! Condition signalled when a turn ends
+    std::condition_variable m_Condition;
+};
+
+} // namespace ic_bl
+
+#endif // CUPLOAD_LANE_SCHEDULER_H
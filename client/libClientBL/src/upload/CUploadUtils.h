@@ -39,6 +39,8 @@
 #include "CIgniteDateTime.h"
 #include "config/CUploadMode.h"
 #include "CIgniteFileUtils.h"
+#include "CIgniteGZip.h"
+#include "CCrc32.h"
 #include "db/CDataBaseFacade.h"
 #include "db/CLocalConfig.h"
 
@@ -124,6 +126,30 @@ static const std::string KEY_ATTACH_PATH = "DAM.Upload.CurlSender.fileAttachment
 //! Constant key for maxCPULoad
 static const std::string KEY_MAX_CPU_LOAD = "DAM.Upload.CPULoadConfig.maxCPULoad";
 
+//! Constant key for number of threads decrypting events of one upload
+static const std::string KEY_UPLOAD_CRYPTO_WORKERS = "DAM.Database.cryptoWorkers";
+
+//! Constant default number of threads decrypting events of one upload
+static const int DEF_UPLOAD_CRYPTO_WORKERS = 1;
+
+//! Constant for rows stored without checksum of the event payload
+static const long long NO_EVENT_CHECKSUM = -1;
+
+//! Constant key for the preset dictionary file used to compress uploads
+static const std::string KEY_COMPRESSION_DICTIONARY = "MQTT.compressionDictionary";
+
+//! Constant key for the url distributing the preset dictionary
+static const std::string KEY_COMPRESSION_DICTIONARY_URL = "MQTT.compressionDictionaryUrl";
+
+//! Constant key for the id of the preset dictionary distributed by the url
+static const std::string KEY_COMPRESSION_DICTIONARY_ID = "MQTT.compressionDictionaryId";
+
+//! Constant key for number of stored events sampled to train the dictionary
+static const std::string KEY_DICTIONARY_SAMPLE_SIZE = "MQTT.compressionDictionarySampleSize";
+
+//! Constant default number of stored events sampled to train the dictionary
+static const int DEF_DICTIONARY_SAMPLE_SIZE = 5000;
+
 //! Constant key for timeOutForCPULoad
 static const std::string KEY_CPU_LOAD_RETRY_TIME = "DAM.Upload.CPULoadConfig.timeOutForCPULoad";
 
@@ -373,9 +399,56 @@ public:
      */
     static std::string DecryptEventData(const std::string& rstrEventData)
     {
-        ic_core::CIgniteDataSecurity securityObject(ic_core::CKeyGenerator::GetActivationKey(),
-                           ic_core::CAesSeed::GetInstance()->GetIvRandom());
-        return securityObject.Decrypt(rstrEventData);
+        return ic_core::CIgniteDataSecurity::DecryptEvent(rstrEventData);
+    }
+
+    /**
+     * Method to decrypt the given encrypted events in place as one group
+     * @param[in/out] rvecEventData Encrypted events, replaced by decrypted
+     * event data
+     * @return void
+     */
+    static void DecryptEventsData(std::vector<std::string>& rvecEventData)
+    {
+        ic_core::CIgniteDataSecurity::DecryptEvents(rvecEventData,
+            ic_core::CIgniteConfig::GetInstance()->GetInt(KEY_UPLOAD_CRYPTO_WORKERS,
+                                                          DEF_UPLOAD_CRYPTO_WORKERS));
+    }
+
+    /**
+     * Method to check that a decrypted event payload is the one stored; rows
+     * with a checksum are validated by it, older rows by parsing the payload
+     * @param[in] rstrEventData decrypted event payload
+     * @param[in] llChecksum CRC32 of the payload stored with the row,
+     * NO_EVENT_CHECKSUM if none is stored
+     * @return true if the payload is valid, false otherwise
+     */
+    static bool IsValidEventData(const std::string& rstrEventData, long long llChecksum)
+    {
+        if (rstrEventData.empty())
+        {
+            return false;
+        }
+        if (NO_EVENT_CHECKSUM != llChecksum)
+        {
+            return (ic_event::CCrc32::Calculate(rstrEventData) == (unsigned int)llChecksum);
+        }
+
+        ic_utils::Json::Value jsonEvent;
+        ic_utils::Json::Reader jsonReader;
+        return jsonReader.parse(rstrEventData, jsonEvent);
+    }
+
+    /**
+     * Method to read the stored checksum of the event payload of a row
+     * @param[in] pCursor cursor positioned on the row
+     * @param[in] nChecksumCol index of the checksum column
+     * @return checksum of the row, NO_EVENT_CHECKSUM if none is stored
+     */
+    static long long GetEventChecksum(ic_core::CStreamCursor* pCursor, int nChecksumCol)
+    {
+        return ((nChecksumCol < 0) || pCursor->IsNull(nChecksumCol)) ?
+               NO_EVENT_CHECKSUM : pCursor->GetLong(nChecksumCol);
     }
 
     /**
@@ -609,10 +682,12 @@ public:
      * @param[out] rmapResults Loaded event details
      * @param[in] llLimitStarTimestamp Event timestamp to be conidered as start time 
      * @param[in] llLimitEndTimestamp Event timestamp to be conidered as cutoff, default - 0 i.e. no limit
+     * @param[in] rstrTopicSelection Selection of the topics to load, default - empty i.e. all topics
      * @return void
      */
     static void GetTopicedStreamingEventsFromDB(const std::string &rstrTable, int nNumRowsRequested, std::vector<long long>* pvectRowIDs,
-            std::map<long long, std::pair<std::string, std::string> >& rmapResults, long long llLimitStarTimestamp = 0, long long llLimitEndTimestamp=0)
+            std::map<long long, std::pair<std::string, std::string> >& rmapResults, long long llLimitStarTimestamp = 0, long long llLimitEndTimestamp=0,
+            const std::string &rstrTopicSelection = "")
     {
         HCPLOG_METHOD() << "numRowsRequested=" << nNumRowsRequested << "; limitStarTimestamp=" << llLimitStarTimestamp <<
                 "; limitEndTimestamp=" << llLimitEndTimestamp;
@@ -636,6 +711,7 @@ public:
         vectProjection.push_back(ic_core::CDataBaseConst::COL_TIMESTAMP);
         vectProjection.push_back(ic_core::CDataBaseConst::COL_EVENTS);
         vectProjection.push_back(ic_core::CDataBaseConst::COL_TOPIC);
+        vectProjection.push_back(ic_core::CDataBaseConst::COL_CHECKSUM);
 
         std::vector<std::string> vectOrderBy;
         vectOrderBy.push_back(ic_core::CDataBaseConst::COL_TIMESTAMP + " ASC");
@@ -654,6 +730,11 @@ public:
 
         strSelection += " AND " + ic_core::CDataBaseConst::COL_TOPIC + " IS NOT NULL";
 
+        if (!rstrTopicSelection.empty())
+        {
+            strSelection += " AND (" + rstrTopicSelection + ")";
+        }
+
         strSelection += " AND " + ic_core::CDataBaseConst::COL_MID + " == 0";
 
 
@@ -665,9 +746,9 @@ public:
         while (bContinueQuery)
         {
             strActualSelection = strSelection + " AND (" + ic_core::CDataBaseConst::COL_ID + " NOT IN (" + strTotalCorruptedEvIds + ")) ";
-            ic_core::CCursor* pC = ic_core::CDataBaseFacade::GetInstance()->Query(rstrTable, vectProjection, strActualSelection, vectOrderBy, nNumRowsRequested);
+            ic_core::CStreamCursor* pC = ic_core::CDataBaseFacade::GetInstance()->QueryStream(rstrTable, vectProjection, strActualSelection, vectOrderBy, nNumRowsRequested);
 
-            if ((pC) && (pC->Size() > 0))
+            if ((pC) && (pC->MoveToNext()))
             {
                 bContinueQuery = ValidateTopicedStreamingEvent(pC,strTotalCorruptedEvIds,setCorruptedEvIds,rmapResults,pvectRowIDs,rstrTable,strDeviceId,strTopicPrefix);
             }
@@ -688,7 +769,8 @@ public:
 
     /**
      * Method to validated topiced streaming events
-     * @param[in/out] pCursor pointer to the object of CCursor
+     * @param[in/out] pCursor pointer to the object of CStreamCursor positioned
+     * on the first row; the cursor is deleted by this method
      * @param[in/out] rstrTotalCorruptedEvIds total corrupted eventIds
      * @param[in/out] rsetCorruptedEvIds set of corrupted eventIds 
      * @param[out] rmapResults loaded event details
@@ -698,21 +780,41 @@ public:
      * @param[in] rstrTopicPrefix topic prefix from config
      * @return True if no records are fetched , false otherwise
      */
-    static bool ValidateTopicedStreamingEvent(ic_core::CCursor* pCursor,std::string &rstrTotalCorruptedEvIds,
+    static bool ValidateTopicedStreamingEvent(ic_core::CStreamCursor* pCursor,std::string &rstrTotalCorruptedEvIds,
         std::set<long long> &rsetCorruptedEvIds,std::map<long long, std::pair<std::string, std::string> >& rmapResults, 
         std::vector<long long>* pvectRowIDs,const std::string &rstrTable,const std::string &rstrDeviceId, const std::string &rstrTopicPrefix)
     {
         bool bContinueQuery = true;
-        for (bool bWorking = pCursor->MoveToFirst(); bWorking; bWorking = pCursor->MoveToNext())
+        const int nIdCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_ID);
+        const int nEventsCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENTS);
+        const int nTopicCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_TOPIC);
+        const int nChecksumCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_CHECKSUM);
+
+        //read the whole page first to decrypt its events as one group
+        std::vector<long long> vecIds;
+        std::vector<std::string> vecEvents;
+        std::vector<std::string> vecTopics;
+        std::vector<long long> vecChecksums;
+        do
         {
-            long long llId = pCursor->GetLong(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_ID));
-            std::string strEventData = pCursor->GetString(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENTS));
-            strEventData = DecryptEventData(strEventData);
-
-            ic_utils::Json::Value jsonEvent;
-            ic_utils::Json::Reader jsonReader;
-            //making sure if the event decryption is success and the event json is parseable
-            if (strEventData.empty() || !(jsonReader.parse(strEventData,jsonEvent)))
+            vecIds.push_back(pCursor->GetLong(nIdCol));
+            vecEvents.push_back(pCursor->GetString(nEventsCol));
+            vecTopics.push_back(pCursor->GetString(nTopicCol));
+            vecChecksums.push_back(GetEventChecksum(pCursor, nChecksumCol));
+        } while (pCursor->MoveToNext());
+
+        delete pCursor;
+        pCursor = NULL;
+
+        DecryptEventsData(vecEvents);
+
+        for (size_t nIdx = 0; nIdx < vecIds.size(); nIdx++)
+        {
+            long long llId = vecIds[nIdx];
+            std::string &strEventData = vecEvents[nIdx];
+
+            //making sure if the event decryption is success and the event is intact
+            if (!IsValidEventData(strEventData, vecChecksums[nIdx]))
             {
                 //add the corrupted event's id to the set to delete them in one shot
                 HCPLOG_E << "Corrupted event(id=" << llId << "):" << strEventData;
@@ -730,7 +832,7 @@ public:
                 continue;
             }
 
-            std::string strTopic = pCursor->GetString(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_TOPIC));
+            std::string &strTopic = vecTopics[nIdx];
             HCPLOG_D << "GOT TOPICED EVENT = " << strEventData << "  AND   topic = " << strTopic;
 
             // Extract the substring from 2c to end of topic string ex: 2c/abc/xyz
@@ -746,11 +848,7 @@ public:
             {
                 HCPLOG_E << "ERROR: 2c not found in topic: "<< strTopic;
             } // nPosOf2c
-            
-        } // for loop
-
-        delete pCursor;
-        pCursor = NULL;
+        }
 
         /* If corrupted event ids are more than the limit, delete them
          * immediately to avoid huge query later
@@ -814,6 +912,8 @@ public:
      * @param[in] llLimitEndTimestamp Get the events from DB until given timestamp
      * @param[in] llAfterId Get the events from DB before given id
      * @param[in] llBeforeId Get the events from DB after given id
+     * @param[out] pGzip If not NULL, the Json formatted events are compressed
+     * into this stream as they are read, instead of being added to rstrResult
      * @return void
      */
     static void GetStreamingEventsFromDB(std::string &rstrLogEvent,
@@ -826,7 +926,8 @@ public:
                                          long long llLimitStartTimestamp = 0,
                                          long long llLimitEndTimestamp=0,
                                          long long llAfterId=-1,
-                                         long long llBeforeId=-1)
+                                         long long llBeforeId=-1,
+                                         ic_utils::CGzipStream *pGzip = NULL)
     {
         HCPLOG_METHOD() << "Table: " << rstrTable << ";rowsReqsted: " << nNumRowsRequested << ";vendor: " << rstrVendor
                 << ";startTime: " << llLimitStartTimestamp << ";endTime: " << llLimitEndTimestamp
@@ -839,6 +940,7 @@ public:
         vectProjection.push_back(ic_core::CDataBaseConst::COL_EVENT_ID);
         vectProjection.push_back(ic_core::CDataBaseConst::COL_TIMESTAMP);
         vectProjection.push_back(ic_core::CDataBaseConst::COL_EVENTS);
+        vectProjection.push_back(ic_core::CDataBaseConst::COL_CHECKSUM);
 
         std::vector<std::string> vectOrderBy;
         vectOrderBy.push_back(ic_core::CDataBaseConst::COL_TIMESTAMP + " ASC");
@@ -849,7 +951,15 @@ public:
 
         pvectRowIDs->clear();
         rstrResult.clear();
-        rstrResult.append("[");
+        if (pGzip)
+        {
+            pGzip->Reset();
+            pGzip->Append("[", 1);
+        }
+        else
+        {
+            rstrResult.append("[");
+        }
 
         std::string strActualSelection = strSelection;
         std::string strTotalCorruptedEvIdsStr = "";
@@ -863,13 +973,13 @@ public:
         {
             // Add a condition to exclude the corrupted events
             strActualSelection = strSelection + " AND (" + ic_core::CDataBaseConst::COL_ID + " NOT IN (" + strTotalCorruptedEvIdsStr + ")) ";
-            ic_core::CCursor* pC = ic_core::CDataBaseFacade::GetInstance()->Query(rstrTable, vectProjection, strActualSelection, vectOrderBy, nNumRowsRequested);
+            ic_core::CStreamCursor* pC = ic_core::CDataBaseFacade::GetInstance()->QueryStream(rstrTable, vectProjection, strActualSelection, vectOrderBy, nNumRowsRequested);
 
             // Check if any records are fetched
-            if ((pC) && (pC->Size() > 0))
+            if ((pC) && (pC->MoveToNext()))
             {
 
-                ValidateStreamingEvent(pC,strEvent , strTotalCorruptedEvIdsStr, setCorruptedEvIds, pvectRowIDs, rstrResult);
+                ValidateStreamingEvent(pC,strEvent , strTotalCorruptedEvIdsStr, setCorruptedEvIds, pvectRowIDs, rstrResult, pGzip);
                 delete pC;
                 pC = NULL;
 
@@ -895,34 +1005,137 @@ public:
         rstrLogEvent = strEvent.str();
         UpdateStreamEventUploadLogStr(rstrLogEvent);
 
-        UpdateFinalResultJsonStr(rstrResult);
+        if (pGzip)
+        {
+            pGzip->Append("]", 1);
+            pGzip->Finish();
+        }
+        else
+        {
+            UpdateFinalResultJsonStr(rstrResult);
+        }
+    }
+
+    /**
+     * Method to retrieve events/alerts from the database, compressing them
+     * while they are read so that the uncompressed payload is never built
+     * @param[in] rstrLogEvent String to be updated for logging purpose
+     * @param[in] rstrTable Table name
+     * @param[in] nNumRowsRequested Requested number of rows to be retrieve
+     * @param[out] pvectRowIDs Number of rows retrieved
+     * @param[out] rGzip Stream receiving the gzipped Json formatted events
+     * @return True if the compressed payload is complete, false otherwise
+     */
+    static bool GetCompressedStreamingEventsFromDB(std::string &rstrLogEvent,
+                                         const std::string &rstrTable,
+                                         int nNumRowsRequested,
+                                         std::vector<long long>* pvectRowIDs,
+                                         ic_utils::CGzipStream &rGzip)
+    {
+        std::string strUnused;
+        GetStreamingEventsFromDB(rstrLogEvent, rstrTable, nNumRowsRequested,
+                                 pvectRowIDs, strUnused,
+                                 std::set<std::string>(), "", 0, 0, -1, -1,
+                                 &rGzip);
+        return rGzip.IsFinished();
+    }
+
+    /**
+     * Method to train a candidate upload compression dictionary from the
+     * newest events of the event store. The dictionary in use is distributed
+     * by MQTT.compressionDictionaryUrl; a candidate is meant to be collected
+     * for training it, not to be used by this device on its own.
+     * @param[in] rstrPath Path of the dictionary file
+     * @return True if the dictionary is trained and saved, false otherwise
+     */
+    static bool TrainCompressionDictionary(const std::string &rstrPath)
+    {
+        HCPLOG_METHOD() << "Dictionary: " << rstrPath;
+        std::vector<std::string> vectProjection;
+        vectProjection.push_back(ic_core::CDataBaseConst::COL_EVENTS);
+
+        std::vector<std::string> vectOrderBy;
+        vectOrderBy.push_back(ic_core::CDataBaseConst::COL_ID + " DESC");
+
+        int nSampleSize = ic_core::CIgniteConfig::GetInstance()->GetInt(
+                        KEY_DICTIONARY_SAMPLE_SIZE, DEF_DICTIONARY_SAMPLE_SIZE);
+        ic_core::CStreamCursor* pC = ic_core::CDataBaseFacade::GetInstance()->
+                QueryStream(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                            vectProjection, "", vectOrderBy, nSampleSize);
+        if (!pC)
+        {
+            HCPLOG_E << "Failed to read the event store";
+            return false;
+        }
+
+        std::vector<std::string> vecEvents;
+        const int nEventsCol = pC->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENTS);
+        while (pC->MoveToNext())
+        {
+            vecEvents.push_back(pC->GetString(nEventsCol));
+        }
+        delete pC;
+        DecryptEventsData(vecEvents);
+
+        ic_utils::CGzipDictionary dictionary;
+        if (0 == dictionary.Train(vecEvents))
+        {
+            HCPLOG_E << "No events to train the dictionary from";
+            return false;
+        }
+        HCPLOG_C << "Trained dictionary id " << dictionary.GetId();
+        return dictionary.Save(rstrPath);
     }
 
     /**
      * Method to validate streaming event
-     * @param[in/out] pCursor pointer to the object of CCursor
+     * @param[in/out] pCursor pointer to the object of CStreamCursor positioned
+     * on the first row
      * @param[out] rStrEvent string capturing log statement of event
      * @param[in/out] rstrTotalCorruptedEvIds total corrupted eventIds
      * @param[in/out] rsetCorruptedEvIds set of corrupted eventIds 
      * @param[out] pvectRowIDs : Number of rows retrieved
      * @param[out] rStrRsult : Json formatted string containing events/alerts
+     * @param[out] pGzip : If not NULL, stream to compress the events into
+     * instead of adding them to rStrRsult
      * @return void
      */
-    static void ValidateStreamingEvent(ic_core::CCursor* pCursor, std::stringstream &rStrEvent, std::string &rstrTotalCorruptedEvIds, 
-        std::set<long long> &rsetCorruptedEvIds, std::vector<long long>* pvectRowIDs, std::string& rStrRsult)
+    static void ValidateStreamingEvent(ic_core::CStreamCursor* pCursor, std::stringstream &rStrEvent, std::string &rstrTotalCorruptedEvIds, 
+        std::set<long long> &rsetCorruptedEvIds, std::vector<long long>* pvectRowIDs, std::string& rStrRsult,
+        ic_utils::CGzipStream *pGzip = NULL)
     {
-        for (bool bWorking = pCursor->MoveToFirst(); bWorking; bWorking = pCursor->MoveToNext())
+        const int nIdCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_ID);
+        const int nEventsCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENTS);
+        const int nEventIdCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENT_ID);
+        const int nTimestampCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_TIMESTAMP);
+        const int nChecksumCol = pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_CHECKSUM);
+
+        //read the whole page first to decrypt its events as one group
+        std::vector<long long> vecIds;
+        std::vector<std::string> vecEvents;
+        std::vector<std::string> vecEventTypes;
+        std::vector<long long> vecTimestamps;
+        std::vector<long long> vecChecksums;
+        do
         {
-            long long llId = pCursor->GetLong(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_ID));
-            std::string strEventData = pCursor->GetString(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENTS));
-            std::string strEventType = pCursor->GetString(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_EVENT_ID));
-            long long llTimestamp = pCursor->GetLong(pCursor->GetColumnIndex(ic_core::CDataBaseConst::COL_TIMESTAMP));
-            strEventData = DecryptEventData(strEventData);
-
-            ic_utils::Json::Value jsonEvent;
-            ic_utils::Json::Reader jsonReader;
-            // Making sure the decryption is success and event json is parseable
-            if (strEventData.empty() || !(jsonReader.parse(strEventData,jsonEvent)))
+            vecIds.push_back(pCursor->GetLong(nIdCol));
+            vecEvents.push_back(pCursor->GetString(nEventsCol));
+            vecEventTypes.push_back(pCursor->GetString(nEventIdCol));
+            vecTimestamps.push_back(pCursor->GetLong(nTimestampCol));
+            vecChecksums.push_back(GetEventChecksum(pCursor, nChecksumCol));
+        } while (pCursor->MoveToNext());
+
+        DecryptEventsData(vecEvents);
+
+        for (size_t nIdx = 0; nIdx < vecIds.size(); nIdx++)
+        {
+            long long llId = vecIds[nIdx];
+            std::string &strEventData = vecEvents[nIdx];
+            const std::string &strEventType = vecEventTypes[nIdx];
+            long long llTimestamp = vecTimestamps[nIdx];
+
+            // Making sure the decryption is success and the event is intact
+            if (!IsValidEventData(strEventData, vecChecksums[nIdx]))
             {
                 // Add the corrupted event's id to the set to delete them in one shot
                 HCPLOG_E << "Corrupted event(id=" << llId << "):" << strEventData;
@@ -932,8 +1145,20 @@ public:
                 continue;
             }
 
-            strEventData.append(",");
-            rStrRsult.append(strEventData);
+            if (pGzip)
+            {
+                // compressed output cannot be taken back, separator goes first
+                if (!pvectRowIDs->empty())
+                {
+                    pGzip->Append(",", 1);
+                }
+                pGzip->Append(strEventData);
+            }
+            else
+            {
+                strEventData.append(",");
+                rStrRsult.append(strEventData);
+            }
             pvectRowIDs->push_back(llId);
 
             rStrEvent << "{\"" << strEventType<< "\":" << llTimestamp <<"},";
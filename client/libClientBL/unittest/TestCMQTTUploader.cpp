@@ -18,6 +18,10 @@
 
 #include "gtest/gtest.h"
 #include "upload/CMQTTUploader.h"
+#include "upload/CMidHandler.h"
+#include "db/CDataBaseFacade.h"
+#include "crypto/CIgniteDataSecurity.h"
+#include <set>
 
 namespace ic_bl
 {
@@ -31,9 +35,70 @@ static const int MAX_UPLOAD_EVENT_COUNT = 175;
 static const std::string UPLOAD_EVENT_COUNT_JSON_PATH = 
                                      "MQTT.pub_topics.events.uploadEventCount";
 
+//! MID reserving the prefetched events until they are published
+static const int RESERVED_MID = -1;
+
+//! Event id of the events inserted by the prefetch tests
+static const std::string PREFETCH_TEST_EVENT = "PrefetchTest";
+
 //! Pointer to the object of CMQTTUploader                                    
 CMQTTUploader *g_pMQTTUploader = nullptr;
 
+/**
+ * Method to replace the events store content by streamed test events
+ * @param[in] nCount Number of events to insert
+ * @return void
+ */
+void insert_prefetch_events(int nCount)
+{
+    ic_core::CDataBaseFacade *pDb = ic_core::CDataBaseFacade::GetInstance();
+    pDb->Remove(ic_core::CDataBaseConst::TABLE_EVENT_STORE);
+    for (int nI = 1; nI <= nCount; nI++)
+    {
+        std::string strEvent = "{\"EventID\":\"" + PREFETCH_TEST_EVENT +
+                               "\",\"Timestamp\":" + std::to_string(nI) +
+                               ",\"Data\":{}}";
+        ic_core::CContentValues data;
+        data.Put(ic_core::CDataBaseConst::COL_EVENT_ID, PREFETCH_TEST_EVENT);
+        data.Put(ic_core::CDataBaseConst::COL_TIMESTAMP, (long long)nI);
+        data.Put(ic_core::CDataBaseConst::COL_STREAM_SUPPORT, 1);
+        data.PutBlob(ic_core::CDataBaseConst::COL_EVENTS,
+                     ic_core::CIgniteDataSecurity::EncryptEvent(strEvent));
+        EXPECT_NE(-1, pDb->Insert(ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                                  &data));
+    }
+}
+
+/**
+ * Method to read the MIDs of the test events
+ * @param void
+ * @return Map of the row ids of the test events to their MID
+ */
+std::map<long long, int> get_prefetch_event_mids()
+{
+    std::map<long long, int> mapMids;
+    std::vector<std::string> vecProjection;
+    vecProjection.push_back(ic_core::CDataBaseConst::COL_ID);
+    vecProjection.push_back(ic_core::CDataBaseConst::COL_MID);
+    ic_core::CCursor *pCursor = ic_core::CDataBaseFacade::GetInstance()->Query(
+                                ic_core::CDataBaseConst::TABLE_EVENT_STORE,
+                                vecProjection,
+                                ic_core::CDataBaseConst::COL_EVENT_ID + " = '" +
+                                PREFETCH_TEST_EVENT + "'");
+    if (pCursor)
+    {
+        if (pCursor->MoveToFirst())
+        {
+            do
+            {
+                mapMids[pCursor->GetLong(0)] = pCursor->GetInt(1);
+            } while (pCursor->MoveToNext());
+        }
+        delete pCursor;
+    }
+    return mapMids;
+}
+
 /**
  * Class for unit testing CMQTTUploader
  */
@@ -54,6 +119,28 @@ public:
      */
     unsigned int FetchMaxUploadEventCnt();
 
+    /**
+     * Wrapper method to set m_unMaxEventUploadCnt of CMQTTUploader
+     * @param[in] unCount Max event upload count
+     * @return void
+     */
+    void SetMaxUploadEventCnt(unsigned int unCount);
+
+    /**
+     * Wrapper method to call FetchEventBatch of CMQTTUploader and to queue
+     * the batch as the prefetch thread does
+     * @param[out] rvecRowIDs Row IDs of the events in the batch
+     * @return true if a batch is ready to publish, false otherwise
+     * @see CMQTTUploader::FetchEventBatch
+     */
+    bool PrefetchEventBatch(std::vector<long long> &rvecRowIDs);
+
+    /**
+     * Wrapper method to call ReleasePrefetchedBatches of CMQTTUploader
+     * @see CMQTTUploader::ReleasePrefetchedBatches
+     */
+    void ReleasePrefetchedBatches();
+
     /**
      * Constructor
      */
@@ -106,6 +193,30 @@ unsigned int CMQTTUploaderTest::FetchMaxUploadEventCnt()
     return g_pMQTTUploader->m_unMaxEventUploadCnt;
 }
 
+void CMQTTUploaderTest::SetMaxUploadEventCnt(unsigned int unCount)
+{
+    g_pMQTTUploader->m_unMaxEventUploadCnt = unCount;
+}
+
+bool CMQTTUploaderTest::PrefetchEventBatch(std::vector<long long> &rvecRowIDs)
+{
+    CMQTTUploader::PrefetchedBatch batch;
+    bool bReady = g_pMQTTUploader->FetchEventBatch(batch);
+    rvecRowIDs = batch.m_vecRowIDs;
+    if (bReady)
+    {
+        std::lock_guard<std::mutex> lock(g_pMQTTUploader->m_PrefetchMutex);
+        g_pMQTTUploader->m_unPrefetchedBytes += batch.m_strPayload.size();
+        g_pMQTTUploader->m_dqPrefetchedBatches.push_back(std::move(batch));
+    }
+    return bReady;
+}
+
+void CMQTTUploaderTest::ReleasePrefetchedBatches()
+{
+    g_pMQTTUploader->ReleasePrefetchedBatches();
+}
+
 TEST_F(CMQTTUploaderTest,
                         test_getComponentStatus_checkCurrentStateOfMqttUploader)
 {
@@ -152,4 +263,102 @@ TEST_F(CMQTTUploaderTest, Test_initEventsUploadCnt)
               obj.FetchMaxUploadEventCnt());
 }
 
-} //namespace ic_bl
\ No newline at end of file
+TEST_F(CMQTTUploaderTest, Test_FetchEventBatch_ReservesRows)
+{
+    CMQTTUploaderTest obj;
+    unsigned int unMaxCnt = obj.FetchMaxUploadEventCnt();
+    obj.SetMaxUploadEventCnt(MIN_UPLOAD_EVENT_COUNT);
+    insert_prefetch_events(MIN_UPLOAD_EVENT_COUNT + 5);
+
+    // Expect the rows of a prefetched batch to be reserved
+    std::vector<long long> vecFirst;
+    ASSERT_TRUE(obj.PrefetchEventBatch(vecFirst));
+    EXPECT_EQ((size_t)MIN_UPLOAD_EVENT_COUNT, vecFirst.size());
+    std::map<long long, int> mapMids = get_prefetch_event_mids();
+    for (size_t nI = 0; nI < vecFirst.size(); nI++)
+    {
+        EXPECT_EQ(RESERVED_MID, mapMids[vecFirst[nI]]);
+    }
+
+    // Expect the next batch query to skip the reserved rows
+    std::vector<long long> vecSecond;
+    ASSERT_TRUE(obj.PrefetchEventBatch(vecSecond));
+    EXPECT_EQ((size_t)5, vecSecond.size());
+    std::set<long long> setFirst(vecFirst.begin(), vecFirst.end());
+    for (size_t nI = 0; nI < vecSecond.size(); nI++)
+    {
+        EXPECT_EQ(0u, setFirst.count(vecSecond[nI]));
+    }
+
+    // Expect no batch once all the rows are reserved
+    std::vector<long long> vecThird;
+    EXPECT_FALSE(obj.PrefetchEventBatch(vecThird));
+    EXPECT_TRUE(vecThird.empty());
+
+    obj.ReleasePrefetchedBatches();
+    obj.SetMaxUploadEventCnt(unMaxCnt);
+    ic_core::CDataBaseFacade::GetInstance()->Remove(
+                                ic_core::CDataBaseConst::TABLE_EVENT_STORE);
+}
+
+TEST_F(CMQTTUploaderTest, Test_ReleasePrefetchedBatches_ResetsMid)
+{
+    CMQTTUploaderTest obj;
+    unsigned int unMaxCnt = obj.FetchMaxUploadEventCnt();
+    obj.SetMaxUploadEventCnt(MIN_UPLOAD_EVENT_COUNT);
+    insert_prefetch_events(MIN_UPLOAD_EVENT_COUNT * 2);
+
+    /* publish failures and shutdown put the batches back in the queue;
+     * expect the queued batches to be reset to MID 0 when released
+     */
+    std::vector<long long> vecRowIDs;
+    ASSERT_TRUE(obj.PrefetchEventBatch(vecRowIDs));
+    ASSERT_TRUE(obj.PrefetchEventBatch(vecRowIDs));
+    obj.ReleasePrefetchedBatches();
+
+    std::map<long long, int> mapMids = get_prefetch_event_mids();
+    EXPECT_EQ((size_t)(MIN_UPLOAD_EVENT_COUNT * 2), mapMids.size());
+    for (std::map<long long, int>::iterator itr = mapMids.begin();
+         itr != mapMids.end(); itr++)
+    {
+        EXPECT_EQ(0, itr->second);
+    }
+
+    // Expect the released events to be read again by the next upload
+    EXPECT_TRUE(obj.PrefetchEventBatch(vecRowIDs));
+    EXPECT_EQ((size_t)MIN_UPLOAD_EVENT_COUNT, vecRowIDs.size());
+
+    obj.ReleasePrefetchedBatches();
+    obj.SetMaxUploadEventCnt(unMaxCnt);
+    ic_core::CDataBaseFacade::GetInstance()->Remove(
+                                ic_core::CDataBaseConst::TABLE_EVENT_STORE);
+}
+
+TEST_F(CMQTTUploaderTest, Test_InitMid_ClearsReservations)
+{
+    CMQTTUploaderTest obj;
+    unsigned int unMaxCnt = obj.FetchMaxUploadEventCnt();
+    obj.SetMaxUploadEventCnt(MIN_UPLOAD_EVENT_COUNT);
+    insert_prefetch_events(MIN_UPLOAD_EVENT_COUNT);
+
+    // reservations left behind as by an interrupted upload
+    std::vector<long long> vecRowIDs;
+    ASSERT_TRUE(obj.PrefetchEventBatch(vecRowIDs));
+
+    // Expect the reconnect to clear the reservations
+    EXPECT_TRUE(CMidHandler::GetInstance()->InitMid());
+    std::map<long long, int> mapMids = get_prefetch_event_mids();
+    EXPECT_EQ((size_t)MIN_UPLOAD_EVENT_COUNT, mapMids.size());
+    for (std::map<long long, int>::iterator itr = mapMids.begin();
+         itr != mapMids.end(); itr++)
+    {
+        EXPECT_EQ(0, itr->second);
+    }
+
+    obj.ReleasePrefetchedBatches();
+    obj.SetMaxUploadEventCnt(unMaxCnt);
+    ic_core::CDataBaseFacade::GetInstance()->Remove(
+                                ic_core::CDataBaseConst::TABLE_EVENT_STORE);
+}
+
+} //namespace ic_bl
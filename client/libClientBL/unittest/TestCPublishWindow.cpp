@@ -0,0 +1,218 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <thread>
+#include "gtest/gtest.h"
+#include "upload/CPublishWindow.h"
+
+#ifdef PREFIX
+#undef PREFIX
+#endif
+
+//! Macro for "test_CPublishWindow" string
+#define PREFIX "test_CPublishWindow"
+
+namespace ic_bl
+{
+
+/**
+ * Class CPublishWindowTest defines a test feature for CPublishWindow class
+ */
+class CPublishWindowTest : public ::testing::Test {
+public:
+    /**
+     * Constructor
+     */
+    CPublishWindowTest()
+    {
+        //Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CPublishWindowTest() override
+    {
+        //Do nothing
+    }
+
+    /**
+     * SetUp method : Code here will be called immediately after the
+     * constructor (right before each test)
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        //Do nothing
+    }
+
+    /**
+     * TearDown method : Code here will be called immediately after
+     * each test (right before the destructor)
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        //Do nothing
+    }
+};
+
+TEST_F(CPublishWindowTest, Test_Disabled)
+{
+    CPublishWindow window;
+
+    // Expect a window not configured to never block nor track MIDs
+    EXPECT_FALSE(window.IsEnabled());
+    for (int nMid = 1; nMid <= 50; nMid++)
+    {
+        EXPECT_TRUE(window.Acquire(0));
+        window.OnPublished(nMid);
+    }
+    EXPECT_EQ(0u, window.GetInflightCount());
+    EXPECT_FALSE(window.OnAcked(1));
+}
+
+TEST_F(CPublishWindowTest, Test_BlocksUntilAcked)
+{
+    CPublishWindow window;
+    window.Configure(2, 10, 10000);
+    EXPECT_TRUE(window.IsEnabled());
+
+    EXPECT_TRUE(window.Acquire(0));
+    window.OnPublished(1);
+    EXPECT_TRUE(window.Acquire(0));
+    window.OnPublished(2);
+
+    // Expect the full window to block until a PUBACK is received
+    EXPECT_FALSE(window.Acquire(10));
+    EXPECT_EQ(2u, window.GetInflightCount());
+
+    std::thread ackThread([&window] { window.OnAcked(1); });
+    EXPECT_TRUE(window.Acquire(5000));
+    ackThread.join();
+    EXPECT_EQ(1u, window.GetInflightCount());
+}
+
+TEST_F(CPublishWindowTest, Test_AckBeforePublished)
+{
+    CPublishWindow window;
+    window.Configure(1, 10, 10000);
+
+    // Expect an ack received before the publish call returns to be matched
+    EXPECT_TRUE(window.Acquire(0));
+    EXPECT_FALSE(window.OnAcked(7));
+    window.OnPublished(7);
+    EXPECT_EQ(0u, window.GetInflightCount());
+    EXPECT_TRUE(window.Acquire(0));
+}
+
+TEST_F(CPublishWindowTest, Test_AckNotPublishedThroughWindow)
+{
+    CPublishWindow window;
+    window.Configure(4, 10, 10000);
+
+    // Expect an ack while no publish is in progress not to be kept
+    EXPECT_FALSE(window.OnAcked(7));
+    EXPECT_TRUE(window.Acquire(0));
+    window.OnPublished(7);
+    EXPECT_EQ(1u, window.GetInflightCount());
+    EXPECT_TRUE(window.OnAcked(7));
+
+    // Expect an ack kept for a publish in progress to be dropped once done
+    EXPECT_TRUE(window.Acquire(0));
+    EXPECT_FALSE(window.OnAcked(8));
+    window.OnPublished(9);
+    EXPECT_TRUE(window.Acquire(0));
+    window.OnPublished(8);
+    EXPECT_EQ(2u, window.GetInflightCount());
+}
+
+TEST_F(CPublishWindowTest, Test_CancelReleasesRoom)
+{
+    CPublishWindow window;
+    window.Configure(1, 10, 10000);
+
+    // Expect the room of an acquired but not published message to be held
+    EXPECT_TRUE(window.Acquire(0));
+    EXPECT_FALSE(window.Acquire(10));
+
+    window.Cancel();
+    EXPECT_TRUE(window.Acquire(0));
+    EXPECT_EQ(0u, window.GetInflightCount());
+}
+
+TEST_F(CPublishWindowTest, Test_GrowsOnAcks)
+{
+    CPublishWindow window;
+    window.Configure(2, 4, 10000);
+
+    // Expect fast acks to grow the window up to its maximum size
+    for (int nMid = 1; nMid <= 100; nMid++)
+    {
+        EXPECT_TRUE(window.Acquire(0));
+        window.OnPublished(nMid);
+        EXPECT_TRUE(window.OnAcked(nMid));
+    }
+    EXPECT_EQ(4u, window.GetSize());
+    EXPECT_EQ(0u, window.GetRetransmitCount());
+}
+
+TEST_F(CPublishWindowTest, Test_ShrinksOnTimeout)
+{
+    CPublishWindow window;
+    window.Configure(4, 8, 20);
+    for (int nMid = 1; nMid <= 4; nMid++)
+    {
+        window.OnPublished(nMid);
+    }
+
+    // Expect unacknowledged MIDs to expire, to halve the window once
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(4u, window.ExpireTimedOut());
+    EXPECT_EQ(2u, window.GetSize());
+    EXPECT_EQ(4u, window.GetRetransmitCount());
+
+    // Expect expired MIDs to stay in flight until their late ack
+    EXPECT_EQ(4u, window.GetInflightCount());
+    EXPECT_FALSE(window.Acquire(10));
+    EXPECT_TRUE(window.OnAcked(1));
+    EXPECT_TRUE(window.OnAcked(2));
+    EXPECT_EQ(2u, window.GetInflightCount());
+    EXPECT_FALSE(window.Acquire(10));
+    EXPECT_TRUE(window.OnAcked(3));
+    EXPECT_TRUE(window.Acquire(0));
+    EXPECT_EQ(0u, window.ExpireTimedOut());
+    EXPECT_EQ(2u, window.GetSize());
+}
+
+TEST_F(CPublishWindowTest, Test_Reset)
+{
+    CPublishWindow window;
+    window.Configure(3, 8, 10000);
+    window.OnPublished(1);
+    window.OnPublished(2);
+
+    // Expect the pending MIDs to be accounted as retransmissions
+    window.Reset();
+    EXPECT_EQ(0u, window.GetInflightCount());
+    EXPECT_EQ(2u, window.GetRetransmitCount());
+    EXPECT_EQ(3u, window.GetSize());
+    EXPECT_FALSE(window.OnAcked(1));
+}
+
+} /* namespace ic_bl */
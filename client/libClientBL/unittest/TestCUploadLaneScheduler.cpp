@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <thread>
+#include <mutex>
+#include <vector>
+#include "gtest/gtest.h"
+#include "upload/CUploadLaneScheduler.h"
+
+#ifdef PREFIX
+#undef PREFIX
+#endif
+
+//! Macro for "test_CUploadLaneScheduler" string
+#define PREFIX "test_CUploadLaneScheduler"
+
+namespace ic_bl
+{
+
+/**
+ * Class CUploadLaneSchedulerTest defines a test feature for
+ * CUploadLaneScheduler class
+ */
+class CUploadLaneSchedulerTest : public ::testing::Test {
+public:
+    /**
+     * Constructor
+     */
+    CUploadLaneSchedulerTest()
+    {
+        //Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CUploadLaneSchedulerTest() override
+    {
+        //Do nothing
+    }
+
+    /**
+     * SetUp method : Code here will be called immediately after the
+     * constructor (right before each test)
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        //Do nothing
+    }
+
+    /**
+     * TearDown method : Code here will be called immediately after
+     * each test (right before the destructor)
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        //Do nothing
+    }
+
+    /**
+     * Method to wait until the given number of lanes wait for their turn
+     * @param[in] rScheduler Scheduler of the lanes
+     * @param[in] unCount Number of waiting lanes
+     * @return void
+     */
+    void WaitForWaiting(CUploadLaneScheduler &rScheduler, unsigned int unCount)
+    {
+        while (rScheduler.GetWaitingCount() < unCount)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+TEST_F(CUploadLaneSchedulerTest, Test_SingleLane)
+{
+    CUploadLaneScheduler scheduler;
+    unsigned int unLane = scheduler.AddLane(1);
+
+    // Expect a lane alone to be granted without waiting
+    for (int nI = 0; nI < 3; nI++)
+    {
+        EXPECT_TRUE(scheduler.Acquire(unLane, 100));
+        scheduler.Release();
+    }
+    EXPECT_EQ(300u, scheduler.GetBytes(unLane));
+    EXPECT_FALSE(scheduler.Acquire(unLane + 1, 100));
+}
+
+TEST_F(CUploadLaneSchedulerTest, Test_ShareOrdersWaitingLanes)
+{
+    CUploadLaneScheduler scheduler;
+    unsigned int unBulk = scheduler.AddLane(1);
+    unsigned int unUrgent = scheduler.AddLane(4);
+    unsigned int unGate = scheduler.AddLane(1);
+
+    // both lanes publish the same bytes, the urgent lane uses less of its share
+    EXPECT_TRUE(scheduler.Acquire(unBulk, 400));
+    scheduler.Release();
+    EXPECT_TRUE(scheduler.Acquire(unUrgent, 400));
+    scheduler.Release();
+
+    // hold the turn until both lanes wait for it
+    EXPECT_TRUE(scheduler.Acquire(unGate, 0));
+    std::mutex orderMutex;
+    std::vector<unsigned int> vecOrder;
+    std::vector<std::thread> vecThreads;
+    unsigned int arrLanes[] = {unBulk, unUrgent};
+    for (unsigned int unLane : arrLanes)
+    {
+        vecThreads.push_back(std::thread([&, unLane] {
+            EXPECT_TRUE(scheduler.Acquire(unLane, 100));
+            {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                vecOrder.push_back(unLane);
+            }
+            scheduler.Release();
+        }));
+    }
+    WaitForWaiting(scheduler, 2);
+    scheduler.Release();
+    for (std::thread &rThread : vecThreads)
+    {
+        rThread.join();
+    }
+
+    // Expect the lane with the larger share to be granted first
+    ASSERT_EQ(2u, vecOrder.size());
+    EXPECT_EQ(unUrgent, vecOrder[0]);
+    EXPECT_EQ(unBulk, vecOrder[1]);
+}
+
+TEST_F(CUploadLaneSchedulerTest, Test_IdleLaneGetsNoCredit)
+{
+    CUploadLaneScheduler scheduler;
+    unsigned int unBusy = scheduler.AddLane(1);
+    unsigned int unIdle = scheduler.AddLane(1);
+    unsigned int unGate = scheduler.AddLane(1);
+
+    for (int nI = 0; nI < 10; nI++)
+    {
+        EXPECT_TRUE(scheduler.Acquire(unBusy, 100));
+        scheduler.Release();
+    }
+
+    /* the idle lane joins at the clock of the busy lane, so one turn of it
+     * catches up with the busy lane instead of running ahead of it
+     */
+    EXPECT_TRUE(scheduler.Acquire(unIdle, 100));
+    scheduler.Release();
+
+    EXPECT_TRUE(scheduler.Acquire(unGate, 0));
+    std::mutex orderMutex;
+    std::vector<unsigned int> vecOrder;
+    std::vector<std::thread> vecThreads;
+    unsigned int arrLanes[] = {unIdle, unBusy};
+    for (unsigned int unLane : arrLanes)
+    {
+        vecThreads.push_back(std::thread([&, unLane] {
+            EXPECT_TRUE(scheduler.Acquire(unLane, 100));
+            {
+                std::lock_guard<std::mutex> lock(orderMutex);
+                vecOrder.push_back(unLane);
+            }
+            scheduler.Release();
+        }));
+    }
+    WaitForWaiting(scheduler, 2);
+    scheduler.Release();
+    for (std::thread &rThread : vecThreads)
+    {
+        rThread.join();
+    }
+
+    // Expect the lanes to be even, the first added lane going first
+    ASSERT_EQ(2u, vecOrder.size());
+    EXPECT_EQ(unBusy, vecOrder[0]);
+    EXPECT_EQ(unIdle, vecOrder[1]);
+}
+
+TEST_F(CUploadLaneSchedulerTest, Test_Close)
+{
+    CUploadLaneScheduler scheduler;
+    unsigned int unFirst = scheduler.AddLane(1);
+    unsigned int unSecond = scheduler.AddLane(1);
+    EXPECT_TRUE(scheduler.Acquire(unFirst, 100));
+
+    // Expect the waiting and further turns to fail once closed
+    std::thread waitThread([&] {
+        EXPECT_FALSE(scheduler.Acquire(unSecond, 100));
+    });
+    WaitForWaiting(scheduler, 1);
+    scheduler.Close();
+    waitThread.join();
+    scheduler.Release();
+    EXPECT_FALSE(scheduler.Acquire(unFirst, 100));
+}
+
+} /* namespace ic_bl */
@@ -274,6 +274,14 @@ public:
      */
     static int StopNotifications();
 
+    /**
+     * Method to train the upload compression dictionary from the stored
+     * events; requires InitClient and InitAnalytics to be done
+     * @param[in] rstrPath path of the dictionary file to create or refresh
+     * @return 0 if the dictionary is saved, non zero otherwise
+     */
+    static int TrainCompressionDictionary(const std::string &rstrPath);
+
     /**
      * Method to add additional analytics handler
      * @param[in] instance of IMessageHandler class
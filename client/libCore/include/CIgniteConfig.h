@@ -30,6 +30,9 @@
 
 #include <string>
 #include <list>
+#include <set>
+#include <atomic>
+#include <memory>
 #include "jsoncpp/json.h"
 #include "CIgniteMutex.h"
 
@@ -74,6 +77,351 @@ enum EconfigUpdateSource
     eCLOUD_CONFIG_UPDATE = 0 ///< Cloud config update
 };
 
+class CIgniteConfig;
+
+/**
+ * Class CConfigSnapshot is an immutable copy of the configuration published by
+ * CIgniteConfig whenever the configuration changes. A reader holding a
+ * snapshot sees one consistent configuration for the whole operation without
+ * any locking, also while a newer snapshot is being published.
+ */
+class CConfigSnapshot
+{
+public:
+    /**
+     * Parameterized Constructor
+     * @param[in] rjsonRoot JSON object containing config root value
+     * @param[in] ullVersion Version of the snapshot
+     */
+    CConfigSnapshot(const ic_utils::Json::Value &rjsonRoot,
+                    const unsigned long long ullVersion);
+
+    /**
+     * Method to get the version of the snapshot; it increases with every
+     * published snapshot
+     * @param void
+     * @return Version of the snapshot
+     */
+    unsigned long long GetVersion() const;
+
+    /**
+     * Method to get the JSON value based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] nIndex Index value
+     * @return JSON value based on key, valid as long as the snapshot is held
+     */
+    const ic_utils::Json::Value& GetJsonValue(const std::string &rstrKey,
+                                              const int nIndex = 0) const;
+
+    /**
+     * Method to get string value based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] rstrDefaultValue String containing default value
+     * @param[in] nIndex Index value
+     * @return String value if key is member else default value
+     */
+    std::string GetString(const std::string &rstrKey,
+                          const std::string &rstrDefaultValue = "",
+                          const int nIndex = 0) const;
+
+    /**
+     * Method to get the integer value based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] nDefaultValue Default integer value
+     * @param[in] nIndex Index value
+     * @return Integer value if key is member else default value
+     */
+    int GetInt(const std::string &rstrKey, const int nDefaultValue = 0,
+               const int nIndex = 0) const;
+
+    /**
+     * Method to get the long value based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] lDefaultValue Default long value
+     * @param[in] nIndex Index value
+     * @return Long value if key is member else default value
+     */
+    long GetLong(const std::string &rstrKey, const long lDefaultValue = 0,
+                 const int nIndex = 0) const;
+
+    /**
+     * Method to get the boolean value based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] bDefaultValue Default boolean value
+     * @param[in] nIndex Index value
+     * @return Boolean value based on key else default value
+     */
+    bool GetBool(const std::string &rstrKey, const bool bDefaultValue = false,
+                 const int nIndex = 0) const;
+
+    /**
+     * Method to get the double value based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] dblDefaultValue Default double value
+     * @param[in] nIndex Index value
+     * @return Double value if key is member else default value
+     */
+    double GetDouble(const std::string &rstrKey,
+                     const double dblDefaultValue = 0.0,
+                     const int nIndex = 0) const;
+
+    /**
+     * Method to get the requested value as string based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @param[in] rstrDefaultValue String containing default value
+     * @param[in] nIndex Index value
+     * @return String value
+     */
+    std::string GetAsString(const std::string &rstrKey,
+                            const std::string &rstrDefaultValue = "",
+                            const int nIndex = 0) const;
+
+    /**
+     * Method to get the size of array based on input parameter
+     * @param[in] rstrKey String containing key value
+     * @return Size of array
+     */
+    int GetArraySize(const std::string &rstrKey) const;
+
+private:
+    friend class CIgniteConfig;
+
+    /**
+     * Method to resolve a key path like "DAM.PPS[%].ratio" in a JSON tree
+     * @param[in] rjsonRoot JSON object to resolve the key in
+     * @param[in] rstrKey String containing key value
+     * @param[in] nIndex Index value used for '%'
+     * @return JSON value of key; if any error, returns json null reference
+     */
+    static const ic_utils::Json::Value& ResolveJsonValue(
+                                        const ic_utils::Json::Value &rjsonRoot,
+                                        const std::string &rstrKey,
+                                        const int nIndex);
+
+    /**
+     * Method to validate valid json value
+     * @param[in] pchCurrent JSON object containing current value
+     * @param[in] pchEnd JSON object containing end value
+     * @return True is json is valid, false otherwise
+     */
+    static bool ValidateGetJsonValue(const char* pchCurrent,
+                                     const char* pchEnd);
+
+    /**
+     * Method to get json array value based on input parameter
+     * @param[in]/[out] prchCurrent GetJsonValue key value
+     * @param[in] pchEnd end value of GetJsonValue key
+     * @param[in]/[out] prjsonValue actual config file data
+     * @param[in] rstrKey GetJsonValue key
+     * @param[in] rnIndex Index value
+     * @return true if prjsonValue was moved to the value of key, false on
+     * any error
+     */ 
+    static bool GetJsonArrayValue(const char **prchCurrent,
+                                  const char *pchEnd,
+                                  const ic_utils::Json::Value **prjsonValue,
+                                  const std::string &rstrKey,
+                                  const int &rnIndex);
+
+    /**
+     * Method to get json object value based on input parameter
+     * @param[in]/[out] prchCurrent GetJsonValue key value
+     * @param[in] pchEnd end value of GetJsonValue key
+     * @param[in]/[out] prjsonValue actual config file data
+     * @param[in] rstrKey GetJsonValue key
+     * @return true if prjsonValue was moved to the value of key, false on
+     * any error
+     */ 
+    static bool GetJsonObjectValue(const char **prchCurrent,
+                                   const char *pchEnd,
+                                   const ic_utils::Json::Value **prjsonValue,
+                                   const std::string &rstrKey);
+
+    //! Member variable to stores config root value
+    const ic_utils::Json::Value m_jsonRoot;
+
+    //! Member variable to stores version of the snapshot
+    const unsigned long long m_ullVersion;
+};
+
+/**
+ * Base class of config handles. A handle resolves its key once when bound to
+ * CIgniteConfig and is re-resolved by CIgniteConfig whenever the configuration
+ * is reloaded, so hot paths can read the value without any lookup.
+ */
+class CConfigHandleBase
+{
+public:
+    /**
+     * Parameterized Constructor
+     * @param[in] rstrKey String containing key value
+     * @param[in] nIndex Index value
+     */
+    CConfigHandleBase(const std::string &rstrKey, const int nIndex);
+
+    /**
+     * Destructor. The handle must already be unbound, see Unbind()
+     */
+    virtual ~CConfigHandleBase();
+
+    /**
+     * Method to get the key of the handle
+     * @param void
+     * @return String containing key value
+     */
+    const std::string& GetKey() const;
+
+    /**
+     * Method to resolve the key of the handle against the configuration
+     * @param[in] pConfig Instance of CIgniteConfig
+     * @return void
+     */
+    virtual void Resolve(CIgniteConfig *pConfig) = 0;
+
+protected:
+    /**
+     * Method to unbind the handle from CIgniteConfig if still bound. Derived
+     * handles call it first in their destructor, so that Resolve() is never
+     * called on a partly destroyed handle.
+     * @param void
+     * @return void
+     */
+    void Unbind();
+
+    //! Member variable to stores key value
+    const std::string m_strKey;
+
+    //! Member variable to stores index value
+    const int m_nIndex;
+
+private:
+    friend class CIgniteConfig;
+
+    //! Member variable to stores config instance the handle is bound to,
+    //! guarded by CIgniteConfig::m_HandleMutex
+    CIgniteConfig *m_pConfig;
+
+    CConfigHandleBase(const CConfigHandleBase&) = delete;
+    CConfigHandleBase& operator=(const CConfigHandleBase&) = delete;
+};
+
+/**
+ * Typed config handle for int, long, bool and double values. Get() is a single
+ * atomic load.
+ */
+template <typename T>
+class CConfigHandle final : public CConfigHandleBase
+{
+public:
+    /**
+     * Parameterized Constructor
+     * @param[in] rstrKey String containing key value
+     * @param[in] rDefaultValue Value used if key is not a member
+     * @param[in] nIndex Index value
+     */
+    CConfigHandle(const std::string &rstrKey, const T &rDefaultValue,
+                  const int nIndex = 0)
+        : CConfigHandleBase(rstrKey, nIndex), m_defaultValue(rDefaultValue),
+          m_value(rDefaultValue)
+    {
+    }
+
+    /**
+     * Destructor, unbinds the handle before its value is destroyed
+     */
+    ~CConfigHandle()
+    {
+        Unbind();
+    }
+
+    /**
+     * Method to get the resolved value
+     * @param void
+     * @return Value if key is member else default value
+     */
+    T Get() const
+    {
+        return m_value.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Overriding Method of CConfigHandleBase class
+     * @see CConfigHandleBase::Resolve()
+     */
+    void Resolve(CIgniteConfig *pConfig) override;
+
+private:
+    //! Member variable to stores default value
+    const T m_defaultValue;
+
+    //! Member variable to stores resolved value
+    std::atomic<T> m_value;
+};
+
+template <> void CConfigHandle<int>::Resolve(CIgniteConfig *pConfig);
+template <> void CConfigHandle<long>::Resolve(CIgniteConfig *pConfig);
+template <> void CConfigHandle<bool>::Resolve(CIgniteConfig *pConfig);
+template <> void CConfigHandle<double>::Resolve(CIgniteConfig *pConfig);
+
+/**
+ * Config handle for string values. The current value is held as a shared
+ * snapshot; a superseded value is released once the last snapshot taken of it
+ * is dropped.
+ */
+template <>
+class CConfigHandle<std::string> final : public CConfigHandleBase
+{
+public:
+    /**
+     * Parameterized Constructor
+     * @param[in] rstrKey String containing key value
+     * @param[in] rstrDefaultValue Value used if key is not a member
+     * @param[in] nIndex Index value
+     */
+    CConfigHandle(const std::string &rstrKey,
+                  const std::string &rstrDefaultValue = "",
+                  const int nIndex = 0);
+
+    /**
+     * Destructor, unbinds the handle before its value is destroyed
+     */
+    ~CConfigHandle();
+
+    /**
+     * Method to get a copy of the resolved value
+     * @param void
+     * @return String value if key is member else default value
+     */
+    std::string Get() const
+    {
+        return *GetSnapshot();
+    }
+
+    /**
+     * Method to get the resolved value without copying it. The returned
+     * snapshot stays valid across later updates for as long as it is held.
+     * @param void
+     * @return Shared pointer to the current value
+     */
+    std::shared_ptr<const std::string> GetSnapshot() const
+    {
+        return std::atomic_load(&m_pValue);
+    }
+
+    /**
+     * Overriding Method of CConfigHandleBase class
+     * @see CConfigHandleBase::Resolve()
+     */
+    void Resolve(CIgniteConfig *pConfig) override;
+
+private:
+    //! Member variable to stores default value
+    const std::string m_strDefaultValue;
+
+    //! Member variable to stores current value, accessed atomically
+    std::shared_ptr<const std::string> m_pValue;
+};
+
 /**
  * Class CIgniteConfig implements methods to handle ignite 
  * configurations utilities
@@ -258,7 +606,42 @@ public:
      */
     std::string GetConfigUpdateSourceInString(enum EconfigUpdateSource eSource);
 
+    /**
+     * Method to bind a config handle. The handle is resolved immediately and
+     * re-resolved whenever the configuration is reloaded or config update is
+     * notified, until it is unbound or destroyed.
+     * @param[in] pHandle Config handle
+     * @return void
+     */
+    void BindHandle(CConfigHandleBase *pHandle);
+
+    /**
+     * Method to unbind a config handle
+     * @param[in] pHandle Config handle
+     * @return void
+     */
+    void UnbindHandle(CConfigHandleBase *pHandle);
+
+    /**
+     * Method to get the current config snapshot. The snapshot does not change
+     * when the configuration is reloaded or updated; get a new snapshot to
+     * see the changes.
+     * @param void
+     * @return Current config snapshot
+     */
+    std::shared_ptr<const CConfigSnapshot> GetSnapshot() const;
+
+    /**
+     * Method to get the version of the current config snapshot, this allows
+     * to detect config changes with a single atomic load
+     * @param void
+     * @return Version of the current config snapshot
+     */
+    unsigned long long GetSnapshotVersion() const;
+
 private:
+    friend class CConfigHandleBase;
+
     /**
      * Parameterized Constructor
      * @param[in] rstrConfigfile String containing config file path
@@ -379,14 +762,6 @@ private:
      */
     int GetLogLevel(const ic_utils::Json::Value &rjsonRoot);
     
-    /**
-     * Method to validate valid json value
-     * @param[in] pchCurrent JSON object containing current value
-     * @param[in] pchEnd JSON object containing end value
-     * @return True is json is valid, false otherwise
-     */
-    bool ValidateGetJsonValue(const char* pchCurrent, const char* pchEnd);
-
     /**
      * Method to check if file logging is enabled or not
      * @param[in] rjsonRoot JSON object containing file logger configuration
@@ -395,34 +770,35 @@ private:
     bool IsFileLoggingEnabled(const ic_utils::Json::Value &rjsonRoot);
 
     /**
-     * Method to get json array value based on input parameter
-     * @param[in]/[out] prchCurrent GetJsonValue key value
-     * @param[in] pchEnd end value of GetJsonValue key
-     * @param[in]/[out] prjsonValue actual config file data
-     * @param[in] rstrKey GetJsonValue key
-     * @param[in] rnIndex Index value
-     * @return returns json value of key; if any error, returns json null 
-     * reference
-     */ 
-    ic_utils::Json::Value GetJsonArrayValue(const char **prchCurrent, 
-                                            const char *pchEnd, 
-                                            ic_utils::Json::Value **prjsonValue, 
-                                            const std::string &rstrKey, 
-                                            const int &rnIndex);
+     * Method to enable the asynchronous log backend based on
+     * 'FileLogger.asyncLogging' configuration
+     * @param[in] rjsonRoot JSON object containing file logger configuration
+     * @return void
+     */
+    void ConfigureAsyncLogging(const ic_utils::Json::Value &rjsonRoot);
 
     /**
-     * Method to get json object value based on input parameter
-     * @param[in]/[out] prchCurrent GetJsonValue key value
-     * @param[in] pchEnd end value of GetJsonValue key
-     * @param[in]/[out] prjsonValue actual config file data
-     * @param[in] rstrKey GetJsonValue key
-     * @return returns json value of key; if any error, returns json null 
-     * reference
-     */ 
-    ic_utils::Json::Value GetJsonObjectValue(const char **prchCurrent, 
-                                             const char *pchEnd, 
-                                             ic_utils::Json::Value **prjsonValue, 
-                                             const std::string &rstrKey);
+     * Method to apply the per module log levels of 'FileLogger.moduleLogLevels'
+     * configuration, modules not configured are not restricted
+     * @param[in] rjsonRoot JSON object containing file logger configuration
+     * @return void
+     */
+    void ConfigureModuleLogLevels(const ic_utils::Json::Value &rjsonRoot);
+
+    /**
+     * Method to re-resolve all bound config handles
+     * @param void
+     * @return void
+     */
+    void RebindHandles();
+
+    /**
+     * Method to publish the current config as new snapshot, must be called
+     * with m_InstanceMutex held after every change of m_jsonRoot
+     * @param void
+     * @return void
+     */
+    void PublishSnapshot();
     
     //! Member variable to stores config root value
     ic_utils::Json::Value m_jsonRoot;
@@ -439,6 +815,19 @@ private:
     //! Member variable to stores map of configUpdate subscribers list
     std::map <std::string, IConfigUpdateNotification*> 
                                                    m_mapConfigUpdateSubscribers;
+
+    //! Member variable to stores current config snapshot
+    std::shared_ptr<const CConfigSnapshot> m_pSnapshot;
+
+    //! Member variable to stores version of current config snapshot
+    std::atomic<unsigned long long> m_ullSnapshotVersion;
+
+    //! Mutex variable to guard bound config handles; static as handles may
+    //! be destroyed concurrently with the config instance they are bound to
+    static ic_utils::CIgniteMutex m_HandleMutex;
+
+    //! Member variable to stores bound config handles
+    std::set<CConfigHandleBase*> m_setHandles;
                                                    
     //! Member variable to stores instance of 'Config' class
     static CIgniteConfig* m_pConfigSingleton;
@@ -28,6 +28,9 @@
 #define CMESSAGE_QUEUE_H
 
 #include <list>
+#include <map>
+#include <set>
+#include <vector>
 #include "CIgniteMessage.h"
 #include "CIgniteThread.h"
 #include "IOnOffNotificationReceiver.h"
@@ -108,46 +111,87 @@ public:
      */
     void NotifyShutdown() override;
 
+    #ifdef IC_UNIT_TEST
+        friend class CMessageQueueTest;
+    #endif
+
 private:
     /**
-     * Method to initiate connections with the message-queue sockets
-     * to process the incoming messages.
+     * This class holds the state of a client connection
+     */
+    class ClientConnection
+    {
+    public:
+        //! Member variable to stores the bytes received but not processed yet
+        std::vector<unsigned char> m_vecBuffer;
+
+        //! Member variable to stores the number of valid bytes in the buffer
+        size_t m_nBufferedBytes = 0;
+    };
+
+    /**
+     * Method to run the reactor loop which accepts the client connections
+     * and processes the incoming messages until shutdown.
      * @param none
      * @return void
      */
     void Connect();
 
     /**
-     * Method to add child sockets to the list
-     * @param[in] nMaxSd current max socket descriptor id
-     * @param[in] rfds file descriptor set of the new socket
+     * Method to wait for activity on the master and client sockets
+     * @param[in] nTimeoutMs wait timeout in milliseconds, -1 to wait forever
+     * @param[out] rvecReadySockets sockets having activity
      * @return void
      */
-    void AddSockets(int &nMaxSd, fd_set &rfds);
+    void WaitForActivity(int nTimeoutMs, std::vector<int> &rvecReadySockets);
 
     /**
-     * Method to add incoming child socket connection to the client sockets list
+     * Method to accept all the pending incoming connections
      * @param none
      * @return void
      */
     void AddNewIncomingConnection();
 
     /**
-     * Method to perform IO operation on the given socket connection.
-     * @param[in] rfds the file descriptor set of the socket on which to perform IO operation
-     * @param[in] pvoidFullMsg void pointer to the memory allocated to process the message
+     * Method to start tracking the given client socket
+     * @param[in] nSd socket descriptor of the client
+     * @return true if the client is added; false otherwise
+     */
+    bool AddConnection(int nSd);
+
+    /**
+     * Method to stop tracking and close the given client socket
+     * @param[in] nSd socket descriptor of the client
      * @return void
      */
-    void PerformIOOperation(fd_set &rfds, void** pvoidFullMsg);
+    void CloseConnection(int nSd);
+
+    /**
+     * Method to read the available data of the given client socket without
+     * blocking, and to dispatch the complete messages received.
+     * @param[in] nSd socket descriptor of the client
+     * @param[out] rbMoreData true if the read budget was exhausted before
+     *             all the available data could be read
+     * @return false if the connection is to be closed; true otherwise
+     */
+    bool ReadFromConnection(int nSd, bool &rbMoreData);
+
+    /**
+     * Method to dispatch the complete messages buffered for the given client
+     * @param[in] nSd socket descriptor of the client
+     * @param[in] rConn connection state of the client
+     * @return false if the buffered data is not a valid message stream
+     */
+    bool ProcessBufferedMessages(int nSd, ClientConnection &rConn);
 
     /**
-     * Method to construct an Ignite message from the given raw message.
+     * Method to construct an Ignite message from the given raw message
+     * and hand it over to the subscribers.
      * @param[in] pvoidFullMsg void pointer pointing to the raw message
-     * @param[in] rnMsgLen message length
-     * @param[in] rnSocketId socket-id
-     * @return true if the message is successfully read and sent; false otherwise
+     * @param[in] nSocketId socket-id
+     * @return void
      */
-    bool ReadMsgAndSend(void *pvoidFullMsg, int &rnMsgLen, int &rnSocketId);
+    void DispatchMessage(const void *pvoidFullMsg, int nSocketId);
 
     //! Member variable to stores shutdown initiated status
     bool m_bIsShutDownInitiated = false;
@@ -158,11 +202,17 @@ private:
     //! Member variable to stores master socket descriptor
     ic_event::sockid m_masterSocket;
 
-    //! Constant variable to stores maximum clients 
-    static const int MAX_CLIENTS = 30;
+    //! Member variable to stores the epoll instance descriptor
+    int m_nPollFd = -1;
+
+    //! Member variable to stores maximum clients, 0 for no limit
+    unsigned int m_unMaxClients = 0;
+
+    //! Member variable to stores the connected clients
+    std::map<int, ClientConnection> m_mapConnections;
 
-    //! Member variable to stores array of socket descriptor 
-    ic_event::sockid m_clientSockets[MAX_CLIENTS];
+    //! Member variable to stores the clients having unread data
+    std::set<int> m_setPendingReads;
 
     /**
      * This class handle subscriber list item
@@ -31,10 +31,16 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <memory>
 #include "IClientConnector.h"
 
 namespace ic_core 
 {
+class CSharedEvent;
+
+//! Reference counted handle of an immutable event snapshot
+typedef std::shared_ptr<const CSharedEvent> CSharedEventPtr;
+
 /**
  * Interface class expose APIs necessary for handlers to receive various 
  * messages
@@ -58,6 +64,7 @@ public:
     {
         MsgType eType;              ///< Enum of message type
         std::string strPayloadJson; ///< String contains message payload
+        CSharedEventPtr pEvent;     ///< Parsed event, set for event messages
     } MsgPayload;
 
     /**
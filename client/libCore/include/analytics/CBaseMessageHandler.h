@@ -267,12 +267,12 @@ protected:
      * Method to dispatch event entries from map based on input parameter
      * @param[in] rstrEventID String containing event id
      * @param[in] rstrDomain String containing domain name
-     * @param[in] rstrSerEvent String containing serialized event
+     * @param[in] rpEvent Shared event to be dispatched
      * @return void
      */
     void DispatchEvent(const std::string &rstrEventID, 
                        const std::string &rstrDomain, 
-                       const std::string &rstrSerEvent);
+                       const CSharedEventPtr &rpEvent);
 
     //! Member variable to stores events domain and associated processor in map
     std::map <std::string, CEventProcessor*> m_mapEventProcessors;
@@ -30,6 +30,7 @@
 #include <bitset>
 #include <exception>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 #include "CIgniteMutex.h"
@@ -38,6 +39,8 @@
 
 namespace ic_core 
 {
+class CConfigSnapshot;
+
 /**
  * class CUploadMode handles different event upload modes over cloud
  */
@@ -147,20 +150,64 @@ private:
         eBATCH = 1 //! Batch upload mode
     };
 
+    /**
+     * Struct holding the upload modes read from one config snapshot. A state
+     * is never modified once published, a config change publishes a new one.
+     */
+    struct UploadModeState
+    {
+        //! Member variable stores version of config snapshot read from
+        unsigned long long m_ullConfigVersion;
+
+        //! Member variable stores configured event upload modes
+        std::bitset<2> m_ConfiguredModes;
+
+        //! Member variable stores default event upload mode
+        std::bitset<2> m_DefaultMode;
+
+        //! Member variable stores eventId as key and upload mode as value
+        std::map<std::string, std::bitset<2>> m_mapEventModeMap;
+
+        //! Member variable stores configured anonymous upload mode status
+        bool m_bAnonymousUploadMode;
+
+        //! Member variable stores configured store and forward status
+        bool m_bStoreAndForwardEnabled;
+    };
+
     /**
      * Default no-argument constructor.
      */
     CUploadMode();
 
+    /**
+     * Method to get the current upload mode state, the state is read again
+     * if the config snapshot changed since it was read
+     * @param void
+     * @return Current upload mode state
+     */
+    std::shared_ptr<const UploadModeState> GetState() const;
+
+    /**
+     * Method to read upload modes from the given config snapshot
+     * @param[in] rSnapshot Config snapshot
+     * @return Upload mode state
+     */
+    std::shared_ptr<const UploadModeState> ReadState(
+                                          const CConfigSnapshot &rSnapshot) const;
+
     /**
      * Method to update map of events and its upload mode based on configured 
      * event list and mode
      * @param[in] rjsonEventList configured event list,
      * @param[in] rstrMode configured upload mode
+     * @param[out] rmapEventModeMap map of events and its upload mode
      * @return void
      */
     void FillEventModeMap(const ic_utils::Json::Value &rjsonEventList, 
-                          const std::string &rstrMode);
+                          const std::string &rstrMode,
+                          std::map<std::string, std::bitset<2>>
+                                                    &rmapEventModeMap) const;
 
     /**
      * Method to return bitset value for configured upload mode, if config is 
@@ -170,7 +217,7 @@ private:
      * @return 2 bit space boolean value for upload mode
      */
     std::bitset<2> GetModeBitSet(const std::string &rstrMode, 
-                               std::bitset<2> defaultBitset = std::bitset<2>());
+                         std::bitset<2> defaultBitset = std::bitset<2>()) const;
 
     /**
      * Method to read and initialize configured events upload mode
@@ -184,11 +231,14 @@ private:
      * @param[in] rjsonSupported JSON object containing supported mode list
      * @param[in] rjsonEvents JSON object containing event supported list
      * @param[in] rTempConfiguredModes Bitset value of temp configured modes
+     * @param[out] rmapEventModeMap map of events and its upload mode
      * @return void
      */
     void ReadSupportedModes(const ic_utils::Json::Value &rjsonSupported,
                             const ic_utils::Json::Value &rjsonEvents,
-                            std::bitset<2> &rTempConfiguredModes);
+                            std::bitset<2> &rTempConfiguredModes,
+                            std::map<std::string, std::bitset<2>>
+                                                    &rmapEventModeMap) const;
 
     /**
      * Method to check if anonymous upload mode is supported or not based in 
@@ -196,24 +246,13 @@ private:
      * @param[in] rjsonUploadConfig JSON object containing upload config
      * @return true if mode is supported, false otherwise
      */
-    bool IsAnonymousUploadModeSupported(const ic_utils::Json::Value &rjsonUploadConfig);
-
-    //! Member variable stores configured event upload modes
-    std::bitset<2> m_ConfiguredModes;
-
-    //! Member variable stores default event upload mode
-    std::bitset<2> m_DefaultMode;
-
-    //! Member variable stores eventId as key and upload mode as value
-    std::map<std::string, std::bitset<2>> m_mapEventModeMap;
-
-    //! Member variable stores configured anonymous upload mode status
-    bool m_bAnonymousUploadMode;
+    bool IsAnonymousUploadModeSupported(
+                         const ic_utils::Json::Value &rjsonUploadConfig) const;
 
-    //! Member variable stores configured store and forward enablement status
-    bool m_bStoreAndForwardEnabled;
+    //! Member variable stores current upload mode state
+    mutable std::shared_ptr<const UploadModeState> m_pState;
 
-    //! Mutex variable
+    //! Mutex variable to serialize reading of upload mode state
     mutable ic_utils::CIgniteMutex m_DataLock;
 };
 } /* namespace ic_core */
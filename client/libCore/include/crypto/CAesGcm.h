@@ -100,6 +100,28 @@ public:
     int GcmDecrypt(const string &rstrBase64enctext, 
                    std::string &rstrDecyptedOut);
 
+    /**
+     * Method to implement AES-GCM encryption Algorithm without tag, returning
+     * the cipher text as is instead of base64 encoded
+     * @param[in] rstrPlaintext String containing plain text to encrypt
+     * @param[out] rstrCipherTextOut String containing AES-GCM encrypted data
+     * @return eGCM_SUCCESS for Encryption Successful, else eGCM_FAILURE for
+     * Encryption Failed
+     */
+    int GcmEncryptRaw(const std::string &rstrPlaintext,
+                      std::string &rstrCipherTextOut);
+
+    /**
+     * Method to implement AES-GCM decryption Algorithm for cipher text which
+     * is not base64 encoded, the counterpart of GcmEncryptRaw
+     * @param[in] rstrCipherText String containing data to be decrypted
+     * @param[out] rstrDecyptedOut String containing AES-GCM decrypted data
+     * @return eGCM_SUCCESS for Decryption Successful, else eGCM_FAILURE for
+     * Decryption Failed
+     */
+    int GcmDecryptRaw(const std::string &rstrCipherText,
+                      std::string &rstrDecyptedOut);
+
     #ifdef IC_UNIT_TEST
         friend class CAesGcmTest;
 
@@ -163,6 +185,25 @@ private:
      */
     AesGcmReturnCode InitGcmEncryptOperation();
 
+    /**
+     * Method to initialize initial gcm decryption operations
+     * @param void
+     * @return eGCM_PROCESS_CONT on successful initialization, otherwise return
+     * eGCM_FAILURE enum value
+     */
+    AesGcmReturnCode InitGcmDecryptOperation();
+
+    /**
+     * Method to decrypt cipher text with the decryption context
+     * @param[in] puchCipherText Cipher text to decrypt
+     * @param[in] nCiphertextLen Length of the cipher text
+     * @param[out] rstrDecyptedOut String containing AES-GCM decrypted data
+     * @return eGCM_SUCCESS for Decryption Successful, else eGCM_FAILURE for
+     * Decryption Failed
+     */
+    int GcmDecryptBytes(const unsigned char *puchCipherText,
+                        int nCiphertextLen, std::string &rstrDecyptedOut);
+
     //! Member variable to store encrypted cipher context
     EVP_CIPHER_CTX* m_pEncryptCtx;
 
@@ -174,6 +215,12 @@ private:
 
     //! Member variable to store IV value
     string m_strIV;
+
+    //! Flag indicating the key is set up in the encryption context
+    bool m_bEncryptKeySet;
+
+    //! Flag indicating the key is set up in the decryption context
+    bool m_bDecryptKeySet;
 };
 } // namespace ic_core
 #endif // CAES_GCM_H
@@ -28,6 +28,7 @@
 #define CIGNITE_DATA_SECURITY_H
 
 #include <string.h>
+#include <vector>
 #include "crypto/CAesGcm.h"
 
 using std::string;
@@ -72,6 +73,92 @@ public:
      * @return Decrypted data
      */
     string Decrypt(const string &rstrBase64enctext);
+
+    /**
+     * Method to encrypt data without base64 encoding the cipher text
+     * @param[in] rstrPlaintext String containing plain text to encrypt
+     * @return GCM encrypted data, empty string on failure
+     */
+    string EncryptBinary(const string &rstrPlaintext);
+
+    /**
+     * Method to decrypt GCM cipher text which is not base64 encoded, If
+     * AES-GCM decryption fails, fall back to AES decryption
+     * @param[in] rstrCipherText String containing AesGcm encrypted data
+     * @return Decrypted data
+     */
+    string DecryptBinary(const string &rstrCipherText);
+
+    /**
+     * Method to encrypt an event payload with the event encryption key. The
+     * cipher contexts and the key are kept per thread and reused across calls,
+     * hence this is cheaper than constructing an instance per event.
+     * The result is binary (see IsBinaryEvent) and is to be stored as a BLOB.
+     * @param[in] rstrEventData String containing event payload to encrypt
+     * @return GCM encrypted data in binary event format, empty on failure
+     */
+    static string EncryptEvent(const string &rstrEventData);
+
+    /**
+     * Method to decrypt an event payload encrypted with the event encryption
+     * key, using the per thread cipher contexts. Both the binary event format
+     * and the base64 text stored by earlier versions are accepted.
+     * @param[in] rstrBase64enctext String containing encrypted event payload
+     * @return Decrypted data
+     */
+    static string DecryptEvent(const string &rstrBase64enctext);
+
+    /**
+     * Method to encrypt a group of event payloads in place with the event
+     * encryption key. The calling thread's cipher contexts are reused for the
+     * whole group; large groups are optionally split across worker threads.
+     * @param[in/out] rvecEventData Event payloads, replaced by base64 encoded
+     * GCM encrypted data
+     * @param[in] unWorkers Maximum number of threads to process the group,
+     * including the calling thread
+     * @return void
+     */
+    static void EncryptEvents(std::vector<string> &rvecEventData,
+                              unsigned int unWorkers = 1);
+
+    /**
+     * Method to decrypt a group of encrypted event payloads in place with the
+     * event encryption key, the counterpart of EncryptEvents
+     * @param[in/out] rvecBase64enctext Base64 encoded encrypted event payloads,
+     * replaced by decrypted data
+     * @param[in] unWorkers Maximum number of threads to process the group,
+     * including the calling thread
+     * @return void
+     */
+    static void DecryptEvents(std::vector<string> &rvecBase64enctext,
+                              unsigned int unWorkers = 1);
+
+    /**
+     * Method to invalidate the cached event encryption key. Every thread
+     * derives the key again on its next event encryption/decryption; to be
+     * called when activation state or the encryption seed changes.
+     * @param void
+     * @return void
+     */
+    static void InvalidateEventKey();
+
+    /**
+     * Method to check whether an encrypted event payload is in the binary event
+     * format, i.e. a format marker followed by the GCM cipher text
+     * @param[in] rstrEventData String containing encrypted event payload
+     * @return True if binary, false if base64 text (or empty)
+     */
+    static bool IsBinaryEvent(const string &rstrEventData);
+
+    /**
+     * Method to convert a base64 encoded encrypted event payload into the
+     * binary event format, without decrypting it
+     * @param[in] rstrBase64enctext String containing base64 encoded encrypted
+     * event payload
+     * @return Payload in binary event format, empty string if the input is
+     * not valid base64
+     */
+    static string EventTextToBinary(const string &rstrBase64enctext);
     
     #ifdef IC_UNIT_TEST
         friend class CIgniteDataSecurityTest;
@@ -111,6 +111,13 @@ public:
      */
     ic_utils::Json::Value GetData() override;
 
+    /**
+     * Method to get read-only access to the event data without copying it
+     * @param void
+     * @return reference to the JSON object containing event data
+     */
+    const ic_utils::Json::Value &GetDataRef() const;
+
     /**
      * Method to check if the given field key is a member of data or not
      * @param[in] rstrKey String containing key value
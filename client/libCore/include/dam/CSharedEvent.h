@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+*******************************************************************************
+* \file CSharedEvent.h
+*
+* \brief This class/module provides an immutable, reference counted snapshot of
+* an event which is shared by all the consumers of the event ingest pipeline, so
+* that an event is parsed and serialized only once.
+*******************************************************************************
+*/
+
+#ifndef CSHARED_EVENT_H
+#define CSHARED_EVENT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "jsoncpp/json.h"
+#include "dam/CEventWrapper.h"
+
+namespace ic_core
+{
+class CSharedEvent;
+
+//! Reference counted handle of an immutable event snapshot
+typedef std::shared_ptr<const CSharedEvent> CSharedEventPtr;
+
+/**
+ * CSharedEvent class freezes a parsed event along with its serialized form.
+ * Once created, the snapshot is never modified, hence it can be handed over
+ * to multiple handlers/threads without copying or re-parsing the payload.
+ */
+class CSharedEvent
+{
+public:
+    /**
+     * Method to create snapshot from an already parsed event. The snapshot
+     * takes the ownership of the given event and serializes it once.
+     * @param[in] pEvent Event to be frozen; must not be used by the caller
+     *                   afterwards
+     * @return Shared snapshot of the event, NULL if pEvent is NULL
+     */
+    static CSharedEventPtr Create(CEventWrapper *pEvent);
+
+    /**
+     * Method to create snapshot from a serialized event. The given string is
+     * parsed once and retained as the serialized form of the snapshot.
+     * @param[in] rstrSerialized Serialized event JSON string
+     * @return Shared snapshot of the event
+     */
+    static CSharedEventPtr Create(const std::string &rstrSerialized);
+
+    /**
+     * Destructor
+     */
+    ~CSharedEvent();
+
+    /**
+     * Method to get the event id
+     * @param void
+     * @return Event id of the event
+     */
+    const std::string &GetEventId() const;
+
+    /**
+     * Method to get the event timestamp
+     * @param void
+     * @return Timestamp of the event in milliseconds
+     */
+    double GetTimestamp() const;
+
+    /**
+     * Method to get the event timezone
+     * @param void
+     * @return Timezone offset of the event in minutes
+     */
+    int GetTimezone() const;
+
+    /**
+     * Method to get the attachments of the event
+     * @param void
+     * @return vector containing attachments
+     */
+    const std::vector<std::string> &GetAttachments() const;
+
+    /**
+     * Method to get the event data
+     * @param void
+     * @return JSON object containing the event data
+     */
+    const ic_utils::Json::Value &GetData() const;
+
+    /**
+     * Method to get the serialized form of the event
+     * @param void
+     * @return Serialized event JSON string
+     */
+    const std::string &GetSerialized() const;
+
+    /**
+     * Method to get a modifiable copy of the event; to be used by the
+     * consumers which need to alter the event for their own purpose
+     * @param void
+     * @return Copy of the event
+     */
+    CEventWrapper GetEventCopy() const;
+
+    #ifdef IC_UNIT_TEST
+        friend class CSharedEventTest;
+    #endif
+
+private:
+    /**
+     * Parameterized constructor
+     * @param[in] pEvent Parsed event, ownership is taken by the snapshot
+     * @param[in] rstrSerialized Serialized form of the event
+     */
+    CSharedEvent(CEventWrapper *pEvent, const std::string &rstrSerialized);
+
+    /**
+     * Copy constructor is not supported; snapshots are shared by reference
+     */
+    CSharedEvent(const CSharedEvent &) = delete;
+
+    /**
+     * Assignment operator is not supported; snapshots are immutable
+     */
+    CSharedEvent &operator=(const CSharedEvent &) = delete;
+
+    //! Member variable holding the parsed event
+    std::unique_ptr<CEventWrapper> m_pEvent;
+
+    //! Member variable holding the serialized event
+    std::string m_strSerialized;
+
+    //! Member variable holding the event id
+    std::string m_strEventId;
+
+    //! Member variable holding the event timestamp
+    double m_dblTimestamp;
+
+    //! Member variable holding the event timezone
+    int m_nTimezone;
+
+    //! Member variable holding the event attachments
+    std::vector<std::string> m_vectAttachments;
+};
+} /* namespace ic_core */
+#endif /* CSHARED_EVENT_H */
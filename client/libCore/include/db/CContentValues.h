@@ -27,6 +27,7 @@
 #ifndef CCONTENT_VALUES_H
 #define CCONTENT_VALUES_H
 
+#include <set>
 #include <string>
 #include <vector>
 #include "jsoncpp/json.h"
@@ -99,6 +100,22 @@ public:
      * @return void
      */
     void Put(std::string strKey, double dblValue);
+
+    /**
+     * Method to put binary value based on key value, stored as a BLOB
+     * @param[in] strKey string containing key value
+     * @param[in] strValue string containing binary content value
+     * @return void
+     */
+    void PutBlob(std::string strKey, const std::string &strValue);
+
+    /**
+     * Method to check whether the value of the given key is binary, i.e. put
+     * by PutBlob; GetAsString returns binary values as is
+     * @param[in] strKey string containing key value
+     * @return true if value is binary, false otherwise
+     */
+    bool IsBlob(const std::string &strKey) const;
     
     /**
      * Method to get data as integer based on input parameter
@@ -148,6 +165,13 @@ public:
      */
     double GetAsDouble(std::string strKey, double dblDef = 0.0f);
 
+    /**
+     * Method to check if the value of the given key is an integer
+     * @param[in] strKey string containing key value
+     * @return true if the value is an integer, false otherwise
+     */
+    bool IsInteger(std::string strKey);
+
     /**
      * Method to get key
      * @param void
@@ -182,6 +206,9 @@ private:
 
     //! Member variable to instance of CDatabase class
     ic_utils::Json::Value m_jsonData;
+
+    //! Member variable to store keys of binary values
+    std::set<std::string> m_setBlobKeys;
 };
 } /* namespace ic_core */
 #endif /* CCONTENT_VALUES_H */
\ No newline at end of file
@@ -103,6 +103,9 @@ public:
     //! Constant key for 'GRANULARITY' string
     static const std::string COL_GRANULARITY;
 
+    //! Constant key for 'CHECKSUM' string
+    static const std::string COL_CHECKSUM;
+
     //! Constant key for 'MESSAGE_SENDER_STORE' string
     static const std::string MESSAGE_SENDER_STORE;
 
@@ -82,6 +82,41 @@ public:
                                                      std::vector<std::string>(),
                   const int nLimit = 0);
 
+    /**
+     * Method to query data from the database without materializing the result;
+     * suitable for scans whose result may be large
+     * @param[in] strTable string containing table name
+     * @param[in] rvecProjection vector containing data projection
+     * @param[in] rstrSelection sql command to be executed
+     * @param[in] rvecOrderBy vector containing order by details
+     * @param[in] nLimit query data limit
+     * @return instance of CStreamCursor class; NULL if query failed. Caller
+     * owns the cursor and must delete it after use.
+     */
+    CStreamCursor* QueryStream(const std::string strTable,
+                  const std::vector<std::string> &rvecProjection =
+                                                     std::vector<std::string>(),
+                  const std::string &rstrSelection = "",
+                  const std::vector<std::string> &rvecOrderBy =
+                                                     std::vector<std::string>(),
+                  const int nLimit = 0);
+
+    /**
+     * Method to get the plan the database uses to run the given query
+     * @param[in] strTable string containing table name
+     * @param[in] rvecProjection vector containing data projection
+     * @param[in] rstrSelection sql command to be executed
+     * @param[in] rvecOrderBy vector containing order by details
+     * @param[in] nLimit query data limit
+     * @return details of the query plan steps, one per line; empty if failed
+     */
+    std::string GetQueryPlan(const std::string strTable,
+                  const std::vector<std::string> &rvecProjection,
+                  const std::string &rstrSelection = "",
+                  const std::vector<std::string> &rvecOrderBy =
+                                                     std::vector<std::string>(),
+                  const int nLimit = 0);
+
     /**
      * Method to insert data in database based on input parameter
      * @param[in] strTable string containing table name
@@ -91,6 +126,15 @@ public:
      */
     long Insert(const std::string strTable, CContentValues *pData);
 
+    /**
+     * Method to insert multiple rows in database based on input parameter
+     * @param[in] strTable string containing table name
+     * @param[in] rvecData rows to be inserted
+     * @return number of rows successfully inserted; -1 for invalid input
+     */
+    int BulkInsert(const std::string strTable,
+                   std::vector<CContentValues> &rvecData);
+
     /**
      * Method to update data in database based on input parameter
      * @param[in] strTable string containing table name
@@ -101,6 +145,19 @@ public:
     bool Update(const std::string strTable, CContentValues *pData, 
                 const std::string &rstrSelection = "");
 
+    /**
+     * Method to update data in database, binding the selection arguments to
+     * the '?' parameters of the selection in order
+     * @param[in] strTable string containing table name
+     * @param[in] pData data to be updated
+     * @param[in] rstrSelection selection with one '?' per argument
+     * @param[in] rvecSelectionArgs arguments of the selection
+     * @return true if data is successfully updated, false otherwise
+     */
+    bool Update(const std::string strTable, CContentValues *pData,
+                const std::string &rstrSelection,
+                const std::vector<std::string> &rvecSelectionArgs);
+
     /**
      * Method to remove data from database based on input parameter
      * @param[in] strTable string containing table name
@@ -110,6 +167,40 @@ public:
     bool Remove(const std::string strTable, 
                 const std::string &rstrSelection = "");
 
+    /**
+     * Method to fill the temporary ID set with the given IDs, replacing its
+     * previous content. The ID set is matched by RemoveByIdSet and
+     * UpdateByIdSet. The set is shared by all users of the connection, so the
+     * calls must be made inside a transaction opened by StartTransaction();
+     * if it cannot be opened the set must not be used.
+     * @param[in] rvecIds IDs of the set
+     * @return true if the ID set is filled, false otherwise
+     */
+    bool BindIdSet(const std::vector<long long> &rvecIds);
+
+    /**
+     * Method to remove the rows whose column value is in the ID set
+     * @param[in] strTable string containing table name
+     * @param[in] rstrColumn column matched against the ID set
+     * @param[in] rstrSelection additional selection, may be empty
+     * @return true if data is successfully removed, false otherwise
+     */
+    bool RemoveByIdSet(const std::string strTable,
+                       const std::string &rstrColumn,
+                       const std::string &rstrSelection = "");
+
+    /**
+     * Method to update the rows whose column value is in the ID set
+     * @param[in] strTable string containing table name
+     * @param[in] pData data to be updated
+     * @param[in] rstrColumn column matched against the ID set
+     * @param[in] rstrSelection additional selection, may be empty
+     * @return true if data is successfully updated, false otherwise
+     */
+    bool UpdateByIdSet(const std::string strTable, CContentValues *pData,
+                       const std::string &rstrColumn,
+                       const std::string &rstrSelection = "");
+
     /**
      * Method to start transaction
      * @param void
@@ -192,6 +283,16 @@ public:
      */
     bool VacuumDb();
 
+    /**
+     * Method to release at most the given number of free pages of the DB file
+     * to the file system; meant to be called during idle periods
+     * @param[in] unMaxPages maximum number of pages to be released; 0 for the
+     * configured 'DAM.Database.vacuumPagesPerStep'
+     * @return number of free pages still left in the file; 0 if incremental
+     * vacuum mode is not enabled, -1 on error
+     */
+    int ReclaimFreePages(unsigned int unMaxPages = 0);
+
 private:
     /**
      * Default no-argument constructor.
@@ -200,6 +301,10 @@ private:
 
     //! Member variable to instance of CDatabase class
     CDatabase *m_pSQLiteDbInstance;
+
+#ifdef IC_UNIT_TEST
+    friend class CDataBaseFacadeTest;
+#endif
 };
 } /* namespace ic_core */
 #endif
@@ -37,6 +37,7 @@
 #include "CIgniteMutex.h"
 #include "CContentValues.h"
 #include "db/CDataBaseConst.h"
+#include "db/CSqlException.h"
 
 namespace ic_core 
 {
@@ -53,6 +54,7 @@ struct SqlQuery
 };
 
 class CDatabase;
+class CDbCheckpointer;
 
 /**
  * This class provides methods to operate on data queried from database
@@ -245,6 +247,135 @@ private:
     friend class CDatabase;
 };
 
+/**
+ * This class provides forward-only access to data queried from database.
+ * Unlike CCursor, rows are not materialized; each MoveToNext() steps the
+ * underlying sqlite statement, so memory use does not grow with the number of
+ * rows. The cursor must be deleted before the database connection is closed.
+ */
+class CStreamCursor
+{
+public:
+    /**
+     * Destructor
+     */
+    ~CStreamCursor();
+
+    /**
+     * Method to move to the next row of the query result; must be called once
+     * before reading the first row
+     * @param void
+     * @return true if a row is available, false if the result is exhausted or
+     * on error
+     */
+    bool MoveToNext();
+
+    /**
+     * Method to get column names
+     * @param void
+     * @return vector of column names
+     */
+    std::vector<std::string> GetColumnNames();
+
+    /**
+     * Method to get column index based on input parameter
+     * @param[in] rstrColName column name
+     * @return column index as integer; -1 if column is not part of the query
+     */
+    int GetColumnIndex(const std::string &rstrColName);
+
+    /**
+     * Method to check if the value of the given column is NULL
+     * @param[in] nColIndex column index
+     * @return true if value is NULL or column index is invalid, false otherwise
+     */
+    bool IsNull(int nColIndex);
+
+    /**
+     * Method to read the value of the given column based on it's index
+     * @param[in] nColIndex column index
+     * @return returns column value as integer; if any error, returns 0
+     */
+    int GetInt(int nColIndex);
+
+    /**
+     * Method to read the value of the given column based on it's index
+     * @param[in] nColIndex column index
+     * @return returns column value as 64 bit integer; if any error, returns 0
+     */
+    long long GetLong(int nColIndex);
+
+    /**
+     * Method to read the value of the given column based on it's index
+     * @param[in] nColIndex column index
+     * @return returns column value as double; if any error, returns 0.0
+     */
+    double GetDouble(int nColIndex);
+
+    /**
+     * Method to read the value of the given column without copying it. The
+     * returned buffer is owned by the cursor and is valid until the next call
+     * of MoveToNext().
+     * @param[in] nColIndex column index
+     * @param[out] rnLength length of the text in bytes
+     * @return pointer to the NUL terminated text; NULL if value is NULL or on
+     * error
+     */
+    const char* GetText(int nColIndex, size_t &rnLength);
+
+    /**
+     * Method to read the value of the given column without copying it. The
+     * returned buffer is owned by the cursor and is valid until the next call
+     * of MoveToNext().
+     * @param[in] nColIndex column index
+     * @param[out] rnLength length of the blob in bytes
+     * @return pointer to the blob; NULL if value is NULL, empty or on error
+     */
+    const void* GetBlob(int nColIndex, size_t &rnLength);
+
+    /**
+     * Method to read the value of the given column based on it's index
+     * @param[in] nColIndex column index
+     * @return returns column value as string; if any error, returns empty
+     * string
+     */
+    std::string GetString(int nColIndex);
+
+private:
+    /**
+     * Parameterized Constructor
+     * @param[in] pDB Sql database
+     * @param[in] pQuery Sql query
+     */
+    CStreamCursor(sqlite3 *pDB, SqlQuery *pQuery);
+
+    /**
+     * Method to check if a row is available and the given column index is
+     * within the query projection
+     * @param[in] nColIndex column index
+     * @return true if column can be read, false otherwise
+     */
+    bool IsReadable(int nColIndex);
+
+    //! Member variable to store vector of columns in data queried using sql query
+    std::vector<std::string> m_vecColumns;
+
+    //! Member variable to hold the prepared statement of the query
+    sqlite3_stmt *m_pStmt;
+
+    //! Member variable to indicate if the statement is positioned on a row
+    bool m_bHasRow;
+
+    //! Member variable to indicate if the query result is exhausted
+    bool m_bExhausted;
+
+    /*
+     * Declared CDatabase as a friend class to access private members of
+     * CStreamCursor class
+     */
+    friend class CDatabase;
+};
+
 /**
  * This class provides methods to manage the database file in terms of
  * - managing database tables
@@ -279,6 +410,42 @@ public:
                                                      std::vector<std::string>(),
                   const int nLimit = 0);
 
+    /**
+     * Method to query data from the database without materializing the result;
+     * rows are fetched one at a time while iterating the returned cursor
+     * @param[in] strTable string containing table name
+     * @param[in] rvecProjection vector containing data projection
+     * @param[in] rstrSelection sql command to be executed
+     * @param[in] rvecOrderBy vector containing order by details
+     * @param[in] nLimit query data limit
+     * @return instance of CStreamCursor class; NULL if query failed
+     */
+    CStreamCursor* QueryStream(const std::string strTable,
+                  const std::vector<std::string> &rvecProjection =
+                                                     std::vector<std::string>(),
+                  const std::string &rstrSelection = "",
+                  const std::vector<std::string> &rvecOrderBy =
+                                                     std::vector<std::string>(),
+                  const int nLimit = 0);
+
+    /**
+     * Method to get the plan sqlite uses to run the given query; meant for
+     * verifying that a query is served by an index
+     * @param[in] strTable string containing table name
+     * @param[in] rvecProjection vector containing data projection
+     * @param[in] rstrSelection sql command to be executed
+     * @param[in] rvecOrderBy vector containing order by details
+     * @param[in] nLimit query data limit
+     * @return details of the 'EXPLAIN QUERY PLAN' steps, one per line; empty
+     * if query failed
+     */
+    std::string GetQueryPlan(const std::string strTable,
+                  const std::vector<std::string> &rvecProjection,
+                  const std::string &rstrSelection = "",
+                  const std::vector<std::string> &rvecOrderBy =
+                                                     std::vector<std::string>(),
+                  const int nLimit = 0);
+
     /**
      * Method to insert data in database based on input parameter
      * @param[in] strTable string containing table name
@@ -289,7 +456,21 @@ public:
     long Insert(const std::string strTable, CContentValues *pData);
 
     /**
-     * Method to update data in database based on input parameter
+     * Method to insert multiple rows in database based on input parameter.
+     * Rows having the same set of columns share one prepared statement; the
+     * caller is expected to wrap the call in a transaction.
+     * @param[in] strTable string containing table name
+     * @param[in] rvecData rows to be inserted
+     * @return number of rows successfully inserted
+     */
+    int BulkInsert(const std::string strTable,
+                   std::vector<CContentValues> &rvecData);
+
+    /**
+     * Method to update data in database based on input parameter. A selection
+     * carrying literal values changes with every call, so its statement is
+     * not kept in the statement cache; use the overload taking selection
+     * arguments for repeated updates.
      * @param[in] strTable string containing table name
      * @param[in] pData data to be updated
      * @param[in] rstrSelection sql command to be executed
@@ -298,6 +479,20 @@ public:
     bool Update(const std::string strTable, CContentValues *pData, 
                 const std::string &rstrSelection = "");
 
+    /**
+     * Method to update data in database, binding the selection arguments to
+     * the '?' parameters of the selection in order. The statement text does
+     * not depend on the arguments and stays in the statement cache.
+     * @param[in] strTable string containing table name
+     * @param[in] pData data to be updated
+     * @param[in] rstrSelection selection with one '?' per argument
+     * @param[in] rvecSelectionArgs arguments of the selection
+     * @return true if data is successfully updated, false otherwise
+     */
+    bool Update(const std::string strTable, CContentValues *pData,
+                const std::string &rstrSelection,
+                const std::vector<std::string> &rvecSelectionArgs);
+
     /**
      * Method to remove data from database based on input parameter
      * @param[in] strTable string containing table name
@@ -307,6 +502,40 @@ public:
     bool Remove(const std::string strTable, 
                 const std::string &rstrSelection = "");
 
+    /**
+     * Method to fill the temporary ID set with the given IDs, replacing its
+     * previous content. The ID set is matched by RemoveByIdSet and
+     * UpdateByIdSet. The set is shared by all users of the connection, so the
+     * calls must be made inside a transaction opened by StartTransaction();
+     * if it cannot be opened the set must not be used.
+     * @param[in] rvecIds IDs of the set
+     * @return true if the ID set is filled, false otherwise
+     */
+    bool BindIdSet(const std::vector<long long> &rvecIds);
+
+    /**
+     * Method to remove the rows whose column value is in the ID set
+     * @param[in] strTable string containing table name
+     * @param[in] rstrColumn column matched against the ID set
+     * @param[in] rstrSelection additional selection, may be empty
+     * @return true if data is successfully removed, false otherwise
+     */
+    bool RemoveByIdSet(const std::string strTable,
+                       const std::string &rstrColumn,
+                       const std::string &rstrSelection = "");
+
+    /**
+     * Method to update the rows whose column value is in the ID set
+     * @param[in] strTable string containing table name
+     * @param[in] pData data to be updated
+     * @param[in] rstrColumn column matched against the ID set
+     * @param[in] rstrSelection additional selection, may be empty
+     * @return true if data is successfully updated, false otherwise
+     */
+    bool UpdateByIdSet(const std::string strTable, CContentValues *pData,
+                       const std::string &rstrColumn,
+                       const std::string &rstrSelection = "");
+
     /**
      * Method to start transaction
      * @param void
@@ -373,12 +602,27 @@ public:
      */
     bool VacuumDb();
 
+    /**
+     * Method to release free pages of the DB file to the file system, at most
+     * the given number per call. Works only in incremental vacuum mode.
+     * @param[in] unMaxPages maximum number of pages to be released; 0 for the
+     * configured 'DAM.Database.vacuumPagesPerStep'
+     * @return number of free pages still left in the file; 0 if incremental
+     * vacuum mode is not enabled, -1 on error
+     */
+    int ReclaimFreePages(unsigned int unMaxPages = 0);
+
 private:
     /**
      * Default no-argument constructor.
      */
     CDatabase();
 
+    /**
+     * Destructor
+     */
+    ~CDatabase();
+
     /**
      * Method to open database
      * @param void
@@ -479,6 +723,13 @@ private:
      */
     bool CreateEventStoreTable();
 
+    /**
+     * Method to create the secondary indexes of event store table
+     * @param void
+     * @return true if indexes are successfully created, false otherwise
+     */
+    bool CreateEventStoreIndexes();
+
     /**
      * Method to create invalid event store table
      * @param void
@@ -535,6 +786,44 @@ private:
      */
     void SetTempDirPragma();
 
+    /**
+     * Method to apply the configured journal mode and synchronous level to
+     * the connection, starting the checkpoint thread if WAL mode is enabled
+     * @param void
+     * @return void
+     */
+    void ConfigureJournalMode();
+
+    /**
+     * Method to stop the checkpoint thread and release it along with its
+     * connection; a later ConfigureJournalMode starts a new one
+     * @param void
+     * @return void
+     */
+    void StopCheckpointer();
+
+    /**
+     * Method to apply the configured auto_vacuum mode, migrating the existing
+     * database file with a one time full vacuum if the mode changed
+     * @param void
+     * @return void
+     */
+    void ConfigureAutoVacuum();
+
+    /**
+     * Method to get the auto_vacuum mode of the database file
+     * @param void
+     * @return 0 for NONE, 1 for FULL, 2 for INCREMENTAL; -1 on error
+     */
+    int GetAutoVacuum();
+
+    /**
+     * Method to read an integer valued pragma of the database
+     * @param[in] rstrPragma name of the pragma
+     * @return value of the pragma; -1 on error
+     */
+    int GetPragmaValue(const std::string &rstrPragma);
+
     /**
      * Method to check and create table based on given error message
      * @param[in] strErrMsg string containing error message
@@ -679,6 +968,31 @@ private:
      */
     void UpgradeVersionFrom16To17();
 
+    /**
+     * Method to upgrade database version from 17 to 18 by creating the
+     * secondary indexes of event store table
+     * @param void
+     * @return void
+     */
+    void UpgradeVersionFrom17To18();
+
+    /**
+     * Method to upgrade database version from 18 to 19 by converting the base64
+     * encrypted event payloads of event, alert and invalid event stores into
+     * binary event format BLOBs
+     * @param void
+     * @return void
+     */
+    void UpgradeVersionFrom18To19();
+
+    /**
+     * Method to upgrade database version from 19 to 20 by adding the checksum
+     * column of the plain event payload to event and alert stores
+     * @param void
+     * @return void
+     */
+    void UpgradeVersionFrom19To20();
+
     /**
      * Method to process settings store config value based on input parameter
      * @param[in] rcontentValues content value
@@ -695,6 +1009,74 @@ private:
      */
     void CreateTables(const std::string &rstrTableName);
 
+    /**
+     * Method to handle the error occurred while executing sql statement
+     * @param[in] rEx exception describing the error
+     * @return void
+     */
+    void HandleSqlException(CSqlException &rEx);
+
+    /**
+     * Method to execute the given sql statement as prepared statement, binding
+     * the values of the given columns to its parameters in order
+     * @param[in] rstrSql SQL statement with one parameter per column
+     * @param[in] rData data holding the values to be bound
+     * @param[in] rvecColumns columns whose values are to be bound
+     * @param[out] pllRowId row id of the inserted row, ignored if NULL
+     * @param[in] pvecArgs arguments bound as text after the column values,
+     * ignored if NULL
+     * @param[in] bCache true to keep the statement in the statement cache,
+     * false to finalize it after execution
+     * @return 0 if sql statement is successfully executed, non-zero sqlite
+     * error-code otherwise
+     */
+    int ExecuteStatement(const std::string &rstrSql, CContentValues &rData,
+                         const std::vector<std::string> &rvecColumns,
+                         long long *pllRowId = NULL,
+                         const std::vector<std::string> *pvecArgs = NULL,
+                         const bool bCache = true);
+
+    /**
+     * Method to build and execute the update statement of the given table
+     * @param[in] strTable string containing table name
+     * @param[in] pData data to be updated
+     * @param[in] rstrSelection selection of the rows to be updated
+     * @param[in] pvecSelectionArgs arguments of the selection, ignored if NULL
+     * @param[in] bCache true to keep the statement in the statement cache
+     * @return true if data is successfully updated, false otherwise
+     */
+    bool ExecuteUpdate(const std::string &strTable, CContentValues *pData,
+                       const std::string &rstrSelection,
+                       const std::vector<std::string> *pvecSelectionArgs,
+                       const bool bCache);
+
+    /**
+     * Method to get prepared statement of the given sql from the statement
+     * cache, preparing and caching it if not found. Must be called with
+     * sqlite mutex locked.
+     * @param[in] rstrSql SQL statement
+     * @param[out] ppStmt prepared statement
+     * @return 0 if statement is available, non-zero sqlite error-code otherwise
+     */
+    int GetStatement(const std::string &rstrSql, sqlite3_stmt **ppStmt);
+
+    /**
+     * Method to finalize all the cached prepared statements. Must be called
+     * with sqlite mutex locked.
+     * @param void
+     * @return void
+     */
+    void FinalizeStatements();
+
+    //! Type of the prepared statement cache entries; sql and statement
+    typedef std::list<std::pair<std::string, sqlite3_stmt*> > StatementList;
+
+    //! Prepared statements, most recently used first
+    StatementList m_listStatements;
+
+    //! Prepared statements indexed by their sql
+    std::map<std::string, StatementList::iterator> m_mapStatements;
+
     //! Mutex variable
     ic_utils::CIgniteMutex m_QueryLock;
 
@@ -713,8 +1095,27 @@ private:
     //! Mutex variable
     ic_utils::CIgniteMutex m_WaitMutex;
 
+    //! Member variable to store if WAL journal mode is configured
+    bool m_bWalMode;
+
+    //! Member variable to store the configured synchronous level
+    std::string m_strSynchronous;
+
+    //! Member variable to store if incremental vacuum mode is configured
+    bool m_bIncrementalVacuum;
+
+    //! Member variable to store number of pages reclaimed per vacuum step
+    unsigned int m_unVacuumPagesPerStep;
+
+    //! Member variable to hold the WAL checkpoint thread
+    CDbCheckpointer *m_pCheckpointer;
+
     //! Member variable to instance of CUploadMode class
     CUploadMode *m_pUploadMode;
+
+#ifdef IC_UNIT_TEST
+    friend class CDataBaseFacadeTest;
+#endif
 };
 } /* namespace ic_core */
 #endif /* CDATABASE_H */
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+*******************************************************************************
+* \file CDbCheckpointer.h
+*
+* \brief This class/module implements the background checkpointing of the
+* database write-ahead log
+*******************************************************************************
+*/
+
+#ifndef CDB_CHECKPOINTER_H
+#define CDB_CHECKPOINTER_H
+
+#include <sqlite3.h>
+#include <string>
+#include "CIgniteThread.h"
+#include "CIgniteMutex.h"
+
+namespace ic_core
+{
+/**
+ * This class checkpoints the write-ahead log of a database running in WAL
+ * journal mode, so that writers never have to do it inline. It uses its own
+ * connection, hence checkpoints do not hold the connection of the writer.
+ * - a passive checkpoint is run once no commit happened for the idle period
+ * - a truncate checkpoint is run as soon as the log exceeds the size limit
+ */
+class CDbCheckpointer : public ic_utils::CIgniteThread
+{
+public:
+    /**
+     * Parameterized Constructor
+     * @param[in] unIdleMs time without commits after which the log is
+     * checkpointed passively, in milliseconds
+     * @param[in] ullTruncateBytes log size at which the log is checkpointed and
+     * truncated; 0 disables size based truncation
+     */
+    CDbCheckpointer(unsigned int unIdleMs, unsigned long long ullTruncateBytes);
+
+    /**
+     * Destructor
+     */
+    virtual ~CDbCheckpointer();
+
+    /**
+     * Method to open the connection used for checkpointing
+     * @param[in] rstrDBPath path of the database file
+     * @return true if connection is opened, false otherwise
+     */
+    bool OpenConnection(const std::string &rstrDBPath);
+
+    /**
+     * Method to close the connection used for checkpointing; waits for a
+     * running checkpoint to finish
+     * @param void
+     * @return void
+     */
+    void CloseConnection();
+
+    /**
+     * Method to notify a commit to the write-ahead log. Meant to be called
+     * from the wal hook of the writer's connection.
+     * @param[in] nWalPages number of pages in the log after the commit
+     * @return void
+     */
+    void NotifyCommit(int nWalPages);
+
+    /**
+     * Method to stop the checkpointing thread
+     * @param void
+     * @return void
+     */
+    void StopCheckpointer();
+
+    /**
+     * Overriding CIgniteThread::Run() method
+     * @see CIgniteThread::Run()
+     */
+    void Run() override;
+
+private:
+    /**
+     * Method to run a checkpoint of the given mode on the checkpoint connection
+     * @param[in] nMode sqlite checkpoint mode
+     * @param[out] rbComplete true if every frame of the log is checkpointed
+     * @return sqlite result code of the checkpoint
+     */
+    int Checkpoint(int nMode, bool &rbComplete);
+
+    //! Time without commits after which a passive checkpoint is run
+    unsigned int m_unIdleMs;
+
+    //! Log size at which a truncate checkpoint is run; 0 if disabled
+    unsigned long long m_ullTruncateBytes;
+
+    //! Page size of the database, used to convert log pages to bytes
+    int m_nPageSize;
+
+    //! Connection used for checkpointing
+    sqlite3 *m_pDB;
+
+    //! Mutex guarding the checkpoint connection
+    ic_utils::CIgniteMutex m_ConnectionMutex;
+
+    //! Mutex guarding the commit state below
+    ic_utils::CIgniteMutex m_StateMutex;
+
+    //! Condition to wake the thread for truncation or stop
+    ic_utils::CThreadCondition m_StateCondition;
+
+    //! Monotonic time of the last commit in milliseconds
+    unsigned long long m_ullLastCommitMs;
+
+    //! Number of commits notified so far
+    unsigned long long m_ullCommitCount;
+
+    //! Flag indicating the log has frames not yet checkpointed
+    bool m_bWalDirty;
+
+    //! Flag indicating a truncate checkpoint is requested
+    bool m_bTruncateRequested;
+
+    //! Flag indicating the thread is asked to stop
+    bool m_bStop;
+
+    //! Number of passive checkpoints run
+    unsigned long long m_ullPassiveCount;
+
+    //! Number of truncate checkpoints run
+    unsigned long long m_ullTruncateCount;
+
+#ifdef IC_UNIT_TEST
+    friend class CDbCheckpointerTest;
+#endif
+};
+} /* namespace ic_core */
+#endif /* CDB_CHECKPOINTER_H */
@@ -20,6 +20,7 @@
 #include "CIgniteLog.h"
 #include "CIgniteConfig.h"
 #include "db/CLocalConfig.h"
+#include "dam/CSharedEvent.h"
 
 //! Macro for CBaseMessageHandler string
 #ifdef PREFIX
@@ -135,28 +136,32 @@ void CBaseMessageHandler::NotifyMessage(MsgPayload stMsgPayload)
 void CBaseMessageHandler::ProcessEventTypeMessage(const MsgPayload 
                                                   &rstMsgPayload)
 {
-    CEventWrapper event;
-    event.JsonToEvent(rstMsgPayload.strPayloadJson);
-    std::string strEventID = event.GetEventId();
+    // Reuse the event parsed by the ingest pipeline, parse only if not given
+    CSharedEventPtr pEvent = rstMsgPayload.pEvent;
+    if (!pEvent)
+    {
+        pEvent = CSharedEvent::Create(rstMsgPayload.strPayloadJson);
+    }
+    const std::string &rstrEventID = pEvent->GetEventId();
 
-    HCPLOG_I << "Processing Event ~ " << rstMsgPayload.strPayloadJson;
+    HCPLOG_I << "Processing Event ~ " << pEvent->GetSerialized();
 
     // Send the event to respective processor
-    if (m_jsonEventDomainMap[strEventID].isArray())
+    if (m_jsonEventDomainMap[rstrEventID].isArray())
     {
         for (int nItr = 0; 
-             nItr < m_jsonEventDomainMap[strEventID].size(); 
+             nItr < m_jsonEventDomainMap[rstrEventID].size(); 
              nItr++)
         {
-            DispatchEvent(strEventID, 
-                          m_jsonEventDomainMap[strEventID][nItr].asString(),
-                          rstMsgPayload.strPayloadJson);
+            DispatchEvent(rstrEventID, 
+                          m_jsonEventDomainMap[rstrEventID][nItr].asString(),
+                          pEvent);
         }
     }
     else
     {
-        DispatchEvent(strEventID, m_jsonEventDomainMap[strEventID].asString(),
-                      rstMsgPayload.strPayloadJson);
+        DispatchEvent(rstrEventID, m_jsonEventDomainMap[rstrEventID].asString(),
+                      pEvent);
     }
 }
 
@@ -207,17 +212,17 @@ bool CBaseMessageHandler::ProcessNotificationTypeMessage(const MsgPayload
 
 void CBaseMessageHandler::DispatchEvent(const std::string &rstrEventID, 
                                         const std::string &rstrDomain, 
-                                        const std::string &rstrSerEvent)
+                                        const CSharedEventPtr &rpEvent)
 {
-    CEventWrapper event;
-    event.JsonToEvent(rstrSerEvent);
-
     std::map<std::string, CEventProcessor*>::iterator iter = 
                                           m_mapEventProcessors.find(rstrDomain);
     if (m_mapEventProcessors.end() != iter && NULL != iter->second) 
     {
         HCPLOG_I << "Sending event " << rstrEventID << 
                    "[Domain:" << rstrDomain << "] to handler...";
+
+        // processors may alter the event, hence each gets its own copy
+        CEventWrapper event = rpEvent->GetEventCopy();
         iter->second->ProcessEvent(event);
     } 
     else 
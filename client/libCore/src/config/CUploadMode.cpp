@@ -38,20 +38,50 @@ CUploadMode::CUploadMode()
 void CUploadMode::Init()
 {
     ic_utils::CScopeLock lock(m_DataLock);
-    m_ConfiguredModes.reset();
-    m_DefaultMode.reset();
-    m_mapEventModeMap.clear();
-    m_ConfiguredModes.set(eSTREAM);
-    m_DefaultMode.set(eSTREAM);
-
-    ic_utils::Json::Value jsonUploadConfig = 
-                        CIgniteConfig::GetInstance()->GetJsonValue("uploadMode");
-    if (jsonUploadConfig != ic_utils::Json::Value::nullRef) 
+    std::atomic_store(&m_pState,
+                      ReadState(*CIgniteConfig::GetInstance()->GetSnapshot()));
+}
+
+std::shared_ptr<const CUploadMode::UploadModeState> CUploadMode::GetState() const
+{
+    std::shared_ptr<const UploadModeState> pState = std::atomic_load(&m_pState);
+    if (pState->m_ullConfigVersion != 
+        CIgniteConfig::GetInstance()->GetSnapshotVersion())
+    {
+        ic_utils::CScopeLock lock(m_DataLock);
+        std::shared_ptr<const CConfigSnapshot> pSnapshot = 
+                                      CIgniteConfig::GetInstance()->GetSnapshot();
+
+        // Another reader may have read the new snapshot meanwhile
+        pState = std::atomic_load(&m_pState);
+        if (pState->m_ullConfigVersion != pSnapshot->GetVersion())
+        {
+            HCPLOG_D << "config changed, reading upload modes again";
+            pState = ReadState(*pSnapshot);
+            std::atomic_store(&m_pState, pState);
+        }
+    }
+    return pState;
+}
+
+std::shared_ptr<const CUploadMode::UploadModeState> CUploadMode::ReadState(
+                                          const CConfigSnapshot &rSnapshot) const
+{
+    std::shared_ptr<UploadModeState> pState(new UploadModeState());
+    pState->m_ullConfigVersion = rSnapshot.GetVersion();
+    pState->m_ConfiguredModes.set(eSTREAM);
+    pState->m_DefaultMode.set(eSTREAM);
+    pState->m_bAnonymousUploadMode = false;
+    pState->m_bStoreAndForwardEnabled = false;
+
+    const ic_utils::Json::Value &rjsonUploadConfig = 
+                                            rSnapshot.GetJsonValue("uploadMode");
+    if (rjsonUploadConfig != ic_utils::Json::Value::nullRef) 
     {
         HCPLOG_I << "read uploadMode config";
         std::bitset<2> tempConfiguredModes;
-        ic_utils::Json::Value jsonSupported = jsonUploadConfig["supported"];
-        ic_utils::Json::Value jsonEvents = jsonUploadConfig["events"];
+        ic_utils::Json::Value jsonSupported = rjsonUploadConfig["supported"];
+        const ic_utils::Json::Value &rjsonEvents = rjsonUploadConfig["events"];
 
         if (jsonSupported == ic_utils::Json::Value::nullRef) 
         {
@@ -64,49 +94,50 @@ void CUploadMode::Init()
         }
 
         HCPLOG_I << "read supported modes";
-        ReadSupportedModes(jsonSupported, jsonEvents, tempConfiguredModes);
+        ReadSupportedModes(jsonSupported, rjsonEvents, tempConfiguredModes,
+                           pState->m_mapEventModeMap);
 
-        if (jsonEvents != ic_utils::Json::Value::nullRef && 
-            jsonUploadConfig["events"].isMember("default"))
+        if (rjsonEvents != ic_utils::Json::Value::nullRef && 
+            rjsonEvents.isMember("default"))
         {
-            m_DefaultMode = GetModeBitSet(jsonUploadConfig["events"]["default"]
-                                               .asString(),tempConfiguredModes);
+            pState->m_DefaultMode = GetModeBitSet(
+                      rjsonEvents["default"].asString(), tempConfiguredModes);
 
             /*
              * Default mode must contain configured modes
              */
-            m_DefaultMode &= tempConfiguredModes;
+            pState->m_DefaultMode &= tempConfiguredModes;
         } 
         else
         {
-            m_DefaultMode = tempConfiguredModes;
+            pState->m_DefaultMode = tempConfiguredModes;
         }
 
-        HCPLOG_I << "defaultMode :" << m_DefaultMode;
-        m_ConfiguredModes = tempConfiguredModes;
+        HCPLOG_I << "defaultMode :" << pState->m_DefaultMode;
+        pState->m_ConfiguredModes = tempConfiguredModes;
 
-        m_bAnonymousUploadMode = IsAnonymousUploadModeSupported(jsonUploadConfig);
+        pState->m_bAnonymousUploadMode = 
+                              IsAnonymousUploadModeSupported(rjsonUploadConfig);
 
-        HCPLOG_I << "Anonymous upload :" << m_bAnonymousUploadMode;
+        HCPLOG_I << "Anonymous upload :" << pState->m_bAnonymousUploadMode;
 
-        if (jsonUploadConfig.isMember("storeAndForward") && 
-            jsonUploadConfig["storeAndForward"].isBool()) 
+        if (rjsonUploadConfig.isMember("storeAndForward") && 
+            rjsonUploadConfig["storeAndForward"].isBool()) 
         {
-            m_bStoreAndForwardEnabled = 
-                                   jsonUploadConfig["storeAndForward"].asBool();
+            pState->m_bStoreAndForwardEnabled = 
+                                  rjsonUploadConfig["storeAndForward"].asBool();
         }
-        else 
-        {
-            m_bStoreAndForwardEnabled = false;
-        }
-        HCPLOG_I << "Store and Forward :" << m_bStoreAndForwardEnabled;
+        HCPLOG_I << "Store and Forward :" << pState->m_bStoreAndForwardEnabled;
     }
-    HCPLOG_I << "configuredModes :" <<m_ConfiguredModes;
+    HCPLOG_I << "configuredModes :" << pState->m_ConfiguredModes;
+    return pState;
 }
 
 void CUploadMode::ReadSupportedModes(const ic_utils::Json::Value &rjsonSupported,
                                      const ic_utils::Json::Value &rjsonEvents,
-                                     std::bitset<2> &rTempConfiguredModes)
+                                     std::bitset<2> &rTempConfiguredModes,
+                                     std::map<std::string, std::bitset<2>>
+                                                    &rmapEventModeMap) const
 {
     for (int nIval = 0; nIval < rjsonSupported.size(); nIval++)
     {
@@ -115,12 +146,13 @@ void CUploadMode::ReadSupportedModes(const ic_utils::Json::Value &rjsonSupported
         rTempConfiguredModes |= GetModeBitSet(strMode);
         if (rjsonEvents != ic_utils::Json::Value::nullRef)
         {
-            FillEventModeMap(rjsonEvents, strMode);
+            FillEventModeMap(rjsonEvents, strMode, rmapEventModeMap);
         }
     }
 }
 
-bool CUploadMode::IsAnonymousUploadModeSupported(const ic_utils::Json::Value &rjsonUploadConfig)
+bool CUploadMode::IsAnonymousUploadModeSupported(
+                          const ic_utils::Json::Value &rjsonUploadConfig) const
 {
     if (rjsonUploadConfig.isMember("anonymousUpload") && 
         rjsonUploadConfig["anonymousUpload"].isBool()) 
@@ -151,7 +183,7 @@ CUploadMode* CUploadMode::GetInstance()
 }
 
 std::bitset<2> CUploadMode::GetModeBitSet(const std::string &rstrMode, 
-                                      std::bitset<2> defaultBitset)
+                                      std::bitset<2> defaultBitset) const
 {
     std::bitset<2> result;
     if (rstrMode == "stream" || rstrMode == "all")
@@ -172,23 +204,25 @@ std::bitset<2> CUploadMode::GetModeBitSet(const std::string &rstrMode,
 }
 
 void CUploadMode::FillEventModeMap(const ic_utils::Json::Value &rjsonEventList,
-                               const std::string &rstrMode)
+                               const std::string &rstrMode,
+                               std::map<std::string, std::bitset<2>>
+                                                    &rmapEventModeMap) const
 {
     if (rjsonEventList.isMember(rstrMode)) 
     {
         HCPLOG_I << "reading event list for mode: "<< rstrMode;
-        ic_utils::Json::Value jsonEvents = rjsonEventList[rstrMode];
-        for (int i = 0; i < jsonEvents.size(); i++) 
+        const ic_utils::Json::Value &rjsonEvents = rjsonEventList[rstrMode];
+        for (int i = 0; i < rjsonEvents.size(); i++) 
         {
-            std::string strEvent = jsonEvents[i].asString();
+            std::string strEvent = rjsonEvents[i].asString();
             HCPLOG_I << "event :"<< strEvent;
             std::bitset<2> uploadMode;
-            if (m_mapEventModeMap.find(strEvent) != m_mapEventModeMap.end())
+            if (rmapEventModeMap.find(strEvent) != rmapEventModeMap.end())
             {
-                uploadMode = m_mapEventModeMap[strEvent];
+                uploadMode = rmapEventModeMap[strEvent];
             }
             uploadMode |= GetModeBitSet(rstrMode);
-            m_mapEventModeMap[strEvent] = uploadMode;
+            rmapEventModeMap[strEvent] = uploadMode;
             HCPLOG_I << strEvent << " " << uploadMode;
         }
     }
@@ -196,66 +230,64 @@ void CUploadMode::FillEventModeMap(const ic_utils::Json::Value &rjsonEventList,
 
 bool CUploadMode::IsEventSupportedForBatch(const std::string &rstrEventId) const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
+    std::shared_ptr<const UploadModeState> pState = GetState();
     std::map<std::string, std::bitset<2> >::const_iterator iter = 
-                                            m_mapEventModeMap.find(rstrEventId);
-    const std::bitset<2>& uploadMode = (iter != m_mapEventModeMap.end()) ? 
-                                                   iter->second : m_DefaultMode;
+                                   pState->m_mapEventModeMap.find(rstrEventId);
+    const std::bitset<2>& uploadMode = 
+                        (iter != pState->m_mapEventModeMap.end()) ? 
+                                          iter->second : pState->m_DefaultMode;
     return uploadMode.test(eBATCH);
 }
 
 bool CUploadMode::IsEventSupportedForStream(const std::string &rstrEventId) const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
+    std::shared_ptr<const UploadModeState> pState = GetState();
     std::map<std::string, std::bitset<2> >::const_iterator iter = 
-                                            m_mapEventModeMap.find(rstrEventId);
-    const std::bitset<2>& uploadMode = (iter != m_mapEventModeMap.end()) ?
-                                                   iter->second : m_DefaultMode;
+                                   pState->m_mapEventModeMap.find(rstrEventId);
+    const std::bitset<2>& uploadMode = 
+                        (iter != pState->m_mapEventModeMap.end()) ? 
+                                          iter->second : pState->m_DefaultMode;
     return uploadMode.test(eSTREAM);
 }
 
 bool CUploadMode::IsBatchModeSupported() const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
-    return m_ConfiguredModes.test(eBATCH);
+    return GetState()->m_ConfiguredModes.test(eBATCH);
 }
 
 bool CUploadMode::IsStreamModeSupported() const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
-    return m_ConfiguredModes.test(eSTREAM);
+    return GetState()->m_ConfiguredModes.test(eSTREAM);
 }
 
 bool CUploadMode::IsAnonymousUploadSupported() const
 {
-    return m_bAnonymousUploadMode;
+    return GetState()->m_bAnonymousUploadMode;
 }
 
 bool CUploadMode::IsStoreAndForwardSupported() const
 {
-    return m_bStoreAndForwardEnabled;
+    return GetState()->m_bStoreAndForwardEnabled;
 }
 
 bool CUploadMode::IsBatchModeSupportedAsDefault() const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
-    return m_DefaultMode.test(eBATCH);
+    return GetState()->m_DefaultMode.test(eBATCH);
 }
 
 bool CUploadMode::IsStreamModeSupportedAsDefault() const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
-    return m_DefaultMode.test(eSTREAM);
+    return GetState()->m_DefaultMode.test(eSTREAM);
 }
 
 std::set<std::string> CUploadMode::GetBatchModeEventList() const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
+    std::shared_ptr<const UploadModeState> pState = GetState();
     std::set<std::string> setEventList;
 
     for (std::map<std::string, std::bitset<2> >::const_iterator itr = 
-         m_mapEventModeMap.begin();
-        itr != m_mapEventModeMap.end(); ++itr)
+         pState->m_mapEventModeMap.begin();
+        itr != pState->m_mapEventModeMap.end(); ++itr)
     {
         const std::bitset<2> modes = itr->second;
         if(modes.test(eBATCH))
@@ -269,12 +301,12 @@ std::set<std::string> CUploadMode::GetBatchModeEventList() const
 
 std::set<std::string> CUploadMode::GetStreamModeEventList() const
 {
-    ic_utils::CScopeLock lock(m_DataLock);
+    std::shared_ptr<const UploadModeState> pState = GetState();
     std::set<std::string> setEventList;
 
     for (std::map<std::string, std::bitset<2> >::const_iterator itr = 
-        m_mapEventModeMap.begin();
-        itr != m_mapEventModeMap.end(); ++itr)
+        pState->m_mapEventModeMap.begin();
+        itr != pState->m_mapEventModeMap.end(); ++itr)
     {
         const std::bitset<2> modes = itr->second;
         if(modes.test(eSTREAM)) 
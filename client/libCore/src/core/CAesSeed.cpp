@@ -21,6 +21,7 @@
 #include "CIgniteLog.h"
 #include "core/CAesSeed.h"
 #include "db/CDataBaseFacade.h"
+#include "crypto/CIgniteDataSecurity.h"
 
 //! Macro for CAesSeed string
 #ifdef PREFIX
@@ -83,6 +84,9 @@ void CAesSeed::Init(std::string strContent, bool bIsChanged)
         m_bUseKeystoreAndroid = false;
         HCPLOG_C << "Using local keystore";
     }
+
+    // Event encryption key is derived from the seed
+    CIgniteDataSecurity::InvalidateEventKey();
 }
 
 CAesSeed *CAesSeed::GetInstance() 
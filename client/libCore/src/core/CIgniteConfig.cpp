@@ -48,10 +48,98 @@ static const std::string PROTECTED_MEMBERS = "ProtectedMembers";
 
 CIgniteConfig* CIgniteConfig::m_pConfigSingleton = NULL;
 
+ic_utils::CIgniteMutex CIgniteConfig::m_HandleMutex;
+
+CConfigHandleBase::CConfigHandleBase(const std::string &rstrKey,
+                                     const int nIndex)
+    : m_strKey(rstrKey), m_nIndex(nIndex), m_pConfig(NULL)
+{
+}
+
+CConfigHandleBase::~CConfigHandleBase()
+{
+}
+
+void CConfigHandleBase::Unbind()
+{
+    // m_pConfig is reset under the same lock when the config is destroyed
+    ic_utils::CScopeLock lock(CIgniteConfig::m_HandleMutex);
+    if (NULL != m_pConfig)
+    {
+        m_pConfig->m_setHandles.erase(this);
+        m_pConfig = NULL;
+    }
+}
+
+const std::string& CConfigHandleBase::GetKey() const
+{
+    return m_strKey;
+}
+
+template <>
+void CConfigHandle<int>::Resolve(CIgniteConfig *pConfig)
+{
+    m_value.store(pConfig->GetInt(m_strKey, m_defaultValue, m_nIndex),
+                  std::memory_order_release);
+}
+
+template <>
+void CConfigHandle<long>::Resolve(CIgniteConfig *pConfig)
+{
+    m_value.store(pConfig->GetLong(m_strKey, m_defaultValue, m_nIndex),
+                  std::memory_order_release);
+}
+
+template <>
+void CConfigHandle<bool>::Resolve(CIgniteConfig *pConfig)
+{
+    m_value.store(pConfig->GetBool(m_strKey, m_defaultValue, m_nIndex),
+                  std::memory_order_release);
+}
+
+template <>
+void CConfigHandle<double>::Resolve(CIgniteConfig *pConfig)
+{
+    m_value.store(pConfig->GetDouble(m_strKey, m_defaultValue, m_nIndex),
+                  std::memory_order_release);
+}
+
+CConfigHandle<std::string>::CConfigHandle(const std::string &rstrKey,
+                                          const std::string &rstrDefaultValue,
+                                          const int nIndex)
+    : CConfigHandleBase(rstrKey, nIndex), m_strDefaultValue(rstrDefaultValue),
+      m_pValue(std::make_shared<const std::string>(rstrDefaultValue))
+{
+}
+
+CConfigHandle<std::string>::~CConfigHandle()
+{
+    Unbind();
+}
+
+void CConfigHandle<std::string>::Resolve(CIgniteConfig *pConfig)
+{
+    std::string strValue = pConfig->GetString(m_strKey, m_strDefaultValue,
+                                              m_nIndex);
+
+    /*
+     * Readers may still hold a snapshot of the current value, so a changed
+     * value is published as a new string instead of being assigned in place
+     */
+    if (strValue != *GetSnapshot())
+    {
+        std::atomic_store(&m_pValue,
+                          std::make_shared<const std::string>(strValue));
+    }
+}
+
 void CIgniteConfig::ConfigureFileLogging()
 {
     ic_utils::Json::Value jsonRoot = 
                         CIgniteConfig::GetInstance()->GetJsonValue("FileLogger");
+    ConfigureAsyncLogging(jsonRoot);
+    ConfigureModuleLogLevels(jsonRoot);
+
     if (IsFileLoggingEnabled(jsonRoot))
     { 
         /*
@@ -92,6 +180,11 @@ void CIgniteConfig::ConfigureFileLogging()
         if (!strLogFilePath.empty() && 0 != nLogFileSize && 
             0 != nLogFileTruncateSize && HCPLOG_MAX_LEVEL >= nLogLevel )
         {
+            // Binary log files are turned back into text by logdecoder
+            ic_utils::CIgniteLog::SetBinaryMode(
+                jsonRoot.isMember("binaryLogging") &&
+                jsonRoot["binaryLogging"].isBool() &&
+                jsonRoot["binaryLogging"].asBool());
             ic_utils::CIgniteLog::SetFileOutputPath(strLogFilePath, 
                                          nLogFileSize,
                                          nLogFileTruncateSize);
@@ -116,6 +209,87 @@ bool CIgniteConfig::IsFileLoggingEnabled(const ic_utils::Json::Value &rjsonRoot)
     return bIsEnabled;
 }
 
+void CIgniteConfig::ConfigureAsyncLogging(const ic_utils::Json::Value &rjsonRoot)
+{
+    const ic_utils::Json::Value &rjsonAsync = rjsonRoot["asyncLogging"];
+    if (!rjsonAsync.isObject() || !rjsonAsync.isMember("enabled") ||
+        !rjsonAsync["enabled"].isBool() || !rjsonAsync["enabled"].asBool())
+    {
+        return;
+    }
+
+    unsigned int unCapacity = 4096;
+    if (rjsonAsync.isMember("capacity") && rjsonAsync["capacity"].isUInt() &&
+        0 != rjsonAsync["capacity"].asUInt())
+    {
+        unCapacity = rjsonAsync["capacity"].asUInt();
+    }
+
+    unsigned int unBlockTimeoutMs = 10;
+    if (rjsonAsync.isMember("blockTimeoutMs") &&
+        rjsonAsync["blockTimeoutMs"].isUInt())
+    {
+        unBlockTimeoutMs = rjsonAsync["blockTimeoutMs"].asUInt();
+    }
+
+    ic_utils::LogOverflowPolicy ePolicy = ic_utils::eLOG_OVERFLOW_DROP_NEWEST;
+    std::string strPolicy = rjsonAsync["overflowPolicy"].isString() ?
+                            rjsonAsync["overflowPolicy"].asString() : "";
+    if ("block" == strPolicy)
+    {
+        ePolicy = ic_utils::eLOG_OVERFLOW_BLOCK;
+    }
+    else if ("dropOldest" == strPolicy)
+    {
+        ePolicy = ic_utils::eLOG_OVERFLOW_DROP_OLDEST;
+    }
+
+    if (ic_utils::CIgniteLog::EnableAsync(unCapacity, ePolicy, unBlockTimeoutMs))
+    {
+        HCPLOG_C << "Async logging enabled, capacity:" << unCapacity
+                 << " policy:" << ePolicy;
+    }
+}
+
+void CIgniteConfig::ConfigureModuleLogLevels(const ic_utils::Json::Value &rjsonRoot)
+{
+    ic_utils::LogLevel arrLevels[ic_utils::eLOG_MODULE_COUNT];
+    for (int nModule = 0; nModule < ic_utils::eLOG_MODULE_COUNT; nModule++)
+    {
+        arrLevels[nModule] = ic_utils::eHCP_LOG_TRACE;
+    }
+
+    const ic_utils::Json::Value &rjsonLevels = rjsonRoot["moduleLogLevels"];
+    if (rjsonLevels.isObject())
+    {
+        for (const std::string &rstrName : rjsonLevels.getMemberNames())
+        {
+            ic_utils::LogModule eModule = ic_utils::eLOG_MODULE_DEFAULT;
+            const ic_utils::Json::Value &rjsonLevel = rjsonLevels[rstrName];
+            if (ic_utils::CIgniteLog::GetModuleByName(rstrName, eModule) &&
+                rjsonLevel.isInt() && rjsonLevel.asInt() >= 0 &&
+                rjsonLevel.asInt() <= ic_utils::eHCP_LOG_TRACE)
+            {
+                arrLevels[eModule] =
+                    static_cast<ic_utils::LogLevel>(rjsonLevel.asInt());
+            }
+            else
+            {
+                HCPLOG_W << "Invalid module log level for " << rstrName;
+            }
+        }
+    }
+
+    for (int nModule = 0; nModule < ic_utils::eLOG_MODULE_COUNT; nModule++)
+    {
+        ic_utils::LogModule eModule = static_cast<ic_utils::LogModule>(nModule);
+        if (ic_utils::CIgniteLog::GetModuleLevel(eModule) != arrLevels[nModule])
+        {
+            ic_utils::CIgniteLog::SetModuleLevel(eModule, arrLevels[nModule]);
+        }
+    }
+}
+
 std::string CIgniteConfig::GetLogFilePath(const ic_utils::Json::Value &rjsonRoot)
 {
     std::string strLogFilePath = "";
@@ -174,110 +348,74 @@ int CIgniteConfig::GetLogLevel(const ic_utils::Json::Value &rjsonRoot)
     return nLogLevel;
 }
 
-std::string CIgniteConfig::GetString(const std::string &rstrKey, 
-                               const std::string &rstrDefaultValue,
-                               const int nIndex)
+CConfigSnapshot::CConfigSnapshot(const ic_utils::Json::Value &rjsonRoot,
+                                 const unsigned long long ullVersion)
+    : m_jsonRoot(rjsonRoot), m_ullVersion(ullVersion)
+{
+}
+
+unsigned long long CConfigSnapshot::GetVersion() const
+{
+    return m_ullVersion;
+}
+
+const ic_utils::Json::Value& CConfigSnapshot::GetJsonValue(
+                                                 const std::string &rstrKey,
+                                                 const int nIndex) const
+{
+    return ResolveJsonValue(m_jsonRoot, rstrKey, nIndex);
+}
+
+std::string CConfigSnapshot::GetString(const std::string &rstrKey,
+                                       const std::string &rstrDefaultValue,
+                                       const int nIndex) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey 
-                    << ", default=" << rstrDefaultValue
-                    << ", index=" << nIndex;
-    std::string strRet = rstrDefaultValue;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey, nIndex);
-    if (rjsonValue.isString())
-    {
-        strRet = rjsonValue.asString();
-    }
-    HCPLOG_METHOD() << ", return=" << strRet;
-    return strRet;
+    return rjsonValue.isString() ? rjsonValue.asString() : rstrDefaultValue;
 }
 
-int CIgniteConfig::GetInt(const std::string &rstrKey,
-                    const int nDefaultValue,
-                    const int nIndex)
+int CConfigSnapshot::GetInt(const std::string &rstrKey,
+                            const int nDefaultValue,
+                            const int nIndex) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey
-                    << ", default=" << nDefaultValue
-                    << ", index=" << nIndex;
-    int nRet = nDefaultValue;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey, nIndex);
-    if (rjsonValue.isIntegral())
-    {
-        nRet = rjsonValue.asInt();
-    }
-    HCPLOG_METHOD() << ", return=" << nRet;
-    return nRet;
+    return rjsonValue.isIntegral() ? rjsonValue.asInt() : nDefaultValue;
 }
 
-long CIgniteConfig::GetLong(const std::string &rstrKey,
-                      const long lDefaultValue,
-                      const int nIndex)
+long CConfigSnapshot::GetLong(const std::string &rstrKey,
+                              const long lDefaultValue,
+                              const int nIndex) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey 
-                    << ", default=" << lDefaultValue
-                    << ", index=" << nIndex;
-    long lRet = lDefaultValue;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey, nIndex);
-    if (rjsonValue.isIntegral())
-    {
-        lRet = rjsonValue.asInt64();
-    }
-    HCPLOG_METHOD() << ", return=" << lRet;
-    return lRet;
+    return rjsonValue.isIntegral() ? rjsonValue.asInt64() : lDefaultValue;
 }
 
-bool CIgniteConfig::GetBool(const std::string &rstrKey,
-                      const bool bDefaultValue,
-                      const int nIndex)
+bool CConfigSnapshot::GetBool(const std::string &rstrKey,
+                              const bool bDefaultValue,
+                              const int nIndex) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey
-                    << ", default=" << bDefaultValue
-                    << ", index=" << nIndex;
-    bool bRet = bDefaultValue;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey, nIndex);
-    if (rjsonValue.isBool())
-    {
-        bRet = rjsonValue.asBool();
-    }
-    HCPLOG_METHOD() << ", return=" << bRet;
-    return bRet;
+    return rjsonValue.isBool() ? rjsonValue.asBool() : bDefaultValue;
 }
-double CIgniteConfig::GetDouble(const std::string &rstrKey,
-                          const double dblDefaultValue,
-                          const int nIndex)
+
+double CConfigSnapshot::GetDouble(const std::string &rstrKey,
+                                  const double dblDefaultValue,
+                                  const int nIndex) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey
-                    << ", default=" << dblDefaultValue
-                    << ", index=" << nIndex;
-    double dblRet = dblDefaultValue;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey, nIndex);
-    if (rjsonValue.isNumeric())
-    {
-        dblRet = rjsonValue.asDouble();
-    }
-    HCPLOG_METHOD() << ", return=" << dblRet;
-    return dblRet;
+    return rjsonValue.isNumeric() ? rjsonValue.asDouble() : dblDefaultValue;
 }
 
-int CIgniteConfig::GetArraySize(const std::string &rstrKey)
+int CConfigSnapshot::GetArraySize(const std::string &rstrKey) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey ;
-    int nRet = 0;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey);
-    if (rjsonValue.isArray())
-    {
-        nRet = rjsonValue.size();
-    }
-    HCPLOG_METHOD() << ", return=" << nRet;
-    return nRet;
+    return rjsonValue.isArray() ? rjsonValue.size() : 0;
 }
 
-std::string CIgniteConfig::GetAsString(const std::string &rstrKey,
-                                 const std::string &rstrDefaultValue,
-                                 const int nIndex)
+std::string CConfigSnapshot::GetAsString(const std::string &rstrKey,
+                                         const std::string &rstrDefaultValue,
+                                         const int nIndex) const
 {
-    HCPLOG_METHOD() << ", key=" << rstrKey
-                    << ", default=" << rstrDefaultValue
-                    << ", index=" << nIndex;
     std::string strRet = rstrDefaultValue;
     const ic_utils::Json::Value &rjsonValue = GetJsonValue(rstrKey, nIndex);
     if (rjsonValue.isInt())
@@ -296,25 +434,25 @@ std::string CIgniteConfig::GetAsString(const std::string &rstrKey,
     {
         // Do nothing
     }
-    HCPLOG_METHOD() << ", return=" << strRet;
     return strRet;
 }
 
-const ic_utils::Json::Value& CIgniteConfig::GetJsonValue(const std::string &rstrKey, 
-                                         const int nIndex)
+const ic_utils::Json::Value& CConfigSnapshot::ResolveJsonValue(
+                                        const ic_utils::Json::Value &rjsonRoot,
+                                        const std::string &rstrKey,
+                                        const int nIndex)
 {
-    ic_utils::CScopeLock lock(m_InstanceMutex);
     const ic_utils::Json::Value &rjsonNullValue = ic_utils::Json::Value::nullRef;
     const char* pchCurrent = rstrKey.c_str();
     const char* pchEnd = pchCurrent + rstrKey.length();
-    ic_utils::Json::Value *pjsonValue = &m_jsonRoot;
+    const ic_utils::Json::Value *pjsonValue = &rjsonRoot;
 
     while (pchCurrent != pchEnd)
     {
         if (*pchCurrent == '[')
         {
-            if (rjsonNullValue == GetJsonArrayValue(&pchCurrent, pchEnd, 
-                                                    &pjsonValue, rstrKey, nIndex))
+            if (!GetJsonArrayValue(&pchCurrent, pchEnd, &pjsonValue, rstrKey,
+                                   nIndex))
             {
                 return rjsonNullValue;
             }
@@ -327,8 +465,7 @@ const ic_utils::Json::Value& CIgniteConfig::GetJsonValue(const std::string &rstr
         }
         else
         {
-            if (rjsonNullValue == GetJsonObjectValue(&pchCurrent, pchEnd, 
-                                                     &pjsonValue, rstrKey))
+            if (!GetJsonObjectValue(&pchCurrent, pchEnd, &pjsonValue, rstrKey))
             {
                 return rjsonNullValue;
             }  
@@ -337,18 +474,16 @@ const ic_utils::Json::Value& CIgniteConfig::GetJsonValue(const std::string &rstr
     return *pjsonValue;
 }
 
-ic_utils::Json::Value CIgniteConfig::GetJsonArrayValue(const char **prchCurrent, 
-                                       const char *pchEnd, 
-                                       ic_utils::Json::Value **prjsonValue, 
-                                       const std::string &rstrKey, 
-                                       const int &rnIndex)
+bool CConfigSnapshot::GetJsonArrayValue(const char **prchCurrent,
+                                        const char *pchEnd,
+                                        const ic_utils::Json::Value **prjsonValue,
+                                        const std::string &rstrKey,
+                                        const int &rnIndex)
 {
-    const ic_utils::Json::Value &rjsonNullValue = ic_utils::Json::Value::nullRef;
-
     if (!(*prjsonValue)->isArray() )
     {
         HCPLOG_E << "FAIL: Not Array Type, key=" << rstrKey;
-        return rjsonNullValue;
+        return false;
     }
     (*prchCurrent)++;
 
@@ -376,7 +511,7 @@ ic_utils::Json::Value CIgniteConfig::GetJsonArrayValue(const char **prchCurrent,
          */
         HCPLOG_E << "FAIL: No closing ] ended unexpectedly!, key="
                     << rstrKey;
-        return rjsonNullValue;
+        return false;
     }
     (*prchCurrent)++; // Move past the ]
 
@@ -385,7 +520,7 @@ ic_utils::Json::Value CIgniteConfig::GetJsonArrayValue(const char **prchCurrent,
         // Invalid index.  Return null value.
         HCPLOG_E << "FAIL: Not valid index! arrayindex=" << nArrayindex
                     << ", key=" << rstrKey;
-        return rjsonNullValue;
+        return false;
     }
     /*
      * We have a valid index.  Let's go ahead and move on to the next 
@@ -393,16 +528,14 @@ ic_utils::Json::Value CIgniteConfig::GetJsonArrayValue(const char **prchCurrent,
      */
     *prjsonValue = &((**prjsonValue)[nArrayindex]);
 
-    return **prjsonValue;
+    return true;
 }
 
-ic_utils::Json::Value CIgniteConfig::GetJsonObjectValue(const char **prchCurrent, 
-                                       const char *pchEnd, 
-                                       ic_utils::Json::Value **prjsonValue, 
-                                       const std::string &rstrKey)
+bool CConfigSnapshot::GetJsonObjectValue(const char **prchCurrent,
+                                         const char *pchEnd,
+                                         const ic_utils::Json::Value **prjsonValue,
+                                         const std::string &rstrKey)
 {
-    const ic_utils::Json::Value &rjsonNullValue = ic_utils::Json::Value::nullRef;
-
     // Parse normal key name
     const char* nameStart = *prchCurrent;
     while (*prchCurrent != pchEnd &&
@@ -418,24 +551,27 @@ ic_utils::Json::Value CIgniteConfig::GetJsonObjectValue(const char **prchCurrent
         HCPLOG_E << "Unable to resolve.  Object expected at "  <<
                     std::string(nameStart, *prchCurrent) 
                     << ", key=" << rstrKey;
-        return rjsonNullValue;
+        return false;
     }
 
-    // Found whole key.  Go ahead and try to move deeper.
+    /*
+     * Found whole key.  Go ahead and try to move deeper, the const lookup
+     * does not add missing keys to the tree.
+     */
     *prjsonValue = &((**prjsonValue)[std::string(nameStart, *prchCurrent)]);
 
     if ((*prjsonValue)->isNull())
     {
         HCPLOG_D << "Key not present in JSON! " << rstrKey;
         // Expected key not found.  Error
-        return rjsonNullValue;
+        return false;
     }
 
-    return **prjsonValue;
+    return true;
 }
 
-bool CIgniteConfig::ValidateGetJsonValue(const char* pchCurrent,
-                                   const char* pchEnd)
+bool CConfigSnapshot::ValidateGetJsonValue(const char* pchCurrent,
+                                           const char* pchEnd)
 {
     if (pchCurrent == pchEnd || *pchCurrent != ']' )
     {
@@ -448,6 +584,115 @@ bool CIgniteConfig::ValidateGetJsonValue(const char* pchCurrent,
     return true;
 }
 
+std::string CIgniteConfig::GetString(const std::string &rstrKey, 
+                               const std::string &rstrDefaultValue,
+                               const int nIndex)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey 
+                    << ", default=" << rstrDefaultValue
+                    << ", index=" << nIndex;
+    std::string strRet = GetSnapshot()->GetString(rstrKey, rstrDefaultValue,
+                                                  nIndex);
+    HCPLOG_METHOD() << ", return=" << strRet;
+    return strRet;
+}
+
+int CIgniteConfig::GetInt(const std::string &rstrKey,
+                    const int nDefaultValue,
+                    const int nIndex)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey
+                    << ", default=" << nDefaultValue
+                    << ", index=" << nIndex;
+    int nRet = GetSnapshot()->GetInt(rstrKey, nDefaultValue, nIndex);
+    HCPLOG_METHOD() << ", return=" << nRet;
+    return nRet;
+}
+
+long CIgniteConfig::GetLong(const std::string &rstrKey,
+                      const long lDefaultValue,
+                      const int nIndex)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey 
+                    << ", default=" << lDefaultValue
+                    << ", index=" << nIndex;
+    long lRet = GetSnapshot()->GetLong(rstrKey, lDefaultValue, nIndex);
+    HCPLOG_METHOD() << ", return=" << lRet;
+    return lRet;
+}
+
+bool CIgniteConfig::GetBool(const std::string &rstrKey,
+                      const bool bDefaultValue,
+                      const int nIndex)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey
+                    << ", default=" << bDefaultValue
+                    << ", index=" << nIndex;
+    bool bRet = GetSnapshot()->GetBool(rstrKey, bDefaultValue, nIndex);
+    HCPLOG_METHOD() << ", return=" << bRet;
+    return bRet;
+}
+double CIgniteConfig::GetDouble(const std::string &rstrKey,
+                          const double dblDefaultValue,
+                          const int nIndex)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey
+                    << ", default=" << dblDefaultValue
+                    << ", index=" << nIndex;
+    double dblRet = GetSnapshot()->GetDouble(rstrKey, dblDefaultValue, nIndex);
+    HCPLOG_METHOD() << ", return=" << dblRet;
+    return dblRet;
+}
+
+int CIgniteConfig::GetArraySize(const std::string &rstrKey)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey ;
+    int nRet = GetSnapshot()->GetArraySize(rstrKey);
+    HCPLOG_METHOD() << ", return=" << nRet;
+    return nRet;
+}
+
+std::string CIgniteConfig::GetAsString(const std::string &rstrKey,
+                                 const std::string &rstrDefaultValue,
+                                 const int nIndex)
+{
+    HCPLOG_METHOD() << ", key=" << rstrKey
+                    << ", default=" << rstrDefaultValue
+                    << ", index=" << nIndex;
+    std::string strRet = GetSnapshot()->GetAsString(rstrKey, rstrDefaultValue,
+                                                    nIndex);
+    HCPLOG_METHOD() << ", return=" << strRet;
+    return strRet;
+}
+
+const ic_utils::Json::Value& CIgniteConfig::GetJsonValue(const std::string &rstrKey, 
+                                         const int nIndex)
+{
+    ic_utils::CScopeLock lock(m_InstanceMutex);
+    return CConfigSnapshot::ResolveJsonValue(m_jsonRoot, rstrKey, nIndex);
+}
+
+std::shared_ptr<const CConfigSnapshot> CIgniteConfig::GetSnapshot() const
+{
+    return std::atomic_load(&m_pSnapshot);
+}
+
+unsigned long long CIgniteConfig::GetSnapshotVersion() const
+{
+    return m_ullSnapshotVersion.load(std::memory_order_acquire);
+}
+
+void CIgniteConfig::PublishSnapshot()
+{
+    unsigned long long ullVersion = m_ullSnapshotVersion.load() + 1;
+    std::atomic_store(&m_pSnapshot, std::shared_ptr<const CConfigSnapshot>(
+                                  new CConfigSnapshot(m_jsonRoot, ullVersion)));
+
+    // Publish the version last, a reader seeing it gets this snapshot or newer
+    m_ullSnapshotVersion.store(ullVersion, std::memory_order_release);
+    HCPLOG_D << "Published config snapshot " << ullVersion;
+}
+
 CIgniteConfig* CIgniteConfig::CreateSingleton(const std::string &rstrConfigfile,
                                   const bool bEnableLogging)
 {
@@ -489,6 +734,7 @@ void CIgniteConfig::ClearInstance()
 }
 
 CIgniteConfig::CIgniteConfig(const std::string &rstrConfigfile)
+    : m_ullSnapshotVersion(0)
 {
     HCPLOG_I << " configfile=" << rstrConfigfile;
     m_mapConfigUpdateSubscribers.clear();
@@ -499,6 +745,7 @@ CIgniteConfig::CIgniteConfig(const std::string &rstrConfigfile)
 
     m_strPath = rstrConfigfile;
     LoadConfigFromFile();
+    PublishSnapshot();
 
     m_strConfigVersion = CSha::GetFileHash(rstrConfigfile);
     ic_utils::Json::FastWriter jsonWriter;
@@ -509,7 +756,12 @@ CIgniteConfig::CIgniteConfig(const std::string &rstrConfigfile)
 
 CIgniteConfig::~CIgniteConfig()
 {
-
+    ic_utils::CScopeLock lock(m_HandleMutex);
+    for (CConfigHandleBase *pHandle : m_setHandles)
+    {
+        pHandle->m_pConfig = NULL;
+    }
+    m_setHandles.clear();
 }
 
 std::string CIgniteConfig::GetConfigVersion()
@@ -550,6 +802,7 @@ void CIgniteConfig::ReloadConfigFromDB()
         {
             ic_utils::CScopeLock lock(m_InstanceMutex);
             CopyDBConfig(mapConfigUpdateMap);
+            PublishSnapshot();
             HCPLOG_T << "CIgniteConfig parsed and applied";
         }
 
@@ -557,6 +810,8 @@ void CIgniteConfig::ReloadConfigFromDB()
         HCPLOG_D << "New CIgniteConfig after Extns applied: "
                  << jsonWriter.write(m_jsonRoot);
     }
+    RebindHandles();
+    ConfigureModuleLogLevels(GetSnapshot()->GetJsonValue("FileLogger"));
 }
 
 bool CIgniteConfig::StoreSettingsToDb(const std::map<std::string,ic_utils::Json::Value>
@@ -627,6 +882,7 @@ bool CIgniteConfig::UpdateConfig(const std::map<std::string,ic_utils::Json::Valu
             HCPLOG_W << "Reset settings for source " << strSourceStr;
             ResetConfigSettings();
         }
+        PublishSnapshot();
     }
     ic_utils::Json::FastWriter jsonWriter;
     HCPLOG_D << "New CIgniteConfig after Extns applied: " << jsonWriter.write(m_jsonRoot);
@@ -657,6 +913,10 @@ void CIgniteConfig::ResetConfigSettings()
 
 void CIgniteConfig::NotifyConfigUpdateToSubscribers()
 {
+    // Rebind handles first so that subscribers read the updated values
+    RebindHandles();
+    ConfigureModuleLogLevels(GetSnapshot()->GetJsonValue("FileLogger"));
+
     HCPLOG_D <<"Number of subscribers: "<<m_mapConfigUpdateSubscribers.size();
     for (const auto& itr : m_mapConfigUpdateSubscribers)
     {
@@ -790,6 +1050,40 @@ void CIgniteConfig::UnSubscribeForConfigUpdateNotification(std::string strSubscr
     }
 }
 
+void CIgniteConfig::BindHandle(CConfigHandleBase *pHandle)
+{
+    if (NULL == pHandle)
+    {
+        HCPLOG_E << "Invalid config handle";
+        return;
+    }
+
+    ic_utils::CScopeLock lock(m_HandleMutex);
+    pHandle->Resolve(this);
+    pHandle->m_pConfig = this;
+    m_setHandles.insert(pHandle);
+    HCPLOG_T << "Bound config handle " << pHandle->GetKey();
+}
+
+void CIgniteConfig::UnbindHandle(CConfigHandleBase *pHandle)
+{
+    ic_utils::CScopeLock lock(m_HandleMutex);
+    if (m_setHandles.erase(pHandle) > 0)
+    {
+        pHandle->m_pConfig = NULL;
+    }
+}
+
+void CIgniteConfig::RebindHandles()
+{
+    ic_utils::CScopeLock lock(m_HandleMutex);
+    HCPLOG_D << "Rebinding config handles: " << m_setHandles.size();
+    for (CConfigHandleBase *pHandle : m_setHandles)
+    {
+        pHandle->Resolve(this);
+    }
+}
+
 std::string CIgniteConfig::GetConfigUpdateSourceInString(enum EconfigUpdateSource eSource)
 {
 
@@ -22,10 +22,17 @@
 #include <sys/un.h>
 #include <sys/time.h>
 #include <unistd.h>
+#include <fcntl.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
 #include <netdb.h>
 #include <cstring>
 #include <cerrno>
 #include <string.h>
+#include <algorithm>
 #include "IOnOff.h"
 #if defined __ANDROID__
 #include <sys/stat.h>
@@ -51,9 +58,6 @@ namespace ic_core
 {
 namespace 
 {
-//! Constant key for 'msg read error' integer value
-static const int MSG_READ_ERROR = -1;
-
 //! Constant key for 'def msg queue priority' integer value
 static const int DEF_MSG_QUEUE_PRIORITY = 11;
 
@@ -75,49 +79,30 @@ inline bool is_queue_valid(int qid)
     return (qid >= 0);
 }
 
-int read_from_socket(int nSd, void* pvoidReadTo, int nSizeToRead)
-{
-    HCPLOG_T << "nSd :" << nSd << "readTo :" << pvoidReadTo 
-             << "sizeToRead :" << nSizeToRead;
+//! Constant key for 'DAM.MsgQueueMaxClients' string
+static const std::string MSG_QUEUE_MAX_CLIENTS = "DAM.MsgQueueMaxClients";
 
-    int nReadSize = 0;
+//! Default maximum clients; 0 means no limit
+static const int DEF_MSG_QUEUE_MAX_CLIENTS = 0;
 
-    if (nSd >= 0 && pvoidReadTo && nSizeToRead > 0)
-    {
-        int nValRead = 0;
-        char* pchReadPtr = (char*)pvoidReadTo;
+//! Number of bytes read from a socket at a time
+static const size_t READ_CHUNK_SIZE = 65536;
 
-        while (nReadSize < nSizeToRead)
-        {
-            nValRead = read(nSd , pchReadPtr, nSizeToRead - nReadSize);
-            if (nValRead > 0)
-            {
-                nReadSize += nValRead;
-                pchReadPtr += nValRead;
-            }
-            else
-            {
-                if (!nValRead)
-                {
-                    HCPLOG_T << "read size zero on socket:" << nSd;
-                }
-                else
-                {
-                    HCPLOG_E << "Error reading on socket:" << nSd;
-                }
-                break;
-            }
-        }
-    }
-    else
-    {
-        nReadSize = -1;
-        HCPLOG_E << "Invalid Input parameters";
-    }
+//! Number of bytes read from a client before serving the other clients
+static const size_t READ_BUDGET_PER_WAKEUP = 1048576;
 
-    HCPLOG_T << "read size from socket :" << nReadSize;
+//! Maximum number of socket events handled per wait
+static const int MAX_POLL_EVENTS = 64;
 
-    return (nReadSize == nSizeToRead) ? nReadSize : MSG_READ_ERROR;
+/**
+ * Method to set the given socket to non-blocking mode
+ * @param[in] nSd socket descriptor
+ * @return true on success; false otherwise
+ */
+bool set_non_blocking(int nSd)
+{
+    int nFlags = fcntl(nSd, F_GETFL, 0);
+    return (nFlags >= 0) && (fcntl(nSd, F_SETFL, nFlags | O_NONBLOCK) == 0);
 }
 
 }
@@ -198,11 +183,6 @@ CMessageQueue::CMessageQueue(std::string strName)
     // make the socket accessible by anyone
     chmod(stAddr.sun_path, 0666);
 #endif
-
-    for (int i = 0; i < MAX_CLIENTS; i++)
-    {
-        m_clientSockets[i] = -1;
-    }
 }
 
 CMessageQueue::~CMessageQueue()
@@ -266,229 +246,362 @@ void CMessageQueue::Run()
                                                         DEF_MSG_QUEUE_PRIORITY);
     ic_utils::CIgniteThread::SetCurrentThreadPriority(nThreadPriority);
 
-#if defined (__ANDROID__)
-    int nfds = sysconf(_SC_OPEN_MAX);
-#else
-    int nfds = getdtablesize();       // Maximum file descriptor
-#endif
-
-    HCPLOG_C << "MaxFileDescrip.=" << nfds;
+    int nMaxClients = CIgniteConfig::GetInstance()->GetInt(MSG_QUEUE_MAX_CLIENTS,
+                                                    DEF_MSG_QUEUE_MAX_CLIENTS);
+    m_unMaxClients = (nMaxClients > 0) ? (unsigned int)nMaxClients : 0;
+    HCPLOG_C << "MaxClients=" << m_unMaxClients;
 
-    // maximum of MAX_CLIENT pending connections for the master socket
-    if (listen(m_masterSocket, MAX_CLIENTS) < 0)
+    if (listen(m_masterSocket, SOMAXCONN) < 0)
     {
         HCPLOG_E << "failed to listen";
         std::exit(-34);
     }
 
+    // master socket is drained on every wakeup, hence non-blocking
+    if (!set_non_blocking(m_masterSocket))
+    {
+        HCPLOG_E << "failed to set non-blocking mode, error:" << errno;
+        std::exit(-34);
+    }
+
+#if defined(__linux__)
+    m_nPollFd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event stEvent;
+    memset(&stEvent, 0, sizeof(stEvent));
+    stEvent.events = EPOLLIN | EPOLLET;
+    stEvent.data.fd = m_masterSocket;
+    if ((m_nPollFd < 0) ||
+        (epoll_ctl(m_nPollFd, EPOLL_CTL_ADD, m_masterSocket, &stEvent) < 0))
+    {
+        HCPLOG_E << "epoll setup failed, error:" << errno;
+        std::exit(-34);
+    }
+#endif
+
     Connect();
 }
 
-void CMessageQueue::AddSockets(int &rnMaxSd, fd_set &rfds)
+void CMessageQueue::WaitForActivity(int nTimeoutMs, 
+                                    std::vector<int> &rvecReadySockets)
 {
-    int nSd;
+    rvecReadySockets.clear();
 
-    // add child sockets to set
-    for (int i = 0; i < MAX_CLIENTS; i++)
+#if defined(__linux__)
+    struct epoll_event stEvents[MAX_POLL_EVENTS];
+    int nActivity = epoll_wait(m_nPollFd, stEvents, MAX_POLL_EVENTS, nTimeoutMs);
+    for (int i = 0; i < nActivity; i++)
     {
-        // socket descriptor
-        nSd = m_clientSockets[i];
+        rvecReadySockets.push_back(stEvents[i].data.fd);
+    }
+#else
+    // level triggered fallback for platforms without epoll
+    std::vector<struct pollfd> vecFds;
+    struct pollfd stFd;
+    stFd.fd = m_masterSocket;
+    stFd.events = POLLIN;
+    stFd.revents = 0;
+    vecFds.push_back(stFd);
+    std::map<int, ClientConnection>::iterator iter;
+    for (iter = m_mapConnections.begin(); iter != m_mapConnections.end(); iter++)
+    {
+        stFd.fd = iter->first;
+        vecFds.push_back(stFd);
+    }
+    int nActivity = poll(vecFds.data(), vecFds.size(), nTimeoutMs);
+    for (size_t i = 0; (nActivity > 0) && (i < vecFds.size()); i++)
+    {
+        if (vecFds[i].revents)
+        {
+            rvecReadySockets.push_back(vecFds[i].fd);
+        }
+    }
+#endif
+
+    if ((nActivity < 0) && (errno != EINTR))
+    {
+        HCPLOG_E << "socket wait error:" << errno;
+    }
+}
 
-        //if valid socket descriptor then add to read list
-        if(nSd >= 0)
+void CMessageQueue::AddNewIncomingConnection()
+{
+    while (true)
+    {
+        int nNewSocket = accept(m_masterSocket, NULL, NULL);
+        if (nNewSocket < 0)
         {
-            FD_SET(nSd , &rfds);
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+            {
+                HCPLOG_E << "accept: error:" << errno;
+            }
+            break;
         }
 
-        //highest file descriptor number, need it for the select function
-        if(nSd > rnMaxSd)
+        //inform user of socket number - used in send and receive commands
+        HCPLOG_D << "New connection , socket fd is :" << nNewSocket;
+
+        if (!AddConnection(nNewSocket))
         {
-            rnMaxSd = nSd;
+            close(nNewSocket);
         }
     }
 }
 
-void CMessageQueue::AddNewIncomingConnection()
+bool CMessageQueue::AddConnection(int nSd)
 {
-    int nNewSocket;
-
-    if ((nNewSocket = accept(m_masterSocket, NULL, NULL)) < 0)
+    if (m_unMaxClients && (m_mapConnections.size() >= m_unMaxClients))
     {
-        HCPLOG_E << "accept: error";
-        std::exit(-35);
+        HCPLOG_E << "Max clients reached (" << m_unMaxClients 
+                 << "), rejecting socket:" << nSd;
+        return false;
     }
 
-    //inform user of socket number - used in send and receive commands
-    HCPLOG_D << "New connection , socket fd is :" << nNewSocket;
-
-    //add new socket to array of sockets
-    for (int i = 0; i < MAX_CLIENTS; i++)
+#if defined(__linux__)
+    if (m_nPollFd >= 0)
     {
-        //if position is empty
-        if (m_clientSockets[i] == -1)
+        struct epoll_event stEvent;
+        memset(&stEvent, 0, sizeof(stEvent));
+        stEvent.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        stEvent.data.fd = nSd;
+        if (epoll_ctl(m_nPollFd, EPOLL_CTL_ADD, nSd, &stEvent) < 0)
         {
-            m_clientSockets[i] = nNewSocket;
-            HCPLOG_D << "Adding to list of sockets as :" << i;
-            break;
+            HCPLOG_E << "epoll add failed for socket:" << nSd << ", error:" << errno;
+            return false;
         }
     }
+#endif
+
+    m_mapConnections[nSd] = ClientConnection();
+    HCPLOG_D << "Clients connected :" << m_mapConnections.size();
+    return true;
+}
+
+void CMessageQueue::CloseConnection(int nSd)
+{
+    HCPLOG_D << "Closing socket:" << nSd;
+#if defined(__linux__)
+    if (m_nPollFd >= 0)
+    {
+        epoll_ctl(m_nPollFd, EPOLL_CTL_DEL, nSd, NULL);
+    }
+#endif
+    close(nSd);
+    m_mapConnections.erase(nSd);
+    m_setPendingReads.erase(nSd);
 }
 
-void CMessageQueue::PerformIOOperation(fd_set &rfds, void** pvoidFullMsg)
+bool CMessageQueue::ReadFromConnection(int nSd, bool &rbMoreData)
 {
-    for (int i = 0; i < MAX_CLIENTS; i++)
+    rbMoreData = false;
+    std::map<int, ClientConnection>::iterator iter = m_mapConnections.find(nSd);
+    if (iter == m_mapConnections.end())
     {
-        int nSd = m_clientSockets[i];
+        return true;
+    }
+    ClientConnection &rConn = iter->second;
 
-        //if socket-id is invalid OR descriptor is not set,
-        //  continue with the next socket
-        if (!((nSd >= 0) && FD_ISSET(nSd, &rfds)))
+    size_t nBudget = READ_BUDGET_PER_WAKEUP;
+    while (true)
+    {
+        if (nBudget == 0)
         {
-            continue;
+            // serve the other clients first; continue in the next iteration
+            rbMoreData = true;
+            return true;
         }
 
-        // continue with reading the header structure
-        void* pvoidMsgHeader = *pvoidFullMsg;
-
-        if (read_from_socket(nSd, pvoidMsgHeader, ic_event::CIgniteMessage::MSG_HEADER_SIZE) == MSG_READ_ERROR)
+        if (rConn.m_vecBuffer.size() < rConn.m_nBufferedBytes + READ_CHUNK_SIZE)
         {
-            HCPLOG_E << "No Header data on socket: " << nSd;
-            close(nSd);
-            m_clientSockets[i] = -1;
+            rConn.m_vecBuffer.resize(rConn.m_nBufferedBytes + READ_CHUNK_SIZE);
         }
-        else
-        {
-            // Read Actual Message
-            int nMsgLen = ic_event::CIgniteMessage::GetMessageSize(pvoidMsgHeader);
-            HCPLOG_I << "actual message Length: " << nMsgLen;
 
-            if (nMsgLen >= 0 && (unsigned int)nMsgLen <=  ic_event::CIgniteMessage::MAX_MESSAGE_LENGTH)
+        /* client sockets stay in blocking mode for the replies written by
+         * the handlers, hence only the reads are made non-blocking
+         */
+        ssize_t nRead = recv(nSd, &rConn.m_vecBuffer[rConn.m_nBufferedBytes],
+                             READ_CHUNK_SIZE, MSG_DONTWAIT);
+        if (nRead > 0)
+        {
+            rConn.m_nBufferedBytes += nRead;
+            nBudget -= std::min(nBudget, (size_t)nRead);
+            if (!ProcessBufferedMessages(nSd, rConn))
             {
-
-                if (!ReadMsgAndSend(*pvoidFullMsg, nMsgLen, nSd))
-                {
-                    // close socket
-                    HCPLOG_E << "actual message not read from socket: " << nSd;
-                    close(nSd);
-                    m_clientSockets[i] = -1;
-                }
+                HCPLOG_E << "invalid message stream on socket: " << nSd;
+                return false;
             }
         }
+        else if (nRead == 0)
+        {
+            HCPLOG_T << "connection closed on socket:" << nSd;
+            return false;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return true;
+        }
+        else if (errno != EINTR)
+        {
+            HCPLOG_E << "Error reading on socket:" << nSd << ", error:" << errno;
+            return false;
+        }
     }
 }
 
-bool CMessageQueue::ReadMsgAndSend(void *pvoidFullMsg, int &rnMsgLen, int &rnSocketId)
+bool CMessageQueue::ProcessBufferedMessages(int nSd, ClientConnection &rConn)
 {
-    bool status = false;
+    size_t nOffset = 0;
+    const size_t nHeaderSize = ic_event::CIgniteMessage::MSG_HEADER_SIZE;
+    bool bValid = true;
+
+    while (rConn.m_nBufferedBytes - nOffset >= nHeaderSize)
+    {
+        const unsigned char *puchMsg = &rConn.m_vecBuffer[nOffset];
+        int nMsgLen = -1;
+        try
+        {
+            nMsgLen = ic_event::CIgniteMessage::GetMessageSize(puchMsg);
+        }
+        catch (const std::string &rstrError)
+        {
+            HCPLOG_E << rstrError;
+        }
 
-    int nReadSize = 0;
+        if ((nMsgLen < 0) || 
+            ((unsigned int)nMsgLen > ic_event::CIgniteMessage::MAX_MESSAGE_LENGTH))
+        {
+            bValid = false;
+            break;
+        }
+
+        if (rConn.m_nBufferedBytes - nOffset < nHeaderSize + nMsgLen)
+        {
+            // wait for the rest of the message
+            if (rConn.m_vecBuffer.size() < nOffset + nHeaderSize + nMsgLen)
+            {
+                rConn.m_vecBuffer.resize(nOffset + nHeaderSize + nMsgLen);
+            }
+            break;
+        }
+
+        DispatchMessage(puchMsg, nSd);
+        nOffset += nHeaderSize + nMsgLen;
+    }
 
-    if (rnMsgLen > 0)
+    // move the partial message to the beginning of the buffer
+    if (nOffset > 0)
     {
-        char* actualMsg = (char*)(pvoidFullMsg) + ic_event::CIgniteMessage::MSG_HEADER_SIZE;
-        nReadSize = read_from_socket(rnSocketId, actualMsg, rnMsgLen);
+        rConn.m_nBufferedBytes -= nOffset;
+        memmove(&rConn.m_vecBuffer[0], &rConn.m_vecBuffer[nOffset],
+                rConn.m_nBufferedBytes);
     }
-    // else it is message with only header with msgLen 0
 
-    if (nReadSize == rnMsgLen)
+    // release the memory held for a large message once it is processed
+    if ((rConn.m_nBufferedBytes == 0) && 
+        (rConn.m_vecBuffer.capacity() > 2 * READ_CHUNK_SIZE))
     {
-        // construct message from serialized data
-        ic_event::CIgniteMessage rcvmsg((void*)pvoidFullMsg);
-        rcvmsg.SetRecipient(rnSocketId);
+        std::vector<unsigned char>().swap(rConn.m_vecBuffer);
+    }
 
-        HCPLOG_LINE() << "-Received message: ";
-        HCPLOG_LINE() << "  -Type: " << rcvmsg.GetType();
-        HCPLOG_LINE() << "  -Reply Required: " << rcvmsg.GetReplyRequired();
-        HCPLOG_LINE() << "  -Length: " << rcvmsg.GetMessageAsString().length();
-        HCPLOG_LINE() << "  -Data: " << rcvmsg.GetMessageAsString();
+    return bValid;
+}
 
-        // Get observers, send message to observers.
-        bool bFoundHandler = false;
-        std::list<SubscriberListItem>::iterator iter;
+void CMessageQueue::DispatchMessage(const void *pvoidFullMsg, int nSocketId)
+{
+    // construct message from serialized data
+    ic_event::CIgniteMessage rcvmsg(pvoidFullMsg);
+    rcvmsg.SetRecipient(nSocketId);
+
+    HCPLOG_LINE() << "-Received message: ";
+    HCPLOG_LINE() << "  -Type: " << rcvmsg.GetType();
+    HCPLOG_LINE() << "  -Reply Required: " << rcvmsg.GetReplyRequired();
+    HCPLOG_LINE() << "  -Length: " << rcvmsg.GetMessageAsString().length();
+    HCPLOG_LINE() << "  -Data: " << rcvmsg.GetMessageAsString();
+
+    // Get observers, send message to observers.
+    bool bFoundHandler = false;
+    std::list<SubscriberListItem>::iterator iter;
 
-        for (iter = m_listSubscriberList.begin(); iter != m_listSubscriberList.end(); iter++)
+    for (iter = m_listSubscriberList.begin(); iter != m_listSubscriberList.end(); iter++)
+    {
+        HCPLOG_T << "Looking for match. " << iter->m_unType;
+        if (iter->m_unType == rcvmsg.GetType())
         {
-            HCPLOG_T << "Looking for match. " << iter->m_unType;
-            if (iter->m_unType == rcvmsg.GetType())
-            {
-                HCPLOG_T << "Match found - type : " << iter->m_pHandler;
-                bFoundHandler = true;
-                iter->m_pHandler->Handle(rcvmsg);
-            }
+            HCPLOG_T << "Match found - type : " << iter->m_pHandler;
+            bFoundHandler = true;
+            iter->m_pHandler->Handle(rcvmsg);
         }
+    }
 
-        if (!bFoundHandler)
+    if (!bFoundHandler)
+    {
+        HCPLOG_T << "Handler not found";
+        if(rcvmsg.GetReplyRequired())
         {
-            HCPLOG_T << "Handler not found";
-            if(rcvmsg.GetReplyRequired())
-            {
-                rcvmsg.Reply("");
-            }
+            rcvmsg.Reply("");
         }
-
-        status = true;
     }
-
-    return status;
 }
 
 void CMessageQueue::Connect()
 {
-    int nActivity, nMaxSd;
-    fd_set fds;  // Read file descriptor set
-
     //accept the incoming connection
     HCPLOG_D << "Waiting for connections ...";
 
-    void* pvoidFullMsg = malloc(ic_event::CIgniteMessage::MAX_SERIALIZED_SIZE);
-
-    if (pvoidFullMsg)
+    CIgniteClient::GetOnOffMonitor()->RegisterForShutdownNotification(this,
+                                                  IOnOff::eR_MESSAGE_QUEUE);
+    std::vector<int> vecReadySockets;
+    while (!m_bIsShutDownInitiated)
     {
-        CIgniteClient::GetOnOffMonitor()->RegisterForShutdownNotification(this,
-                                                      IOnOff::eR_MESSAGE_QUEUE);
-        while (!m_bIsShutDownInitiated)
-        {
-            //clear the socket set
-            FD_ZERO(&fds);
-
-            //add master socket to set
-            FD_SET(m_masterSocket, &fds);
-            nMaxSd = m_masterSocket;
-
-            AddSockets(nMaxSd, fds);
-
-            //wait for an activity on one of the sockets , timeout is NULL , so wait indefinitely
-            nActivity = select( nMaxSd + 1 , &fds , NULL , NULL , NULL);
-
-            if ((nActivity < 0) && (errno != EINTR))
-            {
-                HCPLOG_E << "socket select error";
-            }
+        // clients with unread data are served without waiting
+        int nTimeoutMs = m_setPendingReads.empty() ? -1 : 0;
+        WaitForActivity(nTimeoutMs, vecReadySockets);
 
+        std::set<int> setToRead(m_setPendingReads);
+        m_setPendingReads.clear();
+        for (size_t i = 0; i < vecReadySockets.size(); i++)
+        {
             //If something happened on the master socket , then its an incoming connection
-            if (FD_ISSET(m_masterSocket, &fds))
+            if (vecReadySockets[i] == m_masterSocket)
             {
                 AddNewIncomingConnection();
             }
+            else
+            {
+                setToRead.insert(vecReadySockets[i]);
+            }
+        }
 
-            //else its some IO operation on some other socket :)
-            PerformIOOperation(fds, &pvoidFullMsg);
-
-            if (m_bIsShutDownInitiated) {
-                HCPLOG_I<<"Shut down initiated, breaking from loop";
-                break;
+        //else its some IO operation on some other socket :)
+        std::set<int>::iterator iter;
+        for (iter = setToRead.begin(); iter != setToRead.end(); iter++)
+        {
+            bool bMoreData = false;
+            if (!ReadFromConnection(*iter, bMoreData))
+            {
+                CloseConnection(*iter);
+            }
+            else if (bMoreData)
+            {
+                m_setPendingReads.insert(*iter);
             }
         }
-        free(pvoidFullMsg);
-        pvoidFullMsg = NULL;
-        CIgniteClient::GetOnOffMonitor()->ReadyForShutdown(IOnOff::eR_MESSAGE_QUEUE);
-        CIgniteClient::GetOnOffMonitor()->UnregisterForShutdownNotification(IOnOff::eR_MESSAGE_QUEUE);
-        Detach();
+
+        if (m_bIsShutDownInitiated) {
+            HCPLOG_I<<"Shut down initiated, breaking from loop";
+            break;
+        }
     }
-    else
+
+#if defined(__linux__)
+    if (m_nPollFd >= 0)
     {
-        HCPLOG_E << "Memory allocation Error.";
+        close(m_nPollFd);
+        m_nPollFd = -1;
     }
+#endif
+    CIgniteClient::GetOnOffMonitor()->ReadyForShutdown(IOnOff::eR_MESSAGE_QUEUE);
+    CIgniteClient::GetOnOffMonitor()->UnregisterForShutdownNotification(IOnOff::eR_MESSAGE_QUEUE);
+    Detach();
 }
 
 void CMessageQueue::NotifyShutdown() 
@@ -36,7 +36,8 @@ using std::string;
 namespace ic_core 
 {
 CAesGcm::CAesGcm(const std::string &rstrKey, const std::string &rstrIV):
-                 m_strKey(rstrKey), m_strIV(rstrIV)
+                 m_strKey(rstrKey), m_strIV(rstrIV), m_bEncryptKeySet(false),
+                 m_bDecryptKeySet(false)
 {
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
     m_pEncryptCtx = (EVP_CIPHER_CTX*) malloc(sizeof(EVP_CIPHER_CTX));
@@ -154,6 +155,17 @@ int CAesGcm::GcmEncrypt(const std::string &rstrPlaintext,
 
 AesGcmReturnCode CAesGcm::InitGcmEncryptOperation()
 {
+    if (m_bEncryptKeySet)
+    {
+        // Only reset the IV, keeping the cipher setup and the key schedule
+        if (1 == EVP_EncryptInit_ex(m_pEncryptCtx, NULL, NULL, NULL,
+                     reinterpret_cast<const unsigned char*>(m_strIV.c_str())))
+        {
+            return eGCM_PROCESS_CONT;
+        }
+        m_bEncryptKeySet = false;
+    }
+
     // Initialize the encryption operation
     if (1 != EVP_EncryptInit_ex(m_pEncryptCtx, EVP_aes_128_gcm(), 
                                 NULL, NULL, NULL))
@@ -178,6 +190,7 @@ AesGcmReturnCode CAesGcm::InitGcmEncryptOperation()
         HCPLOG_E << "EVP_EncryptInit_ex key,iv failed";
         return eGCM_FAILURE;
     }
+    m_bEncryptKeySet = true;
     return eGCM_PROCESS_CONT;
 }
 
@@ -256,15 +269,109 @@ int CAesGcm::GcmDecrypt(const string &rstrBase64enctext, string &rstrDecyptedOut
         return eGCM_FAILURE;
     }
 
-    unsigned char *puchCipherText = reinterpret_cast<unsigned char*>
-                                      (const_cast<char*>(pchBase64DecodedText));
-    
-    int nLen= -1, nplaintext_len= -1;
+    int nRet = GcmDecryptBytes(reinterpret_cast<unsigned char*>
+                               (pchBase64DecodedText), nCiphertextLen,
+                               rstrDecyptedOut);
+
+    free(pchBase64DecodedText);
+    return nRet;
+}
+
+int CAesGcm::GcmDecryptRaw(const string &rstrCipherText,
+                           string &rstrDecyptedOut)
+{
+    HCPLOG_METHOD();
+    if (rstrCipherText.empty())
+    {
+        HCPLOG_E << "rstrCipherText is empty";
+        return eGCM_FAILURE;
+    }
+
+    return GcmDecryptBytes(reinterpret_cast<const unsigned char*>
+                           (rstrCipherText.data()), rstrCipherText.size(),
+                           rstrDecyptedOut);
+}
+
+int CAesGcm::GcmDecryptBytes(const unsigned char *puchCipherText,
+                             int nCiphertextLen, string &rstrDecyptedOut)
+{
+    int nLen= -1;
+
+    if (eGCM_FAILURE == InitGcmDecryptOperation())
+    {
+        return eGCM_FAILURE;
+    }
+
+    // Padding is disabled, hence the output is as long as the input
+    string strPlaintext(nCiphertextLen, '\0');
+    if (!EVP_DecryptUpdate(m_pDecryptCtx, 
+                        reinterpret_cast<unsigned char*>(&strPlaintext[0]),
+                        &nLen, puchCipherText, nCiphertextLen))
+    {
+        HCPLOG_E << "Error in DecryptUpdate";
+        return eGCM_FAILURE;
+    }
+    strPlaintext.resize(nLen);
+    rstrDecyptedOut.swap(strPlaintext);
+
+    HCPLOG_I << "GCM Decryption Successful" << rstrDecyptedOut;
+    return eGCM_SUCCESS;
+}
+
+int CAesGcm::GcmEncryptRaw(const std::string &rstrPlaintext,
+                           std::string &rstrCipherTextOut)
+{
+    HCPLOG_METHOD();
+    if (rstrPlaintext.empty())
+    {
+        HCPLOG_E << "puchPlaintext is empty";
+        return eGCM_FAILURE;
+    }
+
+    if (eGCM_FAILURE == InitGcmEncryptOperation())
+    {
+        // Since one of the initialization steps has failed, return from here
+        return eGCM_FAILURE;
+    }
+
+    //Disable padding
+    if (1 != EVP_CIPHER_CTX_set_padding(m_pEncryptCtx,0))
+    {
+        HCPLOG_E << "set_padding failed";
+        return eGCM_FAILURE;
+    }
+
+    int nLen = -1;
+    string strCipherText(rstrPlaintext.size(), '\0');
+    if (1 != EVP_EncryptUpdate(m_pEncryptCtx, 
+                  reinterpret_cast<unsigned char*>(&strCipherText[0]), &nLen,
+                  reinterpret_cast<const unsigned char*>(rstrPlaintext.data()),
+                  rstrPlaintext.size()))
+    {
+        HCPLOG_E << "EVP_EncryptUpdate failed";
+        return eGCM_FAILURE;
+    }
+    strCipherText.resize(nLen);
+    rstrCipherTextOut.swap(strCipherText);
+    return eGCM_SUCCESS;
+}
+
+AesGcmReturnCode CAesGcm::InitGcmDecryptOperation()
+{
+    if (m_bDecryptKeySet)
+    {
+        // Only reset the IV, keeping the cipher setup and the key schedule
+        if (EVP_DecryptInit_ex(m_pDecryptCtx, NULL, NULL, NULL,
+                     reinterpret_cast<const unsigned char*>(m_strIV.c_str())))
+        {
+            return eGCM_PROCESS_CONT;
+        }
+        m_bDecryptKeySet = false;
+    }
 
     // Initialize the decryption operation
     if (!EVP_DecryptInit_ex(m_pDecryptCtx, EVP_aes_128_gcm(), NULL, NULL, NULL))
     {
-        free(pchBase64DecodedText);
         HCPLOG_E << "Error in Init";
         return eGCM_FAILURE;
     }
@@ -272,7 +379,6 @@ int CAesGcm::GcmDecrypt(const string &rstrBase64enctext, string &rstrDecyptedOut
     //Disable padding
     if (1 != EVP_CIPHER_CTX_set_padding(m_pDecryptCtx,0))
     {
-        free(pchBase64DecodedText);
         HCPLOG_E << "set_padding failed";
         return eGCM_FAILURE;
     }
@@ -281,7 +387,6 @@ int CAesGcm::GcmDecrypt(const string &rstrBase64enctext, string &rstrDecyptedOut
     if (!EVP_CIPHER_CTX_ctrl(m_pDecryptCtx, EVP_CTRL_GCM_SET_IVLEN, 
                              m_strIV.size(), NULL))
     {
-        free(pchBase64DecodedText);
         HCPLOG_E << "Error in SET_IVLEN";
         return eGCM_FAILURE;
     }
@@ -291,40 +396,11 @@ int CAesGcm::GcmDecrypt(const string &rstrBase64enctext, string &rstrDecyptedOut
                        reinterpret_cast<const unsigned char*>(m_strKey.c_str()), 
                        reinterpret_cast<const unsigned char*>(m_strIV.c_str())))
     {
-        free(pchBase64DecodedText);
         HCPLOG_E << "Error in init key & iv";
         return eGCM_FAILURE;
     }
-
-    unsigned char *puchPlaintext = nullptr;
-    try
-    {
-        puchPlaintext = new unsigned char[nCiphertextLen];
-    }
-    catch(std::bad_alloc & ba)
-    {
-        HCPLOG_E << "bad_alloc caught";
-        free(pchBase64DecodedText);
-        return eGCM_FAILURE;
-    }
-
-    if (!EVP_DecryptUpdate(m_pDecryptCtx, puchPlaintext, &nLen, puchCipherText, 
-                        nCiphertextLen))
-    {
-        HCPLOG_E << "Error in DecryptUpdate";
-        free(pchBase64DecodedText);
-        delete [] puchPlaintext;
-        return eGCM_FAILURE;
-    }
-    nplaintext_len = nLen;
-    rstrDecyptedOut = string(reinterpret_cast<char*>(puchPlaintext),
-                                                     nplaintext_len);
-
-    HCPLOG_I << "GCM Decryption Successful" << rstrDecyptedOut;
-
-    free(pchBase64DecodedText);
-    delete [] puchPlaintext;
-    return eGCM_SUCCESS;
+    m_bDecryptKeySet = true;
+    return eGCM_PROCESS_CONT;
 }
 
 std::string CAesGcm::GenerateAAD(const string &rstrAADKey)
@@ -17,10 +17,18 @@
  ******************************************************************************/
 
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <system_error>
+#include <thread>
 #include "CIgniteLog.h"
 #include "crypto/CIgniteDataSecurity.h"
 #include "crypto/CAes.h"
 #include "crypto/CAesGcm.h"
+#include "crypto/CBase64.h"
+#include "core/CKeyGenerator.h"
+#include "core/CAesSeed.h"
 
 //! Macro for 'CIgniteDataSecurity' string
 #ifdef PREFIX
@@ -30,6 +38,185 @@
 
 namespace ic_core 
 {
+namespace
+{
+//! Generation of the event encryption key, bumped on every invalidation
+std::atomic<unsigned int> g_atomicEventKeyGen(0);
+
+/*
+ * Marker of the binary event format; base64 text never starts with it, which
+ * keeps payloads stored as text by earlier versions distinguishable
+ */
+const char EVENT_BINARY_FORMAT_V1 = '\x01';
+
+//! Constant upper bound of threads processing one event group
+const unsigned int MAX_EVENT_CRYPTO_WORKERS = 4;
+
+//! Constant minimum number of events handed to one thread of a group
+const size_t MIN_EVENTS_PER_CRYPTO_WORKER = 256;
+
+/**
+ * Structure holding the event encryption instance of a thread
+ */
+struct EventCipher
+{
+    //! Key generation the instance is created for
+    unsigned int unKeyGen;
+
+    //! Event encryption key the instance is created with
+    std::string strKey;
+
+    //! Initialization vector the instance is created with
+    std::string strIV;
+
+    //! Instance created with the event encryption key
+    std::unique_ptr<CIgniteDataSecurity> pSecurity;
+};
+
+/**
+ * Method to get the event encryption instance of the calling thread, creating
+ * it if the key is invalidated since it was created
+ * @param void
+ * @return event encryption instance of the calling thread
+ */
+EventCipher &get_event_cipher()
+{
+    static thread_local EventCipher stCipher = {0, "", "", nullptr};
+
+    unsigned int unKeyGen = g_atomicEventKeyGen.load();
+    if (!stCipher.pSecurity || (stCipher.unKeyGen != unKeyGen))
+    {
+        /*
+         * Key derivation may store a new seed, which invalidates the key again;
+         * the instance is then recreated on the next call
+         */
+        stCipher.strKey = CKeyGenerator::GetActivationKey();
+        stCipher.strIV = CAesSeed::GetInstance()->GetIvRandom();
+        stCipher.pSecurity.reset(new CIgniteDataSecurity(stCipher.strKey,
+                                                         stCipher.strIV));
+        stCipher.unKeyGen = unKeyGen;
+        HCPLOG_D << "Event key generation:" << unKeyGen;
+    }
+    return stCipher;
+}
+
+/**
+ * Method to encrypt an event payload into the binary event format
+ * @param[in] pSecurity Instance used for encryption
+ * @param[in] rstrEventData Event payload
+ * @return Encrypted payload, empty on failure
+ */
+std::string encrypt_event(CIgniteDataSecurity *pSecurity,
+                          const std::string &rstrEventData)
+{
+    std::string strCipherText = pSecurity->EncryptBinary(rstrEventData);
+    if (strCipherText.empty())
+    {
+        return "";
+    }
+    return EVENT_BINARY_FORMAT_V1 + strCipherText;
+}
+
+/**
+ * Method to decrypt an event payload in binary event format or base64 text
+ * @param[in] pSecurity Instance used for decryption
+ * @param[in] rstrEventData Encrypted event payload
+ * @return Decrypted payload
+ */
+std::string decrypt_event(CIgniteDataSecurity *pSecurity,
+                          const std::string &rstrEventData)
+{
+    if (CIgniteDataSecurity::IsBinaryEvent(rstrEventData))
+    {
+        return pSecurity->DecryptBinary(rstrEventData.substr(1));
+    }
+    return pSecurity->Decrypt(rstrEventData);
+}
+
+/**
+ * Method to encrypt or decrypt a range of event payloads in place
+ * @param[in] pSecurity Instance used for the range
+ * @param[in/out] rvecData Event payloads
+ * @param[in] nBegin Index of the first payload of the range
+ * @param[in] nEnd Index past the last payload of the range
+ * @param[in] bEncrypt True to encrypt, false to decrypt
+ * @return void
+ */
+void transform_events(CIgniteDataSecurity *pSecurity,
+                      std::vector<std::string> &rvecData,
+                      size_t nBegin, size_t nEnd, bool bEncrypt)
+{
+    for (size_t nIdx = nBegin; nIdx < nEnd; nIdx++)
+    {
+        std::string strResult = bEncrypt ?
+                                encrypt_event(pSecurity, rvecData[nIdx]) :
+                                decrypt_event(pSecurity, rvecData[nIdx]);
+        rvecData[nIdx].swap(strResult);
+    }
+}
+
+/**
+ * Method to encrypt or decrypt a group of event payloads in place, splitting
+ * it across up to unWorkers threads. The calling thread processes the first
+ * range with its own instance; each worker creates an instance from the
+ * already derived key, so the key is derived at most once per group.
+ * @param[in/out] rvecData Event payloads
+ * @param[in] unWorkers Maximum number of threads including the calling thread
+ * @param[in] bEncrypt True to encrypt, false to decrypt
+ * @return void
+ */
+void transform_event_group(std::vector<std::string> &rvecData,
+                           unsigned int unWorkers, bool bEncrypt)
+{
+    if (rvecData.empty())
+    {
+        return;
+    }
+
+    EventCipher &rCipher = get_event_cipher();
+
+    size_t nWorkers = std::min<size_t>(unWorkers, MAX_EVENT_CRYPTO_WORKERS);
+    nWorkers = std::min(nWorkers,
+                        rvecData.size() / MIN_EVENTS_PER_CRYPTO_WORKER);
+    if (nWorkers <= 1)
+    {
+        transform_events(rCipher.pSecurity.get(), rvecData, 0,
+                         rvecData.size(), bEncrypt);
+        return;
+    }
+
+    const size_t nChunk = (rvecData.size() + nWorkers - 1) / nWorkers;
+    std::vector<std::thread> vecThreads;
+    vecThreads.reserve(nWorkers - 1);
+    for (size_t nBegin = nChunk; nBegin < rvecData.size(); nBegin += nChunk)
+    {
+        const size_t nEnd = std::min(nBegin + nChunk, rvecData.size());
+        try
+        {
+            vecThreads.emplace_back([&rCipher, &rvecData, nBegin, nEnd, bEncrypt]()
+            {
+                CIgniteDataSecurity security(rCipher.strKey, rCipher.strIV);
+                transform_events(&security, rvecData, nBegin, nEnd, bEncrypt);
+            });
+        }
+        catch (const std::system_error &rException)
+        {
+            HCPLOG_E << "Worker creation failed:" << rException.what();
+            transform_events(rCipher.pSecurity.get(), rvecData, nBegin, nEnd,
+                             bEncrypt);
+        }
+    }
+
+    transform_events(rCipher.pSecurity.get(), rvecData, 0,
+                     std::min(nChunk, rvecData.size()), bEncrypt);
+
+    for (auto &rThread : vecThreads)
+    {
+        rThread.join();
+    }
+}
+}
+
 CIgniteDataSecurity::CIgniteDataSecurity(const std::string &rstrKey, 
                                          const std::string &rstrIV)
 {
@@ -88,4 +275,97 @@ string CIgniteDataSecurity::Decrypt(const string &rstrBase64enctext)
 
     return strDecryptedText;
 }
+
+string CIgniteDataSecurity::EncryptBinary(const string &rstrPlaintext)
+{
+    if (rstrPlaintext.empty())
+    {
+        return "";
+    }
+
+    string strCipherText;
+    if (eGCM_SUCCESS != m_pAesGcm->GcmEncryptRaw(rstrPlaintext, strCipherText))
+    {
+        HCPLOG_E << "GcmEncryptRaw Failed!";
+        strCipherText.clear();
+    }
+    return strCipherText;
+}
+
+string CIgniteDataSecurity::DecryptBinary(const string &rstrCipherText)
+{
+    if (rstrCipherText.empty())
+    {
+        return "";
+    }
+
+    std::string strDecryptedText;
+    int nDecryptStatus = m_pAesGcm->GcmDecryptRaw(rstrCipherText,
+                                                  strDecryptedText);
+    HCPLOG_D << "decryptStatus: " << nDecryptStatus;
+
+    // If AES-GCM decryption fails, fall back to AES decryption
+    if (eGCM_FAILURE == nDecryptStatus)
+    {
+        CAes aes(m_strKey, m_strIV);
+        strDecryptedText = aes.Decrypt(CBase64::Encode(
+                               const_cast<char*>(rstrCipherText.data()),
+                               rstrCipherText.size()));
+    }
+
+    return strDecryptedText;
+}
+
+string CIgniteDataSecurity::EncryptEvent(const string &rstrEventData)
+{
+    return encrypt_event(get_event_cipher().pSecurity.get(), rstrEventData);
+}
+
+string CIgniteDataSecurity::DecryptEvent(const string &rstrBase64enctext)
+{
+    return decrypt_event(get_event_cipher().pSecurity.get(), rstrBase64enctext);
+}
+
+void CIgniteDataSecurity::EncryptEvents(std::vector<string> &rvecEventData,
+                                        unsigned int unWorkers)
+{
+    transform_event_group(rvecEventData, unWorkers, true);
+}
+
+void CIgniteDataSecurity::DecryptEvents(std::vector<string> &rvecBase64enctext,
+                                        unsigned int unWorkers)
+{
+    transform_event_group(rvecBase64enctext, unWorkers, false);
+}
+
+void CIgniteDataSecurity::InvalidateEventKey()
+{
+    g_atomicEventKeyGen++;
+}
+
+bool CIgniteDataSecurity::IsBinaryEvent(const string &rstrEventData)
+{
+    return !rstrEventData.empty() &&
+           (EVENT_BINARY_FORMAT_V1 == rstrEventData[0]);
+}
+
+string CIgniteDataSecurity::EventTextToBinary(const string &rstrBase64enctext)
+{
+    int nLen = -1;
+    char *pchDecoded = CBase64::Decode(rstrBase64enctext, nLen);
+    if (nullptr == pchDecoded)
+    {
+        return "";
+    }
+
+    string strBinary;
+    if (nLen > 0)
+    {
+        strBinary.reserve(nLen + 1);
+        strBinary.push_back(EVENT_BINARY_FORMAT_V1);
+        strBinary.append(pchDecoded, nLen);
+    }
+    free(pchDecoded);
+    return strBinary;
+}
 } // namespace ic_core
@@ -100,6 +100,11 @@ ic_utils::Json::Value CEventWrapper::GetData()
     return m_jsonValue;
 }
 
+const ic_utils::Json::Value &CEventWrapper::GetDataRef() const
+{
+    return m_jsonValue;
+}
+
 int CEventWrapper::GetTimezone()
 {
     return m_jsonEventFields[ic_event::TIMEZONE_TAG].asInt();
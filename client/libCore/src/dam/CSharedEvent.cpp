@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "dam/CSharedEvent.h"
+
+namespace ic_core
+{
+CSharedEventPtr CSharedEvent::Create(CEventWrapper *pEvent)
+{
+    if (NULL == pEvent)
+    {
+        return CSharedEventPtr();
+    }
+
+    std::string strSerialized;
+    pEvent->EventToJson(strSerialized);
+    return CSharedEventPtr(new CSharedEvent(pEvent, strSerialized));
+}
+
+CSharedEventPtr CSharedEvent::Create(const std::string &rstrSerialized)
+{
+    CEventWrapper *pEvent = new CEventWrapper();
+    pEvent->JsonToEvent(rstrSerialized);
+    return CSharedEventPtr(new CSharedEvent(pEvent, rstrSerialized));
+}
+
+CSharedEvent::CSharedEvent(CEventWrapper *pEvent,
+                           const std::string &rstrSerialized)
+    : m_pEvent(pEvent), m_strSerialized(rstrSerialized)
+{
+    /* All the fields are read while the snapshot is still private to this
+     * thread; the non-const getters of the event must not be invoked once
+     * the snapshot is shared.
+     */
+    m_strEventId = m_pEvent->GetEventId();
+    m_dblTimestamp = m_pEvent->GetTimestamp();
+    m_nTimezone = m_pEvent->GetTimezone();
+    m_vectAttachments = m_pEvent->GetAttachments();
+}
+
+CSharedEvent::~CSharedEvent()
+{
+    //do nothing
+}
+
+const std::string &CSharedEvent::GetEventId() const
+{
+    return m_strEventId;
+}
+
+double CSharedEvent::GetTimestamp() const
+{
+    return m_dblTimestamp;
+}
+
+int CSharedEvent::GetTimezone() const
+{
+    return m_nTimezone;
+}
+
+const std::vector<std::string> &CSharedEvent::GetAttachments() const
+{
+    return m_vectAttachments;
+}
+
+const ic_utils::Json::Value &CSharedEvent::GetData() const
+{
+    return m_pEvent->GetDataRef();
+}
+
+const std::string &CSharedEvent::GetSerialized() const
+{
+    return m_strSerialized;
+}
+
+CEventWrapper CSharedEvent::GetEventCopy() const
+{
+    return *m_pEvent;
+}
+} /* namespace ic_core */
@@ -46,6 +46,18 @@ CContentValues::CContentValues()
     m_jsonData.clear();
 }
 
+bool CContentValues::IsInteger(std::string strKey)
+{
+    if (!m_jsonData.isMember(strKey))
+    {
+        return false;
+    }
+
+    ic_utils::Json::ValueType eType = m_jsonData[strKey].type();
+    return (ic_utils::Json::intValue == eType) ||
+           (ic_utils::Json::uintValue == eType);
+}
+
 std::vector<std::string> CContentValues::GetKeys()
 {
     return m_jsonData.getMemberNames();
@@ -54,6 +66,7 @@ std::vector<std::string> CContentValues::GetKeys()
 void CContentValues::Clear()
 {
     m_jsonData.clear();
+    m_setBlobKeys.clear();
 }
 
 int CContentValues::Size()
@@ -64,16 +77,19 @@ int CContentValues::Size()
 void CContentValues::Put(std::string strKey, int nValue)
 {
     m_jsonData[strKey] = nValue;
+    m_setBlobKeys.erase(strKey);
 }
 
 void CContentValues::Put(std::string strKey, long long llValue)
 {
     m_jsonData[strKey] = llValue;
+    m_setBlobKeys.erase(strKey);
 }
 
 void CContentValues::Put(std::string strKey, std::string strValue)
 {
     m_jsonData[strKey] = strValue;
+    m_setBlobKeys.erase(strKey);
 }
 
 void CContentValues::Put(std::string strKey, const char* pchValue)
@@ -84,16 +100,31 @@ void CContentValues::Put(std::string strKey, const char* pchValue)
 void CContentValues::Put(std::string strKey, bool bValue)
 {
     m_jsonData[strKey] = bValue;
+    m_setBlobKeys.erase(strKey);
 }
 
 void CContentValues::Put(std::string strKey, float fltValue)
 {
     m_jsonData[strKey] = fltValue;
+    m_setBlobKeys.erase(strKey);
 }
 
 void CContentValues::Put(std::string strKey, double dblValue)
 {
     m_jsonData[strKey] = dblValue;
+    m_setBlobKeys.erase(strKey);
+}
+
+void CContentValues::PutBlob(std::string strKey, const std::string &strValue)
+{
+    // json strings keep embedded zeroes, hence binary data is kept as is
+    m_jsonData[strKey] = strValue;
+    m_setBlobKeys.insert(strKey);
+}
+
+bool CContentValues::IsBlob(const std::string &strKey) const
+{
+    return (m_setBlobKeys.find(strKey) != m_setBlobKeys.end());
 }
 
 std::string CContentValues::GetString(std::string strKey)
@@ -90,6 +90,9 @@ const std::string CDataBaseConst::COL_BATCH_SUPPORT = "BATCH";
 //! Constant key for 'GRANULARITY' string
 const std::string CDataBaseConst::COL_GRANULARITY = "GRANULARITY";
 
+//! Constant key for 'CHECKSUM' string
+const std::string CDataBaseConst::COL_CHECKSUM = "CHECKSUM";
+
 //! Constant key for 'MESSAGE_SENDER_STORE' string
 const std::string CDataBaseConst::MESSAGE_SENDER_STORE = "MESSAGE_SENDER_STORE";
 
@@ -57,6 +57,35 @@ CCursor* CDataBaseFacade::Query(const std::string strTable,
     return NULL;
 }
 
+CStreamCursor* CDataBaseFacade::QueryStream(const std::string strTable,
+                const std::vector<std::string> &rvecProjection,
+                const std::string &rstrSelection,
+                const std::vector<std::string> &rvecOrderBy,
+                const int nLimit)
+{
+    HCPLOG_METHOD();
+    if (!strTable.empty())
+    {
+        return m_pSQLiteDbInstance->QueryStream(strTable, rvecProjection,
+                                    rstrSelection, rvecOrderBy, nLimit);
+    }
+    return NULL;
+}
+
+std::string CDataBaseFacade::GetQueryPlan(const std::string strTable,
+                const std::vector<std::string> &rvecProjection,
+                const std::string &rstrSelection,
+                const std::vector<std::string> &rvecOrderBy,
+                const int nLimit)
+{
+    if (!strTable.empty())
+    {
+        return m_pSQLiteDbInstance->GetQueryPlan(strTable, rvecProjection,
+                                    rstrSelection, rvecOrderBy, nLimit);
+    }
+    return "";
+}
+
 long CDataBaseFacade::Insert(const std::string strTable, CContentValues *pData)
 {
     long lRetValue = eINVALID_OPERATION;
@@ -67,6 +96,17 @@ long CDataBaseFacade::Insert(const std::string strTable, CContentValues *pData)
     return lRetValue;
 }
 
+int CDataBaseFacade::BulkInsert(const std::string strTable,
+                                std::vector<CContentValues> &rvecData)
+{
+    int nRetValue = eINVALID_OPERATION;
+    if (!strTable.empty())
+    {
+        nRetValue = m_pSQLiteDbInstance->BulkInsert(strTable, rvecData);
+    }
+    return nRetValue;
+}
+
 bool CDataBaseFacade::Update(const std::string strTable, CContentValues *pData,
                                                const std::string &rstrSelection)
 {
@@ -78,6 +118,19 @@ bool CDataBaseFacade::Update(const std::string strTable, CContentValues *pData,
     return bRetValue;
 }
 
+bool CDataBaseFacade::Update(const std::string strTable, CContentValues *pData,
+                             const std::string &rstrSelection,
+                             const std::vector<std::string> &rvecSelectionArgs)
+{
+    bool bRetValue = false;
+    if (!strTable.empty() && pData != NULL)
+    {
+        bRetValue = m_pSQLiteDbInstance->Update(strTable, pData, rstrSelection,
+                                                rvecSelectionArgs);
+    }
+    return bRetValue;
+}
+
 bool CDataBaseFacade::Remove(const std::string strTable, 
                                                const std::string &rstrSelection)
 {
@@ -90,6 +143,39 @@ bool CDataBaseFacade::Remove(const std::string strTable,
     return retValue;
 }
 
+bool CDataBaseFacade::BindIdSet(const std::vector<long long> &rvecIds)
+{
+    return m_pSQLiteDbInstance->BindIdSet(rvecIds);
+}
+
+bool CDataBaseFacade::RemoveByIdSet(const std::string strTable,
+                                    const std::string &rstrColumn,
+                                    const std::string &rstrSelection)
+{
+    bool bRetValue = false;
+    if (!strTable.empty() && !rstrColumn.empty())
+    {
+        bRetValue = m_pSQLiteDbInstance->RemoveByIdSet(strTable, rstrColumn,
+                                                       rstrSelection);
+    }
+    return bRetValue;
+}
+
+bool CDataBaseFacade::UpdateByIdSet(const std::string strTable,
+                                    CContentValues *pData,
+                                    const std::string &rstrColumn,
+                                    const std::string &rstrSelection)
+{
+    bool bRetValue = false;
+    if (!strTable.empty() && !rstrColumn.empty() && (pData != NULL))
+    {
+        bRetValue = m_pSQLiteDbInstance->UpdateByIdSet(strTable, pData,
+                                                       rstrColumn,
+                                                       rstrSelection);
+    }
+    return bRetValue;
+}
+
 bool CDataBaseFacade::StartTransaction()
 {
     return m_pSQLiteDbInstance->StartTransaction();
@@ -120,6 +206,11 @@ bool CDataBaseFacade::VacuumDb()
     return m_pSQLiteDbInstance->VacuumDb();
 }
 
+int CDataBaseFacade::ReclaimFreePages(unsigned int unMaxPages)
+{
+    return m_pSQLiteDbInstance->ReclaimFreePages(unMaxPages);
+}
+
 int CDataBaseFacade::CloseConnection()
 {
     HCPLOG_METHOD();
@@ -23,6 +23,7 @@
 #include <iosfwd>
 #include <algorithm>
 #include "db/CDatabase.h"
+#include "db/CDbCheckpointer.h"
 #include "CIgniteConfig.h"
 #include "CIgniteDateTime.h"
 #include "CIgniteFileUtils.h"
@@ -53,7 +54,7 @@ namespace
 #define KEY_VENDOR "vendor"
 
 //! Constant key for 'db version' value
-static const int DB_VERSION = 17;
+static const int DB_VERSION = 20;
 
 //! Constant key array for 'event store columns' value
 static const char* EVENT_STORE_COLUMNS[] =
@@ -71,13 +72,26 @@ static const char* EVENT_STORE_COLUMNS[] =
     CDataBaseConst::COL_MID.c_str(),
     CDataBaseConst::COL_BATCH_SUPPORT.c_str(),
     CDataBaseConst::COL_STREAM_SUPPORT.c_str(),
-    CDataBaseConst::COL_GRANULARITY.c_str()
+    CDataBaseConst::COL_GRANULARITY.c_str(),
+    CDataBaseConst::COL_CHECKSUM.c_str()
 };
 
 //! Constant key for 'event store columns number' value
 static const int EVENT_STORE_COL_NUM = 
                                     sizeof(EVENT_STORE_COLUMNS) / sizeof(char*);
 
+//! Constant key for 'IDX_EVENT_STORE_MID_TIMESTAMP' string
+static const std::string IDX_EVENT_STORE_MID_TIMESTAMP =
+                                                "IDX_EVENT_STORE_MID_TIMESTAMP";
+
+//! Constant key for 'IDX_EVENT_STORE_TIMESTAMP' string
+static const std::string IDX_EVENT_STORE_TIMESTAMP =
+                                                    "IDX_EVENT_STORE_TIMESTAMP";
+
+//! Constant key for 'IDX_EVENT_STORE_EVENTID_TIMESTAMP' string
+static const std::string IDX_EVENT_STORE_EVENTID_TIMESTAMP =
+                                            "IDX_EVENT_STORE_EVENTID_TIMESTAMP";
+
 //! Constant key array for 'invalid event store columns' value
 static const char* INVALID_EVENT_STORE_COLUMNS[] =
 {
@@ -150,6 +164,158 @@ static ic_utils::CIgniteMutex g_TransactionMutex;
 //! Mutex variable to synchronize sql query execution
 static ic_utils::CIgniteMutex g_SqlMutex;
 
+//! Constant key for 'maximum number of cached prepared statements' value
+static const size_t MAX_CACHED_STATEMENTS = 32;
+
+//! Constant key for 'temporary ID set table creation' statement
+static const std::string CREATE_ID_SET =
+                "CREATE TEMP TABLE IF NOT EXISTS ID_SET (ID INTEGER PRIMARY KEY);";
+
+//! Constant key for 'temporary ID set clearing' statement
+static const std::string CLEAR_ID_SET = "DELETE FROM temp.ID_SET;";
+
+//! Constant key for 'temporary ID set insertion' statement
+static const std::string INSERT_ID_SET =
+                        "INSERT OR IGNORE INTO temp.ID_SET (ID) VALUES (?);";
+
+//! Constant key for 'temporary ID set' column
+static const std::string COL_ID_SET = "ID";
+
+//! Constant key for 'DAM.Database.walMode' string
+static const std::string KEY_WAL_MODE = "DAM.Database.walMode";
+
+//! Constant key for 'DAM.Database.synchronous' string
+static const std::string KEY_SYNCHRONOUS = "DAM.Database.synchronous";
+
+//! Constant key for 'DAM.Database.walCheckpointIdleMs' string
+static const std::string KEY_WAL_CHECKPOINT_IDLE_MS =
+                                             "DAM.Database.walCheckpointIdleMs";
+
+//! Constant key for 'DAM.Database.walTruncateSizeKB' string
+static const std::string KEY_WAL_TRUNCATE_SIZE_KB =
+                                              "DAM.Database.walTruncateSizeKB";
+
+//! Constant key for 'DAM.Database.incrementalVacuum' string
+static const std::string KEY_INCREMENTAL_VACUUM =
+                                               "DAM.Database.incrementalVacuum";
+
+//! Constant key for 'DAM.Database.vacuumPagesPerStep' string
+static const std::string KEY_VACUUM_PAGES_PER_STEP =
+                                              "DAM.Database.vacuumPagesPerStep";
+
+//! Constant key for 'default number of pages reclaimed per vacuum step' value
+static const int DEF_VACUUM_PAGES_PER_STEP = 256;
+
+//! Constant key for 'auto_vacuum pragma value of INCREMENTAL mode' value
+static const int AUTO_VACUUM_INCREMENTAL = 2;
+
+//! Constant key for 'default WAL checkpoint idle time in ms' value
+static const int DEF_WAL_CHECKPOINT_IDLE_MS = 5000;
+
+//! Constant key for 'default WAL size triggering truncation in KB' value
+static const int DEF_WAL_TRUNCATE_SIZE_KB = 4096;
+
+//! Constant array of the supported 'synchronous' pragma levels
+static const char* SYNCHRONOUS_LEVELS[] = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+/**
+ * Global method registered as wal hook of the database connection; hands the
+ * commit over to the checkpoint thread
+ * @param[in] pArg instance of CDbCheckpointer
+ * @param[in] pDB database connection
+ * @param[in] pchDbName name of the database committed to
+ * @param[in] nPages number of pages in the write-ahead log
+ * @return SQLITE_OK always
+ */
+static int wal_commit_hook(void *pArg, sqlite3 *pDB, const char *pchDbName,
+                           int nPages)
+{
+    static_cast<CDbCheckpointer*>(pArg)->NotifyCommit(nPages);
+    return SQLITE_OK;
+}
+
+/**
+ * Global method to generate insert statement with one parameter per column
+ * @param[in] rstrTable table name
+ * @param[in] rvecColumns column names
+ * @return insert statement
+ */
+std::string generate_insert_statement(const std::string &rstrTable,
+                                      const std::vector<std::string> &rvecColumns)
+{
+    std::string strColumns, strValues;
+    for (size_t i = 0; i < rvecColumns.size(); i++)
+    {
+        if (i > 0)
+        {
+            strColumns.append(", ");
+            strValues.append(", ");
+        }
+        strColumns.append(rvecColumns[i]);
+        strValues.append("?");
+    }
+    return "INSERT INTO " + rstrTable + " (" + strColumns + ") VALUES (" +
+           strValues + ");";
+}
+
+/**
+ * Global method to generate the selection of the rows whose column value is
+ * in the temporary ID set
+ * @param[in] rstrColumn column matched against the ID set
+ * @param[in] rstrSelection additional selection, may be empty
+ * @return selection string
+ */
+std::string get_id_set_selection(const std::string &rstrColumn,
+                                 const std::string &rstrSelection)
+{
+    std::string strSelection = rstrColumn + " IN (SELECT " + COL_ID_SET +
+                               " FROM temp.ID_SET)";
+    if (!rstrSelection.empty())
+    {
+        strSelection += " AND " + rstrSelection;
+    }
+    return strSelection;
+}
+
+/**
+ * Global method to bind the values of the given columns to the parameters of
+ * the prepared statement, in order
+ * @param[in] pStmt prepared statement
+ * @param[in] rData data holding the values
+ * @param[in] rvecColumns columns whose values are to be bound
+ * @return SQLITE_OK if all values are bound, sqlite error-code otherwise
+ */
+int bind_values(sqlite3_stmt *pStmt, CContentValues &rData,
+                const std::vector<std::string> &rvecColumns)
+{
+    int nRc = SQLITE_OK;
+    for (size_t i = 0; (i < rvecColumns.size()) && (SQLITE_OK == nRc); i++)
+    {
+        /* values other than integers are bound as text, which is what the
+         * quoted literals used to be; column affinity converts them the same
+         * way
+         */
+        if (rData.IsInteger(rvecColumns[i]))
+        {
+            nRc = sqlite3_bind_int64(pStmt, i + 1,
+                                     rData.GetAsLong(rvecColumns[i]));
+        }
+        else if (rData.IsBlob(rvecColumns[i]))
+        {
+            std::string strValue = rData.GetAsString(rvecColumns[i]);
+            nRc = sqlite3_bind_blob(pStmt, i + 1, strValue.data(),
+                                    strValue.size(), SQLITE_TRANSIENT);
+        }
+        else
+        {
+            std::string strValue = rData.GetAsString(rvecColumns[i]);
+            nRc = sqlite3_bind_text(pStmt, i + 1, strValue.c_str(),
+                                    strValue.size(), SQLITE_TRANSIENT);
+        }
+    }
+    return nRc;
+}
+
 /**
  * Global method to use as a callback function while executing sql query and
  * perform database integrity check
@@ -201,6 +367,59 @@ static int callback_schema(void *pData, int nArgc,
     return 0;
 }
 
+/**
+ * Global method to use as a callback function while executing 'EXPLAIN QUERY
+ * PLAN' and collect the detail column of each step
+ * @param[in] pData string to append the plan details to
+ * @param[in] nArgc number of columns of the plan row
+ * @param[in] pchArgv column values of the plan row
+ * @param[in] pchColNames column name
+ * @return 0 always
+ */
+static int callback_query_plan(void *pData, int nArgc,
+                               char **pchArgv, char** pchColNames)
+{
+    // detail is the last column of every version of the plan output
+    if ((nArgc > 0) && pchArgv[nArgc - 1])
+    {
+        std::string *pstrPlan = (std::string*)pData;
+        if (!pstrPlan->empty())
+        {
+            pstrPlan->append("\n");
+        }
+        pstrPlan->append(pchArgv[nArgc - 1]);
+    }
+    return 0;
+}
+
+/**
+ * Global method registered as sql function while upgrading to version 19, to
+ * convert a base64 encrypted event payload into binary event format; values
+ * which are not base64 text are returned unchanged
+ * @param[in] pContext sql function context
+ * @param[in] nArgc number of arguments, always 1
+ * @param[in] ppArgv arguments, the event payload
+ * @return void
+ */
+static void sql_event_text_to_binary(sqlite3_context *pContext, int nArgc,
+                                     sqlite3_value **ppArgv)
+{
+    if (SQLITE_TEXT == sqlite3_value_type(ppArgv[0]))
+    {
+        std::string strText((const char*)sqlite3_value_text(ppArgv[0]),
+                            sqlite3_value_bytes(ppArgv[0]));
+        std::string strBinary =
+                            CIgniteDataSecurity::EventTextToBinary(strText);
+        if (!strBinary.empty())
+        {
+            sqlite3_result_blob(pContext, strBinary.data(), strBinary.size(),
+                                SQLITE_TRANSIENT);
+            return;
+        }
+    }
+    sqlite3_result_value(pContext, ppArgv[0]);
+}
+
 /**
  * Global method to get the column names of the given table name
  * @param[in] strTable table name
@@ -369,19 +588,87 @@ void check_column_aliases(std::vector<std::string> &rvecColumns)
         }
     }
 }
+
+/**
+ * Global method to generate select statement based on given query
+ * @param[in] pstQuery Sql query
+ * @return select statement
+ */
+std::string generate_select_statement(const SqlQuery *pstQuery)
+{
+    const std::string strSeparator = ", ";
+    std::string strColumns;
+    if (pstQuery->vecProjection.empty())
+    {
+        strColumns = "*";
+    }
+    else
+    {
+        strColumns.clear();
+        for (int i = 0; i < pstQuery->vecProjection.size(); i++)
+        {
+            strColumns.append(pstQuery->vecProjection[i]);
+            strColumns.append(strSeparator);
+        }
+        strColumns = strColumns.substr(0, strColumns.length() - 
+                                       strSeparator.length());
+    }
+
+    std::ostringstream statement;
+    statement.clear();
+    statement << "SELECT " << strColumns << " FROM " << pstQuery->strTable;
+    if (!pstQuery->strSelection.empty())
+    {
+        statement << " WHERE " << pstQuery->strSelection;
+    }
+
+    if (!pstQuery->vecOrderBy.empty())
+    {
+        std::string strOrderBy;
+        strOrderBy.clear();
+        for (int i = 0; i < pstQuery->vecOrderBy.size(); i++)
+        {
+            strOrderBy.append(pstQuery->vecOrderBy[i]);
+            strOrderBy.append(strSeparator);
+        }
+        strOrderBy = strOrderBy.substr(0, strOrderBy.length() - 
+                                                         strSeparator.length());
+
+        statement << " ORDER BY " << strOrderBy;
+    }
+
+    if (pstQuery->nLimit > 0)
+    {
+        statement << " LIMIT " << pstQuery->nLimit;
+    }
+
+    statement << ";";
+    return statement.str();
+}
 }
 
 //! Constant key for 'table' string
 const std::string TABLE = "table";
 
-CDatabase::CDatabase() : m_pUploadMode(CUploadMode::GetInstance())
+CDatabase::CDatabase() : m_pCheckpointer(NULL),
+                          m_pUploadMode(CUploadMode::GetInstance())
 {
     CIgniteConfig *pConfig = CIgniteConfig::GetInstance();
     m_strDBPath = pConfig->GetString("DAM.Database.dbStore");
+    m_bWalMode = pConfig->GetBool(KEY_WAL_MODE, false);
+    m_strSynchronous = pConfig->GetString(KEY_SYNCHRONOUS);
+    m_bIncrementalVacuum = pConfig->GetBool(KEY_INCREMENTAL_VACUUM, false);
+    m_unVacuumPagesPerStep = pConfig->GetInt(KEY_VACUUM_PAGES_PER_STEP,
+                                             DEF_VACUUM_PAGES_PER_STEP);
 
     Open();
 }
 
+CDatabase::~CDatabase()
+{
+    StopCheckpointer();
+}
+
 CDatabase* CDatabase::GetInstance()
 {
     static CDatabase sSelf;
@@ -424,62 +711,154 @@ CCursor* CDatabase::Query(const std::string strTable,
     }
 }
 
-long CDatabase::Insert(const std::string strTable, CContentValues *pData)
+CStreamCursor* CDatabase::QueryStream(const std::string strTable,
+                          const std::vector<std::string> &rvecProjection,
+                          const std::string &rstrSelection,
+                          const std::vector<std::string> &rvecOrderBy,
+                          const int nLimit)
 {
-    long long llId = -1;
+    if (m_bCloseRequested)
+    {
+        HCPLOG_C << "Wait";
+        /*
+         * If database connection and file deletion is in progress
+         * then all other db queries must be stopped
+         */
+        m_WaitFlag.ConditionWait(m_WaitMutex);
+    }
+    ic_utils::CScopeLock sLock(m_QueryLock);
 
-    std::string strColumns, strValues;
-    const std::string strSeparator = ", ";
+    SqlQuery stQuery;
+    stQuery.strTable = strTable;
+    stQuery.vecProjection = rvecProjection.empty() ? get_column_names(strTable):
+                                                                 rvecProjection;
+    stQuery.strSelection = rstrSelection;
+    stQuery.vecOrderBy = rvecOrderBy;
+    stQuery.nLimit = nLimit;
 
-    std::vector<std::string> vecColNames = pData->GetKeys();
-    for (int i = 0; i < vecColNames.size(); i++)
+    try
     {
-        strColumns.append(vecColNames[i]);
-        strColumns.append(strSeparator);
-        strValues.append("'");
-        strValues.append(pData->GetAsString(vecColNames[i]));
-        strValues.append("'");
-        strValues.append(strSeparator);
+        return new CStreamCursor(m_pSQLiteDB, &stQuery);
     }
-    strColumns = strColumns.substr(0, strColumns.length() - 
-                                                         strSeparator.length());
-    strValues = strValues.substr(0, strValues.length() - strSeparator.length());
+    catch (CSqlException ex)
+    {
+        HCPLOG_E << ex.ErrorMessage();
+        return NULL;
+    }
+}
 
-    std::ostringstream statement;
-    statement << "INSERT INTO " << strTable << " (" 
-              << strColumns << ") VALUES (" << strValues << ");";
+std::string CDatabase::GetQueryPlan(const std::string strTable,
+                          const std::vector<std::string> &rvecProjection,
+                          const std::string &rstrSelection,
+                          const std::vector<std::string> &rvecOrderBy,
+                          const int nLimit)
+{
+    SqlQuery stQuery;
+    stQuery.strTable = strTable;
+    stQuery.vecProjection = rvecProjection;
+    stQuery.strSelection = rstrSelection;
+    stQuery.vecOrderBy = rvecOrderBy;
+    stQuery.nLimit = nLimit;
 
-    HCPLOG_I << statement.str();
+    std::string strPlan;
+    std::string strSql = "EXPLAIN QUERY PLAN " +
+                         generate_select_statement(&stQuery);
+    if (SQLITE_OK != SqliteExec(strSql, callback_query_plan, (void*)&strPlan))
+    {
+        HCPLOG_E << "Unable to get the query plan";
+        strPlan.clear();
+    }
+    return strPlan;
+}
 
-    std::string strSql = statement.str();
-    bool bSuccess = (SQLITE_OK == SqliteExec(strSql, NULL, 0));
+long CDatabase::Insert(const std::string strTable, CContentValues *pData)
+{
+    long long llId = -1;
+
+    std::vector<std::string> vecColNames = pData->GetKeys();
+    std::string strSql = generate_insert_statement(strTable, vecColNames);
+
+    HCPLOG_T << strSql;
+
+    bool bSuccess = (SQLITE_OK == ExecuteStatement(strSql, *pData, vecColNames,
+                                                   &llId));
 
     HCPLOG_T <<"result : " << bSuccess;
 
     if (bSuccess)
     {
-        llId = sqlite3_last_insert_rowid(m_pSQLiteDB);
         HCPLOG_T <<"id : " << llId;
     }
+    else
+    {
+        llId = -1;
+    }
 
     return llId;
 }
 
+int CDatabase::BulkInsert(const std::string strTable,
+                          std::vector<CContentValues> &rvecData)
+{
+    int nInserted = 0;
+    std::vector<std::string> vecColNames;
+    std::string strSql;
+    for (size_t i = 0; i < rvecData.size(); i++)
+    {
+        std::vector<std::string> vecRowColNames = rvecData[i].GetKeys();
+        if (vecRowColNames != vecColNames)
+        {
+            vecColNames.swap(vecRowColNames);
+            strSql = generate_insert_statement(strTable, vecColNames);
+        }
+
+        if (SQLITE_OK == ExecuteStatement(strSql, rvecData[i], vecColNames))
+        {
+            nInserted++;
+        }
+    }
+
+    HCPLOG_T << "inserted " << nInserted << "/" << rvecData.size()
+             << " rows into " << strTable;
+    return nInserted;
+}
+
 bool CDatabase::Update(const std::string strTable, CContentValues *pData, 
                        const std::string &rstrSelection)
+{
+    /* literal values make each selection a different statement, caching them
+     * would only evict the statements which are reused
+     */
+    return ExecuteUpdate(strTable, pData, rstrSelection, NULL,
+                         rstrSelection.empty());
+}
+
+bool CDatabase::Update(const std::string strTable, CContentValues *pData,
+                       const std::string &rstrSelection,
+                       const std::vector<std::string> &rvecSelectionArgs)
+{
+    return ExecuteUpdate(strTable, pData, rstrSelection, &rvecSelectionArgs,
+                         true);
+}
+
+bool CDatabase::ExecuteUpdate(const std::string &strTable,
+                              CContentValues *pData,
+                              const std::string &rstrSelection,
+                              const std::vector<std::string> *pvecSelectionArgs,
+                              const bool bCache)
 {
     std::string strValues;
     const std::string strSeparator = ", ";
     std::vector<std::string> vecColNames = pData->GetKeys();
     for (int i = 0; i < vecColNames.size(); i++)
     {
+        if (i > 0)
+        {
+            strValues.append(strSeparator);
+        }
         strValues.append(vecColNames[i]);
-        strValues.append(" = '");
-        strValues.append(pData->GetAsString(vecColNames[i]));
-        strValues.append("'");
-        strValues.append(strSeparator);
+        strValues.append(" = ?");
     }
-    strValues = strValues.substr(0, strValues.length() - strSeparator.length());
 
     std::ostringstream statement;
     statement << "UPDATE " << strTable << " SET " << strValues;
@@ -491,7 +870,9 @@ bool CDatabase::Update(const std::string strTable, CContentValues *pData,
 
     std::string strSql = statement.str();
     HCPLOG_T << strSql;
-    bool bSuccess = (SQLITE_OK == SqliteExec(strSql, NULL, 0));
+    bool bSuccess = (SQLITE_OK == ExecuteStatement(strSql, *pData,
+                                                   vecColNames, NULL,
+                                                   pvecSelectionArgs, bCache));
 
     return bSuccess;
 }
@@ -513,6 +894,54 @@ bool CDatabase::Remove(const std::string strTable,
     return bSuccess;
 }
 
+bool CDatabase::BindIdSet(const std::vector<long long> &rvecIds)
+{
+    std::string strCreate = CREATE_ID_SET;
+    if (SQLITE_OK != SqliteExec(strCreate, NULL, 0))
+    {
+        return false;
+    }
+
+    CContentValues data;
+    std::vector<std::string> vecColNames;
+    bool bSuccess = (SQLITE_OK == ExecuteStatement(CLEAR_ID_SET, data,
+                                                   vecColNames));
+
+    vecColNames.push_back(COL_ID_SET);
+    for (size_t i = 0; bSuccess && (i < rvecIds.size()); i++)
+    {
+        data.Put(COL_ID_SET, rvecIds[i]);
+        bSuccess = (SQLITE_OK == ExecuteStatement(INSERT_ID_SET, data,
+                                                  vecColNames));
+    }
+    return bSuccess;
+}
+
+bool CDatabase::RemoveByIdSet(const std::string strTable,
+                              const std::string &rstrColumn,
+                              const std::string &rstrSelection)
+{
+    std::ostringstream statement;
+    statement << "DELETE FROM " << strTable << " WHERE "
+              << get_id_set_selection(rstrColumn, rstrSelection) << ";";
+
+    // the statement text does not depend on the IDs, keep it prepared
+    CContentValues data;
+    std::vector<std::string> vecColNames;
+    return (SQLITE_OK == ExecuteStatement(statement.str(), data, vecColNames));
+}
+
+bool CDatabase::UpdateByIdSet(const std::string strTable,
+                              CContentValues *pData,
+                              const std::string &rstrColumn,
+                              const std::string &rstrSelection)
+{
+    // the statement text does not depend on the IDs, keep it prepared
+    return ExecuteUpdate(strTable, pData,
+                         get_id_set_selection(rstrColumn, rstrSelection),
+                         NULL, true);
+}
+
 int CDatabase::Open()
 {
     bool bExists = ic_utils::CIgniteFileUtils::Exists(m_strDBPath);
@@ -565,12 +994,132 @@ int CDatabase::Open()
     SetTempDirPragma();
 #endif
 
+    ConfigureAutoVacuum();
+    ConfigureJournalMode();
+
     m_bCloseRequested = false;
     m_WaitFlag.ConditionBroadcast();
 
     return nSqlRes;
 }
 
+void CDatabase::ConfigureAutoVacuum()
+{
+    HCPLOG_METHOD() << "incrementalVacuum=" << m_bIncrementalVacuum;
+
+    std::string strAutoVacuum;
+    std::string strSql = "PRAGMA auto_vacuum;";
+    SqliteExec(strSql, callback_dbcheck, (void*)&strAutoVacuum);
+
+    bool bIncremental = (AUTO_VACUUM_INCREMENTAL == atoi(strAutoVacuum.c_str()));
+    if (bIncremental == m_bIncrementalVacuum)
+    {
+        return;
+    }
+
+    /*
+     * auto_vacuum of a database having tables only changes on a full vacuum,
+     * which is run once here; the mode is persisted in the file afterwards
+     */
+    HCPLOG_C << "Migrating auto_vacuum from " << strAutoVacuum;
+    strSql = m_bIncrementalVacuum ? "PRAGMA auto_vacuum=INCREMENTAL;" :
+                                    "PRAGMA auto_vacuum=NONE;";
+    SqliteExec(strSql, NULL, 0);
+
+    strSql = "vacuum;";
+    g_TransactionMutex.Lock();
+    if (SQLITE_OK != SqliteExec(strSql, NULL, 0))
+    {
+        HCPLOG_E << "auto_vacuum migration failed";
+    }
+    g_TransactionMutex.Unlock();
+}
+
+void CDatabase::ConfigureJournalMode()
+{
+    HCPLOG_METHOD() << "walMode=" << m_bWalMode
+                    << "; synchronous=" << m_strSynchronous;
+
+    std::string strJournalMode;
+    std::string strSql = m_bWalMode ? "PRAGMA journal_mode=WAL;" :
+                                      "PRAGMA journal_mode;";
+    SqliteExec(strSql, callback_dbcheck, (void*)&strJournalMode);
+
+    if (!m_bWalMode && ("wal" == strJournalMode))
+    {
+        // WAL mode is persistent, revert the one enabled by an earlier run
+        strSql = "PRAGMA journal_mode=DELETE;";
+        SqliteExec(strSql, callback_dbcheck, (void*)&strJournalMode);
+    }
+    HCPLOG_I << "journal_mode=" << strJournalMode;
+
+    if (!m_strSynchronous.empty())
+    {
+        std::string strLevel(m_strSynchronous);
+        std::transform(strLevel.begin(), strLevel.end(), strLevel.begin(),
+                       (int(*)(int))std::toupper);
+        const char **ppchEnd = SYNCHRONOUS_LEVELS +
+                     sizeof(SYNCHRONOUS_LEVELS) / sizeof(SYNCHRONOUS_LEVELS[0]);
+        if (std::find(SYNCHRONOUS_LEVELS, ppchEnd, strLevel) != ppchEnd)
+        {
+            // synchronous is a per-connection setting, applied on every open
+            strSql = "PRAGMA synchronous=" + strLevel + ";";
+            SqliteExec(strSql, NULL, 0);
+        }
+        else
+        {
+            HCPLOG_E << "Unsupported synchronous level:" << m_strSynchronous;
+        }
+    }
+
+    if (!m_bWalMode || ("wal" != strJournalMode))
+    {
+        return;
+    }
+
+    if (!m_pCheckpointer)
+    {
+        CIgniteConfig *pConfig = CIgniteConfig::GetInstance();
+        unsigned int unIdleMs = pConfig->GetInt(KEY_WAL_CHECKPOINT_IDLE_MS,
+                                                DEF_WAL_CHECKPOINT_IDLE_MS);
+        unsigned long long ullTruncateBytes = 1024ULL *
+               pConfig->GetInt(KEY_WAL_TRUNCATE_SIZE_KB, DEF_WAL_TRUNCATE_SIZE_KB);
+        m_pCheckpointer = new CDbCheckpointer(unIdleMs, ullTruncateBytes);
+        m_pCheckpointer->Start();
+    }
+
+    /*
+     * Registering the hook replaces sqlite's automatic checkpoint on commit,
+     * which is kept if the checkpoint connection cannot be opened
+     */
+    if (m_pCheckpointer->OpenConnection(m_strDBPath))
+    {
+        g_SqlMutex.Lock();
+        sqlite3_wal_hook(m_pSQLiteDB, wal_commit_hook, m_pCheckpointer);
+        g_SqlMutex.Unlock();
+    }
+}
+
+void CDatabase::StopCheckpointer()
+{
+    if (!m_pCheckpointer)
+    {
+        return;
+    }
+
+    // the wal hook must not reach the checkpointer once it is released
+    if (m_pSQLiteDB)
+    {
+        g_SqlMutex.Lock();
+        sqlite3_wal_hook(m_pSQLiteDB, NULL, NULL);
+        g_SqlMutex.Unlock();
+    }
+
+    // stops and joins the thread, then closes the checkpoint connection
+    delete m_pCheckpointer;
+    m_pCheckpointer = NULL;
+}
+
 void CDatabase::SetTempDirPragma()
 {
     HCPLOG_METHOD();
@@ -724,7 +1273,22 @@ bool CDatabase::Recover()
     if (!bRet)
     {
         HCPLOG_E << "Database recovery failed deleting the entire DB!!";
-        sqlite3_close(m_pSQLiteDB);
+        StopCheckpointer();
+
+        // Cached statements keep the connection busy, they go first
+        g_SqlMutex.Lock();
+        FinalizeStatements();
+        g_SqlMutex.Unlock();
+        int nRc = sqlite3_close(m_pSQLiteDB);
+        if (SQLITE_OK != nRc)
+        {
+            /*
+             * A cursor still holds a statement, let sqlite release the
+             * connection once that statement is finalized
+             */
+            HCPLOG_E << "DB close error:" << nRc;
+            sqlite3_close_v2(m_pSQLiteDB);
+        }
         m_pSQLiteDB = NULL;
         Backup();
         Open();
@@ -748,6 +1312,14 @@ int CDatabase::Remove()
     {
         nRc = ic_utils::CIgniteFileUtils::Remove(m_strDBPath + "-journal");
     }
+    if (ic_utils::CIgniteFileUtils::Exists(m_strDBPath + "-wal"))
+    {
+        nRc = ic_utils::CIgniteFileUtils::Remove(m_strDBPath + "-wal");
+    }
+    if (ic_utils::CIgniteFileUtils::Exists(m_strDBPath + "-shm"))
+    {
+        nRc = ic_utils::CIgniteFileUtils::Remove(m_strDBPath + "-shm");
+    }
     return nRc;
 }
 
@@ -759,6 +1331,12 @@ int CDatabase::CloseConnection()
 
     if (m_pSQLiteDB!=NULL) 
     {
+        // The checkpoint connection must go first to let close fold the log
+        StopCheckpointer();
+
+        g_SqlMutex.Lock();
+        FinalizeStatements();
+        g_SqlMutex.Unlock();
         nRc = sqlite3_close(m_pSQLiteDB);
         m_pSQLiteDB = NULL;
     }
@@ -782,6 +1360,8 @@ int CDatabase::ResetDatabase()
         nRc = Open();
     }
 
+    // Encryption seed is gone along with the database
+    CIgniteDataSecurity::InvalidateEventKey();
     return nRc;
 }
 
@@ -801,6 +1381,12 @@ int CDatabase::RemoveDatabase()
 bool CDatabase::VacuumDb()
 {
     HCPLOG_METHOD();
+    if (m_bIncrementalVacuum && (AUTO_VACUUM_INCREMENTAL == GetAutoVacuum()))
+    {
+        // Remaining free pages are reclaimed during idle periods
+        return (ReclaimFreePages() >= 0);
+    }
+
     g_TransactionMutex.Lock();
 
     std::string vacuum = "vacuum;";
@@ -811,6 +1397,53 @@ bool CDatabase::VacuumDb()
     return result;
 }
 
+int CDatabase::ReclaimFreePages(unsigned int unMaxPages)
+{
+    if (!m_bIncrementalVacuum)
+    {
+        return 0;
+    }
+
+    int nFreePages = GetPragmaValue("freelist_count");
+    if (nFreePages <= 0)
+    {
+        return nFreePages;
+    }
+
+    if (0 == unMaxPages)
+    {
+        unMaxPages = m_unVacuumPagesPerStep;
+    }
+
+    HCPLOG_METHOD() << "freePages=" << nFreePages << "; maxPages=" << unMaxPages;
+    g_TransactionMutex.Lock();
+
+    std::string strSql = "PRAGMA incremental_vacuum(" +
+                 ic_utils::CIgniteStringUtils::NumberToString(unMaxPages) + ");";
+    int nRc = ExecuteCommand(strSql);
+
+    g_TransactionMutex.Unlock();
+
+    return (SQLITE_OK == nRc) ? GetPragmaValue("freelist_count") : -1;
+}
+
+int CDatabase::GetAutoVacuum()
+{
+    return GetPragmaValue("auto_vacuum");
+}
+
+int CDatabase::GetPragmaValue(const std::string &rstrPragma)
+{
+    std::string strValue;
+    std::string strSql = "PRAGMA " + rstrPragma + ";";
+    if (SQLITE_OK != SqliteExec(strSql, callback_dbcheck, (void*)&strValue))
+    {
+        HCPLOG_E << "Unable to read pragma " << rstrPragma;
+        return -1;
+    }
+    return atoi(strValue.c_str());
+}
+
 int CDatabase::ExecuteCommand(std::string &rstrCmd)
 {
     if (m_bCloseRequested)
@@ -823,52 +1456,173 @@ int CDatabase::ExecuteCommand(std::string &rstrCmd)
         m_WaitFlag.ConditionWait(m_WaitMutex);
     }
 
-    return SqliteExec(rstrCmd, NULL, 0);
+    return SqliteExec(rstrCmd, NULL, 0);
+}
+
+int CDatabase::SqliteExec(std::string &rstrSql, 
+                          int(*callback)(void*, int, char**, char**), 
+                          void *pData)
+{
+    HCPLOG_METHOD() << rstrSql;
+    int nRc = SQLITE_ERROR;
+    char *pchZErrMsg = 0;
+    try
+    {
+        g_SqlMutex.Lock();
+        nRc = sqlite3_exec(m_pSQLiteDB, rstrSql.c_str(), 
+                                                  callback, pData, &pchZErrMsg);
+        g_SqlMutex.Unlock();
+        if ( nRc != SQLITE_OK )
+        {
+            throw CSqlException(nRc, pchZErrMsg);
+        }
+        if (pchZErrMsg)
+        {
+            sqlite3_free(pchZErrMsg);
+        }
+    }
+    catch (CSqlException& e)
+    {
+        HandleSqlException(e);
+        
+        if (pchZErrMsg)
+        {
+            sqlite3_free(pchZErrMsg);
+        }
+    }
+
+    return nRc;
+}
+
+void CDatabase::HandleSqlException(CSqlException &rEx)
+{
+    HCPLOG_EXCEPTION(rEx.ErrorMessage());
+    if (rEx.ErrorCode() == SQLITE_CANTOPEN || rEx.ErrorCode() == SQLITE_CORRUPT)
+    {
+        HCPLOG_F << "Database Corrupted !!";
+        Remove();
+        exit(EXIT_FAILURE);
+    } 
+    else
+    {
+        CheckAndCreateTable(rEx.ErrorMessage());
+    }
+}
+
+int CDatabase::ExecuteStatement(const std::string &rstrSql,
+                                CContentValues &rData,
+                                const std::vector<std::string> &rvecColumns,
+                                long long *pllRowId,
+                                const std::vector<std::string> *pvecArgs,
+                                const bool bCache)
+{
+    HCPLOG_METHOD() << rstrSql;
+    sqlite3_stmt *pStmt = NULL;
+    std::string strErrMsg;
+
+    g_SqlMutex.Lock();
+    int nRc = SQLITE_OK;
+    if (bCache)
+    {
+        nRc = GetStatement(rstrSql, &pStmt);
+    }
+    else
+    {
+        nRc = sqlite3_prepare_v2(m_pSQLiteDB, rstrSql.c_str(), -1, &pStmt,
+                                 NULL);
+    }
+    if (SQLITE_OK == nRc)
+    {
+        nRc = bind_values(pStmt, rData, rvecColumns);
+    }
+    for (size_t i = 0; (NULL != pvecArgs) && (i < pvecArgs->size()) &&
+                       (SQLITE_OK == nRc); i++)
+    {
+        // selection arguments follow the column values
+        const std::string &rstrArg = (*pvecArgs)[i];
+        nRc = sqlite3_bind_text(pStmt, rvecColumns.size() + i + 1,
+                                rstrArg.c_str(), rstrArg.size(),
+                                SQLITE_TRANSIENT);
+    }
+    if (SQLITE_OK == nRc)
+    {
+        nRc = sqlite3_step(pStmt);
+        if (SQLITE_DONE == nRc || SQLITE_ROW == nRc)
+        {
+            nRc = SQLITE_OK;
+        }
+    }
+
+    if (SQLITE_OK != nRc)
+    {
+        strErrMsg = sqlite3_errmsg(m_pSQLiteDB);
+    }
+    else if (NULL != pllRowId)
+    {
+        *pllRowId = sqlite3_last_insert_rowid(m_pSQLiteDB);
+    }
+
+    if (NULL != pStmt && bCache)
+    {
+        // keep the statement ready for the next execution
+        sqlite3_reset(pStmt);
+        sqlite3_clear_bindings(pStmt);
+    }
+    else if (NULL != pStmt)
+    {
+        sqlite3_finalize(pStmt);
+    }
+    g_SqlMutex.Unlock();
+
+    if (SQLITE_OK != nRc)
+    {
+        CSqlException ex(nRc, strErrMsg.c_str());
+        HandleSqlException(ex);
+    }
+    return nRc;
 }
 
-int CDatabase::SqliteExec(std::string &rstrSql, 
-                          int(*callback)(void*, int, char**, char**), 
-                          void *pData)
+int CDatabase::GetStatement(const std::string &rstrSql, sqlite3_stmt **ppStmt)
 {
-    HCPLOG_METHOD() << rstrSql;
-    int nRc = SQLITE_ERROR;
-    char *pchZErrMsg = 0;
-    try
+    std::map<std::string, StatementList::iterator>::iterator iter =
+                                                 m_mapStatements.find(rstrSql);
+    if (iter != m_mapStatements.end())
     {
-        g_SqlMutex.Lock();
-        nRc = sqlite3_exec(m_pSQLiteDB, rstrSql.c_str(), 
-                                                  callback, pData, &pchZErrMsg);
-        g_SqlMutex.Unlock();
-        if ( nRc != SQLITE_OK )
-        {
-            throw CSqlException(nRc, pchZErrMsg);
-        }
-        if (pchZErrMsg)
-        {
-            sqlite3_free(pchZErrMsg);
-        }
+        // move the statement to the front as most recently used
+        m_listStatements.splice(m_listStatements.begin(), m_listStatements,
+                                iter->second);
+        *ppStmt = iter->second->second;
+        return SQLITE_OK;
     }
-    catch (CSqlException& e)
+
+    int nRc = sqlite3_prepare_v2(m_pSQLiteDB, rstrSql.c_str(), -1, ppStmt, NULL);
+    if (SQLITE_OK != nRc)
     {
-        HCPLOG_EXCEPTION(e.ErrorMessage());
-        if (e.ErrorCode() == SQLITE_CANTOPEN || e.ErrorCode() == SQLITE_CORRUPT)
-        {
-            HCPLOG_F << "Database Corrupted !!";
-            Remove();
-            exit(EXIT_FAILURE);
-        } 
-        else
-        {
-            CheckAndCreateTable(e.ErrorMessage());
-        }
-        
-        if (pchZErrMsg)
-        {
-            sqlite3_free(pchZErrMsg);
-        }
+        *ppStmt = NULL;
+        return nRc;
     }
 
-    return nRc;
+    m_listStatements.push_front(std::make_pair(rstrSql, *ppStmt));
+    m_mapStatements[rstrSql] = m_listStatements.begin();
+
+    if (m_listStatements.size() > MAX_CACHED_STATEMENTS)
+    {
+        sqlite3_finalize(m_listStatements.back().second);
+        m_mapStatements.erase(m_listStatements.back().first);
+        m_listStatements.pop_back();
+    }
+    return SQLITE_OK;
+}
+
+void CDatabase::FinalizeStatements()
+{
+    for (StatementList::iterator iter = m_listStatements.begin();
+         iter != m_listStatements.end(); ++iter)
+    {
+        sqlite3_finalize(iter->second);
+    }
+    m_listStatements.clear();
+    m_mapStatements.clear();
 }
 
 int CDatabase::GetVersion()
@@ -908,15 +1662,54 @@ bool CDatabase::CreateEventStoreTable()
             CDataBaseConst::COL_SIZE + " INTEGER DEFAULT 0, " +
             CDataBaseConst::COL_HAS_ATTACH + " INTEGER DEFAULT 0, " +
             CDataBaseConst::COL_PRIORITY + " INTEGER DEFAULT 3, " +
-            CDataBaseConst::COL_EVENTS + " TEXT NOT NULL, " +
+            CDataBaseConst::COL_EVENTS + " BLOB NOT NULL, " +
             CDataBaseConst::COL_APPID + " TEXT DEFAULT '', " +
             CDataBaseConst::COL_TOPIC + " TEXT DEFAULT NULL, " +
             CDataBaseConst::COL_MID  + " INTEGER DEFAULT 0, " +
             CDataBaseConst::COL_STREAM_SUPPORT + "  TINYINT DEFAULT 0, " +
             CDataBaseConst::COL_BATCH_SUPPORT + " TINYINT DEFAULT 0, " +
-            CDataBaseConst::COL_GRANULARITY + " TINYINT DEFAULT 0);";
+            CDataBaseConst::COL_GRANULARITY + " TINYINT DEFAULT 0, " +
+            CDataBaseConst::COL_CHECKSUM + " INTEGER DEFAULT NULL);";
 
-    return (SQLITE_OK == SqliteExec(strQuery, NULL, 0));
+    return (SQLITE_OK == SqliteExec(strQuery, NULL, 0)) &&
+           CreateEventStoreIndexes();
+}
+
+bool CDatabase::CreateEventStoreIndexes()
+{
+    /*
+     * Uploader scans filter on MID == 0 (plus TOPIC/STREAM/BATCH) in TIMESTAMP
+     * order, and acknowledgements look rows up by MID
+     */
+    std::string strQuery = "CREATE INDEX IF NOT EXISTS " +
+            IDX_EVENT_STORE_MID_TIMESTAMP + " ON " +
+            CDataBaseConst::TABLE_EVENT_STORE + " (" +
+            CDataBaseConst::COL_MID + ", " +
+            CDataBaseConst::COL_TIMESTAMP + ", " +
+            CDataBaseConst::COL_TOPIC + ", " +
+            CDataBaseConst::COL_STREAM_SUPPORT + ", " +
+            CDataBaseConst::COL_BATCH_SUPPORT + ");";
+    bool bCreated = (SQLITE_OK == SqliteExec(strQuery, NULL, 0));
+
+    // Covers the time range existence and max granularity checks entirely
+    strQuery = "CREATE INDEX IF NOT EXISTS " +
+            IDX_EVENT_STORE_TIMESTAMP + " ON " +
+            CDataBaseConst::TABLE_EVENT_STORE + " (" +
+            CDataBaseConst::COL_TIMESTAMP + ", " +
+            CDataBaseConst::COL_STREAM_SUPPORT + ", " +
+            CDataBaseConst::COL_BATCH_SUPPORT + ", " +
+            CDataBaseConst::COL_GRANULARITY + ");";
+    bCreated = bCreated && (SQLITE_OK == SqliteExec(strQuery, NULL, 0));
+
+    // Granularity reduction scans one EVENTID over a time range
+    strQuery = "CREATE INDEX IF NOT EXISTS " +
+            IDX_EVENT_STORE_EVENTID_TIMESTAMP + " ON " +
+            CDataBaseConst::TABLE_EVENT_STORE + " (" +
+            CDataBaseConst::COL_EVENT_ID + ", " +
+            CDataBaseConst::COL_TIMESTAMP + ");";
+    bCreated = bCreated && (SQLITE_OK == SqliteExec(strQuery, NULL, 0));
+
+    return bCreated;
 }
 
 bool CDatabase::CreateInvalidEventStoreTable()
@@ -925,7 +1718,7 @@ bool CDatabase::CreateInvalidEventStoreTable()
             CDataBaseConst::TABLE_INVALID_EVENT_STORE + " (" +
             CDataBaseConst::COL_ID + " INTEGER PRIMARY KEY AUTOINCREMENT, " +
             CDataBaseConst::COL_TIMESTAMP + " INTEGER, " +
-            CDataBaseConst::COL_EVENTS + " TEXT NOT NULL);";
+            CDataBaseConst::COL_EVENTS + " BLOB NOT NULL);";
 
     return (SQLITE_OK == SqliteExec(strQuery, NULL, 0));
 }
@@ -954,10 +1747,11 @@ bool CDatabase::CreateAlertStoreTable()
             CDataBaseConst::COL_SIZE + " INTEGER DEFAULT 0, " +
             CDataBaseConst::COL_HAS_ATTACH + " INTEGER DEFAULT 0, " +
             CDataBaseConst::COL_PRIORITY + " INTEGER DEFAULT 3, " +
-            CDataBaseConst::COL_EVENTS + " TEXT NOT NULL, " +
+            CDataBaseConst::COL_EVENTS + " BLOB NOT NULL, " +
             CDataBaseConst::COL_APPID + " TEXT DEFAULT '', " +
             CDataBaseConst::COL_TOPIC + " TEXT DEFAULT NULL, " +
-            CDataBaseConst::COL_MID  + " INTEGER DEFAULT 0);";
+            CDataBaseConst::COL_MID  + " INTEGER DEFAULT 0, " +
+            CDataBaseConst::COL_CHECKSUM + " INTEGER DEFAULT NULL);";
 
     return (SQLITE_OK == SqliteExec(strQuery, NULL, 0));
 }
@@ -1089,6 +1883,18 @@ bool CDatabase::OnUpgrade(int nOldVer, int nNewVer)
     {
         UpgradeVersionFrom16To17();
     }
+    case 17:
+    {
+        UpgradeVersionFrom17To18();
+    }
+    case 18:
+    {
+        UpgradeVersionFrom18To19();
+    }
+    case 19:
+    {
+        UpgradeVersionFrom19To20();
+    }
     }
     return true;
 }
@@ -1526,6 +2332,83 @@ void CDatabase::UpgradeVersionFrom16To17()
     delete pCursor;
 }
 
+void CDatabase::UpgradeVersionFrom17To18()
+{
+    // Secondary indexes for the upload and granularity reduction queries
+    bool bResult = CreateEventStoreIndexes();
+    HCPLOG_C << " Upgrade (17->18) result : " << bResult;
+}
+
+void CDatabase::UpgradeVersionFrom18To19()
+{
+    const std::string strFunction = "event_text_to_binary";
+    g_SqlMutex.Lock();
+    int nRc = sqlite3_create_function(m_pSQLiteDB, strFunction.c_str(), 1,
+                                      SQLITE_UTF8, NULL,
+                                      sql_event_text_to_binary, NULL, NULL);
+    g_SqlMutex.Unlock();
+    if (SQLITE_OK != nRc)
+    {
+        HCPLOG_E << "Unable to register " << strFunction << ":" << nRc;
+        return;
+    }
+
+    // Only existing tables are converted, missing ones are created as BLOB
+    std::vector<std::string> vecProjection;
+    vecProjection.push_back(CDataBaseConst::COL_NAME_ID);
+    std::string strSelection = CDataBaseConst::COL_TYPE_ID + " = '" + TABLE +
+               "' AND " + CDataBaseConst::COL_NAME_ID + " IN ('" +
+               CDataBaseConst::TABLE_EVENT_STORE + "', '" +
+               CDataBaseConst::TABLE_ALERT_STORE + "', '" +
+               CDataBaseConst::TABLE_INVALID_EVENT_STORE + "')";
+    CCursor *pCursor = Query(CDataBaseConst::TABLE_SQLITE_MASTER,
+                             vecProjection, strSelection);
+    if (pCursor)
+    {
+        for (bool bHasNext = pCursor->MoveToFirst(); bHasNext;
+             bHasNext = pCursor->MoveToNext())
+        {
+            std::string strTable = pCursor->GetString(pCursor->
+                                   GetColumnIndex(CDataBaseConst::COL_NAME_ID));
+
+            /* Declared column type stays TEXT, which does not convert BLOB
+             * values; rows which are not base64 are left as they are
+             */
+            std::string strSql = "UPDATE " + strTable + " SET " +
+                    CDataBaseConst::COL_EVENTS + " = " + strFunction + "(" +
+                    CDataBaseConst::COL_EVENTS + ") WHERE typeof(" +
+                    CDataBaseConst::COL_EVENTS + ") = 'text';";
+            nRc = SqliteExec(strSql, NULL, 0);
+            HCPLOG_C << " Upgrade (18->19) " << strTable << " result : " << nRc;
+        }
+        delete pCursor;
+    }
+
+    g_SqlMutex.Lock();
+    sqlite3_create_function(m_pSQLiteDB, strFunction.c_str(), 1, SQLITE_UTF8,
+                            NULL, NULL, NULL, NULL);
+    g_SqlMutex.Unlock();
+}
+
+void CDatabase::UpgradeVersionFrom19To20()
+{
+    // Rows stored before have no checksum and are validated by parsing them
+    std::string strSql = "ALTER TABLE " + CDataBaseConst::TABLE_EVENT_STORE +
+            " ADD COLUMN " + CDataBaseConst::COL_CHECKSUM +
+            " INTEGER DEFAULT NULL;";
+    int nResult = SqliteExec(strSql, NULL, 0);
+    HCPLOG_C << " Upgrade (19->20)-stage-1: result : " << nResult;
+
+    if (m_pUploadMode->IsStreamModeSupported())
+    {
+        strSql = "ALTER TABLE " + CDataBaseConst::TABLE_ALERT_STORE +
+                " ADD COLUMN " + CDataBaseConst::COL_CHECKSUM +
+                " INTEGER DEFAULT NULL;";
+        nResult = SqliteExec(strSql, NULL, 0);
+        HCPLOG_C << " Upgrade (19->20)-stage-2: result : " << nResult;
+    }
+}
+
 int CDatabase::ProcessSettingStoreConfigValue(CContentValues &rcontentValues,
                                              ic_utils::Json::Value &rjsonConfigValue)
 {
@@ -1584,7 +2467,31 @@ size_t CDatabase::GetSize()
 {
     struct stat stStat_buf;
     int nRc = stat(m_strDBPath.c_str(), &stStat_buf);
-    return nRc == 0 ? stStat_buf.st_size : -1;
+    if (nRc != 0)
+    {
+        return -1;
+    }
+
+    // Data not yet checkpointed is held in the write-ahead log
+    size_t unSize = stStat_buf.st_size;
+    if (m_bWalMode && (0 == stat((m_strDBPath + "-wal").c_str(), &stStat_buf)))
+    {
+        unSize += stStat_buf.st_size;
+    }
+
+    /*
+     * Free pages are left in the file by incremental vacuum until reclaimed,
+     * yet they are reused by inserts, hence not counted
+     */
+    if (m_bIncrementalVacuum)
+    {
+        int nFreePages = GetPragmaValue("freelist_count");
+        int nPageSize = GetPragmaValue("page_size");
+        size_t unFreeSize = (nFreePages > 0 && nPageSize > 0) ?
+                            (size_t)nFreePages * nPageSize : 0;
+        unSize = (unSize > unFreeSize) ? (unSize - unFreeSize) : 0;
+    }
+    return unSize;
 }
 
 bool CDatabase::ClearTables() 
@@ -1623,6 +2530,13 @@ bool CDatabase::ClearTables()
     {
         bRetVal = EndTransaction(bTransactionStarted);
     }
+
+    /*
+     * Encryption seed is cleared along with LocalConfig. Invalidate only once
+     * the removal is committed, a key derived before then from the old seed
+     * would otherwise be cached under the new generation
+     */
+    CIgniteDataSecurity::InvalidateEventKey();
     
     //vacuum
     try 
@@ -1746,6 +2660,15 @@ bool CCursor::RunQuery(sqlite3 *pDB, SqlQuery *pstQuery)
             row.Clear();
             for (int col = 0; col < m_vecColumns.size(); col++)
             {
+                if (SQLITE_BLOB == sqlite3_column_type(pSelstmt, col))
+                {
+                    const char *pchBlob =
+                               (const char*)sqlite3_column_blob(pSelstmt, col);
+                    int nBytes = sqlite3_column_bytes(pSelstmt, col);
+                    row.PutBlob(m_vecColumns[col], pchBlob ?
+                                std::string(pchBlob, nBytes) : std::string());
+                    continue;
+                }
                 row.Put(m_vecColumns[col], 
                                (const char*)sqlite3_column_text(pSelstmt, col));
             }
@@ -1764,54 +2687,7 @@ bool CCursor::RunQuery(sqlite3 *pDB, SqlQuery *pstQuery)
 
 std::string CCursor::GenerateSqlStatement(SqlQuery *pstQuery)
 {
-    const std::string strSeparator = ", ";
-    std::string strColumns;
-    if (pstQuery->vecProjection.empty())
-    {
-        strColumns = "*";
-    }
-    else
-    {
-        strColumns.clear();
-        for (int i = 0; i < pstQuery->vecProjection.size(); i++)
-        {
-            strColumns.append(pstQuery->vecProjection[i]);
-            strColumns.append(strSeparator);
-        }
-        strColumns = strColumns.substr(0, strColumns.length() - 
-                                       strSeparator.length());
-    }
-
-    std::ostringstream statement;
-    statement.clear();
-    statement << "SELECT " << strColumns << " FROM " << pstQuery->strTable;
-    if (!pstQuery->strSelection.empty())
-    {
-        statement << " WHERE " << pstQuery->strSelection;
-    }
-
-    if (!pstQuery->vecOrderBy.empty())
-    {
-        std::string strOrderBy;
-        strOrderBy.clear();
-        for (int i = 0; i < pstQuery->vecOrderBy.size(); i++)
-        {
-            strOrderBy.append(pstQuery->vecOrderBy[i]);
-            strOrderBy.append(strSeparator);
-        }
-        strOrderBy = strOrderBy.substr(0, strOrderBy.length() - 
-                                                         strSeparator.length());
-
-        statement << " ORDER BY " << strOrderBy;
-    }
-
-    if (pstQuery->nLimit > 0)
-    {
-        statement << " LIMIT " << pstQuery->nLimit;
-    }
-
-    statement << ";";
-    return statement.str();
+    return generate_select_statement(pstQuery);
 }
 
 void CCursor::RemoveRow()
@@ -2014,4 +2890,160 @@ CContentValues CCursor::CList::operator [](int index)
 {
     return *(GetIterator(index));
 }
-} /* namespace ic_core */
\ No newline at end of file
+
+CStreamCursor::CStreamCursor(sqlite3 *pDB, SqlQuery *pstQuery)
+{
+    m_vecColumns = pstQuery->vecProjection;
+    check_column_aliases(m_vecColumns);
+    m_pStmt = NULL;
+    m_bHasRow = false;
+    m_bExhausted = false;
+
+    std::string strSql = generate_select_statement(pstQuery);
+
+    HCPLOG_I << strSql;
+
+    g_SqlMutex.Lock();
+    int nRc = sqlite3_prepare_v2(pDB, strSql.c_str(), -1, &m_pStmt, NULL);
+    g_SqlMutex.Unlock();
+
+    if (SQLITE_OK != nRc)
+    {
+        sqlite3_finalize(m_pStmt);
+
+        // The caller is expected to handle this exception
+        throw CSqlException(nRc, "Failed to prepare SQL statement");
+    }
+}
+
+CStreamCursor::~CStreamCursor()
+{
+    g_SqlMutex.Lock();
+    sqlite3_finalize(m_pStmt);
+    g_SqlMutex.Unlock();
+}
+
+bool CStreamCursor::MoveToNext()
+{
+    /*
+     * sqlite would restart the statement if stepped after completion, which
+     * must not happen for a forward-only cursor
+     */
+    if (!m_pStmt || m_bExhausted)
+    {
+        return false;
+    }
+
+    /*
+     * The lock is held only for the step so that other database users are not
+     * blocked while the caller processes the row
+     */
+    g_SqlMutex.Lock();
+    int nRc = sqlite3_step(m_pStmt);
+    g_SqlMutex.Unlock();
+
+    m_bHasRow = (SQLITE_ROW == nRc);
+    if (!m_bHasRow)
+    {
+        m_bExhausted = true;
+        if (SQLITE_DONE != nRc)
+        {
+            HCPLOG_E << "Failed to step SQL statement, error:" << nRc;
+        }
+    }
+    return m_bHasRow;
+}
+
+std::vector<std::string> CStreamCursor::GetColumnNames()
+{
+    return m_vecColumns;
+}
+
+int CStreamCursor::GetColumnIndex(const std::string &rstrColName)
+{
+    for (int i = 0; i < m_vecColumns.size(); i++)
+    {
+        if (rstrColName == m_vecColumns[i])
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool CStreamCursor::IsReadable(int nColIndex)
+{
+    if (!m_bHasRow)
+    {
+        HCPLOG_E << "Cursor is not positioned on a row";
+        return false;
+    }
+
+    if ((nColIndex < 0) || (nColIndex >= m_vecColumns.size()))
+    {
+        HCPLOG_E << "Invalid column index";
+        return false;
+    }
+    return true;
+}
+
+bool CStreamCursor::IsNull(int nColIndex)
+{
+    if (!IsReadable(nColIndex))
+    {
+        return true;
+    }
+    return (SQLITE_NULL == sqlite3_column_type(m_pStmt, nColIndex));
+}
+
+int CStreamCursor::GetInt(int nColIndex)
+{
+    return IsReadable(nColIndex) ? sqlite3_column_int(m_pStmt, nColIndex) : 0;
+}
+
+long long CStreamCursor::GetLong(int nColIndex)
+{
+    return IsReadable(nColIndex) ? sqlite3_column_int64(m_pStmt, nColIndex) : 0;
+}
+
+double CStreamCursor::GetDouble(int nColIndex)
+{
+    return IsReadable(nColIndex) ? sqlite3_column_double(m_pStmt, nColIndex) :
+                                   0.0;
+}
+
+const char* CStreamCursor::GetText(int nColIndex, size_t &rnLength)
+{
+    rnLength = 0;
+    if (!IsReadable(nColIndex))
+    {
+        return NULL;
+    }
+
+    // sqlite3_column_bytes() must follow the conversion done by column_text()
+    const char *pText = (const char*)sqlite3_column_text(m_pStmt, nColIndex);
+    rnLength = sqlite3_column_bytes(m_pStmt, nColIndex);
+    return pText;
+}
+
+const void* CStreamCursor::GetBlob(int nColIndex, size_t &rnLength)
+{
+    rnLength = 0;
+    if (!IsReadable(nColIndex))
+    {
+        return NULL;
+    }
+
+    const void *pBlob = sqlite3_column_blob(m_pStmt, nColIndex);
+    rnLength = sqlite3_column_bytes(m_pStmt, nColIndex);
+    return pBlob;
+}
+
+std::string CStreamCursor::GetString(int nColIndex)
+{
+    size_t nLength = 0;
+    const char *pText = GetText(nColIndex, nLength);
+    return pText ? std::string(pText, nLength) : "";
+}
+} /* namespace ic_core */
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "db/CDbCheckpointer.h"
+#include "CIgniteDateTime.h"
+#include "CIgniteLog.h"
+
+//! Macro for 'CDbCheckpointer' string
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "CDbCheckpointer"
+
+namespace ic_core
+{
+namespace
+{
+//! Time a truncate checkpoint waits for readers and writers, in milliseconds
+const int CHECKPOINT_BUSY_TIMEOUT_MS = 1000;
+
+//! Page size assumed if it cannot be read from the database
+const int DEFAULT_PAGE_SIZE = 4096;
+}
+
+CDbCheckpointer::CDbCheckpointer(unsigned int unIdleMs,
+                                 unsigned long long ullTruncateBytes) :
+    m_unIdleMs(unIdleMs), m_ullTruncateBytes(ullTruncateBytes),
+    m_nPageSize(DEFAULT_PAGE_SIZE), m_pDB(NULL), m_ullLastCommitMs(0),
+    m_ullCommitCount(0), m_bWalDirty(false), m_bTruncateRequested(false),
+    m_bStop(false), m_ullPassiveCount(0), m_ullTruncateCount(0)
+{
+}
+
+CDbCheckpointer::~CDbCheckpointer()
+{
+    StopCheckpointer();
+    CloseConnection();
+}
+
+bool CDbCheckpointer::OpenConnection(const std::string &rstrDBPath)
+{
+    ic_utils::CScopeLock lock(m_ConnectionMutex);
+    if (m_pDB)
+    {
+        return true;
+    }
+
+    if (SQLITE_OK != sqlite3_open_v2(rstrDBPath.c_str(), &m_pDB,
+                                     SQLITE_OPEN_READWRITE, NULL))
+    {
+        HCPLOG_E << "Unable to open checkpoint connection:"
+                 << sqlite3_errmsg(m_pDB);
+        sqlite3_close(m_pDB);
+        m_pDB = NULL;
+        return false;
+    }
+    sqlite3_busy_timeout(m_pDB, CHECKPOINT_BUSY_TIMEOUT_MS);
+
+    /*
+     * Reading the journal mode makes the connection detect the log; until then
+     * checkpoints on it are no-ops
+     */
+    sqlite3_stmt *pStmt = NULL;
+    std::string strJournalMode;
+    if ((SQLITE_OK == sqlite3_prepare_v2(m_pDB, "PRAGMA journal_mode;", -1,
+                                         &pStmt, NULL)) &&
+        (SQLITE_ROW == sqlite3_step(pStmt)))
+    {
+        strJournalMode = (const char*)sqlite3_column_text(pStmt, 0);
+    }
+    sqlite3_finalize(pStmt);
+
+    if ("wal" != strJournalMode)
+    {
+        HCPLOG_E << "Database is not in WAL mode:" << strJournalMode;
+        sqlite3_close(m_pDB);
+        m_pDB = NULL;
+        return false;
+    }
+
+    pStmt = NULL;
+    if ((SQLITE_OK == sqlite3_prepare_v2(m_pDB, "PRAGMA page_size;", -1,
+                                         &pStmt, NULL)) &&
+        (SQLITE_ROW == sqlite3_step(pStmt)))
+    {
+        m_nPageSize = sqlite3_column_int(pStmt, 0);
+    }
+    sqlite3_finalize(pStmt);
+
+    HCPLOG_D << "Checkpoint connection opened, pageSize=" << m_nPageSize;
+    return true;
+}
+
+void CDbCheckpointer::CloseConnection()
+{
+    m_ConnectionMutex.Lock();
+    if (m_pDB)
+    {
+        sqlite3_close(m_pDB);
+        m_pDB = NULL;
+    }
+    m_ConnectionMutex.Unlock();
+
+    // Closing the last connection of the writer checkpoints the whole log
+    m_StateMutex.Lock();
+    m_bWalDirty = false;
+    m_bTruncateRequested = false;
+    m_StateMutex.Unlock();
+}
+
+void CDbCheckpointer::NotifyCommit(int nWalPages)
+{
+    ic_utils::CScopeLock lock(m_StateMutex);
+    m_ullLastCommitMs = ic_utils::CIgniteDateTime::GetMonotonicTimeMs();
+    m_ullCommitCount++;
+    m_bWalDirty = true;
+
+    if ((m_ullTruncateBytes > 0) && !m_bTruncateRequested &&
+        ((unsigned long long)nWalPages * m_nPageSize >= m_ullTruncateBytes))
+    {
+        m_bTruncateRequested = true;
+        m_StateCondition.ConditionSignal();
+    }
+}
+
+void CDbCheckpointer::StopCheckpointer()
+{
+    m_StateMutex.Lock();
+    m_bStop = true;
+    m_StateCondition.ConditionSignal();
+    m_StateMutex.Unlock();
+
+    if (m_bIsRunning)
+    {
+        Join();
+    }
+}
+
+void CDbCheckpointer::Run()
+{
+    HCPLOG_METHOD() << "idleMs=" << m_unIdleMs
+                    << "; truncateBytes=" << m_ullTruncateBytes;
+
+    m_StateMutex.Lock();
+    while (!m_bStop)
+    {
+        if (!m_bTruncateRequested)
+        {
+            m_StateCondition.ConditionTimedwait(m_StateMutex, m_unIdleMs);
+        }
+        if (m_bStop)
+        {
+            break;
+        }
+
+        int nMode = -1;
+        if (m_bTruncateRequested)
+        {
+            nMode = SQLITE_CHECKPOINT_TRUNCATE;
+        }
+        else if (m_bWalDirty && (ic_utils::CIgniteDateTime::GetMonotonicTimeMs()
+                                 - m_ullLastCommitMs >= m_unIdleMs))
+        {
+            nMode = SQLITE_CHECKPOINT_PASSIVE;
+        }
+
+        if (nMode < 0)
+        {
+            continue;
+        }
+
+        unsigned long long ullCommitCount = m_ullCommitCount;
+        m_bTruncateRequested = false;
+
+        // Commits must not wait for the checkpoint, hence the state is unlocked
+        m_StateMutex.Unlock();
+        bool bComplete = false;
+        int nRc = Checkpoint(nMode, bComplete);
+        m_StateMutex.Lock();
+
+        if (SQLITE_OK == nRc)
+        {
+            if (bComplete && (ullCommitCount == m_ullCommitCount))
+            {
+                m_bWalDirty = false;
+            }
+
+            if (SQLITE_CHECKPOINT_TRUNCATE == nMode)
+            {
+                m_ullTruncateCount++;
+            }
+            else
+            {
+                m_ullPassiveCount++;
+            }
+        }
+        else if (SQLITE_BUSY == nRc)
+        {
+            // Retried once the next idle period elapses
+            HCPLOG_W << "Checkpoint busy, mode=" << nMode;
+            m_bTruncateRequested = (SQLITE_CHECKPOINT_TRUNCATE == nMode);
+            m_StateCondition.ConditionTimedwait(m_StateMutex, m_unIdleMs);
+        }
+        else
+        {
+            HCPLOG_E << "Checkpoint failed, mode=" << nMode << "; rc=" << nRc;
+        }
+    }
+    m_StateMutex.Unlock();
+}
+
+int CDbCheckpointer::Checkpoint(int nMode, bool &rbComplete)
+{
+    ic_utils::CScopeLock lock(m_ConnectionMutex);
+    rbComplete = false;
+    if (!m_pDB)
+    {
+        return SQLITE_MISUSE;
+    }
+
+    int nLogFrames = -1;
+    int nCheckpointedFrames = -1;
+    int nRc = sqlite3_wal_checkpoint_v2(m_pDB, NULL, nMode, &nLogFrames,
+                                        &nCheckpointedFrames);
+    rbComplete = (nLogFrames == nCheckpointedFrames);
+
+    HCPLOG_T << "mode=" << nMode << "; rc=" << nRc << "; logFrames="
+             << nLogFrames << "; checkpointed=" << nCheckpointedFrames;
+    return nRc;
+}
+} /* namespace ic_core */
@@ -24,6 +24,7 @@
 #include "CIgniteLog.h"
 #include "CIgniteStringUtils.h"
 #include "db/CDataBaseFacade.h"
+#include "crypto/CIgniteDataSecurity.h"
 
 namespace ic_core 
 {
@@ -67,6 +68,9 @@ std::string CLocalConfig::GetIvRandomNumber(std::string strSeedKey)
 
         //store the random number in DB
         Set(DATA_ENCRYPT_RND_NO, strSeedRndNo);
+
+        // Keys derived from the previous random number are no longer valid
+        CIgniteDataSecurity::InvalidateEventKey();
     }
 
     return strSeedRndNo;
@@ -127,9 +131,12 @@ bool CLocalConfig::Set(std::string strKey, std::string strValue)
     }
     else
     {
+        std::vector<std::string> vecSelectionArgs;
+        vecSelectionArgs.push_back(
+                            ic_utils::CIgniteStringUtils::NumberToString(lId));
         bSuccess = pDBFacade->Update(CDataBaseConst::TABLE_LOCAL_CONFIG, &data,
-                                                 CDataBaseConst::COL_ID + "=" + 
-                                        ic_utils::CIgniteStringUtils::NumberToString(lId));
+                                     CDataBaseConst::COL_ID + "=?",
+                                     vecSelectionArgs);
     }
     
     return bSuccess;
@@ -106,6 +106,10 @@ bool CServiceSettingsStore::StoreSettings(std::string strServiceId,
         vecProjection.push_back(CDataBaseConst::COL_SETTING_SRC_ISDEVICE);
 
         std::string strSelection;
+        std::vector<std::string> vecSelectionArgs;
+        vecSelectionArgs.push_back(strServiceId);
+        vecSelectionArgs.push_back(strObjSettingEnum);
+        vecSelectionArgs.push_back(bIsFromDevice ? "true" : "false");
         if (bIsFromDevice) 
         {
             contentValues.Put(CDataBaseConst::COL_SETTING_SRC_ISDEVICE, true);
@@ -152,7 +156,11 @@ bool CServiceSettingsStore::StoreSettings(std::string strServiceId,
             HCPLOG_T << "Setting is updated in dB" << nId;
             bSuccess = pDBFacade->Update(
                                   CDataBaseConst::TABLE_IGNITE_SERVICE_SETTINGS,
-                                  &contentValues, strSelection);
+                                  &contentValues,
+                                  CDataBaseConst::COL_SETTING_ID + " = ? AND " +
+                                  CDataBaseConst::COL_SETTING_ENUM + " = ? AND " +
+                                  CDataBaseConst::COL_SETTING_SRC_ISDEVICE +
+                                  " = ?", vecSelectionArgs);
         }
 
         if(!bSuccess)
@@ -216,9 +224,13 @@ bool CServiceSettingsStore::StoreSettings(std::string strServiceId,
     else
     {
         HCPLOG_T << "Setting is updated in dB" << lId;
+        std::vector<std::string> vecSelectionArgs;
+        vecSelectionArgs.push_back(strSettingEnum);
         bSuccess = pDBFacade->Update(
                                   CDataBaseConst::TABLE_IGNITE_SERVICE_SETTINGS,
-                                  &contentValues, strSelection);
+                                  &contentValues,
+                                  CDataBaseConst::COL_SETTING_ENUM + " = ?",
+                                  vecSelectionArgs);
     }
     return bSuccess;
 }
@@ -228,17 +240,18 @@ bool CServiceSettingsStore::UpdateResponseReceivedForSettings(
                                                      std::string strSettingEnum)
 {
     HCPLOG_T << "Updating Settings Response for " << strSettingEnum;
-    std::string strSelection = CDataBaseConst::COL_SETTING_ID + " = '" + 
-                               strServiceId + "' AND " + 
-                               CDataBaseConst::COL_SETTING_ENUM + " = '" + 
-                               strSettingEnum + "' AND " + 
+    std::string strSelection = CDataBaseConst::COL_SETTING_ID + " = ? AND " +
+                               CDataBaseConst::COL_SETTING_ENUM + " = ? AND " +
                                CDataBaseConst::COL_SETTING_SRC_ISDEVICE +
                                "='false'";
+    std::vector<std::string> vecSelectionArgs;
+    vecSelectionArgs.push_back(strServiceId);
+    vecSelectionArgs.push_back(strSettingEnum);
     CContentValues data;
     data.Put(CDataBaseConst::COL_SETTING_RESPONSE_STATUS, true);
     bool bStatus = CDataBaseFacade::GetInstance()->Update(
                                   CDataBaseConst::TABLE_IGNITE_SERVICE_SETTINGS,
-                                  &data, strSelection);
+                                  &data, strSelection, vecSelectionArgs);
     return bStatus;
 }
 
@@ -248,12 +261,13 @@ bool CServiceSettingsStore::UpdateAcknowledgementReceivedFromCloud(
                                                        std::string strResp) 
 {
     HCPLOG_T << "Updating Settings Response for " << strCorrelationId;
-    std::string strSelection = CDataBaseConst::COL_SETTING_ID + " = '" + 
-                               strServiceId + "' AND " +
-                               CDataBaseConst::COL_SETTING_CORR_ID + " = '" +
-                               strCorrelationId + "' AND " +
-                               CDataBaseConst::COL_SETTING_SRC_ISDEVICE + 
+    std::string strSelection = CDataBaseConst::COL_SETTING_ID + " = ? AND " +
+                               CDataBaseConst::COL_SETTING_CORR_ID + " = ? AND " +
+                               CDataBaseConst::COL_SETTING_SRC_ISDEVICE +
                                " ='true'";
+    std::vector<std::string> vecSelectionArgs;
+    vecSelectionArgs.push_back(strServiceId);
+    vecSelectionArgs.push_back(strCorrelationId);
 
     CContentValues data;
     if (strResp == STATUS_SUCCESS) 
@@ -268,7 +282,7 @@ bool CServiceSettingsStore::UpdateAcknowledgementReceivedFromCloud(
     }
     bool bStatus = CDataBaseFacade::GetInstance()->Update(
                                   CDataBaseConst::TABLE_IGNITE_SERVICE_SETTINGS,
-                                  &data, strSelection);
+                                  &data, strSelection, vecSelectionArgs);
 
     return bStatus;
 }
@@ -20,6 +20,7 @@
 #include <string.h>
 #include "crypto/CAesGcm.h"
 #include "crypto/CAes.h"
+#include "crypto/CBase64.h"
 #include "db/CLocalConfig.h"
 #include "core/CKeyGenerator.h"
 #include "CIgniteConfig.h"
@@ -346,4 +347,30 @@ TEST_F(CAesGcmTest, Test_GcmEncrypt_AADKeyLessThanFive)
    // Expect GcmEncrypt to succeed
    EXPECT_EQ(eGCM_SUCCESS, nEncryptStatus);
 }
+
+TEST_F(CAesGcmTest, Test_GcmEncryptRaw_GcmDecryptRaw)
+{
+   CAesGcm aesGcmObj("VIN+SLNO+RANDOMJ", "VIN+SLNO+RANDOMJ");
+   const std::string strPlaintext = "this is a random text to be encrypted";
+
+   std::string strCipherText;
+   EXPECT_EQ(eGCM_SUCCESS, aesGcmObj.GcmEncryptRaw(strPlaintext, strCipherText));
+
+   // Expect the cipher text to be the one GcmEncrypt encodes as base64
+   std::string strBase64Text;
+   EXPECT_EQ(eGCM_SUCCESS, aesGcmObj.GcmEncrypt(strPlaintext, strBase64Text));
+   int nLen = -1;
+   char *pchDecoded = CBase64::Decode(strBase64Text, nLen);
+   ASSERT_NE(nullptr, pchDecoded);
+   EXPECT_EQ(std::string(pchDecoded, nLen), strCipherText);
+   free(pchDecoded);
+
+   std::string strDecrypted;
+   EXPECT_EQ(eGCM_SUCCESS, aesGcmObj.GcmDecryptRaw(strCipherText, strDecrypted));
+   EXPECT_EQ(strPlaintext, strDecrypted);
+
+   // Expect empty input to fail
+   EXPECT_EQ(eGCM_FAILURE, aesGcmObj.GcmEncryptRaw("", strCipherText));
+   EXPECT_EQ(eGCM_FAILURE, aesGcmObj.GcmDecryptRaw("", strDecrypted));
+}
 } //namespace
@@ -204,4 +204,28 @@ TEST_F(CContentValuesTest, Test_Clear)
     // Expect the API to return value 0 as data is reset
     EXPECT_EQ(obj.Size(), 0);
 }
+
+TEST_F(CContentValuesTest, Test_PutBlob)
+{
+    CContentValues obj;
+
+    // Binary value with embedded zero bytes
+    std::string strKey = "EVENTS";
+    std::string strValue("\x01\x00\xff\x00", 4);
+
+    obj.PutBlob(strKey, strValue);
+
+    // Expect the value to be kept as is and marked as binary
+    EXPECT_TRUE(obj.IsBlob(strKey));
+    EXPECT_EQ(strValue, obj.GetAsString(strKey));
+
+    // Expect a plain put on the same key to clear the binary marker
+    obj.Put(strKey, "text");
+    EXPECT_FALSE(obj.IsBlob(strKey));
+    EXPECT_EQ("text", obj.GetAsString(strKey));
+
+    obj.PutBlob(strKey, strValue);
+    obj.Clear();
+    EXPECT_FALSE(obj.IsBlob(strKey));
+}
 }
@@ -68,6 +68,32 @@ protected:
       // Do nothing
    }
 
+   /**
+    * Method to configure the incremental vacuum mode of the database and to
+    * migrate the database file to it
+    * @param[in] bEnable true to enable incremental vacuum, false to disable
+    * @param[in] unPagesPerStep Number of pages reclaimed per vacuum step
+    * @return void
+    */
+   void SetIncrementalVacuum(bool bEnable, unsigned int unPagesPerStep)
+   {
+      CDatabase *pDb = CDataBaseFacade::GetInstance()->m_pSQLiteDbInstance;
+      pDb->m_bIncrementalVacuum = bEnable;
+      pDb->m_unVacuumPagesPerStep = unPagesPerStep;
+      pDb->ConfigureAutoVacuum();
+   }
+
+   /**
+    * Wrapper method to call GetPragmaValue of CDatabase
+    * @param[in] rstrPragma Name of the pragma
+    * @return Value of the pragma, -1 on error
+    * @see CDatabase::GetPragmaValue
+    */
+   int GetPragmaValue(const std::string &rstrPragma)
+   {
+      return CDataBaseFacade::GetInstance()->m_pSQLiteDbInstance->
+                                                   GetPragmaValue(rstrPragma);
+   }
 };
 
 // Tests
@@ -185,7 +211,64 @@ TEST_F(CDataBaseFacadeTest , Test_Insert_Negative_2)
              Insert(" ",NULL));
 }
 
-TEST_F(CDataBaseFacadeTest , Test_Query_Negative_1) 
+TEST_F(CDataBaseFacadeTest , Test_Insert_QuotedValue)
+{
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_KEY_VAL, "key-quote");
+   data.Put(CDataBaseConst::COL_VALUE, "it's a 'quoted' value");
+
+   // insert data having quotes, expect it to be stored as is
+   EXPECT_NE(-1, CDataBaseFacade::GetInstance()->
+             Insert(CDataBaseConst::TABLE_LOCAL_CONFIG, &data));
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_VALUE);
+   CCursor *pCursor = CDataBaseFacade::GetInstance()->
+                      Query(CDataBaseConst::TABLE_LOCAL_CONFIG, vecProjection,
+                            CDataBaseConst::COL_KEY_VAL + "='key-quote'");
+   ASSERT_NE(nullptr, pCursor);
+   ASSERT_FALSE(pCursor->Empty());
+   EXPECT_EQ("it's a 'quoted' value", pCursor->GetString(0));
+   delete pCursor;
+}
+
+TEST_F(CDataBaseFacadeTest , Test_BulkInsert)
+{
+   int nCountBefore = CDataBaseFacade::GetInstance()->
+                      GetRowCountOfTable(CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+
+   std::vector<CContentValues> vecRows(3);
+   for (int i = 0; i < 3; i++)
+   {
+      vecRows[i].Put(CDataBaseConst::COL_TIMESTAMP, 1646444909901LL + i);
+      vecRows[i].Put(CDataBaseConst::COL_EVENTS, "{\"EventID\":\"Bulk\"}");
+   }
+
+   // insert rows in one transaction, expect all of them to be inserted
+   CDataBaseFacade::GetInstance()->StartTransaction();
+   EXPECT_EQ(3, CDataBaseFacade::GetInstance()->
+             BulkInsert(CDataBaseConst::TABLE_INVALID_EVENT_STORE, vecRows));
+   CDataBaseFacade::GetInstance()->EndTransaction(true);
+
+   EXPECT_EQ(nCountBefore + 3, CDataBaseFacade::GetInstance()->
+             GetRowCountOfTable(CDataBaseConst::TABLE_INVALID_EVENT_STORE));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_BulkInsert_Negative)
+{
+   std::vector<CContentValues> vecRows(1);
+   vecRows[0].Put(CDataBaseConst::COL_TIMESTAMP, 164644);
+
+   // insert rows in db, expect BulkInsert() to fail as table name is empty
+   EXPECT_EQ(eINVALID_OPERATION, CDataBaseFacade::GetInstance()->
+                                 BulkInsert("", vecRows));
+
+   // insert rows in an unknown table, expect no row to be inserted
+   EXPECT_EQ(0, CDataBaseFacade::GetInstance()->
+                BulkInsert("INVALID_STORE", vecRows));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_Query_Negative_1)
 {
    std::vector<std::string> vectProjection;
    vectProjection.push_back("COUNT(*)");
@@ -193,7 +276,184 @@ TEST_F(CDataBaseFacadeTest , Test_Query_Negative_1)
    EXPECT_EQ(NULL, CDataBaseFacade::GetInstance()->Query(" ",vectProjection));
 }
 
-TEST_F(CDataBaseFacadeTest , Test_Update_Positive) 
+TEST_F(CDataBaseFacadeTest , Test_QueryStream)
+{
+   std::vector<CContentValues> vecRows(3);
+   for (int i = 0; i < 3; i++)
+   {
+      vecRows[i].Put(CDataBaseConst::COL_TIMESTAMP, 1700000000000LL + i);
+      vecRows[i].Put(CDataBaseConst::COL_EVENTS, "stream-" +
+                     ic_utils::CIgniteStringUtils::NumberToString(i));
+   }
+   CDataBaseFacade::GetInstance()->Remove(
+                                   CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+   CDataBaseFacade::GetInstance()->BulkInsert(
+                           CDataBaseConst::TABLE_INVALID_EVENT_STORE, vecRows);
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_TIMESTAMP);
+   vecProjection.push_back(CDataBaseConst::COL_EVENTS);
+   std::vector<std::string> vecOrderBy;
+   vecOrderBy.push_back(CDataBaseConst::COL_TIMESTAMP + " ASC");
+   CStreamCursor *pCursor = CDataBaseFacade::GetInstance()->
+                     QueryStream(CDataBaseConst::TABLE_INVALID_EVENT_STORE,
+                                 vecProjection, "", vecOrderBy);
+   ASSERT_NE(nullptr, pCursor);
+
+   // reading before the first step is expected to fail gracefully
+   EXPECT_EQ(0, pCursor->GetLong(0));
+
+   // rows are expected in order with typed and zero-copy accessors
+   int nTsCol = pCursor->GetColumnIndex(CDataBaseConst::COL_TIMESTAMP);
+   int nEventsCol = pCursor->GetColumnIndex(CDataBaseConst::COL_EVENTS);
+   int nRows = 0;
+   while (pCursor->MoveToNext())
+   {
+      EXPECT_EQ(1700000000000LL + nRows, pCursor->GetLong(nTsCol));
+
+      size_t nLength = 0;
+      const char *pText = pCursor->GetText(nEventsCol, nLength);
+      std::string strExpected = "stream-" +
+                           ic_utils::CIgniteStringUtils::NumberToString(nRows);
+      ASSERT_NE(nullptr, pText);
+      EXPECT_EQ(strExpected, std::string(pText, nLength));
+      EXPECT_EQ(strExpected, pCursor->GetString(nEventsCol));
+      EXPECT_FALSE(pCursor->IsNull(nEventsCol));
+      nRows++;
+   }
+   EXPECT_EQ(3, nRows);
+
+   // cursor is expected to stay exhausted
+   EXPECT_FALSE(pCursor->MoveToNext());
+   EXPECT_EQ(-1, pCursor->GetColumnIndex("unknown"));
+   delete pCursor;
+}
+
+TEST_F(CDataBaseFacadeTest , Test_QueryStream_Blob)
+{
+   std::string strSQL = "INSERT INTO " + CDataBaseConst::TABLE_LOCAL_CONFIG +
+                        " (" + CDataBaseConst::COL_KEY_VAL + "," +
+                        CDataBaseConst::COL_VALUE +
+                        ") VALUES ('key-blob', X'00FF7F');";
+   ASSERT_EQ(SQLITE_OK, CDataBaseFacade::GetInstance()->ExecuteCommand(strSQL));
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_VALUE);
+   CStreamCursor *pCursor = CDataBaseFacade::GetInstance()->
+                      QueryStream(CDataBaseConst::TABLE_LOCAL_CONFIG,
+                                  vecProjection,
+                                  CDataBaseConst::COL_KEY_VAL + "='key-blob'");
+   ASSERT_NE(nullptr, pCursor);
+   ASSERT_TRUE(pCursor->MoveToNext());
+
+   // blob having embedded NUL is expected to be returned completely
+   size_t nLength = 0;
+   const unsigned char *pBlob =
+                 (const unsigned char*)pCursor->GetBlob(0, nLength);
+   ASSERT_NE(nullptr, pBlob);
+   ASSERT_EQ(3u, nLength);
+   EXPECT_EQ(0x00, pBlob[0]);
+   EXPECT_EQ(0xFF, pBlob[1]);
+   EXPECT_EQ(0x7F, pBlob[2]);
+   delete pCursor;
+
+   CDataBaseFacade::GetInstance()->Remove(CDataBaseConst::TABLE_LOCAL_CONFIG,
+                                          CDataBaseConst::COL_KEY_VAL +
+                                          "='key-blob'");
+}
+
+TEST_F(CDataBaseFacadeTest , Test_QueryStream_Negative)
+{
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back("COUNT(*)");
+
+   // query data from the database, expect NULL as table name is empty
+   EXPECT_EQ(nullptr, CDataBaseFacade::GetInstance()->
+                      QueryStream("", vecProjection));
+
+   // query data from an unknown table, expect NULL as statement is invalid
+   EXPECT_EQ(nullptr, CDataBaseFacade::GetInstance()->
+                      QueryStream("INVALID_STORE", vecProjection));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_GetQueryPlan_UploadScan)
+{
+   // table, if dropped by an earlier test, is recreated with its indexes
+   CDataBaseFacade::GetInstance()->Remove(CDataBaseConst::TABLE_EVENT_STORE);
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_ID);
+   vecProjection.push_back(CDataBaseConst::COL_EVENTS);
+   std::vector<std::string> vecOrderBy;
+   vecOrderBy.push_back(CDataBaseConst::COL_TIMESTAMP + " ASC");
+   std::string strSelection = CDataBaseConst::COL_TIMESTAMP + " IS NOT NULL" +
+                   " AND " + CDataBaseConst::COL_MID + " == 0" +
+                   " AND " + CDataBaseConst::COL_TOPIC + " IS NULL" +
+                   " AND " + CDataBaseConst::COL_STREAM_SUPPORT + " == 1";
+   std::string strPlan = CDataBaseFacade::GetInstance()->GetQueryPlan(
+                              CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
+                              strSelection, vecOrderBy, 10);
+
+   // upload scan is expected to be served in order by the MID index
+   EXPECT_NE(std::string::npos,
+             strPlan.find("USING INDEX IDX_EVENT_STORE_MID_TIMESTAMP")) << strPlan;
+   EXPECT_EQ(std::string::npos, strPlan.find("TEMP B-TREE"));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_GetQueryPlan_TimeRangeCheck)
+{
+   // table, if dropped by an earlier test, is recreated with its indexes
+   CDataBaseFacade::GetInstance()->Remove(CDataBaseConst::TABLE_EVENT_STORE);
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_GRANULARITY);
+   std::vector<std::string> vecOrderBy;
+   vecOrderBy.push_back(CDataBaseConst::COL_GRANULARITY + " DESC");
+   std::string strSelection = "(" + CDataBaseConst::COL_TIMESTAMP + " >= 1" +
+                   " AND " + CDataBaseConst::COL_TIMESTAMP + " <= 2)" +
+                   " AND (" + CDataBaseConst::COL_BATCH_SUPPORT + " == 1)";
+   std::string strPlan = CDataBaseFacade::GetInstance()->GetQueryPlan(
+                              CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
+                              strSelection, vecOrderBy, 1);
+
+   // time range check is expected not to touch the table rows at all
+   EXPECT_NE(std::string::npos,
+             strPlan.find("USING COVERING INDEX IDX_EVENT_STORE_TIMESTAMP"));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_GetQueryPlan_GranularityScan)
+{
+   // table, if dropped by an earlier test, is recreated with its indexes
+   CDataBaseFacade::GetInstance()->Remove(CDataBaseConst::TABLE_EVENT_STORE);
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_ID);
+   vecProjection.push_back(CDataBaseConst::COL_TIMESTAMP);
+   std::string strSelection = "(" + CDataBaseConst::COL_TIMESTAMP + " >= 1" +
+                   " AND " + CDataBaseConst::COL_TIMESTAMP + " <= 2)" +
+                   " AND (" + CDataBaseConst::COL_EVENT_ID + "=\"Location\")";
+   std::string strPlan = CDataBaseFacade::GetInstance()->GetQueryPlan(
+                              CDataBaseConst::TABLE_EVENT_STORE, vecProjection,
+                              strSelection);
+
+   // event id lookup is expected to use the event id index
+   EXPECT_NE(std::string::npos,
+             strPlan.find("IDX_EVENT_STORE_EVENTID_TIMESTAMP"));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_GetQueryPlan_Negative)
+{
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_ID);
+
+   // plan is expected to be empty for unknown and empty table names
+   EXPECT_EQ("", CDataBaseFacade::GetInstance()->GetQueryPlan("UNKNOWN_TABLE",
+                                                              vecProjection));
+   EXPECT_EQ("", CDataBaseFacade::GetInstance()->GetQueryPlan("",
+                                                              vecProjection));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_Update_Positive)
 {
    CContentValues data;
    data.Put(CDataBaseConst::COL_MID, 0);
@@ -203,6 +463,47 @@ TEST_F(CDataBaseFacadeTest , Test_Update_Positive)
                    CDataBaseConst::COL_MID + "!=0"));
 }
 
+TEST_F(CDataBaseFacadeTest , Test_Update_SelectionArgs)
+{
+   CDataBaseFacade *pDb = CDataBaseFacade::GetInstance();
+   std::string strSelection = CDataBaseConst::COL_EVENT_ID + " = ? AND " +
+                              CDataBaseConst::COL_TIMESTAMP + " = ?";
+
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_EVENT_ID, "SelectionArgsTest");
+   data.PutBlob(CDataBaseConst::COL_EVENTS, "payload");
+   for (long long llTime = 1; llTime <= 2; llTime++)
+   {
+      data.Put(CDataBaseConst::COL_TIMESTAMP, llTime);
+      EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_EVENT_STORE, &data));
+   }
+
+   // Expect only the row matching the bound arguments to be updated
+   std::vector<std::string> vecSelectionArgs;
+   vecSelectionArgs.push_back("SelectionArgsTest");
+   vecSelectionArgs.push_back("2");
+   CContentValues update;
+   update.Put(CDataBaseConst::COL_MID, 7);
+   EXPECT_TRUE(pDb->Update(CDataBaseConst::TABLE_EVENT_STORE, &update,
+                           strSelection, vecSelectionArgs));
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_TIMESTAMP);
+   CCursor *pCursor = pDb->Query(CDataBaseConst::TABLE_EVENT_STORE,
+                                 vecProjection,
+                                 CDataBaseConst::COL_EVENT_ID +
+                                 " = 'SelectionArgsTest' AND " +
+                                 CDataBaseConst::COL_MID + " = 7");
+   ASSERT_NE(nullptr, pCursor);
+   ASSERT_EQ(1, pCursor->Size());
+   ASSERT_TRUE(pCursor->MoveToFirst());
+   EXPECT_EQ(2, pCursor->GetLong(0));
+   delete pCursor;
+
+   pDb->Remove(CDataBaseConst::TABLE_EVENT_STORE,
+               CDataBaseConst::COL_EVENT_ID + " = 'SelectionArgsTest'");
+}
+
 TEST_F(CDataBaseFacadeTest , Test_Update_Negative) 
 {
    // update data in database, expect true for invalid inputs
@@ -229,6 +530,225 @@ TEST_F(CDataBaseFacadeTest , Test_GetSize)
    EXPECT_NE(-1, CDataBaseFacade::GetInstance()->GetSize());  
 }
 
+TEST_F(CDataBaseFacadeTest , Test_ReclaimFreePages_Disabled)
+{
+   // incremental vacuum is not configured, expect nothing to be reclaimed
+   EXPECT_EQ(0, CDataBaseFacade::GetInstance()->ReclaimFreePages(10));
+   EXPECT_TRUE(CDataBaseFacade::GetInstance()->VacuumDb());
+}
+
+TEST_F(CDataBaseFacadeTest , Test_ConfigureAutoVacuum_Migration)
+{
+   CDataBaseFacade *pDb = CDataBaseFacade::GetInstance();
+   pDb->Remove(CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_TIMESTAMP, (long long)1);
+   data.Put(CDataBaseConst::COL_EVENTS, "migration");
+   EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_INVALID_EVENT_STORE, &data));
+   ASSERT_EQ(0, GetPragmaValue("auto_vacuum"));
+
+   // Expect the existing database to be migrated with its rows kept
+   SetIncrementalVacuum(true, 4);
+   EXPECT_EQ(2, GetPragmaValue("auto_vacuum"));
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_EVENTS);
+   CCursor *pCursor = pDb->Query(CDataBaseConst::TABLE_INVALID_EVENT_STORE,
+                                 vecProjection, "");
+   ASSERT_NE(nullptr, pCursor);
+   EXPECT_EQ(1, pCursor->Size());
+   delete pCursor;
+
+   // Expect the migration back once incremental vacuum is disabled
+   SetIncrementalVacuum(false, 4);
+   EXPECT_EQ(0, GetPragmaValue("auto_vacuum"));
+
+   pDb->Remove(CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+}
+
+TEST_F(CDataBaseFacadeTest , Test_ReclaimFreePages_Incremental)
+{
+   const unsigned int unPagesPerStep = 4;
+   CDataBaseFacade *pDb = CDataBaseFacade::GetInstance();
+   SetIncrementalVacuum(true, unPagesPerStep);
+   ASSERT_EQ(2, GetPragmaValue("auto_vacuum"));
+
+   // payloads spanning overflow pages, freed by the removal
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_TIMESTAMP, (long long)1);
+   data.PutBlob(CDataBaseConst::COL_EVENTS, std::string(8192, '\x01'));
+   for (int nI = 0; nI < 64; nI++)
+   {
+      EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_INVALID_EVENT_STORE,
+                                &data));
+   }
+   pDb->Remove(CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+   int nFreePages = GetPragmaValue("freelist_count");
+   ASSERT_GT(nFreePages, (int)(unPagesPerStep * 2));
+
+   // Expect at most the configured number of pages reclaimed per call
+   int nLeftPages = pDb->ReclaimFreePages();
+   EXPECT_EQ(nLeftPages, GetPragmaValue("freelist_count"));
+   EXPECT_GT(nFreePages, nLeftPages);
+   EXPECT_LE(nFreePages - nLeftPages, (int)unPagesPerStep);
+
+   // Expect an explicit limit to be applied in the same way
+   nFreePages = nLeftPages;
+   nLeftPages = pDb->ReclaimFreePages(2);
+   EXPECT_GT(nFreePages, nLeftPages);
+   EXPECT_LE(nFreePages - nLeftPages, 2);
+
+   // Expect repeated calls to release the free pages completely
+   for (int nI = 0; (nLeftPages > 0) && (nI < nFreePages); nI++)
+   {
+      nLeftPages = pDb->ReclaimFreePages();
+   }
+   EXPECT_EQ(0, nLeftPages);
+
+   SetIncrementalVacuum(false, unPagesPerStep);
+   EXPECT_EQ(0, GetPragmaValue("auto_vacuum"));
+}
+
+TEST_F(CDataBaseFacadeTest , Test_Insert_BlobEvents)
+{
+   CDataBaseFacade *pDb = CDataBaseFacade::GetInstance();
+   pDb->Remove(CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+
+   // binary payload with embedded zero bytes next to a text payload
+   std::string strBlob("\x01\x00payload\x00", 10);
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_TIMESTAMP, (long long)1);
+   data.PutBlob(CDataBaseConst::COL_EVENTS, strBlob);
+   EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_INVALID_EVENT_STORE, &data));
+   data.Put(CDataBaseConst::COL_EVENTS, "dGV4dA==");
+   EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_INVALID_EVENT_STORE, &data));
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_EVENTS);
+   std::vector<std::string> vecOrderBy;
+   vecOrderBy.push_back(CDataBaseConst::COL_ID + " ASC");
+
+   // Expect the binary payload stored as BLOB and the text one as TEXT
+   CCursor *pCursor = pDb->Query(CDataBaseConst::TABLE_INVALID_EVENT_STORE,
+                                 vecProjection, "typeof(" +
+                                 CDataBaseConst::COL_EVENTS + ") = 'blob'");
+   ASSERT_NE(nullptr, pCursor);
+   EXPECT_EQ(1, pCursor->Size());
+   delete pCursor;
+
+   // Expect both cursors to return both payloads unchanged
+   pCursor = pDb->Query(CDataBaseConst::TABLE_INVALID_EVENT_STORE,
+                        vecProjection, "", vecOrderBy);
+   ASSERT_NE(nullptr, pCursor);
+   ASSERT_TRUE(pCursor->MoveToFirst());
+   EXPECT_EQ(strBlob, pCursor->GetString(0));
+   ASSERT_TRUE(pCursor->MoveToNext());
+   EXPECT_EQ("dGV4dA==", pCursor->GetString(0));
+   delete pCursor;
+
+   CStreamCursor *pStream = pDb->QueryStream(
+                              CDataBaseConst::TABLE_INVALID_EVENT_STORE,
+                              vecProjection, "", vecOrderBy);
+   ASSERT_NE(nullptr, pStream);
+   ASSERT_TRUE(pStream->MoveToNext());
+   EXPECT_EQ(strBlob, pStream->GetString(0));
+   ASSERT_TRUE(pStream->MoveToNext());
+   EXPECT_EQ("dGV4dA==", pStream->GetString(0));
+   delete pStream;
+
+   pDb->Remove(CDataBaseConst::TABLE_INVALID_EVENT_STORE);
+}
+
+TEST_F(CDataBaseFacadeTest , Test_Insert_EventChecksum)
+{
+   CDataBaseFacade *pDb = CDataBaseFacade::GetInstance();
+   std::string strSelection = CDataBaseConst::COL_EVENT_ID + " = 'ChecksumTest'";
+
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_EVENT_ID, "ChecksumTest");
+   data.Put(CDataBaseConst::COL_TIMESTAMP, (long long)1);
+   data.PutBlob(CDataBaseConst::COL_EVENTS, "payload");
+   EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_EVENT_STORE, &data));
+   data.Put(CDataBaseConst::COL_CHECKSUM, (long long)4294967295LL);
+   EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_EVENT_STORE, &data));
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_CHECKSUM);
+   std::vector<std::string> vecOrderBy;
+   vecOrderBy.push_back(CDataBaseConst::COL_ID + " ASC");
+
+   // Expect no checksum by default and the full 32-bit value when stored
+   CStreamCursor *pStream = pDb->QueryStream(CDataBaseConst::TABLE_EVENT_STORE,
+                                             vecProjection, strSelection,
+                                             vecOrderBy);
+   ASSERT_NE(nullptr, pStream);
+   ASSERT_TRUE(pStream->MoveToNext());
+   EXPECT_TRUE(pStream->IsNull(0));
+   ASSERT_TRUE(pStream->MoveToNext());
+   EXPECT_FALSE(pStream->IsNull(0));
+   EXPECT_EQ(4294967295LL, pStream->GetLong(0));
+   delete pStream;
+
+   pDb->Remove(CDataBaseConst::TABLE_EVENT_STORE, strSelection);
+}
+
+TEST_F(CDataBaseFacadeTest , Test_RemoveByIdSet)
+{
+   CDataBaseFacade *pDb = CDataBaseFacade::GetInstance();
+   std::string strSelection = CDataBaseConst::COL_EVENT_ID + " = 'IdSetTest'";
+
+   CContentValues data;
+   data.Put(CDataBaseConst::COL_EVENT_ID, "IdSetTest");
+   data.Put(CDataBaseConst::COL_TIMESTAMP, (long long)1);
+   data.PutBlob(CDataBaseConst::COL_EVENTS, "payload");
+   for (int nMid = 1; nMid <= 4; nMid++)
+   {
+      data.Put(CDataBaseConst::COL_MID, nMid);
+      EXPECT_NE(-1, pDb->Insert(CDataBaseConst::TABLE_EVENT_STORE, &data));
+   }
+
+   std::vector<std::string> vecProjection;
+   vecProjection.push_back(CDataBaseConst::COL_ID);
+
+   // Expect only the rows of the bound mids to be updated and removed
+   std::vector<long long> vecMids;
+   vecMids.push_back(1);
+   vecMids.push_back(3);
+   EXPECT_TRUE(pDb->BindIdSet(vecMids));
+
+   CContentValues update;
+   update.Put(CDataBaseConst::COL_TIMESTAMP, (long long)2);
+   EXPECT_TRUE(pDb->UpdateByIdSet(CDataBaseConst::TABLE_EVENT_STORE, &update,
+                                  CDataBaseConst::COL_MID, strSelection));
+   CCursor *pCursor = pDb->Query(CDataBaseConst::TABLE_EVENT_STORE,
+                                 vecProjection,
+                                 strSelection + " AND " +
+                                 CDataBaseConst::COL_TIMESTAMP + " = 2");
+   ASSERT_NE(nullptr, pCursor);
+   EXPECT_EQ(2, pCursor->Size());
+   delete pCursor;
+
+   EXPECT_TRUE(pDb->RemoveByIdSet(CDataBaseConst::TABLE_EVENT_STORE,
+                                  CDataBaseConst::COL_MID, strSelection));
+   pCursor = pDb->Query(CDataBaseConst::TABLE_EVENT_STORE,
+                        vecProjection, strSelection);
+   ASSERT_NE(nullptr, pCursor);
+   EXPECT_EQ(2, pCursor->Size());
+   delete pCursor;
+
+   // Expect a rebound set to replace the previous one
+   vecMids.assign(1, 4);
+   EXPECT_TRUE(pDb->BindIdSet(vecMids));
+   EXPECT_TRUE(pDb->RemoveByIdSet(CDataBaseConst::TABLE_EVENT_STORE,
+                                  CDataBaseConst::COL_MID, strSelection));
+   pCursor = pDb->Query(CDataBaseConst::TABLE_EVENT_STORE,
+                        vecProjection, strSelection);
+   ASSERT_NE(nullptr, pCursor);
+   EXPECT_EQ(1, pCursor->Size());
+   delete pCursor;
+
+   pDb->Remove(CDataBaseConst::TABLE_EVENT_STORE, strSelection);
+}
+
 TEST_F(CDataBaseFacadeTest , Test_removeNegative_1) 
 {
    // Remove data from database functionality, expect fasle for invalid input
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+#include "gtest/gtest.h"
+#include "db/CDbCheckpointer.h"
+#include "CIgniteFileUtils.h"
+
+namespace ic_core
+{
+namespace
+{
+//! Database file used by the tests
+const std::string TEST_DB_FILE = "/tmp/ic_test_checkpointer.db";
+
+/**
+ * Wal hook forwarding the commits to the checkpointer
+ * @param[in] pArg instance of CDbCheckpointer
+ * @param[in] pDB database connection
+ * @param[in] pchDbName database name
+ * @param[in] nPages number of pages in the log
+ * @return SQLITE_OK always
+ */
+int test_wal_hook(void *pArg, sqlite3 *pDB, const char *pchDbName, int nPages)
+{
+    static_cast<CDbCheckpointer*>(pArg)->NotifyCommit(nPages);
+    return SQLITE_OK;
+}
+
+/**
+ * Method to get the size of the given file
+ * @param[in] rstrPath file path
+ * @return file size; -1 if file does not exist
+ */
+long long get_file_size(const std::string &rstrPath)
+{
+    struct stat stStat;
+    return (0 == stat(rstrPath.c_str(), &stStat)) ? stStat.st_size : -1;
+}
+}
+
+/**
+ * Class CDbCheckpointerTest defines a test feature for CDbCheckpointer class
+ */
+class CDbCheckpointerTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CDbCheckpointerTest() : m_pDB(NULL)
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CDbCheckpointerTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * Overriding Method of testing::Test class
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        RemoveFiles();
+        sqlite3_open(TEST_DB_FILE.c_str(), &m_pDB);
+        Exec("PRAGMA journal_mode=WAL;");
+        Exec("CREATE TABLE T (V TEXT);");
+    }
+
+    /**
+     * Overriding Method of testing::Test class
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        sqlite3_close(m_pDB);
+        RemoveFiles();
+    }
+
+    /**
+     * Method to execute the given sql on the writer connection
+     * @param[in] pchSql sql statement
+     * @return sqlite result code
+     */
+    int Exec(const char *pchSql)
+    {
+        return sqlite3_exec(m_pDB, pchSql, NULL, NULL, NULL);
+    }
+
+    /**
+     * Method to remove the database files
+     * @param void
+     * @return void
+     */
+    void RemoveFiles()
+    {
+        ic_utils::CIgniteFileUtils::Remove(TEST_DB_FILE);
+        ic_utils::CIgniteFileUtils::Remove(TEST_DB_FILE + "-wal");
+        ic_utils::CIgniteFileUtils::Remove(TEST_DB_FILE + "-shm");
+    }
+
+    /**
+     * Method to get the given checkpoint counter of the checkpointer
+     * @param[in] rCheckpointer checkpointer
+     * @param[in] bTruncate true for the truncate counter, false for passive
+     * @return value of the counter
+     */
+    unsigned long long GetCount(CDbCheckpointer &rCheckpointer, bool bTruncate)
+    {
+        ic_utils::CScopeLock lock(rCheckpointer.m_StateMutex);
+        return bTruncate ? rCheckpointer.m_ullTruncateCount :
+                           rCheckpointer.m_ullPassiveCount;
+    }
+
+    /**
+     * Method to wait until the given counter of the checkpointer is non zero
+     * @param[in] rCheckpointer checkpointer
+     * @param[in] bTruncate true for the truncate counter, false for passive
+     * @return value of the counter
+     */
+    unsigned long long WaitForCheckpoint(CDbCheckpointer &rCheckpointer,
+                                         bool bTruncate)
+    {
+        unsigned long long ullCount = 0;
+        for (int i = 0; (i < 100) && (0 == ullCount); i++)
+        {
+            usleep(20000);
+            ullCount = GetCount(rCheckpointer, bTruncate);
+        }
+        return ullCount;
+    }
+
+    //! Writer connection
+    sqlite3 *m_pDB;
+};
+
+// Tests
+
+TEST_F(CDbCheckpointerTest, Test_truncate_on_wal_size_limit)
+{
+    CDbCheckpointer checkpointer(60000, 1);
+    ASSERT_TRUE(checkpointer.OpenConnection(TEST_DB_FILE));
+    sqlite3_wal_hook(m_pDB, test_wal_hook, &checkpointer);
+    checkpointer.Start();
+
+    // commit is expected to exceed the limit and get the log truncated
+    EXPECT_EQ(SQLITE_OK, Exec("INSERT INTO T VALUES ('a');"));
+    EXPECT_EQ(1u, WaitForCheckpoint(checkpointer, true));
+    EXPECT_EQ(0, get_file_size(TEST_DB_FILE + "-wal"));
+    EXPECT_EQ(0u, GetCount(checkpointer, false));
+
+    sqlite3_wal_hook(m_pDB, NULL, NULL);
+}
+
+TEST_F(CDbCheckpointerTest, Test_passive_checkpoint_when_idle)
+{
+    CDbCheckpointer checkpointer(50, 0);
+    ASSERT_TRUE(checkpointer.OpenConnection(TEST_DB_FILE));
+    sqlite3_wal_hook(m_pDB, test_wal_hook, &checkpointer);
+    checkpointer.Start();
+
+    // commits are expected to be checkpointed once no commit follows
+    EXPECT_EQ(SQLITE_OK, Exec("INSERT INTO T VALUES ('a');"));
+    EXPECT_EQ(SQLITE_OK, Exec("INSERT INTO T VALUES ('b');"));
+    EXPECT_EQ(1u, WaitForCheckpoint(checkpointer, false));
+    EXPECT_GT(get_file_size(TEST_DB_FILE + "-wal"), 0);
+
+    // log is expected to be clean, hence no further checkpoint
+    usleep(200000);
+    EXPECT_EQ(1u, GetCount(checkpointer, false));
+    EXPECT_EQ(0u, GetCount(checkpointer, true));
+
+    sqlite3_wal_hook(m_pDB, NULL, NULL);
+}
+
+TEST_F(CDbCheckpointerTest, Test_closed_connection)
+{
+    CDbCheckpointer checkpointer(50, 1);
+    EXPECT_FALSE(checkpointer.OpenConnection("/tmp/ic_not_existing/x.db"));
+
+    // commits are expected to be ignored while the connection is closed
+    checkpointer.Start();
+    checkpointer.NotifyCommit(10);
+    checkpointer.CloseConnection();
+    usleep(200000);
+    EXPECT_EQ(0u, GetCount(checkpointer, true));
+    EXPECT_EQ(0u, GetCount(checkpointer, false));
+}
+} /* namespace ic_core */
@@ -19,6 +19,9 @@
 #include "gtest/gtest.h"
 #include "CIgniteConfig.h"
 #include "CIgniteLog.h"
+#include "db/CServiceSettingsStore.h"
+#include <atomic>
+#include <thread>
 
 #ifdef PREFIX
 #undef PREFIX
@@ -303,6 +306,154 @@ TEST_F(CIgniteConfigTest, Test_GetJsonValue_forInValidCase)
     EXPECT_EQ(rjsonNullValue, pObj->GetJsonValue(strIncorrectKey));
 }
 
+TEST_F(CIgniteConfigTest, Test_ConfigHandle_RebindOnUpdate)
+{
+    CIgniteConfig *pObj = CIgniteConfig::GetInstance();
+    CConfigHandle<int> intHandle("TestHandle.count", 3);
+    CConfigHandle<bool> boolHandle("TestHandle.enabled", false);
+    CConfigHandle<std::string> strHandle("TestHandle.name", "none");
+
+    // Expect default values before handles are bound
+    EXPECT_EQ(3, intHandle.Get());
+    EXPECT_EQ("none", strHandle.Get());
+
+    pObj->BindHandle(&intHandle);
+    pObj->BindHandle(&boolHandle);
+    pObj->BindHandle(&strHandle);
+    EXPECT_EQ(3, intHandle.Get());
+    EXPECT_FALSE(boolHandle.Get());
+    std::shared_ptr<const std::string> pOldName = strHandle.GetSnapshot();
+
+    std::string strSource = 
+                pObj->GetConfigUpdateSourceInString(eCLOUD_CONFIG_UPDATE);
+    std::map<std::string, ic_utils::Json::Value> mapUpdate;
+    mapUpdate["TestHandle.count"] = 7;
+    mapUpdate["TestHandle.enabled"] = true;
+    mapUpdate["TestHandle.name"] = "updated";
+    for (const auto &rUpdate : mapUpdate)
+    {
+        ic_utils::Json::Value jsonParameter;
+        jsonParameter[rUpdate.first] = rUpdate.second;
+        EXPECT_TRUE(CServiceSettingsStore::GetInstance()->
+                    StoreSettings(strSource, rUpdate.first, jsonParameter));
+    }
+
+    // Expect handles to be rebound when stored config is reloaded
+    pObj->ReloadConfigFromDB();
+    EXPECT_EQ(7, intHandle.Get());
+    EXPECT_TRUE(boolHandle.Get());
+    EXPECT_EQ("updated", strHandle.Get());
+
+    // Expect a held snapshot of an earlier value to stay valid
+    EXPECT_EQ("none", *pOldName);
+    EXPECT_EQ("updated", *strHandle.GetSnapshot());
+
+    // Expect an unbound handle to no longer follow updates
+    pObj->UnbindHandle(&boolHandle);
+    pObj->UpdateConfig(mapUpdate, eCLOUD_CONFIG_UPDATE, 0);
+    EXPECT_EQ(7, intHandle.Get());
+    pObj->NotifyConfigUpdateToSubscribers();
+    EXPECT_EQ(3, intHandle.Get());
+    EXPECT_EQ("none", strHandle.Get());
+    EXPECT_TRUE(boolHandle.Get());
+}
+
+TEST_F(CIgniteConfigTest, Test_ConfigHandle_DestroyWhileRebinding)
+{
+    CIgniteConfig *pObj = CIgniteConfig::GetInstance();
+    std::atomic<bool> bStop(false);
+
+    // Keep rebinding the handles while they are bound and destroyed
+    std::thread rebinder([pObj, &bStop]()
+    {
+        while (!bStop.load())
+        {
+            pObj->NotifyConfigUpdateToSubscribers();
+        }
+    });
+
+    for (int i = 0; i < 2000; i++)
+    {
+        CConfigHandle<int> *pIntHandle = 
+                                new CConfigHandle<int>("TestHandle.count", i);
+        CConfigHandle<std::string> *pStrHandle = 
+                    new CConfigHandle<std::string>("TestHandle.name", "none");
+        pObj->BindHandle(pIntHandle);
+        pObj->BindHandle(pStrHandle);
+        EXPECT_EQ(i, pIntHandle->Get());
+        EXPECT_EQ("none", pStrHandle->Get());
+
+        // Expect a bound handle to be unbound before its value is destroyed
+        delete pStrHandle;
+        delete pIntHandle;
+    }
+
+    bStop.store(true);
+    rebinder.join();
+}
+
+TEST_F(CIgniteConfigTest, Test_GetSnapshot_StableAcrossReload)
+{
+    CIgniteConfig *pObj = CIgniteConfig::GetInstance();
+    std::shared_ptr<const CConfigSnapshot> pOld = pObj->GetSnapshot();
+    ASSERT_NE(nullptr, pOld);
+    EXPECT_EQ(pOld->GetVersion(), pObj->GetSnapshotVersion());
+    EXPECT_EQ(5, pOld->GetInt("TestSnapshot.count", 5));
+
+    std::string strSource = 
+                pObj->GetConfigUpdateSourceInString(eCLOUD_CONFIG_UPDATE);
+    ic_utils::Json::Value jsonParameter;
+    jsonParameter["TestSnapshot.count"] = 9;
+    EXPECT_TRUE(CServiceSettingsStore::GetInstance()->
+                StoreSettings(strSource, "TestSnapshot.count", jsonParameter));
+    pObj->ReloadConfigFromDB();
+
+    // Expect a held snapshot to keep its values, a new one to see the reload
+    std::shared_ptr<const CConfigSnapshot> pNew = pObj->GetSnapshot();
+    EXPECT_LT(pOld->GetVersion(), pNew->GetVersion());
+    EXPECT_EQ(pNew->GetVersion(), pObj->GetSnapshotVersion());
+    EXPECT_EQ(5, pOld->GetInt("TestSnapshot.count", 5));
+    EXPECT_EQ(9, pNew->GetInt("TestSnapshot.count", 5));
+    EXPECT_EQ(9, pObj->GetInt("TestSnapshot.count", 5));
+    EXPECT_EQ("9", pNew->GetAsString("TestSnapshot.count"));
+
+    // Expect a lookup of a missing key not to add it to the snapshot
+    EXPECT_TRUE(pNew->GetJsonValue("TestSnapshot.missing").isNull());
+    EXPECT_FALSE(pNew->GetJsonValue("TestSnapshot").isMember("missing"));
+
+    std::map<std::string, ic_utils::Json::Value> mapUpdate;
+    pObj->UpdateConfig(mapUpdate, eCLOUD_CONFIG_UPDATE, 0);
+    EXPECT_EQ(5, pObj->GetSnapshot()->GetInt("TestSnapshot.count", 5));
+    EXPECT_EQ(9, pNew->GetInt("TestSnapshot.count", 5));
+}
+
+TEST_F(CIgniteConfigTest, Test_ModuleLogLevels_AppliedOnUpdate)
+{
+    CIgniteConfig *pObj = CIgniteConfig::GetInstance();
+    std::string strSource = 
+                pObj->GetConfigUpdateSourceInString(eCLOUD_CONFIG_UPDATE);
+    ic_utils::Json::Value jsonParameter;
+    jsonParameter["FileLogger.moduleLogLevels.Network"] = 
+                                                    ic_utils::eHCP_LOG_ERROR;
+    EXPECT_TRUE(CServiceSettingsStore::GetInstance()->
+                StoreSettings(strSource, "FileLogger.moduleLogLevels.Network",
+                              jsonParameter));
+
+    // Expect a configured module to be restricted, others not
+    pObj->ReloadConfigFromDB();
+    EXPECT_EQ(ic_utils::eHCP_LOG_ERROR, 
+              ic_utils::CIgniteLog::GetModuleLevel(ic_utils::eLOG_MODULE_NETWORK));
+    EXPECT_EQ(ic_utils::eHCP_LOG_TRACE, 
+              ic_utils::CIgniteLog::GetModuleLevel(ic_utils::eLOG_MODULE_CORE));
+
+    // Expect the restriction to be lifted once the setting is removed
+    std::map<std::string, ic_utils::Json::Value> mapUpdate;
+    pObj->UpdateConfig(mapUpdate, eCLOUD_CONFIG_UPDATE, 0);
+    pObj->NotifyConfigUpdateToSubscribers();
+    EXPECT_EQ(ic_utils::eHCP_LOG_TRACE, 
+              ic_utils::CIgniteLog::GetModuleLevel(ic_utils::eLOG_MODULE_NETWORK));
+}
+
 /* The functions updateConfig, canOverrideMember, copyDBConfig and 
  * storeSettingsToDb are not covered in UT as they can modify the 
  * actual config file
@@ -17,8 +17,11 @@
  ******************************************************************************/
 
 #include <string.h>
+#include <thread>
 #include "gtest/gtest.h"
 #include "crypto/CIgniteDataSecurity.h"
+#include "core/CKeyGenerator.h"
+#include "core/CAesSeed.h"
 
 namespace ic_core
 {
@@ -217,4 +220,98 @@ TEST_F(CIgniteDataSecurityTest, Test_Encrypt_WithoutTagAppend)
    EXPECT_NE("", strEncrypted);
 }
 
+TEST_F(CIgniteDataSecurityTest, Test_ReusedContext_SameResult)
+{
+   CIgniteDataSecurity dataSecurity("VIN+SLNO+RANDOM", "VIN+SLNO+RANDOM");
+   std::string strFirst = "first text to be encrypted";
+   std::string strSecond = "second text, of another length";
+
+   // Encrypt and decrypt repeatedly with the same instance
+   std::string strEncFirst = dataSecurity.Encrypt(strFirst);
+   std::string strEncSecond = dataSecurity.Encrypt(strSecond);
+   EXPECT_EQ(strSecond, dataSecurity.Decrypt(strEncSecond));
+   EXPECT_EQ(strFirst, dataSecurity.Decrypt(strEncFirst));
+
+   // Expect the reused contexts to give the result of fresh ones
+   CIgniteDataSecurity freshSecurity("VIN+SLNO+RANDOM", "VIN+SLNO+RANDOM");
+   EXPECT_EQ(freshSecurity.Encrypt(strSecond), strEncSecond);
+   EXPECT_EQ(strEncFirst, dataSecurity.Encrypt(strFirst));
+}
+
+TEST_F(CIgniteDataSecurityTest, Test_EncryptEvent_DecryptEvent)
+{
+   std::string strEvent = "{\"EventID\":\"Location\",\"Timestamp\":1}";
+
+   std::string strEncrypted = CIgniteDataSecurity::EncryptEvent(strEvent);
+   EXPECT_NE("", strEncrypted);
+   EXPECT_NE(strEvent, strEncrypted);
+   EXPECT_EQ(strEvent, CIgniteDataSecurity::DecryptEvent(strEncrypted));
+
+   // Expect another thread, having its own contexts, to decrypt it as well
+   std::string strDecrypted;
+   std::thread decryptThread([&strDecrypted, &strEncrypted]()
+   {
+      strDecrypted = CIgniteDataSecurity::DecryptEvent(strEncrypted);
+   });
+   decryptThread.join();
+   EXPECT_EQ(strEvent, strDecrypted);
+
+   // Expect the key derived again after invalidation to be the same
+   CIgniteDataSecurity::InvalidateEventKey();
+   EXPECT_EQ(strEncrypted, CIgniteDataSecurity::EncryptEvent(strEvent));
+   EXPECT_EQ("", CIgniteDataSecurity::EncryptEvent(""));
+}
+
+TEST_F(CIgniteDataSecurityTest, Test_EncryptEvents_DecryptEvents)
+{
+   std::vector<std::string> vecEvents;
+   for (int nIdx = 0; nIdx < 1000; nIdx++)
+   {
+      vecEvents.push_back("{\"EventID\":\"Location\",\"Timestamp\":" +
+                          std::to_string(nIdx) + "}");
+   }
+   vecEvents.push_back("");
+   const std::vector<std::string> vecPlain = vecEvents;
+
+   // Expect the group to be split across workers and match per event results
+   CIgniteDataSecurity::EncryptEvents(vecEvents, 4);
+   ASSERT_EQ(vecPlain.size(), vecEvents.size());
+   for (size_t nIdx = 0; nIdx < vecPlain.size(); nIdx++)
+   {
+      EXPECT_EQ(CIgniteDataSecurity::EncryptEvent(vecPlain[nIdx]), vecEvents[nIdx]);
+   }
+
+   CIgniteDataSecurity::DecryptEvents(vecEvents, 4);
+   EXPECT_EQ(vecPlain, vecEvents);
+
+   // Expect the same result on the calling thread only
+   CIgniteDataSecurity::EncryptEvents(vecEvents);
+   CIgniteDataSecurity::DecryptEvents(vecEvents);
+   EXPECT_EQ(vecPlain, vecEvents);
+
+   std::vector<std::string> vecEmpty;
+   CIgniteDataSecurity::EncryptEvents(vecEmpty, 4);
+   EXPECT_TRUE(vecEmpty.empty());
+}
+
+TEST_F(CIgniteDataSecurityTest, Test_EncryptEvent_BinaryFormat)
+{
+   std::string strEvent = "{\"EventID\":\"Location\",\"Timestamp\":1}";
+
+   std::string strEncrypted = CIgniteDataSecurity::EncryptEvent(strEvent);
+   EXPECT_TRUE(CIgniteDataSecurity::IsBinaryEvent(strEncrypted));
+
+   // Expect base64 text of earlier versions to remain readable
+   CIgniteDataSecurity security(CKeyGenerator::GetActivationKey(),
+                                CAesSeed::GetInstance()->GetIvRandom());
+   std::string strText = security.Encrypt(strEvent);
+   EXPECT_FALSE(CIgniteDataSecurity::IsBinaryEvent(strText));
+   EXPECT_EQ(strEvent, CIgniteDataSecurity::DecryptEvent(strText));
+
+   // Expect the converted text to be the binary payload of the same event
+   EXPECT_EQ(strEncrypted, CIgniteDataSecurity::EventTextToBinary(strText));
+   EXPECT_EQ("", CIgniteDataSecurity::EventTextToBinary("{not base64}"));
+   EXPECT_EQ("", CIgniteDataSecurity::EventTextToBinary(""));
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "CMessageQueue.h"
+#include "CIgniteLog.h"
+
+//! Macro for CMessageQueue test class
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "test_CMessageQueue"
+
+namespace ic_core
+{
+namespace
+{
+//! Queue name used by the tests
+const std::string TEST_QUEUE_NAME = "/tmp/ic_test_message_queue";
+
+/**
+ * Receiver collecting the messages handed over by the queue
+ */
+class CTestReceiver : public IMessageReceiver
+{
+public:
+    /**
+     * Overriding Method of IMessageReceiver class
+     * @see IMessageReceiver::Handle()
+     */
+    bool Handle(const ic_event::CIgniteMessage &rMsg) override
+    {
+        m_vecMessages.push_back(rMsg.GetMessageAsString());
+        return true;
+    }
+
+    //! Messages received
+    std::vector<std::string> m_vecMessages;
+};
+
+/**
+ * Method to get the serialized event message of the given payload
+ * @param[in] rstrPayload message payload
+ * @return serialized message
+ */
+std::string GetSerializedEvent(const std::string &rstrPayload)
+{
+    ic_event::CIgniteMessage msg(ic_event::CMessageTypes::eEVENT, -1);
+    msg.SetMessage(rstrPayload);
+    std::string strSerialized;
+    msg.GetSerialized(strSerialized);
+    return strSerialized;
+}
+}
+
+/**
+ * Class CMessageQueueTest defines a test feature for CMessageQueue class
+ */
+class CMessageQueueTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CMessageQueueTest() : m_queue(TEST_QUEUE_NAME)
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CMessageQueueTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * Overriding Method of testing::Test class
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        socketpair(AF_UNIX, SOCK_STREAM, 0, m_nSockets);
+        m_queue.Subscribe(ic_event::CMessageTypes::eEVENT, &m_receiver);
+    }
+
+    /**
+     * Overriding Method of testing::Test class
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        m_queue.Unsubscribe(ic_event::CMessageTypes::eEVENT, &m_receiver);
+        close(m_nSockets[1]);
+        if (m_queue.m_mapConnections.count(m_nSockets[0]))
+        {
+            m_queue.CloseConnection(m_nSockets[0]);
+        }
+    }
+
+    /**
+     * Method to read the data available on the queue end of the socket pair
+     * @param void
+     * @return result of CMessageQueue::ReadFromConnection
+     */
+    bool Read()
+    {
+        bool bMoreData = false;
+        return m_queue.ReadFromConnection(m_nSockets[0], bMoreData);
+    }
+
+    /**
+     * Method to add the given socket to the clients of the queue
+     * @param[in] nSd socket descriptor
+     * @return result of CMessageQueue::AddConnection
+     */
+    bool AddConnection(int nSd)
+    {
+        return m_queue.AddConnection(nSd);
+    }
+
+    /**
+     * Method to set the maximum clients of the queue
+     * @param[in] unMaxClients maximum clients
+     * @return void
+     */
+    void SetMaxClients(unsigned int unMaxClients)
+    {
+        m_queue.m_unMaxClients = unMaxClients;
+    }
+
+    //! Queue under test
+    CMessageQueue m_queue;
+
+    //! Receiver subscribed for the events
+    CTestReceiver m_receiver;
+
+    //! Socket pair; [0] is handled by the queue, [1] is the client
+    int m_nSockets[2];
+};
+
+TEST_F(CMessageQueueTest, Test_ReadFromConnection_PartialMessages)
+{
+    ASSERT_TRUE(AddConnection(m_nSockets[0]));
+
+    std::string strStream = GetSerializedEvent("first") +
+                            GetSerializedEvent("second");
+
+    // Send the stream in two pieces, splitting the second message
+    size_t nSplit = strStream.size() - 3;
+    write(m_nSockets[1], strStream.data(), nSplit);
+    EXPECT_TRUE(Read());
+    ASSERT_EQ(1u, m_receiver.m_vecMessages.size());
+    EXPECT_EQ("first", m_receiver.m_vecMessages[0]);
+
+    // Expect the second message once its remaining bytes arrive
+    write(m_nSockets[1], strStream.data() + nSplit, strStream.size() - nSplit);
+    EXPECT_TRUE(Read());
+    ASSERT_EQ(2u, m_receiver.m_vecMessages.size());
+    EXPECT_EQ("second", m_receiver.m_vecMessages[1]);
+}
+
+TEST_F(CMessageQueueTest, Test_ReadFromConnection_NoDataDoesNotBlock)
+{
+    ASSERT_TRUE(AddConnection(m_nSockets[0]));
+
+    // Expect the read to return without data instead of blocking
+    EXPECT_TRUE(Read());
+    EXPECT_TRUE(m_receiver.m_vecMessages.empty());
+}
+
+TEST_F(CMessageQueueTest, Test_ReadFromConnection_InvalidStream)
+{
+    ASSERT_TRUE(AddConnection(m_nSockets[0]));
+
+    std::string strGarbage(ic_event::CIgniteMessage::MSG_HEADER_SIZE, 'x');
+    write(m_nSockets[1], strGarbage.data(), strGarbage.size());
+
+    // Expect the connection to be reported for closing
+    EXPECT_FALSE(Read());
+}
+
+TEST_F(CMessageQueueTest, Test_ReadFromConnection_PeerClosed)
+{
+    ASSERT_TRUE(AddConnection(m_nSockets[0]));
+    shutdown(m_nSockets[1], SHUT_WR);
+
+    // Expect the connection to be reported for closing
+    EXPECT_FALSE(Read());
+}
+
+TEST_F(CMessageQueueTest, Test_AddConnection_MaxClients)
+{
+    SetMaxClients(1);
+    EXPECT_TRUE(AddConnection(m_nSockets[0]));
+
+    // Expect the connection beyond the configured limit to be rejected
+    int nOther[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, nOther);
+    EXPECT_FALSE(AddConnection(nOther[0]));
+    close(nOther[0]);
+    close(nOther[1]);
+}
+} /* namespace ic_core */
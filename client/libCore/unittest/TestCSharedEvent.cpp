@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "dam/CSharedEvent.h"
+#include "CIgniteLog.h"
+
+//! Macro for CSharedEvent test class
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "test_CSharedEvent"
+
+namespace ic_core
+{
+/**
+ * Class CSharedEventTest defines a test feature for CSharedEvent class
+ */
+class CSharedEventTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CSharedEventTest()
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */ 
+    ~CSharedEventTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * Overriding Method of testing::Test class
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    { 
+        // Do nothing
+    }
+
+    /**
+     * Overriding Method of testing::Test class
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        // Do nothing
+    }
+};
+
+TEST_F(CSharedEventTest, Test_Create_NullEvent)
+{
+    // Expect no snapshot for a NULL event
+    EXPECT_FALSE(CSharedEvent::Create((CEventWrapper *)NULL));
+}
+
+TEST_F(CSharedEventTest, Test_Create_FromEvent)
+{
+    CEventWrapper *pEvent = new CEventWrapper();
+    pEvent->SetEventId("Speed");
+    pEvent->SetTimestamp(1700000000000);
+    pEvent->SetTimezone(330);
+    pEvent->AddField("value", 60);
+
+    CSharedEventPtr pShared = CSharedEvent::Create(pEvent);
+
+    // Expect the snapshot to capture the fields of the event
+    ASSERT_TRUE(pShared != NULL);
+    EXPECT_EQ("Speed", pShared->GetEventId());
+    EXPECT_EQ(1700000000000, pShared->GetTimestamp());
+    EXPECT_EQ(330, pShared->GetTimezone());
+    EXPECT_EQ(60, pShared->GetData()["value"].asInt());
+    EXPECT_TRUE(pShared->GetAttachments().empty());
+
+    // Expect the serialized form to carry the same event
+    CEventWrapper parsed;
+    parsed.JsonToEvent(pShared->GetSerialized());
+    EXPECT_EQ("Speed", parsed.GetEventId());
+    EXPECT_EQ(60, parsed.GetInt("value"));
+}
+
+TEST_F(CSharedEventTest, Test_Create_FromSerialized)
+{
+    std::string strSerialized = "{\"EventID\":\"Location\",\"Version\":\"1.0\","
+        "\"Timestamp\":1700000000000,\"Timezone\":60,"
+        "\"Data\":{\"latitude\":12.5,\"topic\":\"test\"}}";
+
+    CSharedEventPtr pShared = CSharedEvent::Create(strSerialized);
+
+    // Expect the given string to be retained as the serialized form
+    EXPECT_EQ(strSerialized, pShared->GetSerialized());
+    EXPECT_EQ("Location", pShared->GetEventId());
+    EXPECT_EQ(60, pShared->GetTimezone());
+    EXPECT_TRUE(pShared->GetData().isMember("topic"));
+}
+
+TEST_F(CSharedEventTest, Test_GetEventCopy_DoesNotAlterSnapshot)
+{
+    CEventWrapper *pEvent = new CEventWrapper();
+    pEvent->SetEventId("Odometer");
+    pEvent->AddField("value", 100);
+
+    CSharedEventPtr pShared = CSharedEvent::Create(pEvent);
+    std::string strSerialized = pShared->GetSerialized();
+
+    // Modify the copy of the event
+    CEventWrapper copy = pShared->GetEventCopy();
+    copy.AddField("value", 200);
+    copy.AddField("extra", "field");
+
+    // Expect the snapshot to remain unchanged
+    EXPECT_EQ(200, copy.GetInt("value"));
+    EXPECT_EQ(100, pShared->GetData()["value"].asInt());
+    EXPECT_FALSE(pShared->GetData().isMember("extra"));
+    EXPECT_EQ(strSerialized, pShared->GetSerialized());
+}
+
+} // namespace ic_core
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+*******************************************************************************
+* \file: CEventCodec.h
+*
+* \brief: This class encodes events into a compact, versioned binary TLV
+          format and decodes them back, as an alternative to JSON text
+          on the event message queue.
+*******************************************************************************
+*/
+
+#ifndef CEVENT_CODEC_H
+#define CEVENT_CODEC_H
+
+#include <string>
+#include "jsoncpp/json.h"
+
+namespace ic_event
+{
+/**
+ * EventCodec class converts the JSON representation of an event (as built by
+ * CIgniteEvent::EventToJson) to the binary wire format and vice versa.
+ *
+ * Wire format (version 1):
+ *   magic(1) version(1) stringCount(varint) {len(varint) bytes}...
+ *   {tag(1) len(varint) value}...
+ * Event ids, versions and JSON keys are interned in the string table,
+ * timestamp and timezone are fixed-width and data fields keep their types.
+ */
+class CEventCodec
+{
+public:
+    //! First byte of every encoded event; can never start a JSON document
+    static const unsigned char CODEC_MAGIC = 0xB1;
+
+    //! Current version of the binary event format
+    static const unsigned char CODEC_VERSION = 1;
+
+    /**
+     * Method to encode the given event JSON object into the binary format
+     * @param[in] rjsonEvent Event as JSON object
+     * @param[out] rstrEncoded Encoded event
+     * @return true if the event is encoded successfully else false
+     */
+    static bool Encode(const ic_utils::Json::Value &rjsonEvent,
+                       std::string &rstrEncoded);
+
+    /**
+     * Method to decode the given binary event into JSON object
+     * @param[in] puchData Encoded event
+     * @param[in] unLen Length of the encoded event
+     * @param[out] rjsonEvent Decoded event as JSON object
+     * @return true if the event is decoded successfully else false
+     */
+    static bool Decode(const unsigned char *puchData, const unsigned int unLen,
+                       ic_utils::Json::Value &rjsonEvent);
+
+    /**
+     * Method to decode the given binary event into JSON object
+     * @param[in] rstrEncoded Encoded event
+     * @param[out] rjsonEvent Decoded event as JSON object
+     * @return true if the event is decoded successfully else false
+     */
+    static bool Decode(const std::string &rstrEncoded,
+                       ic_utils::Json::Value &rjsonEvent);
+
+    /**
+     * Method to check if the given payload is a binary encoded event
+     * @param[in] rstrPayload Event payload
+     * @return true if the payload is binary encoded else false
+     */
+    static bool IsEncoded(const std::string &rstrPayload);
+
+    /**
+     * Method to convert the given payload to JSON string; payloads which are
+     * not binary encoded are returned as is. Meant for logging purposes.
+     * @param[in] rstrPayload Event payload
+     * @return Event in JSON string format
+     */
+    static std::string ToJsonString(const std::string &rstrPayload);
+
+    /**
+     * Method to describe the given payload for logging without decoding it;
+     * binary encoded payloads are described by their size, others are
+     * returned as is
+     * @param[in] rstrPayload Event payload
+     * @return Event description
+     */
+    static std::string ToLogString(const std::string &rstrPayload);
+};
+
+} /* namespace ic_event */
+
+#endif /* CEVENT_CODEC_H */
@@ -383,6 +383,13 @@ public:
      */
     virtual void EventToJson(std::string&);
 
+    /**
+     * Method to convert the event to the binary wire format (see CEventCodec)
+     * @param[out] rstrEncoded The event data encoded in binary format
+     * @return void
+     */
+    virtual void EventToBinary(std::string &rstrEncoded);
+
     /**
      * Method to extract the filename from given file path
      * @param[in] string File path
@@ -416,6 +423,30 @@ public:
      */
     void JsonToEvent(const std::string& rstrJsonEvent);
 
+    /**
+     * Method to decode the given event which is in binary wire format, and
+     * load it into the event
+     * @param[in] rstrEncoded Event encoded in binary format
+     * @return true if the event is decoded successfully else false
+     */
+    bool BinaryToEvent(const std::string &rstrEncoded);
+
+    /**
+     * Static method to select the wire format used by Send; JSON is used
+     * unless binary format is enabled. The receiving client must support
+     * the binary format.
+     * @param[in] bEnable True to send events in binary format
+     * @return void
+     */
+    static void SetBinaryWireFormat(const bool bEnable);
+
+    /**
+     * Static method to check if events are sent in binary format
+     * @param void
+     * @return True if binary format is enabled else false
+     */
+    static bool IsBinaryWireFormat();
+
     /**
      * flag to track the bench mode 
      */
@@ -487,6 +518,23 @@ protected:
     void ProcessAttachment();
 
 private:
+    /**
+     * Method to build the json object representation of the event
+     * @param[out] rjsonRoot The event as json object
+     * @return void
+     */
+    void EventToJsonValue(ic_utils::Json::Value &rjsonRoot);
+
+    /**
+     * Method to load the event from its json object representation
+     * @param[in] rjsonRoot The event as json object
+     * @return void
+     */
+    void JsonValueToEvent(const ic_utils::Json::Value &rjsonRoot);
+
+    //! Flag to track if events are sent in binary wire format
+    static bool m_bBinaryWireFormat;
+
     /**
      * Method to read the file name and extension from given file path
      * @param[in] rstrPath file path
@@ -30,8 +30,10 @@
 
 #include <queue>
 #include <string>
+#include <vector>
 #include "CIgniteEvent.h"
 #include "CConcurrentQueue.h"
+#include "CIgniteMutex.h"
 
 namespace ic_event 
 {
@@ -48,9 +50,17 @@ typedef enum
 /**
  * EventSender class creats events for different sockets and sents events to queue
  */
+class CIgniteMessage;
+
 class CIgniteEventSender : public ic_event::IEventSender 
 {
 public:
+    //! Default size threshold, in bytes, at which a batch is flushed
+    static const unsigned int DEFAULT_BATCH_MAX_BYTES = 16384;
+
+    //! Default time threshold, in milliseconds, at which a batch is flushed
+    static const unsigned int DEFAULT_BATCH_MAX_DELAY_MS = 100;
+
     /**
      * EventSender default constructor
      */
@@ -81,6 +91,39 @@ public:
      */
     int Send(const std::string &rstrSerializedEvent);
 
+    /**
+     * Method to enable the batching mode. Events passed to Send are then
+     * buffered and written together, without waiting for each write, when
+     * the buffered size or the age of the oldest buffered event reaches the
+     * given thresholds. Events which could not be written are dropped.
+     * @param[in] unMaxBatchBytes Size threshold of a batch in bytes
+     * @param[in] unMaxDelayMs Time threshold of a batch in milliseconds
+     * @return void
+     */
+    void EnableBatching(const unsigned int unMaxBatchBytes = DEFAULT_BATCH_MAX_BYTES,
+                        const unsigned int unMaxDelayMs = DEFAULT_BATCH_MAX_DELAY_MS);
+
+    /**
+     * Method to disable the batching mode; buffered events are flushed
+     * @param void
+     * @return void
+     */
+    void DisableBatching();
+
+    /**
+     * Method to check if batching mode is enabled
+     * @param void
+     * @return True if batching mode is enabled else false
+     */
+    bool IsBatchingEnabled();
+
+    /**
+     * Method to write the buffered events of batching mode immediately
+     * @param void
+     * @return 0 if buffered events are sent successfully else -1
+     */
+    int Flush();
+
     /**
      * Method to open the connection based on the type of socket used
      * @param void
@@ -148,6 +191,103 @@ public:
     #endif
 
 private:
+    //! Thread which flushes the batches on reaching the time threshold
+    class CBatchFlusher;
+
+    /**
+     * Method to send the event without batching
+     * @param[in] rstrSerializedEvent Event getting added to queue
+     * @return 0 if event is sent successfully else -1
+     */
+    int SendUnbatched(const std::string &rstrSerializedEvent);
+
+    /**
+     * Method executed by the batch flushing thread; flushes the batch when
+     * the time or size threshold of batching mode is reached
+     * @param void
+     * @return void
+     */
+    void RunBatchFlusher();
+
+    /**
+     * Method to stop the batch flushing thread
+     * @param void
+     * @return void
+     */
+    void StopBatchFlusher();
+
+    /**
+     * Method to send the given event as a message on the open connection;
+     * binary encoded events are flagged as such in the message header
+     * @param[in] rstrSerializedEvent Serialized event (JSON or binary)
+     * @return 0 if the message is sent successfully else -1
+     */
+    int SendEventMessage(const std::string &rstrSerializedEvent);
+
+    /**
+     * Method to prepare the message for the given event
+     * @param[in] rstrSerializedEvent Serialized event (JSON or binary)
+     * @param[out] rMsg Message to be prepared
+     * @return 0 if the message is prepared successfully else -1
+     */
+    int PrepareEventMessage(const std::string &rstrSerializedEvent, CIgniteMessage &rMsg);
+
+    /**
+     * Method to add the given event to the batch of batching mode
+     * @param[in] rstrSerializedEvent Serialized event (JSON or binary)
+     * @return 0 if the event is added to the batch else -1
+     */
+    int AddEventToBatch(const std::string &rstrSerializedEvent);
+
+    /**
+     * Method to write the buffered events of batching mode; the caller holds
+     * the flush mutex. Events which cannot be written after one reconnect
+     * are reported individually.
+     * @param void
+     * @return 0 if buffered events are sent successfully else -1
+     */
+    int FlushLocked();
+
+    /**
+     * Method to report each of the given events as not sent
+     * @param[in] rvecEvents Serialized events which are dropped
+     * @return void
+     */
+    void ReportLostEvents(const std::vector<std::string> &rvecEvents);
+
+    //! Variable to store the state of batching mode
+    bool m_bBatching = false;
+
+    //! Variable to store the request to stop the batch flushing thread
+    bool m_bStopBatchFlusher = false;
+
+    //! Variable to store the batch flushing thread
+    CBatchFlusher *m_pBatchFlusher = NULL;
+
+    //! Variable to store the size threshold of a batch
+    unsigned int m_unMaxBatchBytes = DEFAULT_BATCH_MAX_BYTES;
+
+    //! Variable to store the time threshold of a batch
+    unsigned int m_unMaxDelayMs = DEFAULT_BATCH_MAX_DELAY_MS;
+
+    //! Variable to store the serialized events of the current batch
+    std::vector<std::string> m_vecBatch;
+
+    //! Variable to store the size of the current batch in bytes
+    unsigned long m_ulBatchBytes = 0;
+
+    //! Variable to store the time at which the current batch was started
+    unsigned long long m_ullBatchStartTime = 0;
+
+    //! Mutex to guard the current batch
+    ic_utils::CIgniteMutex m_batchMutex;
+
+    //! Mutex to keep the events in order while they are being written, batched or not
+    ic_utils::CIgniteMutex m_flushMutex;
+
+    //! Condition to wake up the batch flushing thread
+    ic_utils::CThreadCondition m_batchCondition;
+
     //! Variable to store the Message queue ID
     int m_nMsqid;
 
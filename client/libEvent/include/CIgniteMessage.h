@@ -39,6 +39,7 @@
 #endif
 
 #include <string>
+#include <vector>
 #include <cstdio>
 
 namespace ic_event 
@@ -47,6 +48,16 @@ namespace ic_event
 //! Defining int as sockid 
 typedef int sockid;
 
+/**
+ * Enum of payload formats, carried in the message header flags
+ */
+typedef enum
+{
+    ePAYLOAD_FORMAT_JSON = 0, ///< JSON text (default)
+    ePAYLOAD_FORMAT_BINARY_V1 = 1, ///< Binary TLV event, see CEventCodec
+    ePAYLOAD_FORMAT_MAX = ePAYLOAD_FORMAT_BINARY_V1 ///< Latest known format
+} PayloadFormat;
+
 /**
  * Message class is used to pack and unpack messages to Client in proper format 
  */
@@ -122,6 +133,25 @@ public:
      */
     int Send(std::string& rstrReply = m_strNoReplay);
 
+    /**
+     * Method to get the message in the serialized form written to the socket,
+     * to be sent later along with other messages using SendSerialized
+     * @param[out] rstrSerialized Serialized message
+     * @return 0 if the message is serialized successfully else -1
+     */
+    int GetSerialized(std::string& rstrSerialized) const;
+
+    /**
+     * Static method to send the given serialized messages using vectored
+     * writes; no reply is awaited for the messages
+     * @param[in] nTo SocketID to which the messages are to be sent
+     * @param[in] rvecSerialized Serialized messages, sent in the given order
+     * @param[out] pnSent Number of messages written completely, if not NULL
+     * @return 0 if all the messages are sent successfully else -1
+     */
+    static int SendSerialized(const sockid nTo, const std::vector<std::string>& rvecSerialized,
+                              size_t *pnSent = NULL);
+
     /**
      * Method to receive reply for a particular message
      * @param[in] rstrReplyMsg Message to which reply is expected
@@ -166,6 +196,20 @@ public:
      */
     const unsigned int GetType() const;
 
+    /**
+     * Method to set the format of the message payload
+     * @param[in] unFormat Payload format, one of PayloadFormat
+     * @return void
+     */
+    void SetPayloadFormat(const unsigned int unFormat);
+
+    /**
+     * Method to get the format of the message payload
+     * @param void
+     * @return Payload format, one of PayloadFormat
+     */
+    const unsigned int GetPayloadFormat() const;
+
     /**
      * Method to get a required reply for the message
      * @param void
@@ -224,6 +268,9 @@ private:
     //! Member variable to store the reply request value
     bool m_bReplyReq;
 
+    //! Member variable to store the payload format
+    unsigned int m_unPayloadFormat;
+
     //! Member variable to store the reply destination
     std::string m_strRplyto;
 
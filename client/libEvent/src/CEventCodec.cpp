@@ -0,0 +1,804 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <map>
+#include <vector>
+#include <cstring>
+#include "CEventCodec.h"
+#include "CIgniteEvent.h"
+#include "CIgniteLog.h"
+
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "CEventCodec"
+
+namespace ic_event
+{
+
+namespace
+{
+/**
+ * Enum of top level records of an encoded event
+ */
+typedef enum
+{
+    eTAG_EVENT_ID = 1, ///< Event id; string table index
+    eTAG_VERSION, ///< Event version; string table index
+    eTAG_TIMESTAMP, ///< Timestamp; fixed 8 byte unsigned milliseconds
+    eTAG_TIMEZONE, ///< Timezone; fixed 4 byte signed minutes
+    eTAG_DATA, ///< Event data; typed value
+    eTAG_PII, ///< PII fields; typed value
+    eTAG_ATTACHMENTS, ///< Attachment ids; typed value
+    eTAG_BIZ_TRANSACTION_ID, ///< BizTransactionId; string table index
+    eTAG_MESSAGE_ID, ///< MessageId; string table index
+    eTAG_CORRELATION_ID, ///< CorrelationId; string table index
+    eTAG_BENCH_MODE, ///< Bench mode; typed value
+    eTAG_EXTENSION ///< Members without a dedicated tag; typed object
+} RecordTag;
+
+/**
+ * Enum of value types used for typed fields
+ */
+typedef enum
+{
+    eVAL_NULL = 0, ///< null
+    eVAL_FALSE, ///< false
+    eVAL_TRUE, ///< true
+    eVAL_INT, ///< zigzag varint
+    eVAL_UINT, ///< varint
+    eVAL_REAL, ///< fixed 8 byte IEEE-754 double
+    eVAL_STRING, ///< length prefixed bytes
+    eVAL_ARRAY, ///< count followed by values
+    eVAL_OBJECT ///< count followed by key index and value pairs
+} ValueType;
+
+//! Maximum nesting of arrays/objects accepted while decoding
+const unsigned int MAX_DECODE_DEPTH = 64;
+
+//! Size of the magic and version bytes
+const unsigned int CODEC_HEADER_SIZE = 2;
+
+/**
+ * Class to build an encoded event, interning the strings while the records
+ * are being written.
+ */
+class CEncoder
+{
+public:
+    /**
+     * Method to get the index of the given string in the string table,
+     * adding it if not present
+     * @param[in] rstrValue String to be interned
+     * @return Index of the string
+     */
+    unsigned long long Intern(const std::string &rstrValue)
+    {
+        std::map<std::string, unsigned long long>::iterator it =
+                                                   m_mapIndex.find(rstrValue);
+        if (it != m_mapIndex.end())
+        {
+            return it->second;
+        }
+        unsigned long long ullIndex = m_vecStrings.size();
+        m_mapIndex[rstrValue] = ullIndex;
+        m_vecStrings.push_back(rstrValue);
+        return ullIndex;
+    }
+
+    /**
+     * Method to write a varint to the given buffer
+     * @param[in] ullValue Value to be written
+     * @param[out] rstrOut Buffer
+     * @return void
+     */
+    static void PutVarint(unsigned long long ullValue, std::string &rstrOut)
+    {
+        while (ullValue >= 0x80)
+        {
+            rstrOut.push_back((char)((ullValue & 0x7F) | 0x80));
+            ullValue >>= 7;
+        }
+        rstrOut.push_back((char)ullValue);
+    }
+
+    /**
+     * Method to write a little endian fixed width integer to the given buffer
+     * @param[in] ullValue Value to be written
+     * @param[in] unBytes Number of bytes to be written
+     * @param[out] rstrOut Buffer
+     * @return void
+     */
+    static void PutFixed(unsigned long long ullValue, unsigned int unBytes,
+                         std::string &rstrOut)
+    {
+        for (unsigned int i = 0; i < unBytes; i++)
+        {
+            rstrOut.push_back((char)((ullValue >> (8 * i)) & 0xFF));
+        }
+    }
+
+    /**
+     * Method to write a typed value to the given buffer
+     * @param[in] rjsonValue Value to be written
+     * @param[out] rstrOut Buffer
+     * @return void
+     */
+    void PutValue(const ic_utils::Json::Value &rjsonValue, std::string &rstrOut)
+    {
+        switch (rjsonValue.type())
+        {
+        case ic_utils::Json::booleanValue:
+            rstrOut.push_back((char)(rjsonValue.asBool() ? eVAL_TRUE :
+                                                           eVAL_FALSE));
+            break;
+        case ic_utils::Json::intValue:
+        {
+            long long llValue = rjsonValue.asInt64();
+            rstrOut.push_back((char)eVAL_INT);
+            PutVarint(((unsigned long long)llValue << 1) ^
+                      (unsigned long long)(llValue >> 63), rstrOut);
+            break;
+        }
+        case ic_utils::Json::uintValue:
+            rstrOut.push_back((char)eVAL_UINT);
+            PutVarint(rjsonValue.asUInt64(), rstrOut);
+            break;
+        case ic_utils::Json::realValue:
+        {
+            double dblValue = rjsonValue.asDouble();
+            unsigned long long ullBits = 0;
+            std::memcpy(&ullBits, &dblValue, sizeof(ullBits));
+            rstrOut.push_back((char)eVAL_REAL);
+            PutFixed(ullBits, sizeof(ullBits), rstrOut);
+            break;
+        }
+        case ic_utils::Json::stringValue:
+        {
+            std::string strValue = rjsonValue.asString();
+            rstrOut.push_back((char)eVAL_STRING);
+            PutVarint(strValue.size(), rstrOut);
+            rstrOut.append(strValue);
+            break;
+        }
+        case ic_utils::Json::arrayValue:
+            rstrOut.push_back((char)eVAL_ARRAY);
+            PutVarint(rjsonValue.size(), rstrOut);
+            for (unsigned int i = 0; i < rjsonValue.size(); i++)
+            {
+                PutValue(rjsonValue[i], rstrOut);
+            }
+            break;
+        case ic_utils::Json::objectValue:
+        {
+            ic_utils::Json::Value::Members vecKeys = rjsonValue.getMemberNames();
+            rstrOut.push_back((char)eVAL_OBJECT);
+            PutVarint(vecKeys.size(), rstrOut);
+            for (size_t i = 0; i < vecKeys.size(); i++)
+            {
+                PutVarint(Intern(vecKeys[i]), rstrOut);
+                PutValue(rjsonValue[vecKeys[i]], rstrOut);
+            }
+            break;
+        }
+        default:
+            rstrOut.push_back((char)eVAL_NULL);
+            break;
+        }
+    }
+
+    /**
+     * Method to write a record to the body of the encoded event
+     * @param[in] eTag Record tag
+     * @param[in] rstrValue Encoded record value
+     * @return void
+     */
+    void PutRecord(RecordTag eTag, const std::string &rstrValue)
+    {
+        m_strBody.push_back((char)eTag);
+        PutVarint(rstrValue.size(), m_strBody);
+        m_strBody.append(rstrValue);
+    }
+
+    /**
+     * Method to assemble the encoded event from the string table and records
+     * @param[out] rstrEncoded Encoded event
+     * @return void
+     */
+    void Finish(std::string &rstrEncoded)
+    {
+        rstrEncoded.clear();
+        rstrEncoded.push_back((char)CEventCodec::CODEC_MAGIC);
+        rstrEncoded.push_back((char)CEventCodec::CODEC_VERSION);
+        PutVarint(m_vecStrings.size(), rstrEncoded);
+        for (size_t i = 0; i < m_vecStrings.size(); i++)
+        {
+            PutVarint(m_vecStrings[i].size(), rstrEncoded);
+            rstrEncoded.append(m_vecStrings[i]);
+        }
+        rstrEncoded.append(m_strBody);
+    }
+
+private:
+    //! Member variable to map interned strings to their index
+    std::map<std::string, unsigned long long> m_mapIndex;
+
+    //! Member variable to hold the string table in index order
+    std::vector<std::string> m_vecStrings;
+
+    //! Member variable to hold the encoded records
+    std::string m_strBody;
+};
+
+/**
+ * Class to read an encoded event with bounds checking
+ */
+class CDecoder
+{
+public:
+    /**
+     * Parameterized constructor
+     * @param[in] puchData Encoded data
+     * @param[in] unLen Length of the encoded data
+     * @param[in] rvecStrings String table used to resolve interned strings
+     */
+    CDecoder(const unsigned char *puchData, const unsigned long long unLen,
+             const std::vector<std::string> &rvecStrings)
+        : m_puchPos(puchData), m_puchEnd(puchData + unLen),
+          m_rvecStrings(rvecStrings)
+    {
+    }
+
+    /**
+     * Method to get the number of bytes not read yet
+     * @param void
+     * @return Number of remaining bytes
+     */
+    unsigned long long Remaining() const
+    {
+        return m_puchEnd - m_puchPos;
+    }
+
+    /**
+     * Method to read a single byte
+     * @param[out] ruchValue Byte read
+     * @return true if successful else false
+     */
+    bool GetByte(unsigned char &ruchValue)
+    {
+        if (m_puchPos >= m_puchEnd)
+        {
+            return false;
+        }
+        ruchValue = *m_puchPos++;
+        return true;
+    }
+
+    /**
+     * Method to read a varint
+     * @param[out] rullValue Value read
+     * @return true if successful else false
+     */
+    bool GetVarint(unsigned long long &rullValue)
+    {
+        rullValue = 0;
+        for (unsigned int unShift = 0; unShift < 64; unShift += 7)
+        {
+            unsigned char uchByte = 0;
+            if (!GetByte(uchByte))
+            {
+                return false;
+            }
+            rullValue |= (unsigned long long)(uchByte & 0x7F) << unShift;
+            if (!(uchByte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Method to read a little endian fixed width integer
+     * @param[in] unBytes Number of bytes to be read
+     * @param[out] rullValue Value read
+     * @return true if successful else false
+     */
+    bool GetFixed(unsigned int unBytes, unsigned long long &rullValue)
+    {
+        if (Remaining() < unBytes)
+        {
+            return false;
+        }
+        rullValue = 0;
+        for (unsigned int i = 0; i < unBytes; i++)
+        {
+            rullValue |= (unsigned long long)(*m_puchPos++) << (8 * i);
+        }
+        return true;
+    }
+
+    /**
+     * Method to read the given number of bytes
+     * @param[in] ullLen Number of bytes to be read
+     * @param[out] rstrValue Bytes read
+     * @return true if successful else false
+     */
+    bool GetBytes(unsigned long long ullLen, std::string &rstrValue)
+    {
+        if (Remaining() < ullLen)
+        {
+            return false;
+        }
+        rstrValue.assign((const char *)m_puchPos, (size_t)ullLen);
+        m_puchPos += ullLen;
+        return true;
+    }
+
+    /**
+     * Method to skip the given number of bytes
+     * @param[in] ullLen Number of bytes to be skipped
+     * @param[out] rpuchSkipped Start of the skipped bytes
+     * @return true if successful else false
+     */
+    bool Skip(unsigned long long ullLen, const unsigned char *&rpuchSkipped)
+    {
+        if (Remaining() < ullLen)
+        {
+            return false;
+        }
+        rpuchSkipped = m_puchPos;
+        m_puchPos += ullLen;
+        return true;
+    }
+
+    /**
+     * Method to read the string table
+     * @param[out] rvecStrings String table read
+     * @return true if successful else false
+     */
+    bool GetStringTable(std::vector<std::string> &rvecStrings)
+    {
+        unsigned long long ullCount = 0;
+        if (!GetVarint(ullCount) || ullCount > Remaining())
+        {
+            return false;
+        }
+        rvecStrings.resize((size_t)ullCount);
+        for (unsigned long long i = 0; i < ullCount; i++)
+        {
+            unsigned long long ullLen = 0;
+            if (!GetVarint(ullLen) || !GetBytes(ullLen, rvecStrings[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Method to read an interned string
+     * @param[out] rstrValue String read
+     * @return true if successful else false
+     */
+    bool GetInterned(std::string &rstrValue)
+    {
+        unsigned long long ullIndex = 0;
+        if (!GetVarint(ullIndex) || ullIndex >= m_rvecStrings.size())
+        {
+            return false;
+        }
+        rstrValue = m_rvecStrings[(size_t)ullIndex];
+        return true;
+    }
+
+    /**
+     * Method to read a typed value
+     * @param[out] rjsonValue Value read
+     * @param[in] unDepth Current nesting depth
+     * @return true if successful else false
+     */
+    bool GetValue(ic_utils::Json::Value &rjsonValue, unsigned int unDepth = 0)
+    {
+        unsigned char uchType = 0;
+        unsigned long long ullValue = 0;
+        if ((unDepth > MAX_DECODE_DEPTH) || !GetByte(uchType))
+        {
+            return false;
+        }
+
+        switch (uchType)
+        {
+        case eVAL_NULL:
+            rjsonValue = ic_utils::Json::Value();
+            return true;
+        case eVAL_FALSE:
+        case eVAL_TRUE:
+            rjsonValue = (uchType == eVAL_TRUE);
+            return true;
+        case eVAL_INT:
+            if (!GetVarint(ullValue))
+            {
+                return false;
+            }
+            rjsonValue = ic_utils::Json::Int64((ullValue >> 1) ^
+                                                (~(ullValue & 1) + 1));
+            return true;
+        case eVAL_UINT:
+            if (!GetVarint(ullValue))
+            {
+                return false;
+            }
+            rjsonValue = ic_utils::Json::UInt64(ullValue);
+            return true;
+        case eVAL_REAL:
+        {
+            double dblValue = 0;
+            if (!GetFixed(sizeof(ullValue), ullValue))
+            {
+                return false;
+            }
+            std::memcpy(&dblValue, &ullValue, sizeof(dblValue));
+            rjsonValue = dblValue;
+            return true;
+        }
+        case eVAL_STRING:
+        {
+            std::string strValue;
+            if (!GetVarint(ullValue) || !GetBytes(ullValue, strValue))
+            {
+                return false;
+            }
+            rjsonValue = strValue;
+            return true;
+        }
+        case eVAL_ARRAY:
+            if (!GetVarint(ullValue) || ullValue > Remaining())
+            {
+                return false;
+            }
+            rjsonValue = ic_utils::Json::Value(ic_utils::Json::arrayValue);
+            for (unsigned long long i = 0; i < ullValue; i++)
+            {
+                if (!GetValue(rjsonValue[(ic_utils::Json::ArrayIndex)i],
+                              unDepth + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        case eVAL_OBJECT:
+            if (!GetVarint(ullValue) || ullValue > Remaining())
+            {
+                return false;
+            }
+            rjsonValue = ic_utils::Json::Value(ic_utils::Json::objectValue);
+            for (unsigned long long i = 0; i < ullValue; i++)
+            {
+                std::string strKey;
+                if (!GetInterned(strKey) ||
+                    !GetValue(rjsonValue[strKey], unDepth + 1))
+                {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+private:
+    //! Member variable pointing to the next byte to be read
+    const unsigned char *m_puchPos;
+
+    //! Member variable pointing past the last byte
+    const unsigned char *m_puchEnd;
+
+    //! Member variable referring to the string table of the event
+    const std::vector<std::string> &m_rvecStrings;
+};
+
+/**
+ * Method to get the record tag used for a string member of the event root
+ * @param[in] rstrKey Member name
+ * @param[out] reTag Record tag
+ * @return true if the member has a dedicated string record else false
+ */
+bool GetStringRecordTag(const std::string &rstrKey, RecordTag &reTag)
+{
+    if (rstrKey == EVENT_ID_TAG)
+    {
+        reTag = eTAG_EVENT_ID;
+    }
+    else if (rstrKey == VERSION_TAG)
+    {
+        reTag = eTAG_VERSION;
+    }
+    else if (rstrKey == BIZTRANCID)
+    {
+        reTag = eTAG_BIZ_TRANSACTION_ID;
+    }
+    else if (rstrKey == MSGID)
+    {
+        reTag = eTAG_MESSAGE_ID;
+    }
+    else if (rstrKey == CORID)
+    {
+        reTag = eTAG_CORRELATION_ID;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Method to get the record tag used for a typed value member of the event root
+ * @param[in] rstrKey Member name
+ * @param[out] reTag Record tag
+ * @return true if the member has a dedicated value record else false
+ */
+bool GetValueRecordTag(const std::string &rstrKey, RecordTag &reTag)
+{
+    if (rstrKey == VALUE_TAG)
+    {
+        reTag = eTAG_DATA;
+    }
+    else if (rstrKey == PII_TAG)
+    {
+        reTag = eTAG_PII;
+    }
+    else if (rstrKey == FILE_ATTACHMENT_TAG)
+    {
+        reTag = eTAG_ATTACHMENTS;
+    }
+    else if (rstrKey == MODE_TAG)
+    {
+        reTag = eTAG_BENCH_MODE;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Method to get the member name of the event root for the given record tag
+ * @param[in] uchTag Record tag
+ * @return Member name, NULL for unknown tags
+ */
+const char *GetRecordKey(const unsigned char uchTag)
+{
+    switch (uchTag)
+    {
+    case eTAG_EVENT_ID: return EVENT_ID_TAG;
+    case eTAG_VERSION: return VERSION_TAG;
+    case eTAG_TIMESTAMP: return TIMESTAMP_TAG;
+    case eTAG_TIMEZONE: return TIMEZONE_TAG;
+    case eTAG_DATA: return VALUE_TAG;
+    case eTAG_PII: return PII_TAG;
+    case eTAG_ATTACHMENTS: return FILE_ATTACHMENT_TAG;
+    case eTAG_BIZ_TRANSACTION_ID: return BIZTRANCID;
+    case eTAG_MESSAGE_ID: return MSGID;
+    case eTAG_CORRELATION_ID: return CORID;
+    case eTAG_BENCH_MODE: return MODE_TAG;
+    default: return NULL;
+    }
+}
+} /* namespace */
+
+bool CEventCodec::Encode(const ic_utils::Json::Value &rjsonEvent,
+                         std::string &rstrEncoded)
+{
+    if (!rjsonEvent.isObject())
+    {
+        HCPLOG_E << "Event is not a JSON object";
+        return false;
+    }
+
+    CEncoder encoder;
+    ic_utils::Json::Value jsonExtension(ic_utils::Json::objectValue);
+    ic_utils::Json::Value::Members vecKeys = rjsonEvent.getMemberNames();
+    for (size_t i = 0; i < vecKeys.size(); i++)
+    {
+        const std::string &rstrKey = vecKeys[i];
+        const ic_utils::Json::Value &rjsonMember = rjsonEvent[rstrKey];
+        RecordTag eTag = eTAG_EXTENSION;
+        std::string strRecord;
+
+        if (GetStringRecordTag(rstrKey, eTag) && rjsonMember.isString())
+        {
+            CEncoder::PutVarint(encoder.Intern(rjsonMember.asString()),
+                                strRecord);
+        }
+        else if (GetValueRecordTag(rstrKey, eTag))
+        {
+            encoder.PutValue(rjsonMember, strRecord);
+        }
+        else if ((rstrKey == TIMESTAMP_TAG) && rjsonMember.isNumeric() &&
+                 (rjsonMember.asDouble() >= 0))
+        {
+            eTag = eTAG_TIMESTAMP;
+            CEncoder::PutFixed(rjsonMember.asUInt64(), 8, strRecord);
+        }
+        else if ((rstrKey == TIMEZONE_TAG) && rjsonMember.isInt())
+        {
+            eTag = eTAG_TIMEZONE;
+            CEncoder::PutFixed((unsigned int)rjsonMember.asInt(), 4,
+                               strRecord);
+        }
+        else
+        {
+            // no compact form available; keep the member as is
+            jsonExtension[rstrKey] = rjsonMember;
+            continue;
+        }
+        encoder.PutRecord(eTag, strRecord);
+    }
+
+    if (!jsonExtension.empty())
+    {
+        std::string strRecord;
+        encoder.PutValue(jsonExtension, strRecord);
+        encoder.PutRecord(eTAG_EXTENSION, strRecord);
+    }
+
+    encoder.Finish(rstrEncoded);
+    return true;
+}
+
+bool CEventCodec::Decode(const unsigned char *puchData,
+                         const unsigned int unLen,
+                         ic_utils::Json::Value &rjsonEvent)
+{
+    if (!puchData || (unLen < CODEC_HEADER_SIZE) ||
+        (puchData[0] != CODEC_MAGIC))
+    {
+        HCPLOG_E << "Not a binary encoded event";
+        return false;
+    }
+
+    if (puchData[1] != CODEC_VERSION)
+    {
+        HCPLOG_E << "Unsupported event format version " << (int)puchData[1];
+        return false;
+    }
+
+    std::vector<std::string> vecStrings;
+    CDecoder decoder(puchData + CODEC_HEADER_SIZE, unLen - CODEC_HEADER_SIZE,
+                     vecStrings);
+    if (!decoder.GetStringTable(vecStrings))
+    {
+        HCPLOG_E << "Malformed string table";
+        return false;
+    }
+
+    rjsonEvent = ic_utils::Json::Value(ic_utils::Json::objectValue);
+    while (decoder.Remaining() > 0)
+    {
+        unsigned char uchTag = 0;
+        unsigned long long ullLen = 0;
+        const unsigned char *puchRecord = NULL;
+        if (!decoder.GetByte(uchTag) || !decoder.GetVarint(ullLen) ||
+            !decoder.Skip(ullLen, puchRecord))
+        {
+            HCPLOG_E << "Truncated record";
+            return false;
+        }
+
+        CDecoder record(puchRecord, ullLen, vecStrings);
+
+        const char *pchKey = GetRecordKey(uchTag);
+        bool bOk = true;
+        unsigned long long ullValue = 0;
+        switch (uchTag)
+        {
+        case eTAG_EVENT_ID:
+        case eTAG_VERSION:
+        case eTAG_BIZ_TRANSACTION_ID:
+        case eTAG_MESSAGE_ID:
+        case eTAG_CORRELATION_ID:
+        {
+            std::string strValue;
+            bOk = record.GetInterned(strValue);
+            rjsonEvent[pchKey] = strValue;
+            break;
+        }
+        case eTAG_TIMESTAMP:
+            bOk = record.GetFixed(8, ullValue);
+            rjsonEvent[pchKey] = ic_utils::Json::UInt64(ullValue);
+            break;
+        case eTAG_TIMEZONE:
+            bOk = record.GetFixed(4, ullValue);
+            rjsonEvent[pchKey] = (int)(unsigned int)ullValue;
+            break;
+        case eTAG_DATA:
+        case eTAG_PII:
+        case eTAG_ATTACHMENTS:
+        case eTAG_BENCH_MODE:
+            bOk = record.GetValue(rjsonEvent[pchKey]);
+            break;
+        case eTAG_EXTENSION:
+        {
+            ic_utils::Json::Value jsonExtension;
+            bOk = record.GetValue(jsonExtension) && jsonExtension.isObject();
+            if (bOk)
+            {
+                ic_utils::Json::Value::Members vecKeys =
+                                               jsonExtension.getMemberNames();
+                for (size_t i = 0; i < vecKeys.size(); i++)
+                {
+                    rjsonEvent[vecKeys[i]] = jsonExtension[vecKeys[i]];
+                }
+            }
+            break;
+        }
+        default:
+            // records added by later revisions of this version are skipped
+            HCPLOG_T << "Skipping unknown record " << (int)uchTag;
+            break;
+        }
+
+        if (!bOk)
+        {
+            HCPLOG_E << "Malformed record " << (int)uchTag;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CEventCodec::Decode(const std::string &rstrEncoded,
+                         ic_utils::Json::Value &rjsonEvent)
+{
+    return Decode((const unsigned char *)rstrEncoded.data(),
+                  rstrEncoded.size(), rjsonEvent);
+}
+
+bool CEventCodec::IsEncoded(const std::string &rstrPayload)
+{
+    return !rstrPayload.empty() &&
+           ((unsigned char)rstrPayload[0] == CODEC_MAGIC);
+}
+
+std::string CEventCodec::ToJsonString(const std::string &rstrPayload)
+{
+    if (!IsEncoded(rstrPayload))
+    {
+        return rstrPayload;
+    }
+
+    ic_utils::Json::Value jsonEvent;
+    Decode(rstrPayload, jsonEvent);
+    ic_utils::Json::FastWriter jsonWriter;
+    return jsonWriter.write(jsonEvent);
+}
+
+std::string CEventCodec::ToLogString(const std::string &rstrPayload)
+{
+    if (!IsEncoded(rstrPayload))
+    {
+        return rstrPayload;
+    }
+    return "<binary event, " + std::to_string(rstrPayload.size()) + " bytes>";
+}
+
+} /* namespace ic_event */
@@ -32,6 +32,7 @@
 #include "CIgniteLog.h"
 #include "CIgniteMessage.h"
 #include "CClientInfo.h"
+#include "CEventCodec.h"
 #include "jsoncpp/json.h"
 #include "EventLibVersion.h"
 
@@ -54,6 +55,7 @@ const unsigned int TRUNCATE_MIN_LEN = 16;
 
 //static member declaration
 bool CIgniteEvent::bBenchMode = false;
+bool CIgniteEvent::m_bBinaryWireFormat = false;
 
 namespace 
 {
@@ -221,7 +223,22 @@ void CIgniteEvent::JsonToEvent(const std::string& rstrJsonEvent)
     ic_utils::Json::Value jsonRoot;
     ic_utils::Json::Reader jsonReader;
     jsonReader.parse(rstrJsonEvent, jsonRoot);
+    JsonValueToEvent(jsonRoot);
+}
 
+bool CIgniteEvent::BinaryToEvent(const std::string &rstrEncoded)
+{
+    ic_utils::Json::Value jsonRoot;
+    if (!CEventCodec::Decode(rstrEncoded, jsonRoot))
+    {
+        return false;
+    }
+    JsonValueToEvent(jsonRoot);
+    return true;
+}
+
+void CIgniteEvent::JsonValueToEvent(const ic_utils::Json::Value &jsonRoot)
+{
     m_jsonEventFields[VERSION_TAG] = jsonRoot[VERSION_TAG].asString();
     m_jsonEventFields[EVENT_ID_TAG] = jsonRoot[EVENT_ID_TAG].asString();
     m_jsonEventFields[TIMESTAMP_TAG] = jsonRoot[TIMESTAMP_TAG].asUInt64();
@@ -798,6 +815,23 @@ bool CIgniteEvent::operator != (CIgniteEvent& event)
 void CIgniteEvent::EventToJson(string& json)
 {
     ic_utils::Json::Value jsonRoot;
+    EventToJsonValue(jsonRoot);
+
+    ic_utils::Json::FastWriter jsonWriter;
+    json += jsonWriter.write(jsonRoot);
+    HCPLOG_T << "JSON: " << json;
+}
+
+void CIgniteEvent::EventToBinary(std::string &rstrEncoded)
+{
+    ic_utils::Json::Value jsonRoot;
+    EventToJsonValue(jsonRoot);
+    CEventCodec::Encode(jsonRoot, rstrEncoded);
+    HCPLOG_T << "Binary event size: " << rstrEncoded.size();
+}
+
+void CIgniteEvent::EventToJsonValue(ic_utils::Json::Value &jsonRoot)
+{
     jsonRoot[EVENT_ID_TAG] = m_jsonEventFields[EVENT_ID_TAG];
     jsonRoot[VERSION_TAG] = m_jsonEventFields[VERSION_TAG];
     if(bBenchMode)
@@ -852,10 +886,6 @@ void CIgniteEvent::EventToJson(string& json)
     {
         jsonRoot[CORID] = m_jsonEventFields[CORID];
     }
-
-    ic_utils::Json::FastWriter jsonWriter;
-    json += jsonWriter.write(jsonRoot);
-    HCPLOG_T << "JSON: " << json;
 }
 
 
@@ -878,16 +908,33 @@ int CIgniteEvent::Send()
     ProcessAttachment();
 
     string strSerialized;
-    EventToJson(strSerialized);
+    if (m_bBinaryWireFormat)
+    {
+        EventToBinary(strSerialized);
+    }
+    else
+    {
+        EventToJson(strSerialized);
+    }
     int nRet = -1;
     if(eventSender)
     {
-        HCPLOG_T << "   Sending event:" << strSerialized;
+        HCPLOG_T << "   Sending event:" << CEventCodec::ToLogString(strSerialized);
         nRet = eventSender->Send(strSerialized);
     }
     return nRet;
 }
 
+void CIgniteEvent::SetBinaryWireFormat(const bool bEnable)
+{
+    m_bBinaryWireFormat = bEnable;
+}
+
+bool CIgniteEvent::IsBinaryWireFormat()
+{
+    return m_bBinaryWireFormat;
+}
+
 void CIgniteEvent::SetSender(IEventSender* pSender)
 {
     HCPLOG_METHOD();
@@ -20,6 +20,9 @@
 #include "CIgniteEventSender.h"
 #include "CIgniteMessage.h"
 #include "CIgniteLog.h"
+#include "CEventCodec.h"
+#include "CIgniteDateTime.h"
+#include "CIgniteThread.h"
 
 #ifdef PREFIX
 #undef PREFIX
@@ -35,6 +38,41 @@ namespace ic_event
  */
 const unsigned long ulStartupEventQueueMaxSize = 20480;
 
+/*
+ * Size, as a multiple of the size threshold, up to which a batch may grow
+ *   before the producer flushes it itself instead of the flushing thread.
+ */
+const unsigned int unBatchHardLimitFactor = 4;
+
+/**
+ * Thread flushing the batches of CIgniteEventSender batching mode
+ */
+class CIgniteEventSender::CBatchFlusher : public ic_utils::CIgniteThread
+{
+public:
+    /**
+     * Parameterized constructor
+     * @param[in] pSender Sender whose batches are to be flushed
+     */
+    CBatchFlusher(CIgniteEventSender *pSender) : m_pSender(pSender)
+    {
+    }
+
+    /**
+     * Overridden method of CIgniteThread
+     * @param void
+     * @return void
+     */
+    void Run() override
+    {
+        m_pSender->RunBatchFlusher();
+    }
+
+private:
+    //! Sender whose batches are to be flushed
+    CIgniteEventSender *m_pSender;
+};
+
 CIgniteEventSender::CIgniteEventSender()
 {
     m_nMsqid = -1;
@@ -60,6 +98,7 @@ CIgniteEventSender::CIgniteEventSender(std::string strIpAddr , int nSocketPort)
 
 CIgniteEventSender::~CIgniteEventSender()
 {
+    DisableBatching();
     ic_event::CIgniteMessage::CloseConnection(m_nMsqid);
 }
 
@@ -67,6 +106,18 @@ int CIgniteEventSender::Send(const std::string &rstrSerializedEvent)
 {
     HCPLOG_METHOD();
 
+    if (IsBatchingEnabled())
+    {
+        return AddEventToBatch(rstrSerializedEvent);
+    }
+    return SendUnbatched(rstrSerializedEvent);
+}
+
+int CIgniteEventSender::SendUnbatched(const std::string &rstrSerializedEvent)
+{
+    // the connection and the startup queue are shared with Flush()
+    ic_utils::CScopeLock flushLock(m_flushMutex);
+
     if (m_nMsqid < 0)
     {
         OpenConnectionBasedOnSocketType();
@@ -79,20 +130,16 @@ int CIgniteEventSender::Send(const std::string &rstrSerializedEvent)
         std::string strEvnt;
         while(m_queStartupEvents.Take(&strEvnt))
         {
-            ic_event::CIgniteMessage event(ic_event::CMessageTypes::eEVENT, m_nMsqid);
-            event.SetMessage(strEvnt);
-            nRet = event.Send();
-            HCPLOG_T << "Sending queued startup event=" << strEvnt << "; nRet = " << nRet;
+            nRet = SendEventMessage(strEvnt);
+            HCPLOG_T << "Sending queued startup event=" << CEventCodec::ToLogString(strEvnt) << "; nRet = " << nRet;
             //Only startup events are allowed to be queued; since the startup events are already cleared here,
             // no need to queue anymore events even if the msq connection is broken for some reasons;
             // otherwise it will unnecessarily add overhead to the clients that are using the libAcpEvent library.
             m_bQueueStartupEvents = false;
         }
 
-        ic_event::CIgniteMessage event(ic_event::CMessageTypes::eEVENT, m_nMsqid);
-        event.SetMessage(rstrSerializedEvent);
-        HCPLOG_T << "Sending Event Message to queue=" << m_nMsqid << ", data=" << rstrSerializedEvent;
-        nRet = event.Send();
+        HCPLOG_T << "Sending Event Message to queue=" << m_nMsqid << ", data=" << CEventCodec::ToLogString(rstrSerializedEvent);
+        nRet = SendEventMessage(rstrSerializedEvent);
         if(nRet == -1)
         {
             ic_event::CIgniteMessage::CloseConnection(m_nMsqid);
@@ -108,12 +155,256 @@ int CIgniteEventSender::Send(const std::string &rstrSerializedEvent)
         }
         else
         {
-            HCPLOG_E << "could not send the event " << rstrSerializedEvent;
+            HCPLOG_E << "could not send the event " << CEventCodec::ToJsonString(rstrSerializedEvent);
         }
     }
     return nRet;
 }
 
+int CIgniteEventSender::SendEventMessage(const std::string &rstrSerializedEvent)
+{
+    ic_event::CIgniteMessage event(ic_event::CMessageTypes::eEVENT, m_nMsqid);
+    PrepareEventMessage(rstrSerializedEvent, event);
+    return event.Send();
+}
+
+int CIgniteEventSender::PrepareEventMessage(const std::string &rstrSerializedEvent, CIgniteMessage &rMsg)
+{
+    if (CEventCodec::IsEncoded(rstrSerializedEvent))
+    {
+        // binary events are sent as is, without the string terminator
+        rMsg.SetPayloadFormat(ePAYLOAD_FORMAT_BINARY_V1);
+        return rMsg.SetMessage((const unsigned char*)rstrSerializedEvent.data(), rstrSerializedEvent.size());
+    }
+    return rMsg.SetMessage(rstrSerializedEvent);
+}
+
+void CIgniteEventSender::EnableBatching(const unsigned int unMaxBatchBytes, const unsigned int unMaxDelayMs)
+{
+    HCPLOG_C << "Batching enabled; maxBytes=" << unMaxBatchBytes << ", maxDelayMs=" << unMaxDelayMs;
+
+    m_batchMutex.Lock();
+    m_unMaxBatchBytes = unMaxBatchBytes;
+    m_unMaxDelayMs = unMaxDelayMs;
+    m_bBatching = true;
+    m_bStopBatchFlusher = false;
+    m_batchCondition.ConditionSignal();
+    m_batchMutex.Unlock();
+
+    if (m_pBatchFlusher == NULL)
+    {
+        m_pBatchFlusher = new CBatchFlusher(this);
+        m_pBatchFlusher->Start();
+    }
+}
+
+void CIgniteEventSender::DisableBatching()
+{
+    StopBatchFlusher();
+
+    /*
+     * Unbatched sends wait for the flush lock, so no event sent after
+     * batching is disabled can overtake the remaining batch
+     */
+    ic_utils::CScopeLock flushLock(m_flushMutex);
+    m_batchMutex.Lock();
+    bool bWasBatching = m_bBatching;
+    m_bBatching = false;
+    m_batchMutex.Unlock();
+
+    if (bWasBatching)
+    {
+        HCPLOG_C << "Batching disabled";
+        FlushLocked();
+    }
+}
+
+bool CIgniteEventSender::IsBatchingEnabled()
+{
+    ic_utils::CScopeLock lock(m_batchMutex);
+    return m_bBatching;
+}
+
+void CIgniteEventSender::StopBatchFlusher()
+{
+    if (m_pBatchFlusher != NULL)
+    {
+        m_batchMutex.Lock();
+        m_bStopBatchFlusher = true;
+        m_batchCondition.ConditionSignal();
+        m_batchMutex.Unlock();
+
+        m_pBatchFlusher->Join();
+        delete m_pBatchFlusher;
+        m_pBatchFlusher = NULL;
+    }
+}
+
+int CIgniteEventSender::AddEventToBatch(const std::string &rstrSerializedEvent)
+{
+    m_batchMutex.Lock();
+    if (!m_bBatching)
+    {
+        // batching got disabled meanwhile
+        m_batchMutex.Unlock();
+        return SendUnbatched(rstrSerializedEvent);
+    }
+
+    if (m_vecBatch.empty())
+    {
+        m_ullBatchStartTime = ic_utils::CIgniteDateTime::GetCurrentTimeMs();
+    }
+    m_vecBatch.push_back(rstrSerializedEvent);
+    m_ulBatchBytes += rstrSerializedEvent.size();
+
+    bool bFlushNow = (m_ulBatchBytes >= (unsigned long)m_unMaxBatchBytes * unBatchHardLimitFactor);
+    if ((m_vecBatch.size() == 1) || (m_ulBatchBytes >= m_unMaxBatchBytes))
+    {
+        m_batchCondition.ConditionSignal();
+    }
+    m_batchMutex.Unlock();
+
+    // the flushing thread is not keeping up; write the batch from here
+    if (bFlushNow)
+    {
+        Flush();
+    }
+    return 0;
+}
+
+void CIgniteEventSender::RunBatchFlusher()
+{
+    m_batchMutex.Lock();
+    while (!m_bStopBatchFlusher)
+    {
+        if (m_vecBatch.empty())
+        {
+            m_batchCondition.ConditionWait(m_batchMutex);
+            continue;
+        }
+
+        unsigned long long ullAge = ic_utils::CIgniteDateTime::GetCurrentTimeMs() - m_ullBatchStartTime;
+        if ((ullAge < m_unMaxDelayMs) && (m_ulBatchBytes < m_unMaxBatchBytes))
+        {
+            m_batchCondition.ConditionTimedwait(m_batchMutex, (unsigned int)(m_unMaxDelayMs - ullAge));
+            continue;
+        }
+
+        m_batchMutex.Unlock();
+        Flush();
+        m_batchMutex.Lock();
+    }
+    m_batchMutex.Unlock();
+}
+
+int CIgniteEventSender::Flush()
+{
+    // keeps the batches in order when flushed from multiple threads
+    ic_utils::CScopeLock flushLock(m_flushMutex);
+    return FlushLocked();
+}
+
+int CIgniteEventSender::FlushLocked()
+{
+    std::vector<std::string> vecBatch;
+    m_batchMutex.Lock();
+    vecBatch.swap(m_vecBatch);
+    m_ulBatchBytes = 0;
+    m_batchMutex.Unlock();
+
+    if (vecBatch.empty())
+    {
+        return 0;
+    }
+
+    if (m_nMsqid < 0)
+    {
+        OpenConnectionBasedOnSocketType();
+    }
+
+    if (m_nMsqid < 0)
+    {
+        if (m_bQueueStartupEvents)
+        {
+            for (size_t i = 0; i < vecBatch.size(); i++)
+            {
+                AddEventToStartUpQueue(vecBatch[i]);
+            }
+        }
+        else
+        {
+            ReportLostEvents(vecBatch);
+        }
+        return -1;
+    }
+
+    // events queued before the connection was available are sent first
+    std::vector<std::string> vecEvents;
+    std::string strEvnt;
+    while (m_queStartupEvents.Take(&strEvnt))
+    {
+        vecEvents.push_back(strEvnt);
+        m_bQueueStartupEvents = false;
+    }
+    vecEvents.insert(vecEvents.end(), vecBatch.begin(), vecBatch.end());
+
+    // events which could be serialized, in the order of their messages
+    std::vector<std::string> vecPending;
+    std::vector<std::string> vecSerialized;
+    vecPending.reserve(vecEvents.size());
+    vecSerialized.reserve(vecEvents.size());
+    for (size_t i = 0; i < vecEvents.size(); i++)
+    {
+        ic_event::CIgniteMessage event(ic_event::CMessageTypes::eEVENT, m_nMsqid);
+        std::string strSerialized;
+        if ((PrepareEventMessage(vecEvents[i], event) != 0) || (event.GetSerialized(strSerialized) != 0))
+        {
+            HCPLOG_E << "could not send the event " << CEventCodec::ToJsonString(vecEvents[i]);
+            continue;
+        }
+        vecPending.push_back(vecEvents[i]);
+        vecSerialized.push_back(strSerialized);
+    }
+
+    size_t nSent = 0;
+    int nRet = ic_event::CIgniteMessage::SendSerialized(m_nMsqid, vecSerialized, &nSent);
+    HCPLOG_T << "Sent batch of " << nSent << "/" << vecSerialized.size() << " events; nRet = " << nRet;
+    if (nRet == -1)
+    {
+        ic_event::CIgniteMessage::CloseConnection(m_nMsqid);
+        m_nMsqid = -1;
+        HCPLOG_T << "Connection closed";
+
+        // the events not written completely are retried once on a new connection
+        vecPending.erase(vecPending.begin(), vecPending.begin() + nSent);
+        vecSerialized.erase(vecSerialized.begin(), vecSerialized.begin() + nSent);
+        HCPLOG_W << "retrying " << vecSerialized.size() << " batched events";
+        OpenConnectionBasedOnSocketType();
+        nSent = 0;
+        nRet = ic_event::CIgniteMessage::SendSerialized(m_nMsqid, vecSerialized, &nSent);
+        if (nRet == -1)
+        {
+            if (m_nMsqid >= 0)
+            {
+                ic_event::CIgniteMessage::CloseConnection(m_nMsqid);
+                m_nMsqid = -1;
+                HCPLOG_T << "Connection closed";
+            }
+            vecPending.erase(vecPending.begin(), vecPending.begin() + nSent);
+            ReportLostEvents(vecPending);
+        }
+    }
+    return nRet;
+}
+
+void CIgniteEventSender::ReportLostEvents(const std::vector<std::string> &rvecEvents)
+{
+    for (size_t i = 0; i < rvecEvents.size(); i++)
+    {
+        HCPLOG_E << "could not send the event " << CEventCodec::ToJsonString(rvecEvents[i]);
+    }
+}
+
 SocketType CIgniteEventSender::GetSocketType() 
 {
     return m_eType;
@@ -169,7 +460,7 @@ void CIgniteEventSender::AddEventToStartUpQueue(const std::string &rstrSerialize
     }
     else
     {
-        HCPLOG_E << "Startup event queue full! missing event " << rstrSerializedEvent;
+        HCPLOG_E << "Startup event queue full! missing event " << CEventCodec::ToJsonString(rstrSerializedEvent);
     }
 }
 
@@ -31,6 +31,7 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <signal.h>
 #include <string.h>
@@ -40,6 +41,7 @@
 #include <cstdlib>
 #include <climits>
 #include <sstream>
+#include <atomic>
 
 #if defined(__CYGWIN__)
 #include <cygwin/in.h>
@@ -67,15 +69,23 @@ namespace
 #define CONNECT_TIMEOUT 5
 #define READ_WRITE_TIMEOUT 10
 
-pthread_mutex_t seqnumMutex = PTHREAD_MUTEX_INITIALIZER;
-unsigned int g_unGlobalSeqnum = 0;
+std::atomic<unsigned int> g_unGlobalSeqnum(0);
 
 const unsigned char SYNC_BYTES_LEN = 8;
 const unsigned char SYNC_BYTES[SYNC_BYTES_LEN] = { 0xFF, 0x61, 0x63, 0x70, 0x6d, 0x73, 0x67, 0xFE };
 const unsigned int FLAGS_REPLY_REQUIRED_BITPOS = 0x00000001;
 
+/* Bits 8-15 of the flags carry the payload format. Receivers which predate
+ * this field treat every payload as JSON, hence non-JSON formats are opt-in.
+ */
+const unsigned int FLAGS_PAYLOAD_FORMAT_MASK = 0x0000FF00;
+const unsigned int FLAGS_PAYLOAD_FORMAT_SHIFT = 8;
+
 const int ACP_SOCKET_ERROR = -1;
 
+// Maximum number of messages written by a single writev() call
+const unsigned int MAX_IOV_PER_WRITE = 64;
+
 /**
  * Data structure representing serialized message fileds
  */
@@ -294,10 +304,9 @@ CIgniteMessage::CIgniteMessage(const unsigned int unType, const sockid nTo)
     m_nTo = nTo;
     m_strRplyto = "";
     m_bReplyReq = false;
+    m_unPayloadFormat = ePAYLOAD_FORMAT_JSON;
 
-    pthread_mutex_lock(&seqnumMutex);
     m_unSeqnum = ++g_unGlobalSeqnum;
-    pthread_mutex_unlock(&seqnumMutex);
 
     m_puchMsg = 0;
     m_unLen = 0;
@@ -322,6 +331,7 @@ CIgniteMessage::CIgniteMessage(const void* const pvoidSerializedMessage)
 
     m_nTo = -1;
     m_bReplyReq = ((pRaw->unFlags & FLAGS_REPLY_REQUIRED_BITPOS) == FLAGS_REPLY_REQUIRED_BITPOS);
+    m_unPayloadFormat = (pRaw->unFlags & FLAGS_PAYLOAD_FORMAT_MASK) >> FLAGS_PAYLOAD_FORMAT_SHIFT;
     m_unSeqnum = pRaw->unSeqnum;
     m_unLen = pRaw->unMessageLen;
     if (m_unLen > 0)
@@ -462,6 +472,102 @@ int CIgniteMessage::Send(std::string& rstrReply)
     return nRet;
 }
 
+int CIgniteMessage::GetSerialized(std::string& rstrSerialized) const
+{
+    int nLen = 0;
+    void* pvoidRawmsg = Serialize(nLen);
+    if (pvoidRawmsg == NULL)
+    {
+        return -1;
+    }
+
+    rstrSerialized.assign((const char*)pvoidRawmsg, nLen);
+    free(pvoidRawmsg);
+    return 0;
+}
+
+int CIgniteMessage::SendSerialized(const sockid nTo, const std::vector<std::string>& rvecSerialized,
+                                   size_t *pnSent)
+{
+    HCPLOG_METHOD() << "to=" << nTo << ", count=" << rvecSerialized.size();
+
+    size_t nNext = 0;       // next message to be added to the vector
+    size_t nOffset = 0;     // bytes of the next message already written
+    if (pnSent != NULL)
+    {
+        *pnSent = 0;
+    }
+
+    if (nTo < 0)
+    {
+        return ACP_SOCKET_ERROR;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    struct iovec stIov[MAX_IOV_PER_WRITE];
+
+    while (nNext < rvecSerialized.size())
+    {
+        // timeout for write operation, same as for single messages
+        fd_set writefds;
+        struct timeval stTimeout;
+        stTimeout.tv_sec = READ_WRITE_TIMEOUT;
+        stTimeout.tv_usec = 0;
+        FD_ZERO(&writefds);
+        FD_SET(nTo, &writefds);
+        if (select(nTo + 1, NULL, &writefds, NULL, &stTimeout) < 1)
+        {
+            HCPLOG_T << "Timeout for write error:" << nTo;
+            return ACP_SOCKET_ERROR;
+        }
+
+        int nIovCnt = 0;
+        for (size_t i = nNext; (i < rvecSerialized.size()) && (nIovCnt < (int)MAX_IOV_PER_WRITE); i++)
+        {
+            size_t nSkip = (i == nNext) ? nOffset : 0;
+            stIov[nIovCnt].iov_base = (void*)(rvecSerialized[i].data() + nSkip);
+            stIov[nIovCnt].iov_len = rvecSerialized[i].size() - nSkip;
+            nIovCnt++;
+        }
+
+        ssize_t nWritten = writev(nTo, stIov, nIovCnt);
+        if (nWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            HCPLOG_W << "writev error on socket:" << nTo << "; err=" << std::strerror(errno);
+            return ACP_SOCKET_ERROR;
+        }
+
+        // advance past the fully written messages, remember partial one
+        size_t nRemaining = (size_t)nWritten;
+        while ((nNext < rvecSerialized.size()) && (nRemaining > 0))
+        {
+            size_t nLeft = rvecSerialized[nNext].size() - nOffset;
+            if (nRemaining >= nLeft)
+            {
+                nRemaining -= nLeft;
+                nNext++;
+                nOffset = 0;
+                if (pnSent != NULL)
+                {
+                    *pnSent = nNext;
+                }
+            }
+            else
+            {
+                nOffset += nRemaining;
+                nRemaining = 0;
+            }
+        }
+    }
+
+    return 0;
+}
+
 int CIgniteMessage::Reply(const std::string& rstrReplyMsg) const
 {
     HCPLOG_METHOD() << ", this=" << this << ", replyMsg=" << rstrReplyMsg;
@@ -576,6 +682,16 @@ const unsigned int CIgniteMessage::GetType() const
     return m_unType;
 }
 
+void CIgniteMessage::SetPayloadFormat(const unsigned int unFormat)
+{
+    m_unPayloadFormat = unFormat;
+}
+
+const unsigned int CIgniteMessage::GetPayloadFormat() const
+{
+    return m_unPayloadFormat;
+}
+
 const bool CIgniteMessage::GetReplyRequired() const
 {
     return m_bReplyReq;
@@ -616,6 +732,8 @@ void* CIgniteMessage::Serialize(int& rnLen) const
         pSerializedData->unFlags |= FLAGS_REPLY_REQUIRED_BITPOS;
     }
 
+    pSerializedData->unFlags |= (m_unPayloadFormat << FLAGS_PAYLOAD_FORMAT_SHIFT) & FLAGS_PAYLOAD_FORMAT_MASK;
+
     pSerializedData->unMessageLen = m_unLen;
     pSerializedData->unSeqnum = m_unSeqnum;
     memcpy(pSerializedData->uchMessageData, m_puchMsg, m_unLen);
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "CEventCodec.h"
+#include "CIgniteEvent.h"
+
+namespace ic_event
+{
+
+// Class CEventCodecTest defines a test feature for CEventCodec class
+class CEventCodecTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CEventCodecTest()
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CEventCodecTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * SetUp method : Code here will be called immediately after the
+     * constructor (right before each test)
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * TearDown method : Code here will be called immediately after
+     * each test (right before the destructor)
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        // Do nothing
+    }
+};
+
+// Tests
+
+TEST_F(CEventCodecTest, Test_event_round_trip)
+{
+    CIgniteEvent event("1.0", "Location", 1700000000123.0);
+    event.SetTimezone(330);
+    event.AddField("lat", 12.9716);
+    event.AddField("count", -7);
+    event.AddField("big", (long long)9007199254740993LL);
+    event.AddField("name", std::string("home"));
+    event.AddField("valid", true);
+    event.AddMessageId("msg-1");
+
+    std::string strJson;
+    event.EventToJson(strJson);
+
+    std::string strEncoded;
+    event.EventToBinary(strEncoded);
+
+    // binary format is expected to be detected and smaller than JSON
+    EXPECT_TRUE(CEventCodec::IsEncoded(strEncoded));
+    EXPECT_FALSE(CEventCodec::IsEncoded(strJson));
+    EXPECT_LT(strEncoded.size(), strJson.size());
+
+    CIgniteEvent decoded;
+    EXPECT_TRUE(decoded.BinaryToEvent(strEncoded));
+
+    EXPECT_EQ("Location", decoded.GetEventId());
+    EXPECT_EQ("1.0", decoded.GetVersion());
+    EXPECT_EQ(1700000000123.0, decoded.GetTimestamp());
+    EXPECT_EQ(12.9716, decoded.GetDouble("lat"));
+    EXPECT_EQ(-7, decoded.GetInt("count"));
+    EXPECT_EQ(9007199254740993LL, decoded.GetLong("big"));
+    EXPECT_EQ("home", decoded.GetString("name"));
+    EXPECT_TRUE(decoded.GetBool("valid"));
+    EXPECT_EQ("msg-1", decoded.GetMessageId());
+
+    // decoded event is expected to serialize to the same JSON
+    std::string strDecodedJson;
+    decoded.EventToJson(strDecodedJson);
+    EXPECT_EQ(strJson, strDecodedJson);
+}
+
+TEST_F(CEventCodecTest, Test_keys_are_interned)
+{
+    ic_utils::Json::Value jsonEvent;
+    jsonEvent[EVENT_ID_TAG] = "Samples";
+    for (int i = 0; i < 10; i++)
+    {
+        ic_utils::Json::Value jsonSample;
+        jsonSample["temperatureCelsius"] = i;
+        jsonEvent[VALUE_TAG]["samples"].append(jsonSample);
+    }
+
+    std::string strEncoded;
+    EXPECT_TRUE(CEventCodec::Encode(jsonEvent, strEncoded));
+
+    // repeated key is expected to be stored only once
+    size_t nPos = strEncoded.find("temperatureCelsius");
+    EXPECT_NE(std::string::npos, nPos);
+    EXPECT_EQ(std::string::npos, strEncoded.find("temperatureCelsius", nPos + 1));
+
+    ic_utils::Json::Value jsonDecoded;
+    EXPECT_TRUE(CEventCodec::Decode(strEncoded, jsonDecoded));
+    EXPECT_EQ(jsonEvent, jsonDecoded);
+}
+
+TEST_F(CEventCodecTest, Test_members_without_dedicated_record)
+{
+    ic_utils::Json::Value jsonEvent;
+    jsonEvent[EVENT_ID_TAG] = "Custom";
+    jsonEvent[TIMEZONE_TAG] = ic_utils::Json::Value();
+    jsonEvent["Extra"] = "value";
+
+    std::string strEncoded;
+    EXPECT_TRUE(CEventCodec::Encode(jsonEvent, strEncoded));
+
+    ic_utils::Json::Value jsonDecoded;
+    EXPECT_TRUE(CEventCodec::Decode(strEncoded, jsonDecoded));
+    EXPECT_EQ(jsonEvent, jsonDecoded);
+}
+
+TEST_F(CEventCodecTest, Test_decode_rejects_malformed_input)
+{
+    CIgniteEvent event("1.0", "Location", 1700000000123.0);
+    event.AddField("name", std::string("home"));
+
+    std::string strEncoded;
+    event.EventToBinary(strEncoded);
+
+    ic_utils::Json::Value jsonDecoded;
+
+    // truncated record is expected to be detected
+    std::string strTruncated = strEncoded.substr(0, strEncoded.size() - 1);
+    EXPECT_FALSE(CEventCodec::Decode(strTruncated, jsonDecoded));
+
+    // truncated string table is expected to be detected
+    EXPECT_FALSE(CEventCodec::Decode(strEncoded.substr(0, 4), jsonDecoded));
+
+    // unknown format version is expected to be rejected
+    std::string strNewer = strEncoded;
+    strNewer[1] = (char)(CEventCodec::CODEC_VERSION + 1);
+    EXPECT_FALSE(CEventCodec::Decode(strNewer, jsonDecoded));
+
+    // JSON text is expected to be rejected
+    EXPECT_FALSE(CEventCodec::Decode(std::string("{}"), jsonDecoded));
+}
+
+TEST_F(CEventCodecTest, Test_to_json_string)
+{
+    EXPECT_EQ("{\"a\":1}", CEventCodec::ToJsonString("{\"a\":1}"));
+
+    ic_utils::Json::Value jsonEvent;
+    jsonEvent[EVENT_ID_TAG] = "Location";
+    std::string strEncoded;
+    CEventCodec::Encode(jsonEvent, strEncoded);
+    EXPECT_EQ("{\"EventID\":\"Location\"}\n",
+              CEventCodec::ToJsonString(strEncoded));
+}
+
+TEST_F(CEventCodecTest, Test_to_log_string)
+{
+    EXPECT_EQ("{\"a\":1}", CEventCodec::ToLogString("{\"a\":1}"));
+
+    // binary payload is expected to be described by its size only
+    ic_utils::Json::Value jsonEvent;
+    jsonEvent[EVENT_ID_TAG] = "Location";
+    std::string strEncoded;
+    CEventCodec::Encode(jsonEvent, strEncoded);
+    EXPECT_EQ("<binary event, " + std::to_string(strEncoded.size()) +
+              " bytes>", CEventCodec::ToLogString(strEncoded));
+}
+
+} /* namespace ic_event */
@@ -22,6 +22,11 @@
 #include "CIgniteLog.h"
 #include "CIgniteEvent.h"
 #include "CIgniteDateTime.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+#include <thread>
 
 // Macro for test_CIgniteEventSender string
 #ifdef PREFIX
@@ -36,6 +41,58 @@ static const std::string IPADDRESS = "127.0.0.1";
 namespace ic_event 
 {
 
+namespace
+{
+// Socket path of the test server receiving the batched events
+const std::string BATCH_TEST_SOCKET = "/tmp/ic_test_batch_socket";
+
+/**
+ * Method to open a UNIX socket server for the batched events
+ * @param void
+ * @return Listening socket
+ */
+int OpenTestServer()
+{
+    unlink(BATCH_TEST_SOCKET.c_str());
+    int nServer = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un stAddr = {};
+    stAddr.sun_family = AF_UNIX;
+    strncpy(stAddr.sun_path, BATCH_TEST_SOCKET.c_str(), sizeof(stAddr.sun_path) - 1);
+    bind(nServer, (struct sockaddr*)&stAddr, sizeof(stAddr));
+    listen(nServer, 1);
+    return nServer;
+}
+
+/**
+ * Method to read the given number of event messages from the socket
+ * @param[in] nSocket Connected socket
+ * @param[in] unCount Number of messages to be read
+ * @return Payloads of the messages read
+ */
+std::vector<std::string> ReadEvents(int nSocket, unsigned int unCount)
+{
+    std::vector<std::string> vecEvents;
+    std::vector<char> vecBuffer(CIgniteMessage::MAX_SERIALIZED_SIZE);
+    for (unsigned int i = 0; i < unCount; i++)
+    {
+        if (recv(nSocket, vecBuffer.data(), CIgniteMessage::MSG_HEADER_SIZE, MSG_WAITALL) !=
+            (ssize_t)CIgniteMessage::MSG_HEADER_SIZE)
+        {
+            break;
+        }
+        int nLen = CIgniteMessage::GetMessageSize(vecBuffer.data());
+        if ((nLen > 0) && (recv(nSocket, vecBuffer.data() + CIgniteMessage::MSG_HEADER_SIZE, nLen, MSG_WAITALL) != nLen))
+        {
+            break;
+        }
+        CIgniteMessage msg(vecBuffer.data());
+        EXPECT_EQ(CMessageTypes::eEVENT, msg.GetType());
+        vecEvents.push_back(msg.GetMessageAsString());
+    }
+    return vecEvents;
+}
+} /* namespace */
+
 // Class CIgniteEventSenderTest defines a test feature for CIgniteEventSender class
 class CIgniteEventSenderTest : public ::testing::Test 
 {
@@ -188,4 +245,91 @@ TEST_F(CIgniteEventSenderTest, Test_send_bySetting_socketTypeAs_ipSocket_byPassi
     EXPECT_EQ(-1, eventSenderObj.Send(strSerializedEvent));
 }
 
+TEST_F(CIgniteEventSenderTest, Test_batching_flushes_events_in_order)
+{
+    int nServer = OpenTestServer();
+    CIgniteEventSender eventSenderObj(BATCH_TEST_SOCKET);
+
+    // large thresholds, so that only the explicit flush writes the events
+    eventSenderObj.EnableBatching(1024 * 1024, 60000);
+    EXPECT_TRUE(eventSenderObj.IsBatchingEnabled());
+
+    for (int i = 0; i < 100; i++)
+    {
+        // Expecting 0 as the event is buffered without being written
+        EXPECT_EQ(0, eventSenderObj.Send("{\"EventID\":\"E" + std::to_string(i) + "\"}"));
+    }
+    EXPECT_EQ(0, eventSenderObj.Flush());
+
+    int nClient = accept(nServer, NULL, NULL);
+    std::vector<std::string> vecEvents = ReadEvents(nClient, 100);
+    ASSERT_EQ(100u, vecEvents.size());
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ("{\"EventID\":\"E" + std::to_string(i) + "\"}", vecEvents[i]);
+    }
+
+    eventSenderObj.DisableBatching();
+    EXPECT_FALSE(eventSenderObj.IsBatchingEnabled());
+    close(nClient);
+    close(nServer);
+    unlink(BATCH_TEST_SOCKET.c_str());
+}
+
+TEST_F(CIgniteEventSenderTest, Test_unbatched_send_waits_for_remaining_batch)
+{
+    int nServer = OpenTestServer();
+    CIgniteEventSender eventSenderObj(BATCH_TEST_SOCKET);
+    eventSenderObj.EnableBatching(1024 * 1024, 60000);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(0, eventSenderObj.Send("{\"EventID\":\"E" + std::to_string(i) + "\"}"));
+    }
+
+    // the unbatched event is sent as soon as batching is seen disabled
+    std::thread sender([&eventSenderObj]()
+    {
+        while (eventSenderObj.IsBatchingEnabled())
+        {
+            std::this_thread::yield();
+        }
+        eventSenderObj.Send("{\"EventID\":\"After\"}");
+    });
+    eventSenderObj.DisableBatching();
+
+    // Expecting the unbatched event not to overtake the remaining batch
+    int nClient = accept(nServer, NULL, NULL);
+    std::vector<std::string> vecEvents = ReadEvents(nClient, 101);
+    sender.join();
+    ASSERT_EQ(101u, vecEvents.size());
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ("{\"EventID\":\"E" + std::to_string(i) + "\"}", vecEvents[i]);
+    }
+    EXPECT_EQ("{\"EventID\":\"After\"}", vecEvents[100]);
+
+    close(nClient);
+    close(nServer);
+    unlink(BATCH_TEST_SOCKET.c_str());
+}
+
+TEST_F(CIgniteEventSenderTest, Test_batching_flushes_on_time_threshold)
+{
+    int nServer = OpenTestServer();
+    CIgniteEventSender eventSenderObj(BATCH_TEST_SOCKET);
+    eventSenderObj.EnableBatching(1024 * 1024, 50);
+
+    EXPECT_EQ(0, eventSenderObj.Send("{\"EventID\":\"Timed\"}"));
+
+    // Expecting the flushing thread to write the event after the delay
+    int nClient = accept(nServer, NULL, NULL);
+    std::vector<std::string> vecEvents = ReadEvents(nClient, 1);
+    ASSERT_EQ(1u, vecEvents.size());
+    EXPECT_EQ("{\"EventID\":\"Timed\"}", vecEvents[0]);
+
+    close(nClient);
+    close(nServer);
+    unlink(BATCH_TEST_SOCKET.c_str());
+}
+
 }
@@ -209,6 +209,24 @@ public:
                                    ic_network::HttpErrorCode::eERR_UNKNOWN;
     };
 
+    /**
+     * CDictionaryResponse class to contain the response for compression
+     * dictionary API call.
+     */
+    class CDictionaryResponse
+    {
+    public:
+        //! member variable to hold the http session response code.
+        ic_network::HttpErrorCode m_eHttpSessionErrCode =
+                                   ic_network::HttpErrorCode::eERR_UNKNOWN;
+
+        //! member variable to hold http response code.
+        long m_lHttpRespCode = 0;
+
+        //! member variable to hold the dictionary file content received.
+        std::string m_strDictionary = "";
+    };
+
     /**
      * Method to set actiovation url.
      * @param[in] strUrl The activation url
@@ -267,6 +285,18 @@ public:
     void GetConnectionHealthCheckStatus(CIgniteConnHealthCheckResponse &rResp,
                                         std::string strUrl= "");
 
+    /**
+     * Method to download the compression dictionary distributed by the cloud.
+     * @param[in] rstrToken Access token authorizing the request
+     * @param[out] rResp The dictionary response from cloud
+     * @see CIgniteHTTPConnector::CDictionaryResponse
+     * @param[in] rstrUrl Dictionary url
+     * @return void
+     */
+    void GetCompressionDictionary(const std::string &rstrToken,
+                                  CDictionaryResponse &rResp,
+                                  const std::string &rstrUrl);
+
 private:
     /**
      * Default no-argument constructor.
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+********************************************************************************
+* \file CIgniteDictionaryAPI.h
+*
+* \brief This class provides the necessary interfaces to download the upload  *
+*        compression dictionary                                                *
+********************************************************************************
+*/
+
+#ifndef CIGNITE_DICTIONARY_API_H
+#define CIGNITE_DICTIONARY_API_H
+
+#include "CIgniteHTTPConnector.h"
+
+namespace ic_network
+{
+
+/**
+ * CIgniteDictionaryAPI class exposing APIs necessary for downloading the
+ * compression dictionary distributed by the cloud.
+ */
+class CIgniteDictionaryAPI
+{
+public:
+    /**
+     * Default no-argument constructor.
+     */
+    CIgniteDictionaryAPI();
+
+    /**
+     *  Destructor.
+     */
+    ~CIgniteDictionaryAPI();
+
+    /**
+     * Method to download the compression dictionary.
+     * @param[in] rstrToken Access token authorizing the request
+     * @param[out] rResp Dictionary response from cloud
+     * @see CIgniteHTTPConnector::CDictionaryResponse
+     * @param[in] rstrUrl Dictionary API url
+     * @return void
+     */
+    void FetchDictionary(const std::string &rstrToken,
+                         CIgniteHTTPConnector::CDictionaryResponse &rResp,
+                         const std::string &rstrUrl);
+};
+
+} //namespace
+#endif // CIGNITE_DICTIONARY_API_H
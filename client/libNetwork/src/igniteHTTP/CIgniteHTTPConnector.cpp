@@ -20,6 +20,7 @@
 #include "CIgniteActivationAPI.h"
 #include "CIgniteAuthTokenAPI.h"
 #include "CIgniteConnHealthCheckAPI.h"
+#include "CIgniteDictionaryAPI.h"
 
 #ifdef PREFIX
 #undef PREFIX
@@ -137,5 +138,22 @@ void CIgniteHTTPConnector::GetConnectionHealthCheckStatus(
     }
 }
 
+void CIgniteHTTPConnector::GetCompressionDictionary(const std::string &rstrToken,
+                                            CDictionaryResponse &rResp,
+                                            const std::string &rstrUrl)
+{
+    HCPLOG_METHOD();
+    if (!rstrUrl.empty())
+    {
+        CIgniteDictionaryAPI dictionaryApi;
+        dictionaryApi.FetchDictionary(rstrToken, rResp, rstrUrl);
+    }
+    else
+    {
+        HCPLOG_E << "dictionary URL not set";
+        rResp.m_eHttpSessionErrCode = ic_network::HttpErrorCode::eERR_INV_INPUT;
+    }
+}
+
 
 } //namespace
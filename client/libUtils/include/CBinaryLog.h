@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+*******************************************************************************
+* \file CBinaryLog.h
+*
+* \brief This file provides the encoding of binary log files and their
+* decoding back to the text log layout
+*******************************************************************************
+*/
+
+#ifndef CBINARY_LOG_H
+#define CBINARY_LOG_H
+
+#include <time.h>
+#include <string>
+#include <map>
+
+namespace ic_utils
+{
+//! Magic at the start of a binary log file
+const std::string BINARY_LOG_MAGIC("ICBLOG1\n");
+
+/**
+ * Types of the records of a binary log file
+ */
+enum BinaryLogRecordType
+{
+    eBLOG_RECORD_SITE = 'S',    ///< Text of a log statement site
+    eBLOG_RECORD_LOG = 'L',     ///< Log statement
+    eBLOG_RECORD_TEXT = 'T',    ///< Plain text, e.g. the status block
+    eBLOG_RECORD_ZONE = 'Z'     ///< UTC offset of the device local time
+};
+
+/**
+ * Types of the arguments of a log statement record
+ */
+enum BinaryLogArgType
+{
+    eBLOG_ARG_INT = 1,          ///< Signed integer, zigzag varint
+    eBLOG_ARG_UINT = 2,         ///< Unsigned integer, varint
+    eBLOG_ARG_DOUBLE = 3,       ///< IEEE 754 double, little endian
+    eBLOG_ARG_STRING = 4        ///< Varint length and bytes
+};
+
+/**
+ * class CBinaryLogCodec encodes the records of a binary log file. All
+ * integers are varints so that the file does not depend on the byte order
+ * or word size of the device.
+ */
+class CBinaryLogCodec
+{
+public:
+    /**
+     * Method to append a varint
+     * @param[in] ullValue Value
+     * @param[out] rstrOut String the varint is appended to
+     * @return void
+     */
+    static void AppendVarint(unsigned long long ullValue, std::string &rstrOut);
+
+    /**
+     * Method to read a varint
+     * @param[in] rstrIn Encoded data
+     * @param[in,out] rnPos Position of the varint, moved past it
+     * @param[out] rullValue Value
+     * @return true if read, false if the data ends within the varint
+     */
+    static bool ReadVarint(const std::string &rstrIn, size_t &rnPos,
+                           unsigned long long &rullValue);
+
+    /**
+     * Method to append a signed integer argument
+     * @param[in] llValue Value
+     * @param[out] rstrArgs Arguments the value is appended to
+     * @return void
+     */
+    static void AppendInt(const long long llValue, std::string &rstrArgs);
+
+    /**
+     * Method to append an unsigned integer argument
+     * @param[in] ullValue Value
+     * @param[out] rstrArgs Arguments the value is appended to
+     * @return void
+     */
+    static void AppendUInt(const unsigned long long ullValue,
+                           std::string &rstrArgs);
+
+    /**
+     * Method to append a floating point argument
+     * @param[in] dValue Value
+     * @param[out] rstrArgs Arguments the value is appended to
+     * @return void
+     */
+    static void AppendDouble(const double dValue, std::string &rstrArgs);
+
+    /**
+     * Method to append a string argument
+     * @param[in] pchData String
+     * @param[in] nSize Size of the string
+     * @param[out] rstrArgs Arguments the string is appended to
+     * @return void
+     */
+    static void AppendString(const char *pchData, const size_t nSize,
+                             std::string &rstrArgs);
+
+    /**
+     * Method to format arguments the way an ostream formats them by default
+     * @param[in] rstrArgs Encoded arguments
+     * @param[out] rstrOut String the formatted arguments are appended to
+     * @return true if all arguments are formatted, false if malformed
+     */
+    static bool FormatArgs(const std::string &rstrArgs, std::string &rstrOut);
+
+    /**
+     * Method to encode the record of a log statement site
+     * @param[in] unSiteId Identifier of the site
+     * @param[in] rstrText Text of the site
+     * @param[out] rstrOut String the record is appended to
+     * @return void
+     */
+    static void EncodeSite(const unsigned int unSiteId,
+                           const std::string &rstrText, std::string &rstrOut);
+
+    /**
+     * Method to encode the record of a log statement
+     * @param[in] unSiteId Identifier of the site, 0 for none
+     * @param[in] nLevel Log level
+     * @param[in] ullTimeUs Time in microseconds since the epoch
+     * @param[in] ullThreadId Identifier of the logging thread
+     * @param[in] rstrArgs Encoded arguments
+     * @param[out] rstrOut String the record is appended to
+     * @return void
+     */
+    static void EncodeLog(const unsigned int unSiteId, const int nLevel,
+                          const unsigned long long ullTimeUs,
+                          const unsigned long long ullThreadId,
+                          const std::string &rstrArgs, std::string &rstrOut);
+
+    /**
+     * Method to encode a plain text record
+     * @param[in] rstrText Text
+     * @param[out] rstrOut String the record is appended to
+     * @return void
+     */
+    static void EncodeText(const std::string &rstrText, std::string &rstrOut);
+
+    /**
+     * Method to encode the UTC offset of the device local time
+     * @param[in] lUtcOffset Offset in seconds
+     * @param[out] rstrOut String the record is appended to
+     * @return void
+     */
+    static void EncodeZone(const long lUtcOffset, std::string &rstrOut);
+};
+
+/**
+ * class CLogLineFormatter formats a log line in the text log layout
+ * "HH:MM:SS.mmm L thread: site message"
+ */
+class CLogLineFormatter
+{
+public:
+    /**
+     * Default constructor, formats the device local time
+     */
+    CLogLineFormatter();
+
+    /**
+     * Method to format the time with a fixed UTC offset instead of the local
+     * time zone, used when decoding on another host
+     * @param[in] lUtcOffset Offset in seconds
+     * @return void
+     */
+    void SetUtcOffset(const long lUtcOffset);
+
+    /**
+     * Method to format a log line
+     * @param[in] nLevel Log level
+     * @param[in] ullTimeUs Time in microseconds since the epoch
+     * @param[in] ullThreadId Identifier of the logging thread
+     * @param[in] rstrSite Text of the log statement site
+     * @param[in] rstrMessage Message
+     * @param[out] rstrOut String the line is appended to
+     * @return void
+     */
+    void Format(const int nLevel, const unsigned long long ullTimeUs,
+                const unsigned long long ullThreadId,
+                const std::string &rstrSite, const std::string &rstrMessage,
+                std::string &rstrOut);
+
+    /**
+     * Method to get the name of a log level as shown in the log
+     * @param[in] nLevel Log level
+     * @return Name of the level
+     */
+    static const char *GetLevelName(const int nLevel);
+
+private:
+    //! Flag indicating the time is formatted with m_lUtcOffset
+    bool m_bFixedOffset;
+
+    //! UTC offset in seconds
+    long m_lUtcOffset;
+
+    //! Flag indicating m_chCachedTime is valid
+    bool m_bCached;
+
+    //! Second of the cached time
+    time_t m_cachedSecond;
+
+    //! Cached "HH:MM:SS" of m_cachedSecond
+    char m_chCachedTime[11];
+};
+
+/**
+ * class CBinaryLogDecoder turns a binary log file back into the text log
+ */
+class CBinaryLogDecoder
+{
+public:
+    /**
+     * Default constructor
+     */
+    CBinaryLogDecoder();
+
+    /**
+     * Method to decode the content of a binary log file. A record cut off at
+     * the end, e.g. by a reset while writing, ends the decoding.
+     * @param[in] rstrIn Content of the file
+     * @param[out] rstrOut String the text log is appended to
+     * @return true if the whole content is decoded, false otherwise
+     */
+    bool Decode(const std::string &rstrIn, std::string &rstrOut);
+
+private:
+    /**
+     * Method to decode one record
+     * @param[in] rstrIn Content of the file
+     * @param[in,out] rnPos Position of the record, moved past it
+     * @param[out] rstrOut String the text log is appended to
+     * @return true if decoded, false if malformed
+     */
+    bool DecodeRecord(const std::string &rstrIn, size_t &rnPos,
+                      std::string &rstrOut);
+
+    //! Text of the sites by identifier
+    std::map<unsigned long long, std::string> m_mapSites;
+
+    //! Formatter of the log lines
+    CLogLineFormatter m_formatter;
+};
+
+} /* namespace ic_utils */
+
+#endif /* CBINARY_LOG_H */
@@ -0,0 +1,731 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+*******************************************************************************
+* \file CBoundedQueue.h
+*
+* \brief CBoundedQueue provides a bounded, lock-free multi-producer ring buffer
+* with a selectable overflow policy and item/byte accounting.
+*******************************************************************************
+*/
+
+#ifndef CBOUNDED_QUEUE_H
+#define CBOUNDED_QUEUE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "CConcurrentQueue.h"
+#include "CIgniteMutex.h"
+#include "CIgniteDateTime.h"
+#include "CIgniteLog.h"
+
+/* The queue is included by other modules; it logs under its own name through
+ * a local macro instead of redefining the PREFIX of the including file
+ */
+#ifdef SHORT_LOG_MSG
+    #define CBOUNDED_QUEUE_LOG(level) HCPLOG_SITE(level, "CBoundedQueue::", \
+        __func__, __LINE__, " ")
+#else
+    #define CBOUNDED_QUEUE_LOG(level) HCPLOG_SITE(level, "", \
+        __PRETTY_FUNCTION__, __LINE__, " ")
+#endif
+
+namespace ic_utils
+{
+/**
+ * Policy applied by CBoundedQueue when an item does not fit into the queue
+ */
+typedef enum
+{
+    eOVERFLOW_BLOCK,         ///< Wait for free space up to the put timeout
+    eOVERFLOW_DROP_OLDEST,   ///< Evict the oldest items to make room
+    eOVERFLOW_DROP_NEWEST,   ///< Reject the item being put
+    eOVERFLOW_SPILL_TO_DISK  ///< Append the item to the spill file
+} OverflowPolicy;
+
+/**
+ * Accounting of a CBoundedQueue
+ */
+typedef struct
+{
+    //! Items held in memory
+    unsigned int unItems;
+
+    //! Data size of the items held in memory
+    unsigned long long ullBytes;
+
+    //! Items held in the spill file
+    unsigned int unSpilledItems;
+
+    //! Data size of the items held in the spill file
+    unsigned long long ullSpilledBytes;
+
+    //! Total items accepted by the queue
+    unsigned long long ullPutCount;
+
+    //! Total items taken out of the queue
+    unsigned long long ullTakeCount;
+
+    //! Total items lost due to overflow
+    unsigned long long ullDroppedCount;
+
+    //! Total items written to the spill file
+    unsigned long long ullSpillCount;
+} QueueStats;
+
+/**
+ * A bounded queue built on a ring buffer of pre-allocated cells. Put never
+ * takes a lock unless the queue is full; what happens then is decided by the
+ * OverflowPolicy. The queue is meant for many producers and a single
+ * consumer, Take is nevertheless safe to call from the producers as well
+ * (eOVERFLOW_DROP_OLDEST relies on it).
+ *
+ * The queue is bounded by the number of cells and, optionally, by the sum of
+ * the data sizes given to Put (usually the payload size in bytes).
+ * @tparam Data The type of data stored in the queue; must be default
+ *              constructible and copy assignable.
+ */
+template <class Data>
+class CBoundedQueue : public CQueue<Data>
+{
+public:
+    //! Function to serialize an item into the spill file
+    typedef bool (*SpillEncoder)(const Data &rData, std::string &rstrOut);
+
+    //! Function to deserialize an item from the spill file
+    typedef bool (*SpillDecoder)(const std::string &rstrIn, Data &rData);
+
+    /**
+     * Parameterized constructor
+     * @param[in] unCapacity Maximum number of items; rounded up to the next
+     *                       power of two
+     * @param[in] ullMaxBytes Maximum sum of the data sizes, 0 for no limit
+     * @param[in] ePolicy Policy applied when the queue is full
+     * @param[in] unPutTimeoutMs Maximum wait of Put for eOVERFLOW_BLOCK
+     */
+    CBoundedQueue(unsigned int unCapacity,
+                  unsigned long long ullMaxBytes = 0,
+                  OverflowPolicy ePolicy = eOVERFLOW_DROP_NEWEST,
+                  unsigned int unPutTimeoutMs = 0);
+
+    /**
+     * Destructor
+     */
+    ~CBoundedQueue();
+
+    /**
+     * Method to enable the spill file used by eOVERFLOW_SPILL_TO_DISK. Until
+     * it is enabled, the spill policy behaves like eOVERFLOW_DROP_NEWEST.
+     * @param[in] rstrPath Path of the spill file; truncated when opened and
+     *                     removed when the queue is destroyed
+     * @param[in] pfnEncoder Function to serialize an item
+     * @param[in] pfnDecoder Function to deserialize an item
+     * @return true if the spill file is opened, false otherwise
+     */
+    bool EnableSpill(const std::string &rstrPath, SpillEncoder pfnEncoder,
+                     SpillDecoder pfnDecoder);
+
+    /**
+     * Method to insert data into the queue.
+     * @param[in] data The data to be inserted.
+     * @param[in] unDataSize The size of the data (optional, default is 1).
+     * @return True if the data is accepted, false if it is dropped.
+     */
+    bool Put(Data data, unsigned int unDataSize = 1) override;
+
+    /**
+     * Method to retrieve data from the queue.
+     * @param[out] pData Pointer to store the retrieved data.
+     * @return True if data is successfully retrieved, false if the queue is
+     *         empty.
+     */
+    bool Take(Data *pData) override;
+
+    /**
+     * Method to get the sum of the data sizes of the queued items, including
+     * the spilled ones.
+     * @param void
+     * @return The size of the queue.
+     */
+    unsigned int Size() override;
+
+    /**
+     * Method to get the number of queued items, including the spilled ones.
+     * @param void
+     * @return The number of items in the queue.
+     */
+    unsigned int GetItemCount();
+
+    /**
+     * Method to get the accounting of the queue.
+     * @param void
+     * @return Snapshot of the queue statistics.
+     */
+    QueueStats GetStats();
+
+private:
+    //! Cell of the ring buffer
+    struct Cell
+    {
+        //! Sequence number telling whether the cell is free or filled
+        std::atomic<size_t> atomicSeq;
+
+        //! Stored item
+        Data value;
+
+        //! Data size of the stored item
+        unsigned int unSize;
+    };
+
+    /**
+     * Method to reserve the data size and store the item in a free cell
+     * @param[in] rData Item to be stored
+     * @param[in] unDataSize Data size of the item
+     * @return true if the item is stored, false if the queue is full
+     */
+    bool TryPut(const Data &rData, unsigned int unDataSize);
+
+    /**
+     * Method to take the oldest item from the ring buffer
+     * @param[out] pData Item taken, ignored if NULL
+     * @return true if an item is taken, false if the ring buffer is empty
+     */
+    bool TryTake(Data *pData);
+
+    /**
+     * Method to wait until the item is stored or the put timeout expires
+     * @param[in] rData Item to be stored
+     * @param[in] unDataSize Data size of the item
+     * @return true if the item is stored, false otherwise
+     */
+    bool PutBlocking(const Data &rData, unsigned int unDataSize);
+
+    /**
+     * Method to evict the oldest items until the given item is stored
+     * @param[in] rData Item to be stored
+     * @param[in] unDataSize Data size of the item
+     * @return true if the item is stored, false otherwise
+     */
+    bool PutDropOldest(const Data &rData, unsigned int unDataSize);
+
+    /**
+     * Method to append the item to the spill file
+     * @param[in] rData Item to be stored
+     * @param[in] unDataSize Data size of the item
+     * @return true if the item is stored, false otherwise
+     */
+    bool PutSpill(const Data &rData, unsigned int unDataSize);
+
+    /**
+     * Method to take the oldest item from the spill file
+     * @param[out] pData Item taken
+     * @return true if an item is taken, false if the spill file is empty
+     */
+    bool TakeSpill(Data *pData);
+
+    /**
+     * Method to wake up the producers waiting for free space
+     * @param void
+     * @return void
+     */
+    void WakeProducers();
+
+    /**
+     * Copy constructor is not supported
+     */
+    CBoundedQueue(const CBoundedQueue &) = delete;
+
+    /**
+     * Assignment operator is not supported
+     */
+    CBoundedQueue &operator=(const CBoundedQueue &) = delete;
+
+    //! Cells of the ring buffer
+    std::unique_ptr<Cell[]> m_pCells;
+
+    //! Mask to map a position to its cell; capacity - 1
+    size_t m_nMask;
+
+    //! Maximum sum of the data sizes, 0 for no limit
+    unsigned long long m_ullMaxBytes;
+
+    //! Policy applied when the queue is full
+    OverflowPolicy m_ePolicy;
+
+    //! Maximum wait of Put for eOVERFLOW_BLOCK
+    unsigned int m_unPutTimeoutMs;
+
+    //! Next position to be written; kept apart from the read position
+    alignas(64) std::atomic<size_t> m_atomicPutPos;
+
+    //! Next position to be read
+    alignas(64) std::atomic<size_t> m_atomicTakePos;
+
+    //! Items held in memory
+    std::atomic<unsigned int> m_atomicItems;
+
+    //! Data size of the items held in memory
+    std::atomic<unsigned long long> m_atomicBytes;
+
+    //! Total items accepted by the queue
+    std::atomic<unsigned long long> m_atomicPutCount;
+
+    //! Total items taken out of the queue
+    std::atomic<unsigned long long> m_atomicTakeCount;
+
+    //! Total items lost due to overflow
+    std::atomic<unsigned long long> m_atomicDroppedCount;
+
+    //! Producers waiting for free space
+    std::atomic<unsigned int> m_atomicWaiters;
+
+    //! Mutex used by the producers waiting for free space
+    CIgniteMutex m_waitMutex;
+
+    //! Condition signalled when space is freed
+    CThreadCondition m_spaceCondition;
+
+    //! Items held in the spill file
+    std::atomic<unsigned int> m_atomicSpilledItems;
+
+    //! Data size of the items held in the spill file
+    std::atomic<unsigned long long> m_atomicSpilledBytes;
+
+    //! Total items written to the spill file
+    std::atomic<unsigned long long> m_atomicSpillCount;
+
+    //! Mutex guarding the spill file
+    CIgniteMutex m_spillMutex;
+
+    //! Spill file, NULL if spilling is not enabled
+    FILE *m_pSpillFile;
+
+    //! Path of the spill file
+    std::string m_strSpillPath;
+
+    //! Offset of the next record to be read from the spill file
+    long m_lSpillReadOffset;
+
+    //! Function to serialize an item into the spill file
+    SpillEncoder m_pfnEncoder;
+
+    //! Function to deserialize an item from the spill file
+    SpillDecoder m_pfnDecoder;
+};
+
+template <class Data>
+CBoundedQueue<Data>::CBoundedQueue(unsigned int unCapacity,
+                                   unsigned long long ullMaxBytes,
+                                   OverflowPolicy ePolicy,
+                                   unsigned int unPutTimeoutMs)
+    : m_ullMaxBytes(ullMaxBytes), m_ePolicy(ePolicy),
+      m_unPutTimeoutMs(unPutTimeoutMs), m_atomicPutPos(0), m_atomicTakePos(0),
+      m_atomicItems(0), m_atomicBytes(0), m_atomicPutCount(0),
+      m_atomicTakeCount(0), m_atomicDroppedCount(0), m_atomicWaiters(0),
+      m_atomicSpilledItems(0), m_atomicSpilledBytes(0), m_atomicSpillCount(0),
+      m_pSpillFile(NULL), m_lSpillReadOffset(0), m_pfnEncoder(NULL),
+      m_pfnDecoder(NULL)
+{
+    size_t nCapacity = 2;
+    while (nCapacity < unCapacity)
+    {
+        nCapacity <<= 1;
+    }
+    m_nMask = nCapacity - 1;
+
+    m_pCells.reset(new Cell[nCapacity]);
+    for (size_t nIndex = 0; nIndex < nCapacity; nIndex++)
+    {
+        m_pCells[nIndex].atomicSeq.store(nIndex, std::memory_order_relaxed);
+        m_pCells[nIndex].unSize = 0;
+    }
+}
+
+template <class Data>
+CBoundedQueue<Data>::~CBoundedQueue()
+{
+    if (NULL != m_pSpillFile)
+    {
+        fclose(m_pSpillFile);
+        unlink(m_strSpillPath.c_str());
+    }
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::EnableSpill(const std::string &rstrPath,
+                                      SpillEncoder pfnEncoder,
+                                      SpillDecoder pfnDecoder)
+{
+    CScopeLock lock(m_spillMutex);
+    if (NULL != m_pSpillFile || NULL == pfnEncoder || NULL == pfnDecoder)
+    {
+        return false;
+    }
+
+    m_pSpillFile = fopen(rstrPath.c_str(), "w+b");
+    if (NULL == m_pSpillFile)
+    {
+        CBOUNDED_QUEUE_LOG(ic_utils::eHCP_LOG_ERROR) << "Failed to open spill file " << rstrPath;
+        return false;
+    }
+    m_strSpillPath = rstrPath;
+    m_pfnEncoder = pfnEncoder;
+    m_pfnDecoder = pfnDecoder;
+    return true;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::TryPut(const Data &rData, unsigned int unDataSize)
+{
+    if (0 != m_ullMaxBytes)
+    {
+        /* an item larger than the limit is still accepted by an empty queue,
+         * otherwise it could never be queued
+         */
+        unsigned long long ullBytes = m_atomicBytes.fetch_add(unDataSize);
+        if (0 != ullBytes && (ullBytes + unDataSize) > m_ullMaxBytes)
+        {
+            m_atomicBytes.fetch_sub(unDataSize);
+            return false;
+        }
+    }
+
+    Cell *pCell = NULL;
+    size_t nPos = m_atomicPutPos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        pCell = &m_pCells[nPos & m_nMask];
+        size_t nSeq = pCell->atomicSeq.load(std::memory_order_acquire);
+        intptr_t nDiff = (intptr_t)nSeq - (intptr_t)nPos;
+        if (0 == nDiff)
+        {
+            if (m_atomicPutPos.compare_exchange_weak(nPos, nPos + 1,
+                                                     std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (nDiff < 0)
+        {
+            if (0 != m_ullMaxBytes)
+            {
+                m_atomicBytes.fetch_sub(unDataSize);
+            }
+            return false;
+        }
+        else
+        {
+            nPos = m_atomicPutPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    pCell->value = rData;
+    pCell->unSize = unDataSize;
+    if (0 == m_ullMaxBytes)
+    {
+        m_atomicBytes.fetch_add(unDataSize);
+    }
+    m_atomicItems.fetch_add(1);
+    pCell->atomicSeq.store(nPos + 1, std::memory_order_release);
+    return true;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::TryTake(Data *pData)
+{
+    Cell *pCell = NULL;
+    size_t nPos = m_atomicTakePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        pCell = &m_pCells[nPos & m_nMask];
+        size_t nSeq = pCell->atomicSeq.load(std::memory_order_acquire);
+        intptr_t nDiff = (intptr_t)nSeq - (intptr_t)(nPos + 1);
+        if (0 == nDiff)
+        {
+            if (m_atomicTakePos.compare_exchange_weak(nPos, nPos + 1,
+                                                      std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (nDiff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            nPos = m_atomicTakePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (NULL != pData)
+    {
+        *pData = pCell->value;
+    }
+    pCell->value = Data();
+    m_atomicBytes.fetch_sub(pCell->unSize);
+    m_atomicItems.fetch_sub(1);
+    pCell->atomicSeq.store(nPos + m_nMask + 1, std::memory_order_release);
+    return true;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::Put(Data data, unsigned int unDataSize)
+{
+    bool bStored = false;
+    if (0 == m_atomicSpilledItems.load())
+    {
+        bStored = TryPut(data, unDataSize);
+    }
+
+    if (!bStored)
+    {
+        switch (m_ePolicy)
+        {
+        case eOVERFLOW_BLOCK:
+            bStored = PutBlocking(data, unDataSize);
+            break;
+        case eOVERFLOW_DROP_OLDEST:
+            bStored = PutDropOldest(data, unDataSize);
+            break;
+        case eOVERFLOW_SPILL_TO_DISK:
+            bStored = PutSpill(data, unDataSize);
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (bStored)
+    {
+        m_atomicPutCount.fetch_add(1);
+    }
+    else
+    {
+        m_atomicDroppedCount.fetch_add(1);
+    }
+    return bStored;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::PutBlocking(const Data &rData,
+                                      unsigned int unDataSize)
+{
+    unsigned long long ullDeadline =
+        CIgniteDateTime::GetMonotonicTimeMs() + m_unPutTimeoutMs;
+
+    m_waitMutex.Lock();
+    m_atomicWaiters.fetch_add(1);
+    bool bStored = TryPut(rData, unDataSize);
+    while (!bStored)
+    {
+        unsigned long long ullNow = CIgniteDateTime::GetMonotonicTimeMs();
+        if (ullNow >= ullDeadline)
+        {
+            break;
+        }
+        m_spaceCondition.ConditionTimedwait(m_waitMutex,
+                                            (unsigned int)(ullDeadline - ullNow));
+        bStored = TryPut(rData, unDataSize);
+    }
+    m_atomicWaiters.fetch_sub(1);
+    m_waitMutex.Unlock();
+    return bStored;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::PutDropOldest(const Data &rData,
+                                        unsigned int unDataSize)
+{
+    bool bStored = false;
+    while (!bStored)
+    {
+        if (TryTake(NULL))
+        {
+            m_atomicDroppedCount.fetch_add(1);
+        }
+        else if (0 == m_atomicItems.load())
+        {
+            /* nothing left to evict; the consumer or another producer is
+             * in the middle of taking the last item, so just retry
+             */
+            usleep(0);
+        }
+        bStored = TryPut(rData, unDataSize);
+    }
+    return bStored;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::PutSpill(const Data &rData, unsigned int unDataSize)
+{
+    CScopeLock lock(m_spillMutex);
+    if (NULL == m_pSpillFile)
+    {
+        return false;
+    }
+
+    std::string strRecord;
+    if (!m_pfnEncoder(rData, strRecord))
+    {
+        CBOUNDED_QUEUE_LOG(ic_utils::eHCP_LOG_ERROR) << "Failed to serialize item for spilling";
+        return false;
+    }
+
+    uint32_t unHeader[2] = {unDataSize, (uint32_t)strRecord.size()};
+    if (0 != fseek(m_pSpillFile, 0, SEEK_END) ||
+        1 != fwrite(unHeader, sizeof(unHeader), 1, m_pSpillFile) ||
+        (!strRecord.empty() &&
+         1 != fwrite(strRecord.data(), strRecord.size(), 1, m_pSpillFile)))
+    {
+        CBOUNDED_QUEUE_LOG(ic_utils::eHCP_LOG_ERROR) << "Failed to write spill file " << m_strSpillPath;
+        return false;
+    }
+
+    m_atomicSpilledBytes.fetch_add(unDataSize);
+    m_atomicSpilledItems.fetch_add(1);
+    m_atomicSpillCount.fetch_add(1);
+    return true;
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::TakeSpill(Data *pData)
+{
+    CScopeLock lock(m_spillMutex);
+    if (NULL == m_pSpillFile || 0 == m_atomicSpilledItems.load())
+    {
+        return false;
+    }
+
+    fflush(m_pSpillFile);
+    uint32_t unHeader[2] = {0, 0};
+    std::string strRecord;
+    bool bRead = (0 == fseek(m_pSpillFile, m_lSpillReadOffset, SEEK_SET)) &&
+                 (1 == fread(unHeader, sizeof(unHeader), 1, m_pSpillFile));
+    if (bRead && 0 != unHeader[1])
+    {
+        strRecord.resize(unHeader[1]);
+        bRead = (1 == fread(&strRecord[0], unHeader[1], 1, m_pSpillFile));
+    }
+
+    if (!bRead)
+    {
+        // spill file is unreadable; whatever was spilled is lost
+        CBOUNDED_QUEUE_LOG(ic_utils::eHCP_LOG_ERROR) << "Failed to read spill file "
+            << m_strSpillPath << "; dropping " << m_atomicSpilledItems.load()
+            << " items";
+        m_atomicDroppedCount.fetch_add(m_atomicSpilledItems.exchange(0));
+        m_atomicSpilledBytes.store(0);
+    }
+    else
+    {
+        m_lSpillReadOffset += sizeof(unHeader) + unHeader[1];
+        m_atomicSpilledBytes.fetch_sub(unHeader[0]);
+        m_atomicSpilledItems.fetch_sub(1);
+        if (!m_pfnDecoder(strRecord, *pData))
+        {
+            CBOUNDED_QUEUE_LOG(ic_utils::eHCP_LOG_ERROR) << "Failed to deserialize spilled item";
+            m_atomicDroppedCount.fetch_add(1);
+            bRead = false;
+        }
+    }
+
+    if (0 == m_atomicSpilledItems.load())
+    {
+        // all spilled items are consumed, start over with an empty file
+        if (0 != ftruncate(fileno(m_pSpillFile), 0))
+        {
+            CBOUNDED_QUEUE_LOG(ic_utils::eHCP_LOG_WARNING) << "Failed to truncate spill file " << m_strSpillPath;
+        }
+        m_lSpillReadOffset = 0;
+    }
+    return bRead;
+}
+
+template <class Data>
+void CBoundedQueue<Data>::WakeProducers()
+{
+    if (0 != m_atomicWaiters.load())
+    {
+        CScopeLock lock(m_waitMutex);
+        m_spaceCondition.ConditionBroadcast();
+    }
+}
+
+template <class Data>
+bool CBoundedQueue<Data>::Take(Data *pData)
+{
+    /* items in memory are always older than the spilled ones, since Put
+     * keeps spilling as long as the spill file is not drained
+     */
+    bool bTaken = TryTake(pData);
+    if (bTaken)
+    {
+        WakeProducers();
+    }
+    else
+    {
+        while (0 != m_atomicSpilledItems.load() && !bTaken)
+        {
+            bTaken = TakeSpill(pData);
+        }
+    }
+
+    if (bTaken)
+    {
+        m_atomicTakeCount.fetch_add(1);
+    }
+    return bTaken;
+}
+
+template <class Data>
+unsigned int CBoundedQueue<Data>::Size()
+{
+    return (unsigned int)(m_atomicBytes.load() + m_atomicSpilledBytes.load());
+}
+
+template <class Data>
+unsigned int CBoundedQueue<Data>::GetItemCount()
+{
+    return m_atomicItems.load() + m_atomicSpilledItems.load();
+}
+
+template <class Data>
+QueueStats CBoundedQueue<Data>::GetStats()
+{
+    QueueStats stStats;
+    stStats.unItems = m_atomicItems.load();
+    stStats.ullBytes = m_atomicBytes.load();
+    stStats.unSpilledItems = m_atomicSpilledItems.load();
+    stStats.ullSpilledBytes = m_atomicSpilledBytes.load();
+    stStats.ullPutCount = m_atomicPutCount.load();
+    stStats.ullTakeCount = m_atomicTakeCount.load();
+    stStats.ullDroppedCount = m_atomicDroppedCount.load();
+    stStats.ullSpillCount = m_atomicSpillCount.load();
+    return stStats;
+}
+} // namespace ic_utils
+
+#undef CBOUNDED_QUEUE_LOG
+
+#endif /* CBOUNDED_QUEUE_H */
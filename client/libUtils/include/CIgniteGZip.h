@@ -27,6 +27,12 @@
 #ifndef CIGNITE_GZIP_H
 #define CIGNITE_GZIP_H
 
+#include <string>
+#include <vector>
+
+//! zlib stream state, kept opaque to users of this header
+struct z_stream_s;
+
 namespace ic_utils
 {
 /**
@@ -67,5 +73,215 @@ public:
     static CZippedMsg* GzipMsg(unsigned char* puchInMsg, 
                                unsigned int unInMsgSize);
 };
+
+/**
+ * A class providing streaming gzip compression. The deflate state and the
+ * output buffer are kept across messages; Reset() starts a new gzip member
+ * without reallocating them, so one instance serves any number of messages.
+ */
+class CGzipStream
+{
+public:
+    /**
+     * Default no-argument constructor.
+     */
+    CGzipStream();
+
+    /**
+     * Destructor.
+     */
+    ~CGzipStream();
+
+    /**
+     * Method to compress and append data to the current message.
+     * @param[in] pchData Pointer to the data to compress.
+     * @param[in] unSize Size of the data.
+     * @return true on success, false if compression failed or the message is
+     * already finished.
+     */
+    bool Append(const char* pchData, unsigned int unSize);
+
+    /**
+     * Method to compress and append data to the current message.
+     * @param[in] rstrData Data to compress.
+     * @return true on success, false otherwise.
+     */
+    bool Append(const std::string &rstrData);
+
+    /**
+     * Method to finish the current message, flushing the remaining compressed
+     * data and the gzip trailer to the output.
+     * @param void
+     * @return true on success, false otherwise.
+     */
+    bool Finish();
+
+    /**
+     * Method to start a new message, discarding the output of the current one
+     * while keeping the allocated deflate state and output capacity.
+     * @param void
+     * @return true on success, false otherwise.
+     */
+    bool Reset();
+
+    /**
+     * Method to set a preset dictionary used for every following message.
+     * As the gzip format cannot carry a dictionary, messages are produced in
+     * the zlib format while a dictionary is set; its header holds the
+     * dictionary id (Adler-32) the receiver needs to select the dictionary.
+     * Discards the current message.
+     * @param[in] rstrDictionary Dictionary content, empty to go back to gzip
+     * messages without a dictionary.
+     * @return true on success, false otherwise.
+     */
+    bool SetDictionary(const std::string &rstrDictionary);
+
+    /**
+     * Method to get the id of the preset dictionary, i.e. its Adler-32
+     * checksum as carried in the zlib header.
+     * @param void
+     * @return Dictionary id, 0 if no dictionary is set.
+     */
+    unsigned long GetDictionaryId() const;
+
+    /**
+     * Method to get the compressed output of the current message; complete
+     * once Finish() succeeded.
+     * @param void
+     * @return Pointer to the compressed data.
+     */
+    const unsigned char* GetData() const;
+
+    /**
+     * Method to get the size of the compressed output of the current message.
+     * @param void
+     * @return Size of the compressed data.
+     */
+    unsigned int GetSize() const;
+
+    /**
+     * Method to get the total size of the data appended to the current message.
+     * @param void
+     * @return Size of the uncompressed data.
+     */
+    unsigned long GetInputSize() const;
+
+    /**
+     * Method to check whether the current message is finished, i.e. its
+     * compressed output is complete.
+     * @param void
+     * @return true if finished, false otherwise.
+     */
+    bool IsFinished() const;
+
+private:
+    /**
+     * Method to (re)initialize the deflate state.
+     * @param[in] nWindowBits zlib window bits, selecting the wrapper format.
+     * @return true on success, false otherwise.
+     */
+    bool Init(int nWindowBits);
+
+    /**
+     * Method to run deflate over the pending input, growing the output buffer
+     * as needed.
+     * @param[in] nFlush zlib flush mode.
+     * @return true on success, false otherwise.
+     */
+    bool Deflate(int nFlush);
+
+    //! Pointer to the deflate state, NULL if initialization failed.
+    z_stream_s* m_pStream;
+
+    //! Buffer holding the compressed output; its size is the capacity in use.
+    std::vector<unsigned char> m_vecOut;
+
+    //! Size of the compressed output in m_vecOut.
+    unsigned int m_unOutSize;
+
+    //! Boolean indicating whether the current message is finished.
+    bool m_bFinished;
+
+    //! Preset dictionary, empty if none is set.
+    std::string m_strDictionary;
+
+    //! Adler-32 id of the preset dictionary, 0 if none is set.
+    unsigned long m_ulDictionaryId;
+
+    // Not copyable, the deflate state is owned by the instance.
+    CGzipStream(const CGzipStream&);
+    CGzipStream& operator=(const CGzipStream&);
+};
+/**
+ * A class representing a preset dictionary for event compression. The
+ * dictionary is trained from the schemas of events and kept in a JSON file
+ * along with its id, the Adler-32 checksum of its content. Uploads advertise
+ * the id so the receiver can pick the same dictionary.
+ */
+class CGzipDictionary
+{
+public:
+    /**
+     * Default no-argument constructor.
+     */
+    CGzipDictionary();
+
+    /**
+     * Method to load the dictionary from a file.
+     * @param[in] rstrPath Path of the dictionary file.
+     * @return true if a valid dictionary was loaded, false otherwise.
+     */
+    bool Load(const std::string &rstrPath);
+
+    /**
+     * Method to read the dictionary from the content of a dictionary file.
+     * @param[in] rstrContent Content of the dictionary file.
+     * @return true if the content holds a valid dictionary matching its id,
+     * false otherwise.
+     */
+    bool Parse(const std::string &rstrContent);
+
+    /**
+     * Method to save the dictionary to a file.
+     * @param[in] rstrPath Path of the dictionary file.
+     * @return true on success, false otherwise.
+     */
+    bool Save(const std::string &rstrPath) const;
+
+    /**
+     * Method to train the dictionary content from a sample of events. Every
+     * event is reduced to its schema: field names and short string values
+     * (EventID, Version, ...) are kept, other values are dropped. The most
+     * frequent schemas are placed at the end, closest to the data.
+     * @param[in] rvecEvents JSON events to train from.
+     * @param[in] unMaxSize Maximum dictionary size, capped to the deflate
+     * window size.
+     * @return Number of distinct schemas in the dictionary.
+     */
+    unsigned int Train(const std::vector<std::string> &rvecEvents,
+                       unsigned int unMaxSize = MAX_SIZE);
+
+    /**
+     * Method to get the dictionary id, the Adler-32 checksum of its content
+     * which is also the id carried by the zlib header.
+     * @param void
+     * @return Dictionary id, 0 if the dictionary is empty.
+     */
+    unsigned long GetId() const;
+
+    /**
+     * Method to get the dictionary content.
+     * @param void
+     * @return Dictionary content.
+     */
+    const std::string& GetData() const;
+
+    //! Maximum useful dictionary size, the deflate window size
+    static const unsigned int MAX_SIZE = 32768;
+
+private:
+    //! Dictionary content
+    std::string m_strData;
+};
 }/* namespace ic_utils */
 #endif /* CIGNITE_GZIP_H */
@@ -33,57 +33,77 @@
 #include <fstream>
 #include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 #include "CIgniteMutex.h"
 
 #define HCPLOG_METHOD() HCPLOG_T
 #define HCPLOG_LINE() HCPLOG_T
-#define HCPLOG_EXCEPTION(e) HCPLOG(ic_utils::eHCP_LOG_ERROR) << \
-    "EXCEPTION AT " << __PRETTY_FUNCTION__ << ":" << __LINE__ << ", Text=" << e
+#define HCPLOG_EXCEPTION(e) HCPLOG_SITE(ic_utils::eHCP_LOG_ERROR, \
+    "EXCEPTION AT ", __PRETTY_FUNCTION__, __LINE__, ", Text=") << e
 
 //Below flag can be enabled from CMakefile
 #ifdef SHORT_LOG_MSG
-    #define HCPLOG_RW(PREFIX) HCPLOG(ic_utils::eHCP_LOG_WARNING) << PREFIX \
-        << "::" << __func__ << ":" << __LINE__ << " "
+    #define HCPLOG_RW(PREFIX) HCPLOG_SITE(ic_utils::eHCP_LOG_WARNING, \
+        PREFIX "::", __func__, __LINE__, " ")
     #define HCPLOG_W HCPLOG_RW(PREFIX)
 
-    #define HCPLOG_RF(PREFIX) HCPLOG(ic_utils::eHCP_LOG_FATAL) << PREFIX \
-        << "::" << __func__ << ":" << __LINE__ << " "
+    #define HCPLOG_RF(PREFIX) HCPLOG_SITE(ic_utils::eHCP_LOG_FATAL, \
+        PREFIX "::", __func__, __LINE__, " ")
     #define HCPLOG_F HCPLOG_RF(PREFIX)
 
-    #define HCPLOG_RC(PREFIX) HCPLOG(ic_utils::eHCP_LOG_CRITICAL) << PREFIX \
-        << "::" << __func__ << ":" << __LINE__ << " "
+    #define HCPLOG_RC(PREFIX) HCPLOG_SITE(ic_utils::eHCP_LOG_CRITICAL, \
+        PREFIX "::", __func__, __LINE__, " ")
     #define HCPLOG_C HCPLOG_RC(PREFIX)
 
-    #define HCPLOG_RE(PREFIX) HCPLOG(ic_utils::eHCP_LOG_ERROR) << PREFIX \
-    << "::" << __func__ << ":" << __LINE__ << " "
+    #define HCPLOG_RE(PREFIX) HCPLOG_SITE(ic_utils::eHCP_LOG_ERROR, \
+        PREFIX "::", __func__, __LINE__, " ")
     #define HCPLOG_E HCPLOG_RE(PREFIX)
 #else
-    #define HCPLOG_W HCPLOG(ic_utils::eHCP_LOG_WARNING) << __PRETTY_FUNCTION__ \
-        << ":" << __LINE__ << " "
-    #define HCPLOG_F HCPLOG(ic_utils::eHCP_LOG_FATAL) << __PRETTY_FUNCTION__ \
-        << ":" << __LINE__ << " "
-    #define HCPLOG_C HCPLOG(ic_utils::eHCP_LOG_CRITICAL) << __PRETTY_FUNCTION__ \
-        << ":" << __LINE__ << " "
-    #define HCPLOG_E HCPLOG(ic_utils::eHCP_LOG_ERROR) << __PRETTY_FUNCTION__ \
-        << ":" << __LINE__ << " "
+    #define HCPLOG_W HCPLOG_SITE(ic_utils::eHCP_LOG_WARNING, "", \
+        __PRETTY_FUNCTION__, __LINE__, " ")
+    #define HCPLOG_F HCPLOG_SITE(ic_utils::eHCP_LOG_FATAL, "", \
+        __PRETTY_FUNCTION__, __LINE__, " ")
+    #define HCPLOG_C HCPLOG_SITE(ic_utils::eHCP_LOG_CRITICAL, "", \
+        __PRETTY_FUNCTION__, __LINE__, " ")
+    #define HCPLOG_E HCPLOG_SITE(ic_utils::eHCP_LOG_ERROR, "", \
+        __PRETTY_FUNCTION__, __LINE__, " ")
 #endif
 
-#define HCPLOG_I HCPLOG(ic_utils::eHCP_LOG_INFO) << __PRETTY_FUNCTION__ << " "
-#define HCPLOG_D HCPLOG(ic_utils::eHCP_LOG_DEBUG) << __PRETTY_FUNCTION__ << \
-    ":" << __LINE__ << " "
-#define HCPLOG_T HCPLOG(ic_utils::eHCP_LOG_TRACE) << __PRETTY_FUNCTION__ << \
-    ":" << __LINE__ << " "
+#define HCPLOG_I HCPLOG_SITE(ic_utils::eHCP_LOG_INFO, "", __PRETTY_FUNCTION__, \
+    -1, " ")
+#define HCPLOG_D HCPLOG_SITE(ic_utils::eHCP_LOG_DEBUG, "", \
+    __PRETTY_FUNCTION__, __LINE__, " ")
+#define HCPLOG_T HCPLOG_SITE(ic_utils::eHCP_LOG_TRACE, "", \
+    __PRETTY_FUNCTION__, __LINE__, " ")
 
+//Below flag can be set from CMakefile to compile out more verbose logs
 #ifndef HCPLOG_MAX_LEVEL
     #define HCPLOG_MAX_LEVEL ic_utils::eHCP_LOG_TRACE
 #endif
 
-#define HCPLOG(level) \
+//Below flag is set per library from CMakefile
+#ifndef HCPLOG_MODULE
+    #define HCPLOG_MODULE ic_utils::eLOG_MODULE_DEFAULT
+#endif
+
+/* Disabled statements cost a constant compare and one load of the module's
+ * effective level; the logger and the streamed arguments are not evaluated
+ */
+#define HCPLOG_AT(level, site) \
 if (level > HCPLOG_MAX_LEVEL || level == ic_utils::eHCP_LOG_NONE) ; \
-else if (( level > ic_utils::CIgniteLog::GetReportingLevel()) && \
-    ( level > ic_utils::CIgniteLog::GetFileOutputLevel())) ; \
-else ic_utils::CIgniteLog().Get(level)
+else if (!ic_utils::CIgniteLog::IsEnabled(level, HCPLOG_MODULE)) ; \
+else ic_utils::CIgniteLog().Get(level, site)
+
+#define HCPLOG(level) HCPLOG_AT(level, NULL)
+
+/* The text of a site, e.g. "function:line ", is built and numbered once
+ * per call site when the statement is first enabled
+ */
+#define HCPLOG_SITE(level, before, func, line, after) \
+HCPLOG_AT(level, [](const char *pchFunc) -> const ic_utils::CLogSite* { \
+    static const ic_utils::CLogSite site(before, pchFunc, line, after); \
+    return &site; }(func))
 
 namespace ic_utils 
 {
@@ -102,6 +122,255 @@ enum LogLevel
     eHCP_LOG_TRACE      ///< Trace type logs
 };
 
+/**
+ * Policy of the asynchronous log backend when its ring buffer is full
+ */
+enum LogOverflowPolicy
+{
+    eLOG_OVERFLOW_BLOCK,        ///< Wait for free space up to the block timeout
+    eLOG_OVERFLOW_DROP_NEWEST,  ///< Drop the record being logged
+    eLOG_OVERFLOW_DROP_OLDEST   ///< Drop the oldest queued records
+};
+
+/**
+ * Enum of the modules having their own runtime log level, one per library
+ */
+enum LogModule
+{
+    eLOG_MODULE_DEFAULT,    ///< Code built without a module
+    eLOG_MODULE_UTILS,      ///< libUtils
+    eLOG_MODULE_EVENT,      ///< libEvent
+    eLOG_MODULE_NETWORK,    ///< libNetwork
+    eLOG_MODULE_CORE,       ///< libCore
+    eLOG_MODULE_CLIENTBL,   ///< libClientBL
+    eLOG_MODULE_AUTO,       ///< libAuto
+    eLOG_MODULE_DEVICE,     ///< libDevice
+    eLOG_MODULE_APP,        ///< deviceclient application
+    eLOG_MODULE_COUNT       ///< Number of modules
+};
+
+class CAsyncLogWriter;
+class CLogFileLock;
+
+/**
+ * class CLogSite holds the text a log statement starts with, e.g. the function
+ * and line, together with the identifier it is referenced by in binary logs
+ */
+class CLogSite
+{
+public:
+    /**
+     * Parameterized constructor, assigns the identifier of the site
+     * @param[in] pchBefore Text before the function
+     * @param[in] pchFunc Function of the log statement
+     * @param[in] nLine Line of the log statement, negative to omit it
+     * @param[in] pchAfter Text after the function and line
+     */
+    CLogSite(const char *pchBefore, const char *pchFunc, const int nLine,
+             const char *pchAfter);
+
+    /**
+     * Method to get the identifier of the site, unique within the process
+     * @param void
+     * @return Identifier, starting with 1
+     */
+    unsigned int GetId() const
+    {
+        return m_unId;
+    }
+
+    /**
+     * Method to get the text of the site
+     * @param void
+     * @return Text of the site
+     */
+    const std::string& GetText() const
+    {
+        return m_strText;
+    }
+
+private:
+    //! Identifier of the site
+    unsigned int m_unId;
+
+    //! Text of the site
+    std::string m_strText;
+
+    /**
+     * Copy constructor is not supported
+     */
+    CLogSite(const CLogSite&) = delete;
+
+    /**
+     * Assignment operator is not supported
+     */
+    CLogSite& operator=(const CLogSite&) = delete;
+};
+
+/**
+ * class CLogStream collects the arguments of a log statement. In text mode it
+ * formats them like an ostringstream; in binary mode integers, floating point
+ * values and strings are stored raw while other types, and values streamed
+ * after a formatting manipulator, are formatted and stored as strings.
+ */
+class CLogStream
+{
+public:
+    /**
+     * Default constructor, text mode
+     */
+    CLogStream();
+
+    /**
+     * Method to switch the stream to binary mode, before arguments are added
+     * @param void
+     * @return void
+     */
+    void SetBinary();
+
+    /**
+     * Method to check if the stream is in binary mode
+     * @param void
+     * @return true if binary, false if text
+     */
+    bool IsBinary() const
+    {
+        return m_bBinary;
+    }
+
+    /**
+     * Method to get the collected arguments
+     * @param void
+     * @return Text in text mode, encoded arguments in binary mode
+     */
+    std::string str() const;
+
+    /**
+     * Method to add an argument of a type without raw encoding
+     * @param[in] rValue Argument
+     * @return Reference to the stream
+     */
+    template <class T>
+    CLogStream& operator<<(const T &rValue)
+    {
+        return Put(rValue);
+    }
+
+    //! Overloads storing raw values in binary mode
+    CLogStream& operator<<(bool bValue);
+    CLogStream& operator<<(char chValue);
+    CLogStream& operator<<(signed char chValue);
+    CLogStream& operator<<(unsigned char uchValue);
+    CLogStream& operator<<(short sValue);
+    CLogStream& operator<<(unsigned short usValue);
+    CLogStream& operator<<(int nValue);
+    CLogStream& operator<<(unsigned int unValue);
+    CLogStream& operator<<(long lValue);
+    CLogStream& operator<<(unsigned long ulValue);
+    CLogStream& operator<<(long long llValue);
+    CLogStream& operator<<(unsigned long long ullValue);
+    CLogStream& operator<<(float fValue);
+    CLogStream& operator<<(double dValue);
+    CLogStream& operator<<(const char *pchValue);
+    CLogStream& operator<<(const std::string &rstrValue);
+
+    //! Overloads for manipulators such as std::endl and std::hex
+    CLogStream& operator<<(std::ostream& (*pfnManip)(std::ostream&));
+    CLogStream& operator<<(std::ios_base& (*pfnManip)(std::ios_base&));
+
+private:
+    /**
+     * Method to add an argument formatted by the stream
+     * @param[in] rValue Argument
+     * @return Reference to the stream
+     */
+    template <class T>
+    CLogStream& Put(const T &rValue)
+    {
+        if (m_bBinary)
+        {
+            m_os.str("");
+            m_os << rValue;
+            AppendFormatted();
+        }
+        else
+        {
+            m_os << rValue;
+        }
+        return *this;
+    }
+
+    /**
+     * Method to add a signed integer argument, raw if possible
+     * @param[in] value Argument
+     * @return Reference to the stream
+     */
+    template <class T>
+    CLogStream& PutInt(const T value)
+    {
+        if (IsRaw())
+        {
+            AppendInt(value);
+            return *this;
+        }
+        return Put(value);
+    }
+
+    /**
+     * Method to add an unsigned integer argument, raw if possible
+     * @param[in] value Argument
+     * @return Reference to the stream
+     */
+    template <class T>
+    CLogStream& PutUInt(const T value)
+    {
+        if (IsRaw())
+        {
+            AppendUInt(value);
+            return *this;
+        }
+        return Put(value);
+    }
+
+    /**
+     * Method to check if values are stored raw, they are in binary mode as
+     * long as the stream has the default format flags
+     * @param void
+     * @return true if raw, false if formatted
+     */
+    bool IsRaw() const;
+
+    /**
+     * Method to append the content of m_os as a string argument
+     * @param void
+     * @return void
+     */
+    void AppendFormatted();
+
+    /**
+     * Method to append a raw signed integer argument
+     * @param[in] llValue Argument
+     * @return void
+     */
+    void AppendInt(const long long llValue);
+
+    /**
+     * Method to append a raw unsigned integer argument
+     * @param[in] ullValue Argument
+     * @return void
+     */
+    void AppendUInt(const unsigned long long ullValue);
+
+    //! Text in text mode, scratch for formatted arguments in binary mode
+    std::ostringstream m_os;
+
+    //! Encoded arguments in binary mode
+    std::string m_strArgs;
+
+    //! Flag indicating binary mode
+    bool m_bBinary;
+};
+
 /**
  * class CIgniteLog provides a configurable logging mechanism with support for 
  * funtionalities like log truncation, compression, to initialize 
@@ -123,9 +392,11 @@ public:
     /**
      * Method to get the output stream associated with the CIgniteLog object.
      * @param elevel Log level (default is eHCP_LOG_INFO).
+     * @param pSite Site of the log statement, NULL if it has none.
      * @return Reference to the output stream.
      */
-    std::ostringstream& Get(LogLevel elevel = eHCP_LOG_INFO);
+    CLogStream& Get(LogLevel elevel = eHCP_LOG_INFO,
+                    const CLogSite *pSite = NULL);
 
 public:
     /**
@@ -155,6 +426,45 @@ public:
      * @return void
      */
     static void SetFileOutputLevel(const LogLevel&);
+
+    /**
+     * Method to check if a log statement of a module is enabled, it is if
+     * its level is within the reporting or the file output level and within
+     * the level of the module
+     * @param[in] eLevel Level of the log statement
+     * @param[in] eModule Module of the log statement
+     * @return true if enabled, false otherwise
+     */
+    static inline bool IsEnabled(const LogLevel eLevel, const LogModule eModule)
+    {
+        return (eLevel <=
+                m_arrEnabledLevel[eModule].load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Method to set the most verbose level logged by a module
+     * @param[in] eModule Module
+     * @param[in] eLevel Level, eHCP_LOG_TRACE to not restrict the module
+     * @return true if set, false if the module or level is invalid
+     */
+    static bool SetModuleLevel(const LogModule eModule, const LogLevel eLevel);
+
+    /**
+     * Method to get the most verbose level logged by a module
+     * @param[in] eModule Module
+     * @return Level of the module
+     */
+    static LogLevel GetModuleLevel(const LogModule eModule);
+
+    /**
+     * Method to get the module of a configured module name, the name is the
+     * library name without the "lib" prefix, e.g. "Core" or "ClientBL"
+     * @param[in] rstrName Module name
+     * @param[out] reModule Module of the name
+     * @return true if the name is known, false otherwise
+     */
+    static bool GetModuleByName(const std::string &rstrName,
+                                LogModule &reModule);
     
     /**
      * Method to set the path for file output, along with options for 
@@ -331,6 +641,70 @@ public:
      */
     static void ResetDiagHeader(void);
 
+    /**
+     * Method to enable the asynchronous log backend. Log statements then only
+     * queue a record into a lock-free ring buffer; a writer thread formats the
+     * records and writes them in batches to stdout and the log file. Fatal
+     * records and the record closing the log file are flushed before the log
+     * statement returns.
+     * @param[in] unCapacity Number of records of the ring buffer
+     * @param[in] ePolicy Policy applied when the ring buffer is full
+     * @param[in] unBlockTimeoutMs Maximum wait of a log statement for free
+     *            space, used by eLOG_OVERFLOW_BLOCK only
+     * @return true if enabled, false if it was already enabled
+     */
+    static bool EnableAsync(const unsigned int unCapacity,
+                            const LogOverflowPolicy ePolicy,
+                            const unsigned int unBlockTimeoutMs = 0);
+
+    /**
+     * Method to disable the asynchronous log backend, queued records are
+     * written before it returns
+     * @param void
+     * @return void
+     */
+    static void DisableAsync();
+
+    /**
+     * Method to check if the asynchronous log backend is enabled
+     * @param void
+     * @return true if enabled, false otherwise
+     */
+    static bool IsAsyncEnabled();
+
+    /**
+     * Method to wait until the records queued so far are written
+     * @param[in] unTimeoutMs Maximum wait
+     * @return true if all records are written or the asynchronous backend is
+     *         not enabled, false on timeout
+     */
+    static bool FlushAsync(const unsigned int unTimeoutMs);
+
+    /**
+     * Method to get the number of records dropped by the asynchronous backend
+     * since it was enabled
+     * @param void
+     * @return Number of dropped records
+     */
+    static unsigned long long GetAsyncDroppedCount();
+
+    /**
+     * Method to switch the log file between the text and the binary format.
+     * Binary records hold the site identifier, raw time, thread and raw
+     * arguments; the logdecoder tool turns them back into the text layout.
+     * A log file of the other format is moved to ".bak" when it is opened.
+     * @param[in] bBinary true for the binary format, false for text
+     * @return void
+     */
+    static void SetBinaryMode(const bool bBinary);
+
+    /**
+     * Method to check if the log file is written in the binary format
+     * @param void
+     * @return true if binary, false if text
+     */
+    static bool IsBinaryMode();
+
     #ifdef IC_UNIT_TEST
         friend class CIgniteLogTest;
 
@@ -346,19 +720,22 @@ public:
     #endif
     
 private:
+    friend class CAsyncLogWriter;
+    friend class CLogFileLock;
+
     /**
      * Method to truncate the log file.
      * @param void
      * @return void
      */
-    void TruncateFile();
+    static void TruncateFile();
 
     /**
      * Method to truncate the log file if required based on configured settings
      * @param void
      * @return void
      */
-    void TruncateIfRequired();
+    static void TruncateIfRequired();
 
     /**
      * Constructor for CIgniteLog class
@@ -375,21 +752,97 @@ private:
     //! File output log level.
     static LogLevel m_eFileOutputLevel;
 
+    //! Most verbose level logged by each module
+    static std::atomic<int> m_arrModuleLevel[eLOG_MODULE_COUNT];
+
+    /* Most verbose level enabled for each module, the lower of its module
+     * level and the higher of the reporting and file output level
+     */
+    static std::atomic<int> m_arrEnabledLevel[eLOG_MODULE_COUNT];
+
+    /**
+     * Method to recompute the enabled level of each module
+     * @param void
+     * @return void
+     */
+    static void UpdateEnabledLevels();
+
+    /**
+     * Method to write the log statement in the binary format, stdout gets the
+     * text line
+     * @param void
+     * @return void
+     */
+    void WriteBinary();
+
+    /**
+     * Method to open the log file, in binary mode a new file starts with the
+     * binary log header; caller holds m_fileMutex
+     * @param[in] rstrPath Path of the log file
+     * @return void
+     */
+    static void OpenLogFile(const std::string &rstrPath);
+
+    /**
+     * Method to write text, e.g. the status block, to the open log file;
+     * caller holds m_fileMutex
+     * @param[in] rstrText Text
+     * @return void
+     */
+    static void WriteFileText(const std::string &rstrText);
+
+    /**
+     * Method to encode a log statement for the binary log file, preceded by
+     * its site the first time the site is used in the file; caller holds
+     * m_fileMutex
+     * @param[in] pSite Site of the log statement, NULL if it has none
+     * @param[in] eLevel Level of the log statement
+     * @param[in] ullTimeUs Time of the log statement in microseconds
+     * @param[in] threadId Thread of the log statement
+     * @param[in] rstrArgs Encoded arguments
+     * @param[out] rstrOut String the records are appended to
+     * @return void
+     */
+    static void EncodeBinaryRecord(const CLogSite *pSite, const LogLevel eLevel,
+                                   const unsigned long long ullTimeUs,
+                                   const pthread_t threadId,
+                                   const std::string &rstrArgs,
+                                   std::string &rstrOut);
+
+    /**
+     * Method to write the diagnostic headers to a stream
+     * @param[out] ros Stream the headers are written to
+     * @return void
+     */
+    static void WriteDiagHeader(std::ostream &ros);
+
     //! Output file stream for file logging.
     static std::ofstream m_of;
 
     //! Log level associated with the current CIgniteLog object.
     LogLevel m_eLogLevel;
 
-    //! Output string stream for building log messages.
-    std::ostringstream m_os;
+    //! Output stream for building log messages.
+    CLogStream m_os;
+
+    //! Site of the log statement, NULL if it has none
+    const CLogSite *m_pSite;
+
+    //! Asynchronous writer the record is queued to, NULL when logging inline
+    std::shared_ptr<CAsyncLogWriter> m_pWriter;
+
+    //! Time of the log statement in microseconds, used by the async backend
+    unsigned long long m_ullTimeUs;
+
+    //! Thread of the log statement, used by the async backend
+    pthread_t m_threadId;
 
     /**
      * Method to convert LogLevel enum value to a string
      * @param[in] elevel LogLevel value
      * @return string associated with provided level.
      */
-    std::string ToString(const LogLevel elevel);
+    static std::string ToString(const LogLevel elevel);
 
     /**
      * CIgniteLog Constructor, the CIgniteLog class is non-copyable.
@@ -407,6 +860,13 @@ private:
     //! Mutex for controlling access to log operations.
     static CIgniteMutex m_logMutex;
 
+    //! Mutex serializing log file writes except inline text ones, open, close
+    //! and move
+    static CIgniteMutex m_fileMutex;
+
+    //! Asynchronous writer, NULL when the asynchronous backend is disabled
+    static std::shared_ptr<CAsyncLogWriter> m_pAsyncWriter;
+
     //! Size at which log files should be truncated.
     static unsigned long m_ulTruncateFileSize;
 
@@ -0,0 +1,398 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "CBinaryLog.h"
+
+namespace ic_utils
+{
+namespace
+{
+//! Size of the buffer of a formatted number or log line prefix
+const int FORMAT_BUFFER_SIZE = 64;
+
+/**
+ * Method to map a signed value to an unsigned one with small magnitudes
+ * staying small
+ * @param[in] llValue Signed value
+ * @return Zigzag encoded value
+ */
+unsigned long long zigzag_encode(const long long llValue)
+{
+    return ((unsigned long long)llValue << 1) ^ (unsigned long long)(llValue >> 63);
+}
+
+/**
+ * Method to map a zigzag encoded value back to the signed value
+ * @param[in] ullValue Zigzag encoded value
+ * @return Signed value
+ */
+long long zigzag_decode(const unsigned long long ullValue)
+{
+    return (long long)(ullValue >> 1) ^ -(long long)(ullValue & 1);
+}
+
+/**
+ * Method to read a varint length followed by that many bytes
+ * @param[in] rstrIn Encoded data
+ * @param[in,out] rnPos Position of the length, moved past the bytes
+ * @param[out] rstrOut String the bytes are assigned to
+ * @return true if read, false if the data ends early
+ */
+bool read_bytes(const std::string &rstrIn, size_t &rnPos, std::string &rstrOut)
+{
+    unsigned long long ullSize = 0;
+    if (!CBinaryLogCodec::ReadVarint(rstrIn, rnPos, ullSize) ||
+        (ullSize > rstrIn.size() - rnPos))
+    {
+        return false;
+    }
+    rstrOut.assign(rstrIn, rnPos, (size_t)ullSize);
+    rnPos += (size_t)ullSize;
+    return true;
+}
+}
+
+void CBinaryLogCodec::AppendVarint(unsigned long long ullValue,
+                                   std::string &rstrOut)
+{
+    while (ullValue >= 0x80)
+    {
+        rstrOut.push_back((char)((ullValue & 0x7F) | 0x80));
+        ullValue >>= 7;
+    }
+    rstrOut.push_back((char)ullValue);
+}
+
+bool CBinaryLogCodec::ReadVarint(const std::string &rstrIn, size_t &rnPos,
+                                 unsigned long long &rullValue)
+{
+    rullValue = 0;
+    for (unsigned int unShift = 0; unShift < 64; unShift += 7)
+    {
+        if (rnPos >= rstrIn.size())
+        {
+            return false;
+        }
+        unsigned char uchByte = (unsigned char)rstrIn[rnPos++];
+        rullValue |= (unsigned long long)(uchByte & 0x7F) << unShift;
+        if (0 == (uchByte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CBinaryLogCodec::AppendInt(const long long llValue, std::string &rstrArgs)
+{
+    rstrArgs.push_back((char)eBLOG_ARG_INT);
+    AppendVarint(zigzag_encode(llValue), rstrArgs);
+}
+
+void CBinaryLogCodec::AppendUInt(const unsigned long long ullValue,
+                                 std::string &rstrArgs)
+{
+    rstrArgs.push_back((char)eBLOG_ARG_UINT);
+    AppendVarint(ullValue, rstrArgs);
+}
+
+void CBinaryLogCodec::AppendDouble(const double dValue, std::string &rstrArgs)
+{
+    unsigned long long ullBits = 0;
+    memcpy(&ullBits, &dValue, sizeof(ullBits));
+
+    rstrArgs.push_back((char)eBLOG_ARG_DOUBLE);
+    for (int nByte = 0; nByte < 8; nByte++)
+    {
+        rstrArgs.push_back((char)(ullBits >> (nByte * 8)));
+    }
+}
+
+void CBinaryLogCodec::AppendString(const char *pchData, const size_t nSize,
+                                   std::string &rstrArgs)
+{
+    rstrArgs.push_back((char)eBLOG_ARG_STRING);
+    AppendVarint(nSize, rstrArgs);
+    rstrArgs.append(pchData, nSize);
+}
+
+bool CBinaryLogCodec::FormatArgs(const std::string &rstrArgs,
+                                 std::string &rstrOut)
+{
+    size_t nPos = 0;
+    char chBuffer[FORMAT_BUFFER_SIZE];
+    while (nPos < rstrArgs.size())
+    {
+        unsigned char uchType = (unsigned char)rstrArgs[nPos++];
+        unsigned long long ullValue = 0;
+        int nLen = 0;
+
+        switch (uchType)
+        {
+        case eBLOG_ARG_INT:
+            if (!ReadVarint(rstrArgs, nPos, ullValue))
+            {
+                return false;
+            }
+            nLen = snprintf(chBuffer, sizeof(chBuffer), "%lld",
+                            zigzag_decode(ullValue));
+            break;
+        case eBLOG_ARG_UINT:
+            if (!ReadVarint(rstrArgs, nPos, ullValue))
+            {
+                return false;
+            }
+            nLen = snprintf(chBuffer, sizeof(chBuffer), "%llu", ullValue);
+            break;
+        case eBLOG_ARG_DOUBLE:
+        {
+            if (rstrArgs.size() - nPos < 8)
+            {
+                return false;
+            }
+            for (int nByte = 0; nByte < 8; nByte++)
+            {
+                ullValue |= (unsigned long long)(unsigned char)
+                            rstrArgs[nPos++] << (nByte * 8);
+            }
+            double dValue = 0;
+            memcpy(&dValue, &ullValue, sizeof(dValue));
+
+            // An ostream with default flags formats like %g with precision 6
+            nLen = snprintf(chBuffer, sizeof(chBuffer), "%g", dValue);
+            break;
+        }
+        case eBLOG_ARG_STRING:
+        {
+            std::string strValue;
+            if (!read_bytes(rstrArgs, nPos, strValue))
+            {
+                return false;
+            }
+            rstrOut.append(strValue);
+            break;
+        }
+        default:
+            return false;
+        }
+
+        if ((nLen > 0) && (nLen < (int)sizeof(chBuffer)))
+        {
+            rstrOut.append(chBuffer, nLen);
+        }
+    }
+    return true;
+}
+
+void CBinaryLogCodec::EncodeSite(const unsigned int unSiteId,
+                                 const std::string &rstrText,
+                                 std::string &rstrOut)
+{
+    rstrOut.push_back((char)eBLOG_RECORD_SITE);
+    AppendVarint(unSiteId, rstrOut);
+    AppendVarint(rstrText.size(), rstrOut);
+    rstrOut.append(rstrText);
+}
+
+void CBinaryLogCodec::EncodeLog(const unsigned int unSiteId, const int nLevel,
+                                const unsigned long long ullTimeUs,
+                                const unsigned long long ullThreadId,
+                                const std::string &rstrArgs,
+                                std::string &rstrOut)
+{
+    rstrOut.push_back((char)eBLOG_RECORD_LOG);
+    AppendVarint(unSiteId, rstrOut);
+    rstrOut.push_back((char)nLevel);
+    AppendVarint(ullTimeUs, rstrOut);
+    AppendVarint(ullThreadId, rstrOut);
+    AppendVarint(rstrArgs.size(), rstrOut);
+    rstrOut.append(rstrArgs);
+}
+
+void CBinaryLogCodec::EncodeText(const std::string &rstrText,
+                                 std::string &rstrOut)
+{
+    rstrOut.push_back((char)eBLOG_RECORD_TEXT);
+    AppendVarint(rstrText.size(), rstrOut);
+    rstrOut.append(rstrText);
+}
+
+void CBinaryLogCodec::EncodeZone(const long lUtcOffset, std::string &rstrOut)
+{
+    rstrOut.push_back((char)eBLOG_RECORD_ZONE);
+    AppendVarint(zigzag_encode(lUtcOffset), rstrOut);
+}
+
+CLogLineFormatter::CLogLineFormatter()
+    : m_bFixedOffset(false), m_lUtcOffset(0), m_bCached(false),
+      m_cachedSecond(0)
+{
+    m_chCachedTime[0] = '\0';
+}
+
+void CLogLineFormatter::SetUtcOffset(const long lUtcOffset)
+{
+    m_bFixedOffset = true;
+    m_lUtcOffset = lUtcOffset;
+    m_bCached = false;
+}
+
+void CLogLineFormatter::Format(const int nLevel,
+                               const unsigned long long ullTimeUs,
+                               const unsigned long long ullThreadId,
+                               const std::string &rstrSite,
+                               const std::string &rstrMessage,
+                               std::string &rstrOut)
+{
+    time_t second = (time_t)(ullTimeUs / 1000000);
+    if (!m_bCached || (second != m_cachedSecond))
+    {
+        tm r = {0};
+        if (m_bFixedOffset)
+        {
+            time_t localSecond = second + m_lUtcOffset;
+            gmtime_r(&localSecond, &r);
+        }
+        else
+        {
+            localtime_r(&second, &r);
+        }
+        strftime(m_chCachedTime, sizeof(m_chCachedTime), "%H:%M:%S", &r);
+        m_cachedSecond = second;
+        m_bCached = true;
+    }
+
+    char chPrefix[FORMAT_BUFFER_SIZE];
+    int nLen = snprintf(chPrefix, sizeof(chPrefix), "%s.%03ld %s %llu: ",
+                        m_chCachedTime, (long)((ullTimeUs % 1000000) / 1000),
+                        GetLevelName(nLevel), ullThreadId);
+    if ((nLen > 0) && (nLen < (int)sizeof(chPrefix)))
+    {
+        rstrOut.append(chPrefix, nLen);
+    }
+    rstrOut.append(rstrSite);
+    rstrOut.append(rstrMessage);
+    rstrOut.push_back('\n');
+}
+
+const char *CLogLineFormatter::GetLevelName(const int nLevel)
+{
+    /* static const char* const cstrBuffer[] = {"NONE ", "FATAL", "CRIT ",
+     * "ERROR", "WARN ", "INFO ", "DEBUG", "TRACE"};
+     */
+    static const char* const cstrBuffer[] = {"N ", "F", "C", "E", "W", "I", "D",
+                                             "T"};
+    if ((nLevel < 0) || (nLevel >= (int)(sizeof(cstrBuffer) /
+                                         sizeof(cstrBuffer[0]))))
+    {
+        return "?";
+    }
+    return cstrBuffer[nLevel];
+}
+
+CBinaryLogDecoder::CBinaryLogDecoder()
+{
+    // do nothing
+}
+
+bool CBinaryLogDecoder::Decode(const std::string &rstrIn, std::string &rstrOut)
+{
+    if (0 != rstrIn.compare(0, BINARY_LOG_MAGIC.size(), BINARY_LOG_MAGIC))
+    {
+        return false;
+    }
+
+    size_t nPos = BINARY_LOG_MAGIC.size();
+    while (nPos < rstrIn.size())
+    {
+        if (!DecodeRecord(rstrIn, nPos, rstrOut))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CBinaryLogDecoder::DecodeRecord(const std::string &rstrIn, size_t &rnPos,
+                                     std::string &rstrOut)
+{
+    unsigned char uchType = (unsigned char)rstrIn[rnPos++];
+    unsigned long long ullSiteId = 0;
+    std::string strData;
+
+    switch (uchType)
+    {
+    case eBLOG_RECORD_SITE:
+        if (!CBinaryLogCodec::ReadVarint(rstrIn, rnPos, ullSiteId) ||
+            !read_bytes(rstrIn, rnPos, strData))
+        {
+            return false;
+        }
+        m_mapSites[ullSiteId] = strData;
+        return true;
+    case eBLOG_RECORD_LOG:
+    {
+        unsigned long long ullTimeUs = 0;
+        unsigned long long ullThreadId = 0;
+        if (!CBinaryLogCodec::ReadVarint(rstrIn, rnPos, ullSiteId) ||
+            (rnPos >= rstrIn.size()))
+        {
+            return false;
+        }
+        int nLevel = (unsigned char)rstrIn[rnPos++];
+        if (!CBinaryLogCodec::ReadVarint(rstrIn, rnPos, ullTimeUs) ||
+            !CBinaryLogCodec::ReadVarint(rstrIn, rnPos, ullThreadId) ||
+            !read_bytes(rstrIn, rnPos, strData))
+        {
+            return false;
+        }
+
+        std::string strMessage;
+        bool bFormatted = CBinaryLogCodec::FormatArgs(strData, strMessage);
+        std::map<unsigned long long, std::string>::const_iterator itSite =
+            m_mapSites.find(ullSiteId);
+        m_formatter.Format(nLevel, ullTimeUs, ullThreadId,
+                           (itSite != m_mapSites.end()) ? itSite->second : "",
+                           strMessage, rstrOut);
+        return bFormatted;
+    }
+    case eBLOG_RECORD_TEXT:
+        if (!read_bytes(rstrIn, rnPos, strData))
+        {
+            return false;
+        }
+        rstrOut.append(strData);
+        return true;
+    case eBLOG_RECORD_ZONE:
+    {
+        unsigned long long ullOffset = 0;
+        if (!CBinaryLogCodec::ReadVarint(rstrIn, rnPos, ullOffset))
+        {
+            return false;
+        }
+        m_formatter.SetUtcOffset((long)zigzag_decode(ullOffset));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+} /* namespace ic_utils */
@@ -20,8 +20,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
 #include "CIgniteGZip.h"
 #include "CIgniteLog.h"
+#include "CIgniteFileUtils.h"
+#include "jsoncpp/json.h"
 
 #ifdef PREFIX
 #undef PREFIX
@@ -30,6 +35,102 @@
 
 namespace ic_utils
 {
+namespace
+{
+//! Minimum free space in the output buffer for one deflate call
+const unsigned int GZIP_OUT_CHUNK = 4096;
+
+//! Window bits selecting the gzip wrapper
+const int GZIP_WINDOW_BITS = MAX_WBITS + 16;
+
+//! Window bits selecting the zlib wrapper, the only one carrying a dictionary
+const int ZLIB_WINDOW_BITS = MAX_WBITS;
+
+//! Dictionary file member holding the id
+const std::string DICT_KEY_ID = "id";
+
+//! Dictionary file member holding the dictionary content
+const std::string DICT_KEY_DICTIONARY = "dictionary";
+
+//! Longest string value kept in a schema, longer ones are considered data
+const unsigned int MAX_SCHEMA_STRING_LEN = 32;
+
+/**
+ * Method to append the schema of a JSON value, serialized the way events are
+ * written, to a string
+ * @param[in] rjsonValue JSON value
+ * @param[out] rstrSchema String to append the schema to
+ * @return void
+ */
+void append_schema(const Json::Value &rjsonValue, std::string &rstrSchema)
+{
+    if (rjsonValue.isObject())
+    {
+        rstrSchema.append("{");
+        const Json::Value::Members vecMembers = rjsonValue.getMemberNames();
+        for (size_t nIdx = 0; nIdx < vecMembers.size(); nIdx++)
+        {
+            if (nIdx > 0)
+            {
+                rstrSchema.append(",");
+            }
+            rstrSchema.append("\"" + vecMembers[nIdx] + "\":");
+            append_schema(rjsonValue[vecMembers[nIdx]], rstrSchema);
+        }
+        rstrSchema.append("}");
+    }
+    else if (rjsonValue.isArray())
+    {
+        // elements of an array usually share the schema of the first one
+        rstrSchema.append("[");
+        if (!rjsonValue.empty())
+        {
+            append_schema(rjsonValue[0u], rstrSchema);
+        }
+        rstrSchema.append("]");
+    }
+    else if (rjsonValue.isString() &&
+             (rjsonValue.asString().size() <= MAX_SCHEMA_STRING_LEN))
+    {
+        rstrSchema.append("\"" + rjsonValue.asString() + "\"");
+    }
+    else if (rjsonValue.isString())
+    {
+        rstrSchema.append("\"\"");
+    }
+    // numbers and booleans are data, only their field name is kept
+}
+
+/**
+ * Method to compute the id of a preset dictionary, as carried by the zlib
+ * header
+ * @param[in] rstrDictionary Dictionary content
+ * @return Adler-32 checksum of the content, 0 if the content is empty
+ */
+unsigned long get_dictionary_id(const std::string &rstrDictionary)
+{
+    if (rstrDictionary.empty())
+    {
+        return 0;
+    }
+    return adler32(adler32(0L, Z_NULL, 0), (const Bytef*)rstrDictionary.data(),
+                   rstrDictionary.size());
+}
+
+/**
+ * Method to compare schema frequencies, most frequent first
+ * @param[in] rpairA First schema and its count
+ * @param[in] rpairB Second schema and its count
+ * @return true if rpairA goes before rpairB, false otherwise
+ */
+bool is_more_frequent(const std::pair<std::string, unsigned int> &rpairA,
+                      const std::pair<std::string, unsigned int> &rpairB)
+{
+    return (rpairA.second != rpairB.second) ? (rpairA.second > rpairB.second) :
+                                              (rpairA.first < rpairB.first);
+}
+}
+
 CZippedMsg::CZippedMsg()
 {
     m_puchBuf = NULL;
@@ -105,4 +206,282 @@ CZippedMsg* CIgniteGZip::GzipMsg(unsigned char* puchInMsg,
     return zm;
 }
 
+CGzipStream::CGzipStream() : m_pStream(NULL), m_unOutSize(0),
+                             m_bFinished(false), m_ulDictionaryId(0)
+{
+    Init(GZIP_WINDOW_BITS);
+}
+
+bool CGzipStream::Init(int nWindowBits)
+{
+    if (m_pStream != NULL)
+    {
+        deflateEnd(m_pStream);
+    }
+    else
+    {
+        m_pStream = new z_stream;
+    }
+    m_pStream->zalloc = Z_NULL;
+    m_pStream->zfree = Z_NULL;
+    m_pStream->opaque = Z_NULL;
+
+    // Same parameters as GzipMsg, the wrapper is selected by nWindowBits
+    int nRet = deflateInit2(m_pStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                            nWindowBits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+    if (Z_OK != nRet)
+    {
+        HCPLOG_E << "Cannot initiate gzip:" << nRet;
+        delete m_pStream;
+        m_pStream = NULL;
+    }
+    m_unOutSize = 0;
+    m_bFinished = false;
+    return (m_pStream != NULL);
+}
+
+CGzipStream::~CGzipStream()
+{
+    if (m_pStream != NULL)
+    {
+        deflateEnd(m_pStream);
+        delete m_pStream;
+    }
+}
+
+bool CGzipStream::Append(const char* pchData, unsigned int unSize)
+{
+    if ((m_pStream == NULL) || m_bFinished)
+    {
+        return false;
+    }
+
+    m_pStream->next_in = (Bytef*)pchData;
+    m_pStream->avail_in = unSize;
+    return Deflate(Z_NO_FLUSH);
+}
+
+bool CGzipStream::Append(const std::string &rstrData)
+{
+    return Append(rstrData.data(), rstrData.size());
+}
+
+bool CGzipStream::Finish()
+{
+    if ((m_pStream == NULL) || m_bFinished)
+    {
+        return false;
+    }
+
+    m_pStream->next_in = Z_NULL;
+    m_pStream->avail_in = 0;
+    m_bFinished = Deflate(Z_FINISH);
+
+    HCPLOG_I << "Input size is " << m_pStream->total_in
+             << ", GZip output size is: " << m_unOutSize << "!";
+    return m_bFinished;
+}
+
+bool CGzipStream::Reset()
+{
+    m_unOutSize = 0;
+    m_bFinished = false;
+    if ((m_pStream == NULL) || (Z_OK != deflateReset(m_pStream)))
+    {
+        return false;
+    }
+
+    // deflateReset drops the dictionary, it is set again for every message
+    return m_strDictionary.empty() ||
+           (Z_OK == deflateSetDictionary(m_pStream,
+                                  (const Bytef*)m_strDictionary.data(),
+                                  m_strDictionary.size()));
+}
+
+bool CGzipStream::SetDictionary(const std::string &rstrDictionary)
+{
+    m_strDictionary = rstrDictionary.substr(0, CGzipDictionary::MAX_SIZE);
+    m_ulDictionaryId = get_dictionary_id(m_strDictionary);
+
+    if (!Init(m_strDictionary.empty() ? GZIP_WINDOW_BITS : ZLIB_WINDOW_BITS))
+    {
+        return false;
+    }
+    return Reset();
+}
+
+unsigned long CGzipStream::GetDictionaryId() const
+{
+    return m_ulDictionaryId;
+}
+
+const unsigned char* CGzipStream::GetData() const
+{
+    return m_vecOut.empty() ? NULL : &m_vecOut[0];
+}
+
+unsigned int CGzipStream::GetSize() const
+{
+    return m_unOutSize;
+}
+
+unsigned long CGzipStream::GetInputSize() const
+{
+    return (m_pStream != NULL) ? m_pStream->total_in : 0;
+}
+
+bool CGzipStream::IsFinished() const
+{
+    return m_bFinished;
+}
+
+bool CGzipStream::Deflate(int nFlush)
+{
+    int nRet = Z_OK;
+    do
+    {
+        if (m_vecOut.size() - m_unOutSize < GZIP_OUT_CHUNK)
+        {
+            m_vecOut.resize((m_vecOut.size() * 2) + GZIP_OUT_CHUNK);
+        }
+        m_pStream->next_out = &m_vecOut[m_unOutSize];
+        m_pStream->avail_out = m_vecOut.size() - m_unOutSize;
+
+        nRet = deflate(m_pStream, nFlush);
+        m_unOutSize = m_vecOut.size() - m_pStream->avail_out;
+
+        if (Z_STREAM_ERROR == nRet)
+        {
+            HCPLOG_E << "gzip stream error:" << nRet;
+            return false;
+        }
+        /* Z_NO_FLUSH is done once all input is consumed; Z_FINISH is done
+         * once deflate reports the end of the stream
+         */
+    } while ((Z_FINISH == nFlush) ? (Z_STREAM_END != nRet) :
+                                    (0 != m_pStream->avail_in));
+    return true;
+}
+
+const unsigned int CGzipDictionary::MAX_SIZE;
+
+CGzipDictionary::CGzipDictionary()
+{
+}
+
+bool CGzipDictionary::Load(const std::string &rstrPath)
+{
+    std::string strPath = rstrPath;
+    std::string strContent;
+    CIgniteFileUtils::ReadFile(strPath, strContent);
+
+    if (!Parse(strContent))
+    {
+        HCPLOG_E << "Invalid dictionary file " << rstrPath;
+        return false;
+    }
+    return true;
+}
+
+bool CGzipDictionary::Parse(const std::string &rstrContent)
+{
+    Json::Value jsonRoot;
+    Json::Reader jsonReader;
+    if (rstrContent.empty() || !jsonReader.parse(rstrContent, jsonRoot) ||
+        !jsonRoot.isObject() || !jsonRoot[DICT_KEY_ID].isIntegral() ||
+        !jsonRoot[DICT_KEY_DICTIONARY].isString())
+    {
+        return false;
+    }
+
+    // the id names the dictionary on the wire, it has to match the content
+    std::string strData = jsonRoot[DICT_KEY_DICTIONARY].asString();
+    unsigned long ulId = jsonRoot[DICT_KEY_ID].asUInt();
+    if ((strData.size() > MAX_SIZE) || (get_dictionary_id(strData) != ulId))
+    {
+        HCPLOG_E << "Dictionary content does not match id " << ulId;
+        return false;
+    }
+
+    m_strData = strData;
+    HCPLOG_I << "Read dictionary id " << ulId << ", size " << m_strData.size();
+    return true;
+}
+
+bool CGzipDictionary::Save(const std::string &rstrPath) const
+{
+    Json::Value jsonRoot;
+    jsonRoot[DICT_KEY_ID] = (Json::UInt)GetId();
+    jsonRoot[DICT_KEY_DICTIONARY] = m_strData;
+
+    Json::StyledWriter jsonWriter;
+    std::ofstream file(rstrPath.c_str(), std::ofstream::trunc);
+    file << jsonWriter.write(jsonRoot);
+    file.close();
+    if (file.fail())
+    {
+        HCPLOG_E << "Cannot write dictionary file " << rstrPath;
+        return false;
+    }
+    return true;
+}
+
+unsigned int CGzipDictionary::Train(const std::vector<std::string> &rvecEvents,
+                                    unsigned int unMaxSize)
+{
+    std::map<std::string, unsigned int> mapSchemaCount;
+    Json::Reader jsonReader;
+    for (size_t nIdx = 0; nIdx < rvecEvents.size(); nIdx++)
+    {
+        Json::Value jsonEvent;
+        if (jsonReader.parse(rvecEvents[nIdx], jsonEvent, false))
+        {
+            std::string strSchema;
+            append_schema(jsonEvent, strSchema);
+            mapSchemaCount[strSchema]++;
+        }
+    }
+
+    std::vector<std::pair<std::string, unsigned int> > vecSchemas(
+                                 mapSchemaCount.begin(), mapSchemaCount.end());
+    std::sort(vecSchemas.begin(), vecSchemas.end(), is_more_frequent);
+
+    // Keep the most frequent schemas fitting into the dictionary
+    unsigned int unSize = std::min(unMaxSize, MAX_SIZE);
+    // a schema too large for the remaining space leaves it to smaller ones
+    size_t nUsed = 0;
+    std::vector<size_t> vecKept;
+    for (size_t nIdx = 0; nIdx < vecSchemas.size(); nIdx++)
+    {
+        if (nUsed + vecSchemas[nIdx].first.size() <= unSize)
+        {
+            nUsed += vecSchemas[nIdx].first.size();
+            vecKept.push_back(nIdx);
+        }
+    }
+    size_t nCount = vecKept.size();
+
+    // deflate reaches the end of the dictionary with the shortest distances
+    m_strData.clear();
+    for (size_t nIdx = nCount; nIdx > 0; nIdx--)
+    {
+        m_strData.append(vecSchemas[vecKept[nIdx - 1]].first);
+    }
+
+    HCPLOG_I << "Trained dictionary from " << rvecEvents.size()
+             << " events: " << nCount << " of " << vecSchemas.size()
+             << " schemas, size " << m_strData.size();
+    return nCount;
+}
+
+unsigned long CGzipDictionary::GetId() const
+{
+    return get_dictionary_id(m_strData);
+}
+
+const std::string& CGzipDictionary::GetData() const
+{
+    return m_strData;
+}
+
 }/* namespace ic_utils */
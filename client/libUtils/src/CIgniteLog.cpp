@@ -22,12 +22,19 @@
 #include <sys/time.h>
 #include <pthread.h>
 #include <stdio.h>
+#include <string.h>
 #include <zlib.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <iterator>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include "CIgniteLog.h"
+#include "CBoundedQueue.h"
+#include "CBinaryLog.h"
 #include "CIgniteFileUtils.h"
 #include "CPreIgniteLogger.h"
 #include "CIgniteMutex.h"
@@ -62,6 +69,33 @@ const int MAX_DIAG_ENTRIES_LOWER_LIMIT = 5;
 //! g_vectorDiagHeader store diagnostic headers as strings in a vector.
 static std::vector<std::string> g_vectorDiagHeader;
 
+//! Wait of the async writer for new records, bounds a missed wake-up
+static const unsigned int ASYNC_IDLE_WAIT_MS = 50;
+
+//! Maximum number of records the async writer writes in one batch
+static const unsigned int ASYNC_MAX_BATCH = 256;
+
+//! Wait of a fatal or closing log statement for its record to be written
+static const unsigned int ASYNC_FLUSH_TIMEOUT_MS = 2000;
+
+//! Flag indicating the async backend is enabled, checked before loading it
+static std::atomic<bool> g_bAsyncEnabled(false);
+
+//! Flag set on the async writer thread, whose own log statements are inline
+static thread_local bool g_bIsAsyncWriter = false;
+
+//! Flag indicating the log file is written in the binary format
+static std::atomic<bool> g_bBinaryMode(false);
+
+//! Flag set while the thread holds the log file mutex
+static thread_local bool g_bHoldsFileMutex = false;
+
+//! Number of registered log statement sites
+static std::atomic<unsigned int> g_atomicSiteCount(0);
+
+//! Sites already written to the binary log file, guarded by the file mutex
+static std::vector<bool> g_vecSiteWritten;
+
 namespace ic_utils 
 {
 /**
@@ -78,15 +112,607 @@ inline std::string get_time_formatted();
  */
 inline void print_pre_logger(const std::string &log);
 
+/**
+ * Record of a log statement queued to the async writer
+ */
+struct LogRecord
+{
+    LogLevel eLevel;                ///< Level of the log statement
+    unsigned long long ullTimeUs;   ///< Time of the log statement
+    pthread_t threadId;             ///< Thread of the log statement
+    const CLogSite *pSite;          ///< Site of the statement, if binary
+    bool bBinary;                   ///< Message holds encoded arguments
+    std::string strMessage;         ///< Message without the prefix
+    bool bIsLast;                   ///< Log file is closed after the record
+};
+
+/**
+ * class CLogFileLock holds the log file mutex for its scope and marks the
+ * thread, so that log statements of the thread write without locking again
+ */
+class CLogFileLock
+{
+public:
+    /**
+     * Constructor, locks the log file mutex unless the thread holds it
+     */
+    CLogFileLock() : m_bLocked(!g_bHoldsFileMutex)
+    {
+        if (m_bLocked)
+        {
+            CIgniteLog::m_fileMutex.Lock();
+            g_bHoldsFileMutex = true;
+        }
+    }
+
+    /**
+     * Destructor, unlocks the log file mutex if locked by the constructor
+     */
+    ~CLogFileLock()
+    {
+        if (m_bLocked)
+        {
+            g_bHoldsFileMutex = false;
+            CIgniteLog::m_fileMutex.Unlock();
+        }
+    }
+
+private:
+    //! Flag indicating the mutex was locked by this object
+    bool m_bLocked;
+};
+
+/**
+ * Method to get the message of a record as text
+ * @param[in] pSite Site of the record, used for encoded arguments only
+ * @param[in] bBinary Flag indicating rstrMessage holds encoded arguments
+ * @param[in] rstrMessage Message
+ * @return Message text starting with the site text
+ */
+static std::string get_record_text(const CLogSite *pSite, const bool bBinary,
+                                   const std::string &rstrMessage)
+{
+    if (!bBinary)
+    {
+        return rstrMessage;
+    }
+
+    std::string strText = (NULL != pSite) ? pSite->GetText() : "";
+    CBinaryLogCodec::FormatArgs(rstrMessage, strText);
+    return strText;
+}
+
+/**
+ * class CAsyncLogWriter owns the ring buffer of the asynchronous log backend
+ * and the thread formatting and writing its records in batches
+ */
+class CAsyncLogWriter
+{
+public:
+    /**
+     * Parameterized constructor, starts the writer thread
+     * @param[in] unCapacity Number of records of the ring buffer
+     * @param[in] ePolicy Policy applied when the ring buffer is full
+     * @param[in] unBlockTimeoutMs Maximum wait for free space when blocking
+     */
+    CAsyncLogWriter(const unsigned int unCapacity,
+                    const LogOverflowPolicy ePolicy,
+                    const unsigned int unBlockTimeoutMs);
+
+    /**
+     * Destructor, writes the queued records and joins the writer thread
+     */
+    ~CAsyncLogWriter();
+
+    /**
+     * Method to queue a record
+     * @param[in] rRecord Record to be written
+     * @return true if queued, false if dropped
+     */
+    bool Push(const LogRecord &rRecord);
+
+    /**
+     * Method to wait until the queued records are written
+     * @param[in] unTimeoutMs Maximum wait
+     * @return true if written, false on timeout
+     */
+    bool Flush(const unsigned int unTimeoutMs);
+
+    /**
+     * Method to get the number of dropped records
+     * @param void
+     * @return Number of dropped records
+     */
+    unsigned long long GetDroppedCount();
+
+private:
+    /**
+     * Method run by the writer thread
+     * @param void
+     * @return void
+     */
+    void Run();
+
+    /**
+     * Method to write a batch of records to stdout and the log file
+     * @param[in] rvecBatch Records in the order they were queued
+     * @return void
+     */
+    void WriteBatch(const std::vector<LogRecord> &rvecBatch);
+
+    /**
+     * Method to add a record to the output of a batch
+     * @param[in] rRecord Record to be added
+     * @param[in,out] rstrStdout Output to stdout
+     * @param[in,out] rstrFile Output to the log file
+     * @return void
+     */
+    void AddRecord(const LogRecord &rRecord, std::string &rstrStdout,
+                   std::string &rstrFile);
+
+    /**
+     * Method to wake the writer thread if it is waiting for records
+     * @param void
+     * @return void
+     */
+    void Wake();
+
+    //! Ring buffer of the queued records
+    CBoundedQueue<LogRecord> m_queue;
+
+    //! Mutex of the wake-up and flush conditions
+    std::mutex m_waitMutex;
+
+    //! Condition the writer thread waits on for new records
+    std::condition_variable m_wakeCondition;
+
+    //! Condition flushing log statements wait on for the writer
+    std::condition_variable m_flushCondition;
+
+    //! Flag to stop the writer thread once the queue is drained
+    std::atomic<bool> m_bStop;
+
+    //! Flag indicating the writer thread waits for new records
+    std::atomic<bool> m_bIdle;
+
+    //! Flag indicating the writer thread holds taken but unwritten records
+    std::atomic<bool> m_bBusy;
+
+    //! Number of dropped records already reported in the log
+    unsigned long long m_ullReportedDrops;
+
+    //! Formatter of the text log lines
+    CLogLineFormatter m_formatter;
+
+    //! Writer thread
+    std::thread m_thread;
+};
+
+/**
+ * Method to map the log overflow policy to the queue overflow policy
+ * @param[in] ePolicy Log overflow policy
+ * @return Queue overflow policy
+ */
+static OverflowPolicy to_queue_policy(const LogOverflowPolicy ePolicy)
+{
+    OverflowPolicy eQueuePolicy = eOVERFLOW_DROP_NEWEST;
+    if (eLOG_OVERFLOW_BLOCK == ePolicy)
+    {
+        eQueuePolicy = eOVERFLOW_BLOCK;
+    }
+    else if (eLOG_OVERFLOW_DROP_OLDEST == ePolicy)
+    {
+        eQueuePolicy = eOVERFLOW_DROP_OLDEST;
+    }
+    return eQueuePolicy;
+}
+
+CAsyncLogWriter::CAsyncLogWriter(const unsigned int unCapacity,
+                                 const LogOverflowPolicy ePolicy,
+                                 const unsigned int unBlockTimeoutMs)
+    : m_queue(unCapacity, 0, to_queue_policy(ePolicy), unBlockTimeoutMs),
+      m_bStop(false), m_bIdle(false), m_bBusy(false), m_ullReportedDrops(0)
+{
+    m_thread = std::thread(&CAsyncLogWriter::Run, this);
+}
+
+CAsyncLogWriter::~CAsyncLogWriter()
+{
+    m_bStop = true;
+    Wake();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool CAsyncLogWriter::Push(const LogRecord &rRecord)
+{
+    bool bQueued = m_queue.Put(rRecord);
+
+    /* The writer marks itself idle before it checks the queue once more, so
+     * either it sees this record or this thread sees it idle
+     */
+    if (m_bIdle.load())
+    {
+        Wake();
+    }
+    return bQueued;
+}
+
+bool CAsyncLogWriter::Flush(const unsigned int unTimeoutMs)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(unTimeoutMs);
+
+    std::unique_lock<std::mutex> lock(m_waitMutex);
+    while ((0 != m_queue.GetItemCount()) || m_bBusy.load())
+    {
+        m_wakeCondition.notify_one();
+        if (std::cv_status::timeout ==
+            m_flushCondition.wait_until(lock, deadline))
+        {
+            return ((0 == m_queue.GetItemCount()) && !m_bBusy.load());
+        }
+    }
+    return true;
+}
+
+unsigned long long CAsyncLogWriter::GetDroppedCount()
+{
+    return m_queue.GetStats().ullDroppedCount;
+}
+
+void CAsyncLogWriter::Wake()
+{
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    m_wakeCondition.notify_one();
+}
+
+void CAsyncLogWriter::Run()
+{
+    g_bIsAsyncWriter = true;
+    std::vector<LogRecord> vecBatch;
+    vecBatch.reserve(ASYNC_MAX_BATCH);
+    LogRecord record;
+
+    while (true)
+    {
+        m_bBusy = true;
+        while ((vecBatch.size() < ASYNC_MAX_BATCH) && m_queue.Take(&record))
+        {
+            vecBatch.push_back(record);
+        }
+
+        if (!vecBatch.empty())
+        {
+            WriteBatch(vecBatch);
+            vecBatch.clear();
+        }
+
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        m_bBusy = false;
+        m_flushCondition.notify_all();
+        if (0 != m_queue.GetItemCount())
+        {
+            continue;
+        }
+        if (m_bStop.load())
+        {
+            break;
+        }
+
+        m_bIdle = true;
+        if (0 == m_queue.GetItemCount())
+        {
+            m_wakeCondition.wait_for(lock,
+                std::chrono::milliseconds(ASYNC_IDLE_WAIT_MS));
+        }
+        m_bIdle = false;
+    }
+}
+
+void CAsyncLogWriter::WriteBatch(const std::vector<LogRecord> &rvecBatch)
+{
+    std::string strStdout;
+    std::string strFile;
+    bool bWritten = false;
+    {
+        CLogFileLock lock;
+        unsigned long long ullDropped = GetDroppedCount();
+        if (ullDropped > m_ullReportedDrops)
+        {
+            LogRecord dropRecord;
+            dropRecord.eLevel = eHCP_LOG_WARNING;
+            dropRecord.ullTimeUs = rvecBatch.front().ullTimeUs;
+            dropRecord.threadId = pthread_self();
+            dropRecord.pSite = NULL;
+            dropRecord.bBinary = false;
+            dropRecord.strMessage = std::to_string(ullDropped -
+                                    m_ullReportedDrops) + " log records dropped";
+            dropRecord.bIsLast = false;
+            m_ullReportedDrops = ullDropped;
+            AddRecord(dropRecord, strStdout, strFile);
+        }
+
+        for (size_t nIndex = 0; nIndex < rvecBatch.size(); nIndex++)
+        {
+            const LogRecord &rRecord = rvecBatch[nIndex];
+            AddRecord(rRecord, strStdout, strFile);
+            if (rRecord.bIsLast &&
+                (rRecord.eLevel <= CIgniteLog::m_eFileOutputLevel) &&
+                CIgniteLog::m_of.is_open())
+            {
+                CIgniteLog::m_atomicFileSize += strFile.size();
+                CIgniteLog::m_of << strFile;
+                CIgniteLog::m_of.flush();
+                CIgniteLog::m_of.close();
+                strFile.clear();
+            }
+        }
+
+        if (!strFile.empty() && CIgniteLog::m_of.is_open())
+        {
+            CIgniteLog::m_atomicFileSize += strFile.size();
+            CIgniteLog::m_of << strFile;
+            CIgniteLog::m_of.flush();
+            bWritten = true;
+        }
+    }
+
+    if (!strStdout.empty())
+    {
+        fwrite(strStdout.data(), 1, strStdout.size(), stdout);
+        fflush(stdout);
+    }
+
+    if (bWritten)
+    {
+        // Truncation takes the file mutex itself
+        CIgniteLog::TruncateIfRequired();
+    }
+}
+
+void CAsyncLogWriter::AddRecord(const LogRecord &rRecord,
+                                std::string &rstrStdout, std::string &rstrFile)
+{
+    bool bToStdout = (rRecord.eLevel <= CIgniteLog::m_eReportingLevel);
+    bool bToFile = (rRecord.eLevel <= CIgniteLog::m_eFileOutputLevel);
+    bool bBinaryFile = g_bBinaryMode.load();
+    std::string strLine;
+
+    if (bToStdout || (bToFile && !bBinaryFile))
+    {
+        m_formatter.Format(rRecord.eLevel, rRecord.ullTimeUs,
+                           (unsigned long long)rRecord.threadId, "",
+                           get_record_text(rRecord.pSite, rRecord.bBinary,
+                                           rRecord.strMessage), strLine);
+    }
+
+    if (bToStdout)
+    {
+        rstrStdout.append(strLine);
+    }
+
+    if (bToFile && bBinaryFile && rRecord.bBinary)
+    {
+        CIgniteLog::EncodeBinaryRecord(rRecord.pSite, rRecord.eLevel,
+                                       rRecord.ullTimeUs, rRecord.threadId,
+                                       rRecord.strMessage, rstrFile);
+    }
+    else if (bToFile && bBinaryFile)
+    {
+        // Text record, e.g. queued before the switch to the binary format
+        std::string strArgs;
+        CBinaryLogCodec::AppendString(rRecord.strMessage.data(),
+                                      rRecord.strMessage.size(), strArgs);
+        CIgniteLog::EncodeBinaryRecord(NULL, rRecord.eLevel, rRecord.ullTimeUs,
+                                       rRecord.threadId, strArgs, rstrFile);
+    }
+    else if (bToFile)
+    {
+        rstrFile.append(strLine);
+    }
+}
+
+CLogSite::CLogSite(const char *pchBefore, const char *pchFunc,
+                   const int nLine, const char *pchAfter)
+    : m_unId(++g_atomicSiteCount), m_strText(pchBefore)
+{
+    m_strText.append(pchFunc);
+    if (nLine >= 0)
+    {
+        m_strText.append(":" + std::to_string(nLine));
+    }
+    m_strText.append(pchAfter);
+}
+
+CLogStream::CLogStream() : m_bBinary(false)
+{
+    //do nothing
+}
+
+void CLogStream::SetBinary()
+{
+    m_bBinary = true;
+}
+
+std::string CLogStream::str() const
+{
+    return (m_bBinary ? m_strArgs : m_os.str());
+}
+
+bool CLogStream::IsRaw() const
+{
+    return (m_bBinary &&
+            (m_os.flags() == (std::ios_base::skipws | std::ios_base::dec)) &&
+            (0 == m_os.width()) && (6 == m_os.precision()));
+}
+
+void CLogStream::AppendFormatted()
+{
+    std::string strFormatted = m_os.str();
+    if (!strFormatted.empty())
+    {
+        CBinaryLogCodec::AppendString(strFormatted.data(), strFormatted.size(),
+                                      m_strArgs);
+    }
+}
+
+void CLogStream::AppendInt(const long long llValue)
+{
+    CBinaryLogCodec::AppendInt(llValue, m_strArgs);
+}
+
+void CLogStream::AppendUInt(const unsigned long long ullValue)
+{
+    CBinaryLogCodec::AppendUInt(ullValue, m_strArgs);
+}
+
+CLogStream& CLogStream::operator<<(bool bValue)
+{
+    // Printed as 0 or 1 unless std::boolalpha is set
+    return PutInt(bValue);
+}
+
+CLogStream& CLogStream::operator<<(char chValue)
+{
+    if (IsRaw())
+    {
+        CBinaryLogCodec::AppendString(&chValue, 1, m_strArgs);
+        return *this;
+    }
+    return Put(chValue);
+}
+
+CLogStream& CLogStream::operator<<(signed char chValue)
+{
+    return (*this << (char)chValue);
+}
+
+CLogStream& CLogStream::operator<<(unsigned char uchValue)
+{
+    return (*this << (char)uchValue);
+}
+
+CLogStream& CLogStream::operator<<(short sValue)
+{
+    return PutInt(sValue);
+}
+
+CLogStream& CLogStream::operator<<(unsigned short usValue)
+{
+    return PutUInt(usValue);
+}
+
+CLogStream& CLogStream::operator<<(int nValue)
+{
+    return PutInt(nValue);
+}
+
+CLogStream& CLogStream::operator<<(unsigned int unValue)
+{
+    return PutUInt(unValue);
+}
+
+CLogStream& CLogStream::operator<<(long lValue)
+{
+    return PutInt(lValue);
+}
+
+CLogStream& CLogStream::operator<<(unsigned long ulValue)
+{
+    return PutUInt(ulValue);
+}
+
+CLogStream& CLogStream::operator<<(long long llValue)
+{
+    return PutInt(llValue);
+}
+
+CLogStream& CLogStream::operator<<(unsigned long long ullValue)
+{
+    return PutUInt(ullValue);
+}
+
+CLogStream& CLogStream::operator<<(float fValue)
+{
+    return (*this << (double)fValue);
+}
+
+CLogStream& CLogStream::operator<<(double dValue)
+{
+    if (IsRaw())
+    {
+        CBinaryLogCodec::AppendDouble(dValue, m_strArgs);
+        return *this;
+    }
+    return Put(dValue);
+}
+
+CLogStream& CLogStream::operator<<(const char *pchValue)
+{
+    if (IsRaw() && (NULL != pchValue))
+    {
+        CBinaryLogCodec::AppendString(pchValue, strlen(pchValue), m_strArgs);
+        return *this;
+    }
+    return Put(pchValue);
+}
+
+CLogStream& CLogStream::operator<<(const std::string &rstrValue)
+{
+    if (IsRaw())
+    {
+        CBinaryLogCodec::AppendString(rstrValue.data(), rstrValue.size(),
+                                      m_strArgs);
+        return *this;
+    }
+    return Put(rstrValue);
+}
+
+CLogStream& CLogStream::operator<<(std::ostream& (*pfnManip)(std::ostream&))
+{
+    // Output of manipulators such as std::endl is kept as a string argument
+    return Put(pfnManip);
+}
+
+CLogStream& CLogStream::operator<<(std::ios_base& (*pfnManip)(std::ios_base&))
+{
+    // Format flags apply to the scratch stream in binary mode as well
+    pfnManip(m_os);
+    return *this;
+}
+
 //! m_eReportingLevel for the default reporting log level.
 LogLevel CIgniteLog::m_eReportingLevel = eHCP_LOG_FATAL;
 
 //! m_eFileOutputLevel for the default log level for file output.
 LogLevel CIgniteLog::m_eFileOutputLevel = eHCP_LOG_NONE;
 
+static_assert(9 == eLOG_MODULE_COUNT, "module level tables need an entry "
+              "per module");
+
+//! No module is restricted by default.
+std::atomic<int> CIgniteLog::m_arrModuleLevel[eLOG_MODULE_COUNT] = {
+    {eHCP_LOG_TRACE}, {eHCP_LOG_TRACE}, {eHCP_LOG_TRACE}, {eHCP_LOG_TRACE},
+    {eHCP_LOG_TRACE}, {eHCP_LOG_TRACE}, {eHCP_LOG_TRACE}, {eHCP_LOG_TRACE},
+    {eHCP_LOG_TRACE}};
+
+//! Enabled levels follow the default reporting level until levels are set.
+std::atomic<int> CIgniteLog::m_arrEnabledLevel[eLOG_MODULE_COUNT] = {
+    {eHCP_LOG_FATAL}, {eHCP_LOG_FATAL}, {eHCP_LOG_FATAL}, {eHCP_LOG_FATAL},
+    {eHCP_LOG_FATAL}, {eHCP_LOG_FATAL}, {eHCP_LOG_FATAL}, {eHCP_LOG_FATAL},
+    {eHCP_LOG_FATAL}};
+
 //! Mutex for controlling access to log-related operations.
 CIgniteMutex CIgniteLog::m_logMutex;
 
+//! Mutex serializing log file writes except inline text ones, open, close and
+//! move.
+CIgniteMutex CIgniteLog::m_fileMutex;
+
 //! Flag indicating whether log truncation is enabled.
 bool CIgniteLog::m_bTruncateLog(true);
 
@@ -111,30 +737,87 @@ std::map<std::string, std::string> CIgniteLog::m_mapStatus;
 //! Mutex for controlling access to the status map in the log.
 ic_utils::CIgniteMutex CIgniteLog::m_statusMutex;
 
-std::ostringstream& CIgniteLog::Get(LogLevel eLevel)
+//! Async writer, defined after the log file so that it is destroyed first.
+std::shared_ptr<CAsyncLogWriter> CIgniteLog::m_pAsyncWriter;
+
+CLogStream& CIgniteLog::Get(LogLevel eLevel, const CLogSite *pSite)
 {
     m_eLogLevel = eLevel;
+    m_pSite = pSite;
+    if (g_bAsyncEnabled.load(std::memory_order_relaxed) && !g_bIsAsyncWriter &&
+        !g_bHoldsFileMutex)
+    {
+        m_pWriter = std::atomic_load(&m_pAsyncWriter);
+    }
+    if (m_pWriter || g_bBinaryMode.load(std::memory_order_relaxed))
+    {
+        // The prefix is formatted later from the captured values
+        struct timeval stTv;
+        gettimeofday(&stTv, 0);
+        m_ullTimeUs = (unsigned long long)stTv.tv_sec * 1000000 + stTv.tv_usec;
+        m_threadId = pthread_self();
+        if (g_bBinaryMode.load(std::memory_order_relaxed))
+        {
+            m_os.SetBinary();
+        }
+        else if (NULL != pSite)
+        {
+            m_os << pSite->GetText();
+        }
+        return m_os;
+    }
+
     m_os << get_time_formatted();
     m_os << " " << ToString(eLevel);
     m_os << " " << pthread_self();
     m_os << ": ";
+    if (NULL != pSite)
+    {
+        m_os << pSite->GetText();
+    }
 
     //m_os << std::string(eLevel > logDEBUG ? 0 : eLevel - logDEBUG, '\t');
     return m_os;
 }
 
-CIgniteLog::CIgniteLog()
+CIgniteLog::CIgniteLog() : m_pSite(NULL)
 {
     m_bIsLast = false;
 }
 
-CIgniteLog::CIgniteLog(bool bIsLast) : m_bIsLast(bIsLast)
+CIgniteLog::CIgniteLog(bool bIsLast) : m_bIsLast(bIsLast), m_pSite(NULL)
 {
     //do nothing
 }
 
 CIgniteLog::~CIgniteLog()
 {
+    if (m_pWriter)
+    {
+        LogRecord record;
+        record.eLevel = m_eLogLevel;
+        record.ullTimeUs = m_ullTimeUs;
+        record.threadId = m_threadId;
+        record.pSite = m_pSite;
+        record.bBinary = m_os.IsBinary();
+        record.strMessage = m_os.str();
+        record.bIsLast = m_bIsLast;
+        m_pWriter->Push(record);
+
+        // A fatal record may be the last one before the process goes down
+        if ((eHCP_LOG_FATAL == m_eLogLevel) || m_bIsLast)
+        {
+            m_pWriter->Flush(ASYNC_FLUSH_TIMEOUT_MS);
+        }
+        return;
+    }
+
+    if (m_os.IsBinary())
+    {
+        WriteBinary();
+        return;
+    }
+
     m_os << std::endl;
 
     if (m_eLogLevel <= m_eReportingLevel)
@@ -161,6 +844,54 @@ CIgniteLog::~CIgniteLog()
 
 }
 
+void CIgniteLog::WriteBinary()
+{
+    if (m_eLogLevel <= m_eReportingLevel)
+    {
+        // stdout stays readable, only the log file is binary
+        CLogLineFormatter formatter;
+        std::string strLine;
+        formatter.Format(m_eLogLevel, m_ullTimeUs,
+                         (unsigned long long)m_threadId, "",
+                         get_record_text(m_pSite, true, m_os.str()), strLine);
+        fputs(strLine.c_str(), stdout);
+        fflush(stdout);
+    }
+
+    if (m_eLogLevel > m_eFileOutputLevel)
+    {
+        return;
+    }
+
+    // A log statement of a thread holding the file mutex writes without it
+    bool bNested = g_bHoldsFileMutex;
+    bool bWritten = false;
+    {
+        CLogFileLock lock;
+        if (m_of.is_open())
+        {
+            std::string strRecord;
+            EncodeBinaryRecord(m_pSite, m_eLogLevel, m_ullTimeUs, m_threadId,
+                               m_os.str(), strRecord);
+            m_atomicFileSize += strRecord.size();
+            m_of << strRecord;
+            m_of.flush();
+            bWritten = true;
+
+            if (m_bIsLast)
+            {
+                m_of.close();
+            }
+        }
+    }
+
+    if (bWritten && !bNested)
+    {
+        // Truncation takes the file mutex itself
+        TruncateIfRequired();
+    }
+}
+
 void CIgniteLog::CloseLogFile()
 {
     ic_utils::CIgniteLog(true).Get(eHCP_LOG_CRITICAL) \
@@ -180,6 +911,7 @@ void CIgniteLog::SetReportingLevel(const LogLevel& reLevel)
     if ( reLevel <= HCPLOG_MAX_LEVEL )
     {
         m_eReportingLevel = reLevel;
+        UpdateEnabledLevels();
     }
 }
 
@@ -193,6 +925,64 @@ void CIgniteLog::SetFileOutputLevel(const LogLevel& reLevel)
     if ( reLevel <= HCPLOG_MAX_LEVEL )
     {
         m_eFileOutputLevel = reLevel;
+        UpdateEnabledLevels();
+    }
+}
+
+bool CIgniteLog::SetModuleLevel(const LogModule eModule, const LogLevel eLevel)
+{
+    bool bRet = false;
+
+    if ((eModule < eLOG_MODULE_COUNT) && (eLevel <= eHCP_LOG_TRACE))
+    {
+        m_arrModuleLevel[eModule] = eLevel;
+        UpdateEnabledLevels();
+        bRet = true;
+    }
+
+    return bRet;
+}
+
+LogLevel CIgniteLog::GetModuleLevel(const LogModule eModule)
+{
+    LogLevel eLevel = eHCP_LOG_TRACE;
+    if (eModule < eLOG_MODULE_COUNT)
+    {
+        eLevel = static_cast<LogLevel>(m_arrModuleLevel[eModule].load());
+    }
+    return eLevel;
+}
+
+bool CIgniteLog::GetModuleByName(const std::string &rstrName,
+                                 LogModule &reModule)
+{
+    static const char* const cstrModules[] = {"Default", "Utils", "Event",
+        "Network", "Core", "ClientBL", "Auto", "Device", "App"};
+
+    for (int nModule = 0; nModule < eLOG_MODULE_COUNT; nModule++)
+    {
+        if (rstrName == cstrModules[nModule])
+        {
+            reModule = static_cast<LogModule>(nModule);
+            return true;
+        }
+    }
+    return false;
+}
+
+void CIgniteLog::UpdateEnabledLevels()
+{
+    // Setters may race, the last one to recompute wins with current levels
+    static CIgniteMutex levelMutex;
+    ic_utils::CScopeLock lock(levelMutex);
+
+    int nOutputLevel = (m_eReportingLevel > m_eFileOutputLevel) ?
+                       m_eReportingLevel : m_eFileOutputLevel;
+    for (int nModule = 0; nModule < eLOG_MODULE_COUNT; nModule++)
+    {
+        int nModuleLevel = m_arrModuleLevel[nModule].load();
+        m_arrEnabledLevel[nModule].store((nModuleLevel < nOutputLevel) ?
+                                         nModuleLevel : nOutputLevel);
     }
 }
 void CIgniteLog::EnableTruncate()
@@ -256,6 +1046,8 @@ bool CIgniteLog::UpdateFilePath(const std::string& rstrNewPath)
 
 void CIgniteLog::CloseAndFlushLogFile()
 {
+    FlushAsync(ASYNC_FLUSH_TIMEOUT_MS);
+    CLogFileLock lock;
     if (m_of.is_open())
     {
         m_of.flush();
@@ -359,9 +1151,10 @@ void CIgniteLog::TruncateIfRequired()
 
 void CIgniteLog::TruncateFile()
 {
+    CLogFileLock lock;
     if(m_of.is_open())
     {
-        m_of <<"\nTRUNCATING FILE \n";
+        WriteFileText("\nTRUNCATING FILE \n");
         m_of.flush();
         m_of.close();
         std::string strTmpFile = m_strFilePath + ".bak";
@@ -390,8 +1183,7 @@ void CIgniteLog::TruncateFile()
         ic_utils::CIgniteFileUtils::Move(m_strFilePath , strTmpFile);
     }
 
-    m_atomicFileSize=0;
-    m_of.open(m_strFilePath.c_str(), std::ios::app);
+    OpenLogFile(m_strFilePath);
     CIgniteLog::LogStatus();
 }
 
@@ -435,6 +1227,7 @@ void CIgniteLog::SetFileOutputPath(const std::string& rstrPath,
                                    const int nTruncateFileSize,
                                    const int nTruncateToSize)
 {
+    CLogFileLock lock;
     m_strFilePath = rstrPath;
     m_atomicFileSize = 0;
     m_ulTruncateFileSize = nTruncateFileSize;
@@ -455,8 +1248,7 @@ void CIgniteLog::SetFileOutputPath(const std::string& rstrPath,
             m_of.close();
         }
 
-        m_atomicFileSize = ic_utils::CIgniteFileUtils::GetSize(rstrPath);
-        m_of.open(rstrPath.c_str(), std::ios::app);
+        OpenLogFile(rstrPath);
 
         if(!m_of.is_open())
         {
@@ -508,7 +1300,8 @@ bool CIgniteLog::MoveToUpload(std::string strLogPath, std::string strUploadPath,
     }
 
     //start logging into the log file
-    m_of.open(strLogPath, std::ios::app);
+    CLogFileLock lock;
+    OpenLogFile(strLogPath);
     CIgniteLog::LogStatus();
     
     return bIsMoved;
@@ -516,12 +1309,7 @@ bool CIgniteLog::MoveToUpload(std::string strLogPath, std::string strUploadPath,
 
 std::string CIgniteLog::ToString(const LogLevel eLevel)
 {
-    /* static const char* const cstrBuffer[] = {"NONE ", "FATAL", "CRIT ",  
-     * "ERROR", "WARN ", "INFO ", "DEBUG", "TRACE"};
-     */
-    static const char* const cstrBuffer[] = {"N ", "F", "C", "E", "W", "I", "D", 
-                                         "T"};
-    return cstrBuffer[eLevel];
+    return CLogLineFormatter::GetLevelName(eLevel);
 }
 
 inline void print_pre_logger(const std::string &rstrLog)
@@ -558,17 +1346,19 @@ void CIgniteLog::LogStatus()
 
     if(m_of.is_open())
     {
-        m_of <<"****************************************\n";
-        m_of << "Time :"
-             << ic_utils::CIgniteDateTime::GetCurrentFormattedDateTime()
-             << std::endl;
+        std::ostringstream osStatus;
+        osStatus <<"****************************************\n";
+        osStatus << "Time :"
+                 << ic_utils::CIgniteDateTime::GetCurrentFormattedDateTime()
+                 << std::endl;
         for(mapIter = m_mapStatus.begin(); mapIter != m_mapStatus.end(); 
             ++mapIter)
         {
-            m_of << mapIter->first <<"="<<mapIter->second<<std::endl;
+            osStatus << mapIter->first <<"="<<mapIter->second<<std::endl;
         }
-        PrintDiagHeader();
-        m_of << "****************************************\n";
+        WriteDiagHeader(osStatus);
+        osStatus << "****************************************\n";
+        WriteFileText(osStatus.str());
     }
 }
 
@@ -630,38 +1420,154 @@ bool CIgniteLog::PrintDiagHeader(void)
 
     if (m_of.is_open())
     {       
-        m_of << "Diagnostics Information\n";
-        if (!g_vectorDiagHeader.empty())
+        std::ostringstream osDiag;
+        WriteDiagHeader(osDiag);
+        WriteFileText(osDiag.str());
+        bRetVal = true;
+    }
+    else
+    {
+
+    }
+
+    return bRetVal;
+}
+
+void CIgniteLog::WriteDiagHeader(std::ostream &ros)
+{
+    ros << "Diagnostics Information\n";
+    if (!g_vectorDiagHeader.empty())
+    {
+        for (int nI = 0; nI < g_vectorDiagHeader.size(); nI++)
         {
-            for (int nI = 0; nI < g_vectorDiagHeader.size(); nI++)
-            {
-                m_of << g_vectorDiagHeader[nI] << std::endl;
-            }
-            
-#ifdef IC_UNIT_TEST
-            std::cout << "Diagnostics Information\n";
-            for (int nJ = 0; nJ < g_vectorDiagHeader.size(); nJ++)
-            {
-                std::cout << g_vectorDiagHeader[nJ] << std::endl;
-            }
-#endif     
+            ros << g_vectorDiagHeader[nI] << std::endl;
         }
-        else // empty Diag header
+
+#ifdef IC_UNIT_TEST
+        std::cout << "Diagnostics Information\n";
+        for (int nJ = 0; nJ < g_vectorDiagHeader.size(); nJ++)
         {
-            m_of << "No Diag info available/disabled\n";
+            std::cout << g_vectorDiagHeader[nJ] << std::endl;
+        }
+#endif     
+    }
+    else // empty Diag header
+    {
+        ros << "No Diag info available/disabled\n";
 #ifdef IC_UNIT_TEST
-            std::cout << "Diagnostics Information\n";
-            std::cout << "No Diag info available/disabled"<<std::endl;
+        std::cout << "Diagnostics Information\n";
+        std::cout << "No Diag info available/disabled"<<std::endl;
 #endif
+    }
+}
+
+void CIgniteLog::OpenLogFile(const std::string &rstrPath)
+{
+    bool bBinary = g_bBinaryMode.load();
+    int nSize = ic_utils::CIgniteFileUtils::GetSize(rstrPath);
+    unsigned long ulSize = (nSize > 0) ? nSize : 0;
+
+    if (ulSize > 0)
+    {
+        // Keep a file of the other format aside instead of appending to it
+        char chMagic[8] = {0};
+        std::ifstream in(rstrPath.c_str(), std::ios::binary);
+        in.read(chMagic, sizeof(chMagic));
+        bool bIsBinary = ((std::size_t)in.gcount() == BINARY_LOG_MAGIC.size()) &&
+                         (0 == BINARY_LOG_MAGIC.compare(0, std::string::npos,
+                                                        chMagic, in.gcount()));
+        in.close();
+        if (bIsBinary != bBinary)
+        {
+            std::string strFile = rstrPath;
+            std::string strBakFile = rstrPath + ".bak";
+            ic_utils::CIgniteFileUtils::Remove(strBakFile);
+            ic_utils::CIgniteFileUtils::Move(strFile, strBakFile);
+            ulSize = 0;
         }
-        bRetVal = true;
+    }
+
+    m_of.open(rstrPath.c_str(), std::ios::app | std::ios::binary);
+    m_atomicFileSize = ulSize;
+    g_vecSiteWritten.assign(g_vecSiteWritten.size(), false);
+
+    if (bBinary && m_of.is_open())
+    {
+        std::string strHeader = (0 == ulSize) ? BINARY_LOG_MAGIC : "";
+
+        // The decoder shows times in the device local time
+        time_t now = time(NULL);
+        tm r = {0};
+        localtime_r(&now, &r);
+        CBinaryLogCodec::EncodeZone(r.tm_gmtoff, strHeader);
+        m_atomicFileSize += strHeader.size();
+        m_of << strHeader;
+        m_of.flush();
+    }
+}
+
+void CIgniteLog::WriteFileText(const std::string &rstrText)
+{
+    if (g_bBinaryMode.load())
+    {
+        std::string strRecord;
+        CBinaryLogCodec::EncodeText(rstrText, strRecord);
+        m_atomicFileSize += strRecord.size();
+        m_of << strRecord;
     }
     else
     {
+        m_of << rstrText;
+    }
+}
+
+void CIgniteLog::EncodeBinaryRecord(const CLogSite *pSite,
+                                    const LogLevel eLevel,
+                                    const unsigned long long ullTimeUs,
+                                    const pthread_t threadId,
+                                    const std::string &rstrArgs,
+                                    std::string &rstrOut)
+{
+    unsigned int unSiteId = 0;
+    if (NULL != pSite)
+    {
+        unSiteId = pSite->GetId();
+        if (g_vecSiteWritten.size() <= unSiteId)
+        {
+            g_vecSiteWritten.resize(unSiteId + 1, false);
+        }
+        if (!g_vecSiteWritten[unSiteId])
+        {
+            CBinaryLogCodec::EncodeSite(unSiteId, pSite->GetText(), rstrOut);
+            g_vecSiteWritten[unSiteId] = true;
+        }
+    }
+    CBinaryLogCodec::EncodeLog(unSiteId, eLevel, ullTimeUs,
+                               (unsigned long long)threadId, rstrArgs, rstrOut);
+}
 
+void CIgniteLog::SetBinaryMode(const bool bBinary)
+{
+    FlushAsync(ASYNC_FLUSH_TIMEOUT_MS);
+    CLogFileLock lock;
+    if (bBinary == g_bBinaryMode.load())
+    {
+        return;
     }
 
-    return bRetVal;
+    g_bBinaryMode = bBinary;
+    if (m_of.is_open())
+    {
+        m_of.flush();
+        m_of.close();
+        OpenLogFile(m_strFilePath);
+        LogStatus();
+    }
+}
+
+bool CIgniteLog::IsBinaryMode()
+{
+    return g_bBinaryMode.load();
 }
 
 unsigned int CIgniteLog::GetMaxDiagEntryValue()
@@ -692,5 +1598,56 @@ void CIgniteLog::ResetDiagHeader(void)
     g_vectorDiagHeader.clear();
 }
 
+bool CIgniteLog::EnableAsync(const unsigned int unCapacity,
+                             const LogOverflowPolicy ePolicy,
+                             const unsigned int unBlockTimeoutMs)
+{
+    static std::mutex enableMutex;
+    std::lock_guard<std::mutex> lock(enableMutex);
+    if (std::atomic_load(&m_pAsyncWriter))
+    {
+        return false;
+    }
+
+    std::shared_ptr<CAsyncLogWriter> pWriter =
+        std::make_shared<CAsyncLogWriter>(unCapacity, ePolicy,
+                                          unBlockTimeoutMs);
+    std::atomic_store(&m_pAsyncWriter, pWriter);
+    g_bAsyncEnabled = true;
+    return true;
+}
+
+void CIgniteLog::DisableAsync()
+{
+    std::shared_ptr<CAsyncLogWriter> pWriter;
+
+    /* Log statements in flight keep their own reference, the last one
+     * releasing it drains the queue and joins the writer thread
+     */
+    g_bAsyncEnabled = false;
+    pWriter = std::atomic_exchange(&m_pAsyncWriter, pWriter);
+    if (pWriter)
+    {
+        pWriter->Flush(ASYNC_FLUSH_TIMEOUT_MS);
+    }
+}
+
+bool CIgniteLog::IsAsyncEnabled()
+{
+    return (NULL != std::atomic_load(&m_pAsyncWriter));
+}
+
+bool CIgniteLog::FlushAsync(const unsigned int unTimeoutMs)
+{
+    std::shared_ptr<CAsyncLogWriter> pWriter = std::atomic_load(&m_pAsyncWriter);
+    return (pWriter ? pWriter->Flush(unTimeoutMs) : true);
+}
+
+unsigned long long CIgniteLog::GetAsyncDroppedCount()
+{
+    std::shared_ptr<CAsyncLogWriter> pWriter = std::atomic_load(&m_pAsyncWriter);
+    return (pWriter ? pWriter->GetDroppedCount() : 0);
+}
+
 } /* namespace ic_utils */
 
@@ -78,7 +78,12 @@ int CThreadCondition::ConditionTimedwait(CIgniteMutex& rMutex ,
     struct timeval now;
     gettimeofday(&now,NULL);
     stTimeToWait.tv_sec =  now.tv_sec + (unTimeInMs / 1000);
-    stTimeToWait.tv_nsec = (now.tv_usec+1000UL*unTimeInMs)*1000UL;
+    stTimeToWait.tv_nsec = (now.tv_usec + 1000UL * (unTimeInMs % 1000)) * 1000UL;
+    if (stTimeToWait.tv_nsec >= 1000000000L)
+    {
+        stTimeToWait.tv_sec++;
+        stTimeToWait.tv_nsec -= 1000000000L;
+    }
     return pthread_cond_timedwait(&m_conditionVar, rMutex.GetMutexHandle(), 
                                   &stTimeToWait);
 }
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "CBinaryLog.h"
+
+namespace ic_utils
+{
+//! Define a test fixture for CBinaryLogCodec and CBinaryLogDecoder
+class CBinaryLogTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CBinaryLogTest()
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CBinaryLogTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * SetUp method : Code here will be called immediately after the
+     * constructor (right before each test)
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * TearDown method : Code here will be called immediately after
+     * each test (right before the destructor)
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        // Do nothing
+    }
+};
+
+// Tests
+
+TEST_F(CBinaryLogTest, Test_Varint_RoundTrip)
+{
+    const unsigned long long arrValues[] = {0, 1, 127, 128, 300, 16384,
+        0xFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL};
+    std::string strData;
+    for (size_t nIdx = 0; nIdx < sizeof(arrValues) / sizeof(arrValues[0]);
+         nIdx++)
+    {
+        CBinaryLogCodec::AppendVarint(arrValues[nIdx], strData);
+    }
+
+    size_t nPos = 0;
+    for (size_t nIdx = 0; nIdx < sizeof(arrValues) / sizeof(arrValues[0]);
+         nIdx++)
+    {
+        unsigned long long ullValue = 0;
+        EXPECT_TRUE(CBinaryLogCodec::ReadVarint(strData, nPos, ullValue));
+        EXPECT_EQ(arrValues[nIdx], ullValue);
+    }
+    EXPECT_EQ(strData.size(), nPos);
+
+    // Expect a varint cut off at the end of the data to fail
+    unsigned long long ullValue = 0;
+    nPos = 0;
+    EXPECT_FALSE(CBinaryLogCodec::ReadVarint(std::string("\x80\x80"), nPos,
+                                             ullValue));
+}
+
+TEST_F(CBinaryLogTest, Test_FormatArgs_MatchesStream)
+{
+    std::string strArgs;
+    std::ostringstream os;
+
+    CBinaryLogCodec::AppendString("speed=", 6, strArgs);
+    os << "speed=";
+    CBinaryLogCodec::AppendInt(-42, strArgs);
+    os << -42;
+    CBinaryLogCodec::AppendUInt(18446744073709551615ULL, strArgs);
+    os << 18446744073709551615ULL;
+    CBinaryLogCodec::AppendDouble(3.14159265, strArgs);
+    os << 3.14159265;
+    CBinaryLogCodec::AppendDouble(1e-7, strArgs);
+    os << 1e-7;
+    CBinaryLogCodec::AppendDouble(1234567.0, strArgs);
+    os << 1234567.0;
+    CBinaryLogCodec::AppendDouble(0.5f, strArgs);
+    os << 0.5f;
+
+    std::string strOut;
+    EXPECT_TRUE(CBinaryLogCodec::FormatArgs(strArgs, strOut));
+    EXPECT_EQ(os.str(), strOut);
+
+    // Expect malformed arguments to fail after the valid ones
+    strOut.clear();
+    EXPECT_FALSE(CBinaryLogCodec::FormatArgs(strArgs + "\x09", strOut));
+    EXPECT_EQ(os.str(), strOut);
+}
+
+TEST_F(CBinaryLogTest, Test_Decode_TextLayout)
+{
+    // 2023-11-14 22:13:20.123 UTC, shown one hour ahead
+    const unsigned long long ullTimeUs = 1700000000123456ULL;
+    std::string strArgs;
+    CBinaryLogCodec::AppendString("value ", 6, strArgs);
+    CBinaryLogCodec::AppendInt(7, strArgs);
+
+    std::string strLog = BINARY_LOG_MAGIC;
+    CBinaryLogCodec::EncodeZone(3600, strLog);
+    CBinaryLogCodec::EncodeSite(3, "CTest::Run:42 ", strLog);
+    CBinaryLogCodec::EncodeLog(3, 4, ullTimeUs, 1234, strArgs, strLog);
+    CBinaryLogCodec::EncodeText("**status**\n", strLog);
+    CBinaryLogCodec::EncodeLog(0, 1, ullTimeUs + 1000000, 99, "", strLog);
+
+    CBinaryLogDecoder decoder;
+    std::string strText;
+    EXPECT_TRUE(decoder.Decode(strLog, strText));
+    EXPECT_EQ("23:13:20.123 W 1234: CTest::Run:42 value 7\n"
+              "**status**\n"
+              "23:13:21.123 F 99: \n", strText);
+
+    // Expect a record cut off by a reset to end the decoding
+    CBinaryLogDecoder truncated;
+    strText.clear();
+    EXPECT_FALSE(truncated.Decode(strLog.substr(0, strLog.size() - 2),
+                                  strText));
+    EXPECT_EQ("23:13:20.123 W 1234: CTest::Run:42 value 7\n"
+              "**status**\n", strText);
+
+    // Expect a text log to be rejected
+    CBinaryLogDecoder text;
+    strText.clear();
+    EXPECT_FALSE(text.Decode("12:00:00.000 I 1: text log\n", strText));
+    EXPECT_TRUE(strText.empty());
+}
+
+} /* namespace ic_utils */
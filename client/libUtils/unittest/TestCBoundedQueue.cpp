@@ -0,0 +1,280 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "CBoundedQueue.h"
+#include "CIgniteDateTime.h"
+
+namespace ic_utils
+{
+namespace
+{
+//! Spill file used by the tests
+const std::string TEST_SPILL_FILE = "/tmp/ic_test_bounded_queue.spill";
+
+/**
+ * Method to serialize a string for the spill file
+ * @param[in] rstrData Item to be serialized
+ * @param[out] rstrOut Serialized item
+ * @return true always
+ */
+bool EncodeString(const std::string &rstrData, std::string &rstrOut)
+{
+    rstrOut = rstrData;
+    return true;
+}
+
+/**
+ * Method to deserialize a string from the spill file
+ * @param[in] rstrIn Serialized item
+ * @param[out] rstrData Deserialized item
+ * @return true always
+ */
+bool DecodeString(const std::string &rstrIn, std::string &rstrData)
+{
+    rstrData = rstrIn;
+    return true;
+}
+}
+
+//! Define a test fixture for CBoundedQueue
+class CBoundedQueueTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CBoundedQueueTest()
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CBoundedQueueTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * SetUp method : Code here will be called immediately after the
+     * constructor (right before each test)
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * TearDown method : Code here will be called immediately after
+     * each test (right before the destructor)
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        // Do nothing
+    }
+};
+
+// Tests
+
+TEST_F(CBoundedQueueTest, Test_put_take_in_order_with_accounting)
+{
+    CBoundedQueue<std::string> queue(4);
+    EXPECT_TRUE(queue.Put("a", 10));
+    EXPECT_TRUE(queue.Put("bb", 20));
+    EXPECT_EQ(30u, queue.Size());
+    EXPECT_EQ(2u, queue.GetItemCount());
+
+    std::string strData;
+    EXPECT_TRUE(queue.Take(&strData));
+    EXPECT_EQ("a", strData);
+    EXPECT_EQ(20u, queue.Size());
+    EXPECT_TRUE(queue.Take(&strData));
+    EXPECT_EQ("bb", strData);
+    EXPECT_FALSE(queue.Take(&strData));
+
+    QueueStats stStats = queue.GetStats();
+    EXPECT_EQ(0u, stStats.unItems);
+    EXPECT_EQ(0u, stStats.ullBytes);
+    EXPECT_EQ(2u, stStats.ullPutCount);
+    EXPECT_EQ(2u, stStats.ullTakeCount);
+    EXPECT_EQ(0u, stStats.ullDroppedCount);
+}
+
+TEST_F(CBoundedQueueTest, Test_drop_newest_on_item_and_byte_limit)
+{
+    CBoundedQueue<int> queue(2, 100, eOVERFLOW_DROP_NEWEST);
+    EXPECT_TRUE(queue.Put(1, 10));
+    EXPECT_TRUE(queue.Put(2, 10));
+
+    // item limit is expected to reject the third item
+    EXPECT_FALSE(queue.Put(3, 10));
+
+    int nData = 0;
+    EXPECT_TRUE(queue.Take(&nData));
+    EXPECT_TRUE(queue.Take(&nData));
+
+    // byte limit is expected to reject the item once exceeded
+    EXPECT_TRUE(queue.Put(4, 90));
+    EXPECT_FALSE(queue.Put(5, 20));
+    EXPECT_EQ(90u, queue.Size());
+    EXPECT_EQ(2u, queue.GetStats().ullDroppedCount);
+
+    // an item larger than the limit is expected to fit an empty queue
+    EXPECT_TRUE(queue.Take(&nData));
+    EXPECT_TRUE(queue.Put(6, 500));
+}
+
+TEST_F(CBoundedQueueTest, Test_drop_oldest_evicts_head)
+{
+    CBoundedQueue<int> queue(4, 0, eOVERFLOW_DROP_OLDEST);
+    for (int i = 1; i <= 6; i++)
+    {
+        EXPECT_TRUE(queue.Put(i));
+    }
+
+    // two oldest items are expected to be evicted
+    int nData = 0;
+    for (int i = 3; i <= 6; i++)
+    {
+        EXPECT_TRUE(queue.Take(&nData));
+        EXPECT_EQ(i, nData);
+    }
+    EXPECT_EQ(2u, queue.GetStats().ullDroppedCount);
+}
+
+TEST_F(CBoundedQueueTest, Test_block_waits_for_consumer)
+{
+    CBoundedQueue<int> queue(2, 0, eOVERFLOW_BLOCK, 200);
+    EXPECT_TRUE(queue.Put(1));
+    EXPECT_TRUE(queue.Put(2));
+
+    // put is expected to fail after the timeout when nobody consumes
+    unsigned long long ullStart = CIgniteDateTime::GetMonotonicTimeMs();
+    EXPECT_FALSE(queue.Put(3));
+    EXPECT_GE(CIgniteDateTime::GetMonotonicTimeMs() - ullStart, 190u);
+
+    // put is expected to succeed once the consumer frees a cell
+    std::thread consumer([&queue]()
+    {
+        usleep(50000);
+        int nData = 0;
+        queue.Take(&nData);
+    });
+    EXPECT_TRUE(queue.Put(4));
+    consumer.join();
+
+    int nData = 0;
+    EXPECT_TRUE(queue.Take(&nData));
+    EXPECT_EQ(2, nData);
+    EXPECT_TRUE(queue.Take(&nData));
+    EXPECT_EQ(4, nData);
+}
+
+TEST_F(CBoundedQueueTest, Test_spill_to_disk_keeps_order)
+{
+    CBoundedQueue<std::string> queue(2, 0, eOVERFLOW_SPILL_TO_DISK);
+
+    // without spill file the queue is expected to reject the overflow
+    EXPECT_TRUE(queue.Put("1", 1));
+    EXPECT_TRUE(queue.Put("2", 1));
+    EXPECT_FALSE(queue.Put("x", 1));
+
+    std::string strData;
+    EXPECT_TRUE(queue.Take(&strData));
+    EXPECT_TRUE(queue.EnableSpill(TEST_SPILL_FILE, EncodeString,
+                                  DecodeString));
+
+    EXPECT_TRUE(queue.Put("3", 1));
+    EXPECT_TRUE(queue.Put("4", 1));
+    EXPECT_TRUE(queue.Put("5", 1));
+    EXPECT_EQ(4u, queue.GetItemCount());
+    EXPECT_EQ(2u, queue.GetStats().unSpilledItems);
+
+    // a freed cell is not expected to be used while items are spilled
+    EXPECT_TRUE(queue.Take(&strData));
+    EXPECT_EQ("2", strData);
+    EXPECT_TRUE(queue.Put("6", 1));
+
+    for (int i = 3; i <= 6; i++)
+    {
+        EXPECT_TRUE(queue.Take(&strData));
+        EXPECT_EQ(std::to_string(i), strData);
+    }
+    EXPECT_FALSE(queue.Take(&strData));
+
+    // spill file is expected to be reusable once drained
+    EXPECT_TRUE(queue.Put("7", 1));
+    EXPECT_TRUE(queue.Put("8", 1));
+    EXPECT_TRUE(queue.Put("9", 1));
+    for (int i = 7; i <= 9; i++)
+    {
+        EXPECT_TRUE(queue.Take(&strData));
+        EXPECT_EQ(std::to_string(i), strData);
+    }
+    EXPECT_EQ(4u, queue.GetStats().ullSpillCount);
+}
+
+TEST_F(CBoundedQueueTest, Test_multiple_producers)
+{
+    const int PRODUCERS = 4;
+    const int ITEMS_PER_PRODUCER = 10000;
+    CBoundedQueue<int> queue(256, 0, eOVERFLOW_BLOCK, 5000);
+
+    std::vector<std::thread> vecProducers;
+    for (int nProducer = 0; nProducer < PRODUCERS; nProducer++)
+    {
+        vecProducers.push_back(std::thread([&queue, nProducer]()
+        {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; i++)
+            {
+                queue.Put(nProducer * ITEMS_PER_PRODUCER + i);
+            }
+        }));
+    }
+
+    // items of each producer are expected in the order they were put
+    std::vector<int> vecLast(PRODUCERS, -1);
+    int nTaken = 0;
+    while (nTaken < PRODUCERS * ITEMS_PER_PRODUCER)
+    {
+        int nData = 0;
+        if (queue.Take(&nData))
+        {
+            int nProducer = nData / ITEMS_PER_PRODUCER;
+            EXPECT_LT(vecLast[nProducer], nData);
+            vecLast[nProducer] = nData;
+            nTaken++;
+        }
+    }
+
+    for (size_t i = 0; i < vecProducers.size(); i++)
+    {
+        vecProducers[i].join();
+    }
+    EXPECT_EQ(0u, queue.GetStats().ullDroppedCount);
+    EXPECT_EQ(0u, queue.Size());
+}
+
+} /* namespace ic_utils */
@@ -0,0 +1,324 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <zlib.h>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include "gtest/gtest.h"
+#include "CIgniteGZip.h"
+
+namespace ic_utils
+{
+namespace
+{
+/**
+ * Method to decompress a gzip message
+ * @param[in] puchData Compressed data
+ * @param[in] unSize Size of the compressed data
+ * @param[out] rstrOut Decompressed data
+ * @return true if the message is complete and valid, false otherwise
+ */
+bool Gunzip(const unsigned char *puchData, unsigned int unSize,
+            std::string &rstrOut)
+{
+    z_stream strm = {};
+    if (Z_OK != inflateInit2(&strm, MAX_WBITS + 16))
+    {
+        return false;
+    }
+
+    char chBuf[4096];
+    int nRet = Z_OK;
+    strm.next_in = (Bytef*)puchData;
+    strm.avail_in = unSize;
+    rstrOut.clear();
+    do
+    {
+        strm.next_out = (Bytef*)chBuf;
+        strm.avail_out = sizeof(chBuf);
+        nRet = inflate(&strm, Z_NO_FLUSH);
+        rstrOut.append(chBuf, sizeof(chBuf) - strm.avail_out);
+    } while (Z_OK == nRet);
+
+    inflateEnd(&strm);
+    return (Z_STREAM_END == nRet);
+}
+
+/**
+ * Method to decompress a zlib message compressed with a preset dictionary
+ * @param[in] puchData Compressed data
+ * @param[in] unSize Size of the compressed data
+ * @param[in] rstrDict Preset dictionary
+ * @param[out] rstrOut Decompressed data
+ * @return true if the message is complete and valid, false otherwise
+ */
+bool Inflate(const unsigned char *puchData, unsigned int unSize,
+             const std::string &rstrDict, std::string &rstrOut)
+{
+    z_stream strm = {};
+    if (Z_OK != inflateInit(&strm))
+    {
+        return false;
+    }
+
+    char chBuf[4096];
+    int nRet = Z_OK;
+    strm.next_in = (Bytef*)puchData;
+    strm.avail_in = unSize;
+    rstrOut.clear();
+    do
+    {
+        strm.next_out = (Bytef*)chBuf;
+        strm.avail_out = sizeof(chBuf);
+        nRet = inflate(&strm, Z_NO_FLUSH);
+        if (Z_NEED_DICT == nRet)
+        {
+            nRet = inflateSetDictionary(&strm, (const Bytef*)rstrDict.data(),
+                                        rstrDict.size());
+        }
+        rstrOut.append(chBuf, sizeof(chBuf) - strm.avail_out);
+    } while (Z_OK == nRet);
+
+    inflateEnd(&strm);
+    return (Z_STREAM_END == nRet);
+}
+
+/**
+ * Method to create a batch of events as uploaded
+ * @param[in] nCount Number of events
+ * @return JSON array of events
+ */
+std::string make_events(int nCount)
+{
+    std::string strEvents = "[";
+    for (int nIdx = 0; nIdx < nCount; nIdx++)
+    {
+        strEvents.append((nIdx > 0) ? "," : "");
+        strEvents.append("{\"Data\":{\"speed\":" + std::to_string(nIdx % 90) +
+                         "},\"EventID\":\"Speed\",\"Timestamp\":" +
+                         std::to_string(1700000000000LL + nIdx) +
+                         ",\"Timezone\":60,\"Version\":\"1.0\"}");
+    }
+    strEvents.append("]");
+    return strEvents;
+}
+}
+
+//! Define a test fixture for CIgniteGZip
+class CIgniteGZipTest : public ::testing::Test
+{
+protected:
+    /**
+     * Constructor
+     */
+    CIgniteGZipTest()
+    {
+        // Do nothing
+    }
+
+    /**
+     * Destructor
+     */
+    ~CIgniteGZipTest() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * SetUp method : Code here will be called immediately after the
+     * constructor (right before each test)
+     * @see testing::Test::SetUp()
+     */
+    void SetUp() override
+    {
+        // Do nothing
+    }
+
+    /**
+     * TearDown method : Code here will be called immediately after
+     * each test (right before the destructor)
+     * @see testing::Test::TearDown()
+     */
+    void TearDown() override
+    {
+        // Do nothing
+    }
+};
+
+// Tests
+
+TEST_F(CIgniteGZipTest, Test_GzipMsg)
+{
+    std::string strMsg = "[{\"EventID\":\"Location\",\"Timestamp\":1}]";
+    CZippedMsg *pZipped = CIgniteGZip::GzipMsg((unsigned char*)strMsg.c_str(),
+                                               strMsg.size());
+    ASSERT_NE(nullptr, pZipped);
+
+    std::string strOut;
+    EXPECT_TRUE(Gunzip(pZipped->m_puchBuf, pZipped->m_unSize, strOut));
+    EXPECT_EQ(strMsg, strOut);
+    delete pZipped;
+}
+
+TEST_F(CIgniteGZipTest, Test_GzipStream_AppendsAcrossResets)
+{
+    CGzipStream gzip;
+
+    // Expect every message to be complete, also after the stream is reused
+    for (int nMsg = 0; nMsg < 3; nMsg++)
+    {
+        EXPECT_TRUE(gzip.Reset());
+
+        std::string strMsg;
+        for (int nIdx = 0; nIdx < 5000; nIdx++)
+        {
+            std::string strEvent = "{\"EventID\":\"Location\",\"Timestamp\":" +
+                                   std::to_string(nIdx * nMsg) + "},";
+            strMsg.append(strEvent);
+            EXPECT_TRUE(gzip.Append(strEvent));
+        }
+        EXPECT_FALSE(gzip.IsFinished());
+        EXPECT_TRUE(gzip.Finish());
+        EXPECT_TRUE(gzip.IsFinished());
+        EXPECT_EQ(strMsg.size(), gzip.GetInputSize());
+
+        std::string strOut;
+        EXPECT_TRUE(Gunzip(gzip.GetData(), gzip.GetSize(), strOut));
+        EXPECT_EQ(strMsg, strOut);
+    }
+
+    // Expect appending to a finished message to fail until it is reset
+    EXPECT_FALSE(gzip.Append("x", 1));
+    EXPECT_FALSE(gzip.Finish());
+}
+
+TEST_F(CIgniteGZipTest, Test_GzipStream_EmptyMessage)
+{
+    CGzipStream gzip;
+    EXPECT_TRUE(gzip.Finish());
+
+    std::string strOut = "not empty";
+    EXPECT_TRUE(Gunzip(gzip.GetData(), gzip.GetSize(), strOut));
+    EXPECT_EQ("", strOut);
+}
+
+TEST_F(CIgniteGZipTest, Test_GzipStream_Dictionary)
+{
+    std::vector<std::string> vecEvents;
+    vecEvents.push_back("{\"Data\":{\"speed\":10},\"EventID\":\"Speed\","
+                        "\"Timestamp\":1,\"Timezone\":60,\"Version\":\"1.0\"}");
+    CGzipDictionary dictionary;
+    EXPECT_EQ(1u, dictionary.Train(vecEvents));
+
+    CGzipStream plain;
+    std::string strMsg = make_events(2);
+    EXPECT_TRUE(plain.Append(strMsg));
+    EXPECT_TRUE(plain.Finish());
+
+    CGzipStream gzip;
+    EXPECT_TRUE(gzip.SetDictionary(dictionary.GetData()));
+    EXPECT_NE(0u, gzip.GetDictionaryId());
+
+    // Expect the dictionary to apply to every message and to pay off
+    for (int nMsg = 0; nMsg < 2; nMsg++)
+    {
+        EXPECT_TRUE(gzip.Reset());
+        EXPECT_TRUE(gzip.Append(strMsg));
+        EXPECT_TRUE(gzip.Finish());
+        EXPECT_LT(gzip.GetSize(), plain.GetSize());
+
+        std::string strOut;
+        EXPECT_TRUE(Inflate(gzip.GetData(), gzip.GetSize(),
+                            dictionary.GetData(), strOut));
+        EXPECT_EQ(strMsg, strOut);
+    }
+
+    // Expect a cleared dictionary to go back to plain gzip messages
+    EXPECT_TRUE(gzip.SetDictionary(""));
+    EXPECT_EQ(0u, gzip.GetDictionaryId());
+    EXPECT_TRUE(gzip.Append(strMsg));
+    EXPECT_TRUE(gzip.Finish());
+    std::string strOut;
+    EXPECT_TRUE(Gunzip(gzip.GetData(), gzip.GetSize(), strOut));
+    EXPECT_EQ(strMsg, strOut);
+}
+
+TEST_F(CIgniteGZipTest, Test_GzipDictionary_Train)
+{
+    std::vector<std::string> vecEvents;
+    for (int nIdx = 0; nIdx < 3; nIdx++)
+    {
+        vecEvents.push_back("{\"Data\":{\"on\":true},\"EventID\":\"Rare\","
+                            "\"Timestamp\":" + std::to_string(nIdx) + "}");
+    }
+    for (int nIdx = 0; nIdx < 5; nIdx++)
+    {
+        vecEvents.push_back("{\"Data\":{\"lat\":" + std::to_string(nIdx) +
+                            ",\"vin\":\"" + std::string(40, 'A' + nIdx) +
+                            "\"},\"EventID\":\"Location\",\"Timestamp\":" +
+                            std::to_string(nIdx) + ",\"Version\":\"1.0\"}");
+    }
+    vecEvents.push_back("not an event");
+
+    // Expect values to be dropped, most frequent schema last
+    CGzipDictionary dictionary;
+    EXPECT_EQ(2u, dictionary.Train(vecEvents));
+    EXPECT_EQ("{\"Data\":{\"on\":},\"EventID\":\"Rare\",\"Timestamp\":}"
+              "{\"Data\":{\"lat\":,\"vin\":\"\"},\"EventID\":\"Location\","
+              "\"Timestamp\":,\"Version\":\"1.0\"}", dictionary.GetData());
+
+    // Expect the size limit to keep the most frequent schema only
+    EXPECT_EQ(1u, dictionary.Train(vecEvents, 80));
+    EXPECT_EQ("{\"Data\":{\"lat\":,\"vin\":\"\"},\"EventID\":\"Location\","
+              "\"Timestamp\":,\"Version\":\"1.0\"}", dictionary.GetData());
+
+    // Expect a schema too large for the limit to be skipped, not to end it
+    EXPECT_EQ(1u, dictionary.Train(vecEvents, 60));
+    EXPECT_EQ("{\"Data\":{\"on\":},\"EventID\":\"Rare\",\"Timestamp\":}",
+              dictionary.GetData());
+}
+
+TEST_F(CIgniteGZipTest, Test_GzipDictionary_SaveLoad)
+{
+    std::string strPath = "/tmp/TestCIgniteGZip.dict";
+    std::vector<std::string> vecEvents(1, "{\"EventID\":\"Speed\"}");
+
+    CGzipDictionary dictionary;
+    dictionary.Train(vecEvents);
+    EXPECT_TRUE(dictionary.Save(strPath));
+
+    // Expect the id to be the one the zlib header carries
+    CGzipStream gzip;
+    EXPECT_TRUE(gzip.SetDictionary(dictionary.GetData()));
+    EXPECT_EQ(gzip.GetDictionaryId(), dictionary.GetId());
+
+    CGzipDictionary loaded;
+    EXPECT_TRUE(loaded.Load(strPath));
+    EXPECT_EQ(dictionary.GetId(), loaded.GetId());
+    EXPECT_EQ(dictionary.GetData(), loaded.GetData());
+    remove(strPath.c_str());
+
+    EXPECT_FALSE(loaded.Load(strPath));
+
+    // Expect a content not matching its id to be rejected
+    EXPECT_FALSE(loaded.Parse("{\"id\":1,\"dictionary\":\"{}\"}"));
+    EXPECT_EQ(dictionary.GetData(), loaded.GetData());
+}
+
+} /* namespace ic_utils */
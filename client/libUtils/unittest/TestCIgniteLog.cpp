@@ -19,9 +19,17 @@
 #include <unistd.h>
 #include <string.h>
 #include <fstream>
+#include <sstream>
+#include <iterator>
 #include "gtest/gtest.h"
 #include "CIgniteFileUtils.h"
 #include "CIgniteLog.h"
+#include "CBinaryLog.h"
+
+#ifdef PREFIX
+#undef PREFIX
+#endif
+#define PREFIX "TestCIgniteLog"
 
 //! Constant key for new directory
 static const std::string NEWDIR = "NewDir";
@@ -82,6 +90,71 @@ public:
      * @return True if flag is set true else False
      */
    bool GetTruncateLogStatus();
+
+   /**
+    * Method to hold the log file mutex, which stalls the async writer
+    * @param void
+    * @return void
+    */
+   void LockLogFile()
+   {
+      CIgniteLog::m_fileMutex.Lock();
+   }
+
+   /**
+    * Method to release the log file mutex
+    * @param void
+    * @return void
+    */
+   void UnlockLogFile()
+   {
+      CIgniteLog::m_fileMutex.Unlock();
+   }
+
+   /**
+    * Method to read the content of a file
+    * @param[in] rstrPath Path of the file
+    * @return Content of the file
+    */
+   std::string ReadFile(const std::string &rstrPath)
+   {
+      std::ifstream file(rstrPath);
+      return std::string((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+   }
+
+   /**
+    * Method to log the same statements in every format
+    * @param void
+    * @return void
+    */
+   void LogSample()
+   {
+      std::string strName = "speed";
+      HCPLOG_E << "sample " << strName << "=" << -42 << " max=" << 250u
+               << " ratio=" << 0.75 << " on=" << true << " unit=" << 'k'
+               << " hex=" << std::hex << 255 << " " << 10;
+      HCPLOG_W << "count " << 18446744073709551615ULL;
+      HCPLOG(eHCP_LOG_WARNING) << "no site " << 1.5f;
+   }
+
+   /**
+    * Method to strip the time of every line of a text log
+    * @param[in] rstrLog Text log
+    * @return Text log without the times
+    */
+   std::string StripTimes(const std::string &rstrLog)
+   {
+      std::istringstream in(rstrLog);
+      std::string strLine;
+      std::string strOut;
+      while (std::getline(in, strLine))
+      {
+         strOut.append(strLine.size() > 12 ? strLine.substr(12) : strLine);
+         strOut.append("\n");
+      }
+      return strOut;
+   }
 };
 
 bool CIgniteLogTest::GetTruncateLogStatus()
@@ -553,4 +626,214 @@ TEST_F(CIgniteLogTest, Test_MoveToUpload_validLogPath_compressedTrue)
    CIgniteFileUtils::Remove(strUploadPath);
 }
 
-}
\ No newline at end of file
+// Test case to write async records in order to the log file
+TEST_F(CIgniteLogTest, Test_Async_RecordsWrittenInOrder)
+{
+   std::string strLogPath = "/tmp/TestCIgniteLogAsync.log";
+   CIgniteFileUtils::Remove(strLogPath);
+   LogLevel eFileLevel = CIgniteLog::GetFileOutputLevel();
+   CIgniteLog::SetFileOutputLevel(eHCP_LOG_INFO);
+   CIgniteLog::SetFileOutputPath(strLogPath, 5000000, 3000000);
+
+   EXPECT_TRUE(CIgniteLog::EnableAsync(16, eLOG_OVERFLOW_BLOCK, 1000));
+   EXPECT_FALSE(CIgniteLog::EnableAsync(16, eLOG_OVERFLOW_BLOCK, 1000));
+   EXPECT_TRUE(CIgniteLog::IsAsyncEnabled());
+   for (int nIdx = 0; nIdx < 100; nIdx++)
+   {
+      CIgniteLog().Get(eHCP_LOG_INFO) << "async record " << nIdx << ".";
+   }
+   EXPECT_TRUE(CIgniteLog::FlushAsync(2000));
+   EXPECT_EQ(0u, CIgniteLog::GetAsyncDroppedCount());
+
+   // Expect every record with the inline prefix layout, in logging order
+   std::string strContent = ReadFile(strLogPath);
+   size_t nPos = 0;
+   for (int nIdx = 0; nIdx < 100; nIdx++)
+   {
+      std::string strMsg = ": async record " + std::to_string(nIdx) + ".\n";
+      size_t nFound = strContent.find(strMsg, nPos);
+      ASSERT_NE(std::string::npos, nFound);
+      nPos = nFound + strMsg.size();
+   }
+   EXPECT_EQ(' ', strContent[12]);
+   EXPECT_EQ('I', strContent[13]);
+
+   CIgniteLog::DisableAsync();
+   EXPECT_FALSE(CIgniteLog::IsAsyncEnabled());
+   CIgniteLog::CloseAndFlushLogFile();
+   CIgniteLog::SetFileOutputLevel(eFileLevel);
+   CIgniteFileUtils::Remove(strLogPath);
+}
+
+// Test case to drop and report the newest records when the buffer is full
+TEST_F(CIgniteLogTest, Test_Async_DropNewestWhenFull)
+{
+   std::string strLogPath = "/tmp/TestCIgniteLogAsyncDrop.log";
+   CIgniteFileUtils::Remove(strLogPath);
+   LogLevel eFileLevel = CIgniteLog::GetFileOutputLevel();
+   CIgniteLog::SetFileOutputLevel(eHCP_LOG_INFO);
+   CIgniteLog::SetFileOutputPath(strLogPath, 5000000, 3000000);
+   EXPECT_TRUE(CIgniteLog::EnableAsync(8, eLOG_OVERFLOW_DROP_NEWEST));
+
+   // Stall the writer so that the buffer overflows
+   LockLogFile();
+   for (int nIdx = 0; nIdx < 1000; nIdx++)
+   {
+      CIgniteLog().Get(eHCP_LOG_INFO) << "drop record " << nIdx << ".";
+   }
+   unsigned long long ullDropped = CIgniteLog::GetAsyncDroppedCount();
+   EXPECT_LT(0u, ullDropped);
+   UnlockLogFile();
+
+   // Expect the first records kept and the drops reported in the log
+   CIgniteLog().Get(eHCP_LOG_INFO) << "after drops";
+   EXPECT_TRUE(CIgniteLog::FlushAsync(2000));
+   std::string strContent = ReadFile(strLogPath);
+   EXPECT_NE(std::string::npos, strContent.find(": drop record 0.\n"));
+   EXPECT_NE(std::string::npos, strContent.find(" log records dropped\n"));
+
+   // Expect every record either written or counted as dropped
+   unsigned long long ullWritten = 0;
+   size_t nPos = strContent.find(": drop record ");
+   while (std::string::npos != nPos)
+   {
+      ullWritten++;
+      nPos = strContent.find(": drop record ", nPos + 1);
+   }
+   EXPECT_EQ(1000u, ullWritten + ullDropped);
+
+   CIgniteLog::DisableAsync();
+   CIgniteLog::CloseAndFlushLogFile();
+   CIgniteLog::SetFileOutputLevel(eFileLevel);
+   CIgniteFileUtils::Remove(strLogPath);
+}
+
+// Test case to write a fatal record before the log statement returns
+TEST_F(CIgniteLogTest, Test_Async_FatalRecordFlushed)
+{
+   std::string strLogPath = "/tmp/TestCIgniteLogAsyncFatal.log";
+   CIgniteFileUtils::Remove(strLogPath);
+   LogLevel eFileLevel = CIgniteLog::GetFileOutputLevel();
+   CIgniteLog::SetFileOutputLevel(eHCP_LOG_INFO);
+   CIgniteLog::SetFileOutputPath(strLogPath, 5000000, 3000000);
+   EXPECT_TRUE(CIgniteLog::EnableAsync(64, eLOG_OVERFLOW_DROP_NEWEST));
+
+   CIgniteLog().Get(eHCP_LOG_INFO) << "before fatal";
+   CIgniteLog().Get(eHCP_LOG_FATAL) << "fatal record";
+
+   // Expect both records without an explicit flush
+   std::string strContent = ReadFile(strLogPath);
+   EXPECT_NE(std::string::npos, strContent.find(": before fatal\n"));
+   EXPECT_NE(std::string::npos, strContent.find(" F "));
+   EXPECT_NE(std::string::npos, strContent.find(": fatal record\n"));
+
+   CIgniteLog::DisableAsync();
+   CIgniteLog::CloseAndFlushLogFile();
+   CIgniteLog::SetFileOutputLevel(eFileLevel);
+   CIgniteFileUtils::Remove(strLogPath);
+}
+
+// Test case to skip disabled statements of a module without evaluating them
+TEST_F(CIgniteLogTest, Test_ModuleLevel_DisabledStatementNotEvaluated)
+{
+   LogLevel eReportingLevel = CIgniteLog::GetReportingLevel();
+   LogLevel eFileLevel = CIgniteLog::GetFileOutputLevel();
+   CIgniteLog::SetReportingLevel(eHCP_LOG_INFO);
+   CIgniteLog::SetFileOutputLevel(eHCP_LOG_WARNING);
+   EXPECT_TRUE(CIgniteLog::IsEnabled(eHCP_LOG_INFO, HCPLOG_MODULE));
+   EXPECT_FALSE(CIgniteLog::IsEnabled(eHCP_LOG_DEBUG, HCPLOG_MODULE));
+
+   // Expect a module level to restrict only its own module
+   EXPECT_TRUE(CIgniteLog::SetModuleLevel(HCPLOG_MODULE, eHCP_LOG_ERROR));
+   EXPECT_EQ(eHCP_LOG_ERROR, CIgniteLog::GetModuleLevel(HCPLOG_MODULE));
+   EXPECT_FALSE(CIgniteLog::IsEnabled(eHCP_LOG_INFO, HCPLOG_MODULE));
+   EXPECT_TRUE(CIgniteLog::IsEnabled(eHCP_LOG_ERROR, HCPLOG_MODULE));
+   EXPECT_TRUE(CIgniteLog::IsEnabled(eHCP_LOG_INFO, eLOG_MODULE_APP));
+
+   int nEvaluated = 0;
+   HCPLOG(eHCP_LOG_INFO) << "not logged " << ++nEvaluated;
+   EXPECT_EQ(0, nEvaluated);
+   HCPLOG(eHCP_LOG_ERROR) << "logged " << ++nEvaluated;
+   EXPECT_EQ(1, nEvaluated);
+
+   // Expect a module level not to enable more than the output levels
+   EXPECT_TRUE(CIgniteLog::SetModuleLevel(HCPLOG_MODULE, eHCP_LOG_TRACE));
+   EXPECT_FALSE(CIgniteLog::IsEnabled(eHCP_LOG_DEBUG, HCPLOG_MODULE));
+   EXPECT_FALSE(CIgniteLog::SetModuleLevel(eLOG_MODULE_COUNT, eHCP_LOG_INFO));
+
+   LogModule eModule = eLOG_MODULE_DEFAULT;
+   EXPECT_TRUE(CIgniteLog::GetModuleByName("ClientBL", eModule));
+   EXPECT_EQ(eLOG_MODULE_CLIENTBL, eModule);
+   EXPECT_FALSE(CIgniteLog::GetModuleByName("Unknown", eModule));
+
+   CIgniteLog::SetReportingLevel(eReportingLevel);
+   CIgniteLog::SetFileOutputLevel(eFileLevel);
+}
+
+// Test case to decode a binary log file to the text log layout
+TEST_F(CIgniteLogTest, Test_Binary_DecodesToTextLayout)
+{
+   std::string strTextPath = "/tmp/TestCIgniteLogText.log";
+   std::string strBinaryPath = "/tmp/TestCIgniteLogBinary.log";
+   LogLevel eFileLevel = CIgniteLog::GetFileOutputLevel();
+   CIgniteLog::SetFileOutputLevel(eHCP_LOG_WARNING);
+
+   for (int nAsync = 0; nAsync < 2; nAsync++)
+   {
+      CIgniteFileUtils::Remove(strTextPath);
+      CIgniteFileUtils::Remove(strBinaryPath);
+      if (1 == nAsync)
+      {
+         EXPECT_TRUE(CIgniteLog::EnableAsync(64, eLOG_OVERFLOW_BLOCK, 1000));
+      }
+
+      CIgniteLog::SetFileOutputPath(strTextPath, 5000000, 3000000);
+      LogSample();
+      CIgniteLog::CloseAndFlushLogFile();
+
+      CIgniteLog::SetBinaryMode(true);
+      EXPECT_TRUE(CIgniteLog::IsBinaryMode());
+      CIgniteLog::SetFileOutputPath(strBinaryPath, 5000000, 3000000);
+      LogSample();
+      LogSample();
+      CIgniteLog::CloseAndFlushLogFile();
+      CIgniteLog::SetBinaryMode(false);
+      CIgniteLog::DisableAsync();
+
+      // Expect the decoded statements to match the text log but the times
+      std::string strText = ReadFile(strTextPath);
+      std::string strBinary = ReadFile(strBinaryPath);
+      EXPECT_EQ(0u, strBinary.find(BINARY_LOG_MAGIC));
+      EXPECT_EQ(std::string::npos, strBinary.find("sample speed"));
+
+      CBinaryLogDecoder decoder;
+      std::string strDecoded;
+      EXPECT_TRUE(decoder.Decode(strBinary, strDecoded));
+      EXPECT_NE(std::string::npos,
+                strText.find("sample speed=-42 max=250 ratio=0.75 on=1 "
+                             "unit=k hex=ff a\n"));
+      EXPECT_EQ(StripTimes(strText + strText), StripTimes(strDecoded));
+
+      // Expect the text of each of the two sites written once per file
+      int nSites = 0;
+      size_t nPos = strBinary.find("LogSample");
+      while (std::string::npos != nPos)
+      {
+         nSites++;
+         nPos = strBinary.find("LogSample", nPos + 1);
+      }
+      EXPECT_EQ(2, nSites);
+   }
+
+   // Expect a binary file to be moved aside when opened for text
+   CIgniteLog::SetFileOutputPath(strBinaryPath, 5000000, 3000000);
+   EXPECT_TRUE(CIgniteFileUtils::Exists(strBinaryPath + ".bak"));
+   CIgniteLog::CloseAndFlushLogFile();
+
+   CIgniteLog::SetFileOutputLevel(eFileLevel);
+   CIgniteFileUtils::Remove(strTextPath);
+   CIgniteFileUtils::Remove(strBinaryPath);
+   CIgniteFileUtils::Remove(strBinaryPath + ".bak");
+}
+
+}
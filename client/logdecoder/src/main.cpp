@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (c) 2023-24 Harman International
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+/*!
+*******************************************************************************
+* \file main.cpp
+*
+* \brief logdecoder turns a binary log file, plain or gzip compressed as
+* uploaded, back into the text log layout
+*******************************************************************************
+*/
+
+#include <zlib.h>
+#include <stdio.h>
+#include <string>
+#include "CBinaryLog.h"
+
+namespace
+{
+//! Size of the buffer reading the log file
+const int READ_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * Method to read a log file, gzip compressed files are decompressed
+ * @param[in] pchPath Path of the log file
+ * @param[out] rstrContent Content of the log file
+ * @return true if read, false otherwise
+ */
+bool read_log_file(const char *pchPath, std::string &rstrContent)
+{
+    gzFile file = gzopen(pchPath, "rb");
+    if (NULL == file)
+    {
+        return false;
+    }
+
+    char chBuffer[READ_BUFFER_SIZE];
+    int nRead = 0;
+    while ((nRead = gzread(file, chBuffer, sizeof(chBuffer))) > 0)
+    {
+        rstrContent.append(chBuffer, nRead);
+    }
+    gzclose(file);
+    return (0 == nRead);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if ((argc < 2) || (argc > 3))
+    {
+        fprintf(stderr, "Usage: %s <binary log file> [output file]\n", argv[0]);
+        return 1;
+    }
+
+    std::string strContent;
+    if (!read_log_file(argv[1], strContent))
+    {
+        fprintf(stderr, "Failed to read %s\n", argv[1]);
+        return 1;
+    }
+
+    std::string strText;
+    ic_utils::CBinaryLogDecoder decoder;
+    bool bDecoded = decoder.Decode(strContent, strText);
+
+    FILE *pOut = (3 == argc) ? fopen(argv[2], "w") : stdout;
+    if (NULL == pOut)
+    {
+        fprintf(stderr, "Failed to open %s\n", argv[2]);
+        return 1;
+    }
+    fwrite(strText.data(), 1, strText.size(), pOut);
+    if (stdout != pOut)
+    {
+        fclose(pOut);
+    }
+
+    if (!bDecoded)
+    {
+        // Records up to a cut off or malformed one are still written
+        fprintf(stderr, "%s is not a complete binary log\n", argv[1]);
+        return 2;
+    }
+    return 0;
+}